@@ -12,6 +12,7 @@
 
 #include "platform_utils.hpp"
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 
@@ -121,6 +122,21 @@ bool FileSysUtilsFindFilesInPath(const std::string& path, std::vector<std::strin
     return true;
 }
 
+bool FileSysUtilsGetFileStamp(const std::string& path, uint64_t& size, uint64_t& modification_stamp) {
+    std::error_code ec;
+    const auto file_size = FS_PREFIX::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto write_time = FS_PREFIX::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    size = static_cast<uint64_t>(file_size);
+    modification_stamp = static_cast<uint64_t>(write_time.time_since_epoch().count());
+    return true;
+}
+
 #elif defined(XR_OS_WINDOWS)
 
 // For pre C++17 compiler that doesn't support experimental filesystem
@@ -227,6 +243,17 @@ bool FileSysUtilsFindFilesInPath(const std::string& path, std::vector<std::strin
     return false;
 }
 
+bool FileSysUtilsGetFileStamp(const std::string& path, uint64_t& size, uint64_t& modification_stamp) {
+    WIN32_FILE_ATTRIBUTE_DATA file_data;
+    if (!GetFileAttributesExW(utf8_to_wide(path).c_str(), GetFileExInfoStandard, &file_data)) {
+        return false;
+    }
+    size = (static_cast<uint64_t>(file_data.nFileSizeHigh) << 32) | file_data.nFileSizeLow;
+    modification_stamp =
+        (static_cast<uint64_t>(file_data.ftLastWriteTime.dwHighDateTime) << 32) | file_data.ftLastWriteTime.dwLowDateTime;
+    return true;
+}
+
 #else  // XR_OS_LINUX/XR_OS_APPLE fallback
 
 // simple POSIX-compatible implementation of the <filesystem> pieces used by OpenXR
@@ -319,4 +346,20 @@ bool FileSysUtilsFindFilesInPath(const std::string& path, std::vector<std::strin
     return true;
 }
 
+bool FileSysUtilsGetFileStamp(const std::string& path, uint64_t& size, uint64_t& modification_stamp) {
+    struct stat path_stat;
+    if (stat(path.c_str(), &path_stat) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(path_stat.st_size);
+    // Whole seconds are too coarse to notice a file rewritten shortly after it was read.
+#if defined(XR_OS_APPLE)
+    const struct timespec& mtime = path_stat.st_mtimespec;
+#else
+    const struct timespec& mtime = path_stat.st_mtim;
+#endif
+    modification_stamp = static_cast<uint64_t>(mtime.tv_sec) * 1000000000u + static_cast<uint64_t>(mtime.tv_nsec);
+    return true;
+}
+
 #endif
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -44,3 +45,7 @@ bool FileSysUtilsParsePathList(std::string& path_list, std::vector<std::string>&
 
 // Record all the filenames for files found in the provided path.
 bool FileSysUtilsFindFilesInPath(const std::string& path, std::vector<std::string>& files);
+
+// Get the size and an opaque last-modification stamp for a file, so callers can detect when it changes.
+// The stamp is only meaningful when compared to another stamp for the same path.
+bool FileSysUtilsGetFileStamp(const std::string& path, uint64_t& size, uint64_t& modification_stamp);
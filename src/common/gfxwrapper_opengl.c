@@ -215,6 +215,8 @@ typedef struct {
 
 ksOpenGLExtensions glExtensions;
 
+bool GlSupportsMultiview(void) { return glExtensions.multi_view; }
+
 /*
 ================================
 Get proc address / extensions
@@ -431,6 +431,7 @@ Common defines
 #endif
 
 void GlInitExtensions(void);
+bool GlSupportsMultiview(void);  // GL_OVR_multiview2, as found by GlInitExtensions
 
 /*
 ================================================================================================================================
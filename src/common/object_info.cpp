@@ -12,7 +12,6 @@
 
 #include "object_info.h"
 
-#include "extra_algorithms.h"
 #include "hex_and_handles.h"
 
 #include <openxr/openxr.h>
@@ -43,39 +42,28 @@ void ObjectInfoCollection::AddObjectName(uint64_t object_handle, XrObjectType ob
     }
 
     // Otherwise, add it or update the name
-    XrSdkLogObjectInfo new_obj = {object_handle, object_type};
-
-    // If it already exists, update the name
-    auto lookup_info = LookUpStoredObjectInfo(new_obj);
-    if (lookup_info != nullptr) {
-        lookup_info->name = object_name;
-        return;
-    }
-
-    // It doesn't exist, so add a new info block
-    new_obj.name = object_name;
-    object_info_.push_back(new_obj);
+    XrSdkLogObjectInfo& stored = object_info_[ObjectKey(object_handle, object_type)];
+    stored.handle = object_handle;
+    stored.type = object_type;
+    stored.name = object_name;
 }
 
 void ObjectInfoCollection::RemoveObject(uint64_t object_handle, XrObjectType object_type) {
-    vector_remove_if_and_erase(
-        object_info_, [=](XrSdkLogObjectInfo const& info) { return info.handle == object_handle && info.type == object_type; });
+    object_info_.erase(ObjectKey(object_handle, object_type));
 }
 
 XrSdkLogObjectInfo const* ObjectInfoCollection::LookUpStoredObjectInfo(XrSdkLogObjectInfo const& info) const {
-    auto e = object_info_.end();
-    auto it = std::find_if(object_info_.begin(), e, [&](XrSdkLogObjectInfo const& stored) { return Equivalent(stored, info); });
-    if (it != e) {
-        return &(*it);
+    auto it = object_info_.find(ObjectKey(info.handle, info.type));
+    if (it != object_info_.end()) {
+        return &it->second;
     }
     return nullptr;
 }
 
 XrSdkLogObjectInfo* ObjectInfoCollection::LookUpStoredObjectInfo(XrSdkLogObjectInfo const& info) {
-    auto e = object_info_.end();
-    auto it = std::find_if(object_info_.begin(), e, [&](XrSdkLogObjectInfo const& stored) { return Equivalent(stored, info); });
-    if (it != e) {
-        return &(*it);
+    auto it = object_info_.find(ObjectKey(info.handle, info.type));
+    if (it != object_info_.end()) {
+        return &it->second;
     }
     return nullptr;
 }
@@ -19,9 +19,11 @@
 
 #include <openxr/openxr.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 struct XrSdkGenericObject {
@@ -136,8 +138,19 @@ class ObjectInfoCollection {
     bool Empty() const { return object_info_.empty(); }
 
    private:
-    // Object names that have been set for given objects
-    std::vector<XrSdkLogObjectInfo> object_info_;
+    using ObjectKey = std::pair<uint64_t, XrObjectType>;
+
+    struct ObjectKeyHash {
+        size_t operator()(ObjectKey const& key) const {
+            // Combine hashes of both handle value and object type enum.
+            return std::hash<uint64_t>()(key.first) ^ (std::hash<int>()(static_cast<int>(key.second)) << 1);
+        }
+    };
+
+    // Object names that have been set for given objects, indexed by handle and type.
+    // Nodes of an unordered_map are never moved, so pointers handed out by LookUpStoredObjectInfo
+    // remain valid until that object is removed.
+    std::unordered_map<ObjectKey, XrSdkLogObjectInfo, ObjectKeyHash> object_info_;
 };
 
 struct XrSdkSessionLabel;
@@ -2,8 +2,12 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include "shards.h"
+
 #include <iostream>
 #include <algorithm>
+#include <string>
+#include <vector>
 #include <xr_dependencies.h>
 #include <conformance_test.h>
 
@@ -57,9 +61,25 @@ int main(int argc, const char** argv)
 {
     SetupConsole();
 
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const int shardCount = Conformance::ExtractShardCount(args);
+    if (shardCount < 0) {
+        std::cerr << "--shards requires a positive number of shards\n";
+        return 2;
+    }
+    if (shardCount > 1) {
+        return Conformance::RunShardedConformanceTests(argv[0], args, shardCount);
+    }
+
+    // Run in this process, without any --shards 1 option.
+    std::vector<const char*> launchArgv{argv[0]};
+    for (const std::string& arg : args) {
+        launchArgv.push_back(arg.c_str());
+    }
+
     ConformanceLaunchSettings launchSettings;
-    launchSettings.argc = argc;
-    launchSettings.argv = argv;
+    launchSettings.argc = int(launchArgv.size());
+    launchSettings.argv = launchArgv.data();
     launchSettings.message = OnTestMessage;
 
     XrcTestResult testResult;
@@ -0,0 +1,788 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "shards.h"
+
+#include <conformance/utilities/test_durations.h>
+#include <xr_dependencies.h>
+#include <conformance_test.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace Conformance
+{
+    namespace
+    {
+        constexpr const char* DefaultDurationsFile = "conformance_shard_durations.txt";
+        constexpr const char* DefaultReportFile = "conformance_report.xml";
+
+        /// If @p args[i] is one of @p names, either as `name value` or `name=value`, stores the value, advances @p i past
+        /// it and returns true.
+        bool MatchOption(const std::vector<std::string>& args, size_t& i, std::initializer_list<const char*> names, std::string& value)
+        {
+            for (const char* name : names) {
+                const std::string& arg = args[i];
+                if (arg == name && i + 1 < args.size()) {
+                    value = args[i + 1];
+                    i += 2;
+                    return true;
+                }
+                const size_t nameLength = strlen(name);
+                if (arg.size() > nameLength && arg.compare(0, nameLength, name) == 0 &&
+                    (arg[nameLength] == '=' || arg[nameLength] == ':')) {
+                    value = arg.substr(nameLength + 1);
+                    i += 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Where the user asked for the ctsxml report to go, from the reporter arguments that are stripped from the shard
+        /// command lines because each shard writes a ctsxml report of its own.
+        struct ReporterArgs
+        {
+            std::string ctsxmlOut;
+            std::string defaultOut;
+            bool otherReporters = false;
+        };
+
+        std::vector<std::string> StripReporterArgs(const std::vector<std::string>& args, ReporterArgs& reporterArgs)
+        {
+            std::vector<std::string> remaining;
+            for (size_t i = 0; i < args.size();) {
+                std::string value;
+                if (MatchOption(args, i, {"-r", "--reporter"}, value)) {
+                    // Reporter specs are "name[::key=value]*".
+                    const std::string reporterName = value.substr(0, value.find("::"));
+                    if (reporterName != "ctsxml") {
+                        reporterArgs.otherReporters = true;
+                        continue;
+                    }
+                    const size_t out = value.find("::out=");
+                    if (out != std::string::npos) {
+                        const size_t start = out + strlen("::out=");
+                        reporterArgs.ctsxmlOut = value.substr(start, value.find("::", start) - start);
+                    }
+                }
+                else if (MatchOption(args, i, {"-o", "--out"}, value)) {
+                    reporterArgs.defaultOut = value;
+                }
+                else {
+                    remaining.push_back(args[i++]);
+                }
+            }
+            return remaining;
+        }
+
+        std::string FindOptionValue(const std::vector<std::string>& args, const char* name)
+        {
+            std::string value;
+            for (size_t i = 0; i < args.size();) {
+                if (!MatchOption(args, i, {name}, value)) {
+                    ++i;
+                }
+            }
+            return value;
+        }
+
+        bool FileExists(const std::string& path)
+        {
+            return std::ifstream(path).good();
+        }
+
+        bool ReadFile(const std::string& path, std::string& contents)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            contents = buffer.str();
+            return true;
+        }
+
+#if defined(_WIN32)
+        using ShardProcess = HANDLE;
+
+        // Quotes an argument so that CommandLineToArgvW and the CRT split it back out unchanged.
+        std::string QuoteArgument(const std::string& arg)
+        {
+            if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == std::string::npos) {
+                return arg;
+            }
+            std::string quoted = "\"";
+            size_t backslashes = 0;
+            for (char c : arg) {
+                if (c == '\\') {
+                    backslashes++;
+                    continue;
+                }
+                quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+                quoted += c;
+                backslashes = 0;
+            }
+            quoted.append(backslashes * 2, '\\');
+            return quoted + '"';
+        }
+
+        bool StartShard(const std::string& executable, const std::vector<std::string>& args, const std::string& logPath,
+                        ShardProcess& process)
+        {
+            std::string commandLine = QuoteArgument(executable);
+            for (const std::string& arg : args) {
+                commandLine += ' ' + QuoteArgument(arg);
+            }
+
+            SECURITY_ATTRIBUTES inheritable{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+            HANDLE log = CreateFileA(logPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &inheritable, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                                     nullptr);
+            if (log == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+
+            STARTUPINFOA startupInfo{};
+            startupInfo.cb = sizeof(startupInfo);
+            startupInfo.dwFlags = STARTF_USESTDHANDLES;
+            startupInfo.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+            startupInfo.hStdOutput = log;
+            startupInfo.hStdError = log;
+            PROCESS_INFORMATION processInfo{};
+            const BOOL created = CreateProcessA(executable.c_str(), &commandLine[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr,
+                                                &startupInfo, &processInfo);
+            CloseHandle(log);
+            if (!created) {
+                return false;
+            }
+            CloseHandle(processInfo.hThread);
+            process = processInfo.hProcess;
+            return true;
+        }
+
+        /// Returns the exit code of the shard, or -1 if it could not be determined.
+        int WaitForShard(ShardProcess process)
+        {
+            DWORD exitCode = DWORD(-1);
+            if (WaitForSingleObject(process, INFINITE) != WAIT_OBJECT_0 || !GetExitCodeProcess(process, &exitCode)) {
+                exitCode = DWORD(-1);
+            }
+            CloseHandle(process);
+            return int(exitCode);
+        }
+
+        std::string GetExecutablePath(const char* argv0)
+        {
+            char path[MAX_PATH];
+            const DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+            return length > 0 && length < MAX_PATH ? std::string(path, length) : std::string(argv0);
+        }
+#else
+        using ShardProcess = pid_t;
+
+        bool StartShard(const std::string& executable, const std::vector<std::string>& args, const std::string& logPath,
+                        ShardProcess& process)
+        {
+            std::vector<char*> argv;
+            argv.push_back(const_cast<char*>(executable.c_str()));
+            for (const std::string& arg : args) {
+                argv.push_back(const_cast<char*>(arg.c_str()));
+            }
+            argv.push_back(nullptr);
+
+            posix_spawn_file_actions_t fileActions;
+            posix_spawn_file_actions_init(&fileActions);
+            posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO);
+            const int error = posix_spawnp(&process, executable.c_str(), &fileActions, nullptr, argv.data(), environ);
+            posix_spawn_file_actions_destroy(&fileActions);
+            return error == 0;
+        }
+
+        /// Returns the exit code of the shard, or -1 if it did not exit normally.
+        int WaitForShard(ShardProcess process)
+        {
+            int status = 0;
+            while (waitpid(process, &status, 0) == -1) {
+                if (errno != EINTR) {
+                    return -1;
+                }
+            }
+            return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        }
+
+        std::string GetExecutablePath(const char* argv0)
+        {
+            return argv0;
+        }
+#endif
+
+        /// Appends the timing history lines that each shard wrote to its own file to @p historyPath, and removes the shard
+        /// files. Shards never append to the shared history themselves, so their lines cannot interleave.
+        bool AppendShardTimingHistories(const std::string& historyPath, const std::vector<std::string>& shardHistoryPaths)
+        {
+            bool needHeader = !FileExists(historyPath);
+            std::ostringstream lines;
+            for (const std::string& shardHistoryPath : shardHistoryPaths) {
+                std::ifstream shardHistory(shardHistoryPath);
+                for (std::string line; std::getline(shardHistory, line);) {
+                    if (!line.empty() && line[0] == '#') {
+                        if (!needHeader) {
+                            continue;
+                        }
+                        needHeader = false;
+                    }
+                    lines << line << '\n';
+                }
+                shardHistory.close();
+                std::remove(shardHistoryPath.c_str());
+            }
+
+            const std::string text = lines.str();
+            if (text.empty()) {
+                return true;
+            }
+            std::ofstream history(historyPath, std::ios::app);
+            history.write(text.data(), text.size());
+            return bool(history);
+        }
+
+        std::string GetAttribute(const std::string& line, const char* name)
+        {
+            const std::string key = std::string(" ") + name + "=\"";
+            const size_t start = line.find(key);
+            if (start == std::string::npos) {
+                return {};
+            }
+            const size_t valueStart = start + key.size();
+            return line.substr(valueStart, line.find('"', valueStart) - valueStart);
+        }
+
+        void SetAttribute(std::string& line, const char* name, const std::string& value)
+        {
+            const std::string key = std::string(" ") + name + "=\"";
+            const size_t start = line.find(key);
+            if (start != std::string::npos) {
+                const size_t valueStart = start + key.size();
+                line.replace(valueStart, line.find('"', valueStart) - valueStart, value);
+            }
+        }
+
+        uint64_t GetCountAttribute(const std::string& line, const char* name)
+        {
+            return strtoull(GetAttribute(line, name).c_str(), nullptr, 10);
+        }
+
+        std::string Trim(const std::string& line)
+        {
+            const size_t start = line.find_first_not_of(' ');
+            return start == std::string::npos ? std::string() : line.substr(start);
+        }
+
+        /// The parts of a ctsxml report written by CTSReporter that differ between shards.
+        ///
+        /// This relies on the report layout produced by Catch::XmlWriter, one element per line, rather than parsing XML:
+        /// every shard report is written by the same binary.
+        struct ShardReport
+        {
+            std::vector<std::string> lines;
+            std::string testSuite;
+            std::string filters;
+            uint64_t testSuccessCount = 0;
+            uint64_t testFailureCount = 0;
+            std::vector<std::string> timedSubmission;
+            std::vector<std::string> swapchainFormats;
+            uint64_t pipelineCreationCount = 0;
+            double pipelineCreationMs = 0;
+            std::vector<std::string> testCaseTimings;
+            std::vector<std::string> testCases;
+            std::vector<std::string> systemOut;
+            std::vector<std::string> systemErr;
+        };
+
+        /// Collects the lines strictly between line @p i (an opening tag) and the line closing @p element.
+        std::vector<std::string> CollectElementContent(const std::vector<std::string>& lines, size_t& i, const std::string& element)
+        {
+            std::vector<std::string> content;
+            const std::string close = "</" + element + ">";
+            for (++i; i < lines.size() && Trim(lines[i]) != close; ++i) {
+                content.push_back(lines[i]);
+            }
+            return content;
+        }
+
+        bool StartsWith(const std::string& text, const char* prefix)
+        {
+            return text.compare(0, strlen(prefix), prefix) == 0;
+        }
+
+        /// Reads a shard report. Returns false unless the report is complete: a shard that crashed or was killed while
+        /// writing it leaves a truncated file, which must not be merged as if its missing test cases had passed.
+        bool ParseShardReport(const std::string& path, ShardReport& report)
+        {
+            std::string contents;
+            if (!ReadFile(path, contents)) {
+                return false;
+            }
+            std::istringstream stream(contents);
+            for (std::string line; std::getline(stream, line);) {
+                report.lines.push_back(line);
+            }
+
+            bool foundResults = false;
+            bool foundTestSuiteEnd = false;
+            bool inTestCases = false;
+            // Test cases have system-out and system-err elements of their own; only the test suite's are collected.
+            int openTestCases = 0;
+            for (size_t i = 0; i < report.lines.size() && !foundTestSuiteEnd; ++i) {
+                const std::string& line = report.lines[i];
+                const std::string trimmed = Trim(line);
+                if (inTestCases) {
+                    if (openTestCases == 0 && trimmed == "<system-out>") {
+                        report.systemOut = CollectElementContent(report.lines, i, "system-out");
+                    }
+                    else if (openTestCases == 0 && trimmed == "<system-err>") {
+                        report.systemErr = CollectElementContent(report.lines, i, "system-err");
+                    }
+                    else if (openTestCases == 0 && (trimmed == "<system-out/>" || trimmed == "<system-err/>")) {
+                    }
+                    else if (openTestCases == 0 && trimmed == "</testsuite>") {
+                        foundTestSuiteEnd = true;
+                    }
+                    else {
+                        if (StartsWith(trimmed, "<testcase ") && trimmed.compare(trimmed.size() - 2, 2, "/>") != 0) {
+                            openTestCases++;
+                        }
+                        else if (trimmed == "</testcase>") {
+                            openTestCases--;
+                        }
+                        report.testCases.push_back(line);
+                    }
+                }
+                else if (trimmed.compare(0, 11, "<testsuite ") == 0) {
+                    report.testSuite = line;
+                }
+                else if (trimmed.compare(0, 32, "<property name=\"filters\" value=\"") == 0) {
+                    report.filters = GetAttribute(line, "value");
+                }
+                else if (trimmed.compare(0, 13, "<cts:results ") == 0) {
+                    report.testSuccessCount = GetCountAttribute(line, "testSuccessCount");
+                    report.testFailureCount = GetCountAttribute(line, "testFailureCount");
+                    foundResults = true;
+                }
+                else if (trimmed == "<cts:timedSubmission>") {
+                    report.timedSubmission = CollectElementContent(report.lines, i, "cts:timedSubmission");
+                }
+                else if (trimmed == "<cts:swapchainFormats>") {
+                    report.swapchainFormats = CollectElementContent(report.lines, i, "cts:swapchainFormats");
+                }
+                else if (trimmed.compare(0, 22, "<cts:pipelineCreation ") == 0) {
+                    report.pipelineCreationCount = GetCountAttribute(line, "count");
+                    report.pipelineCreationMs = strtod(GetAttribute(line, "ms").c_str(), nullptr);
+                }
+                else if (trimmed == "<cts:testCaseTimings>") {
+                    report.testCaseTimings = CollectElementContent(report.lines, i, "cts:testCaseTimings");
+                }
+                else if (trimmed == "</cts:ctsConformanceReport>") {
+                    inTestCases = true;
+                }
+            }
+            return !report.testSuite.empty() && foundResults && foundTestSuiteEnd;
+        }
+
+        std::string EscapeXml(const std::string& text)
+        {
+            std::string escaped;
+            for (char c : text) {
+                switch (c) {
+                case '&':
+                    escaped += "&amp;";
+                    break;
+                case '<':
+                    escaped += "&lt;";
+                    break;
+                case '>':
+                    escaped += "&gt;";
+                    break;
+                case '"':
+                    escaped += "&quot;";
+                    break;
+                default:
+                    escaped += c;
+                    break;
+                }
+            }
+            return escaped;
+        }
+
+        /// A shard that did not produce a complete report. It is written to the merged report as a test case with an
+        /// error, so that the report can never look complete while missing the shard's test cases.
+        struct FailedShard
+        {
+            int index;
+            int exitCode;
+            std::string logPath;
+        };
+
+        void WriteElementContent(std::ostream& out, const std::string& indent, const std::string& element,
+                                 const std::vector<std::string>& content)
+        {
+            if (content.empty()) {
+                out << indent << '<' << element << "/>\n";
+                return;
+            }
+            out << indent << '<' << element << ">\n";
+            for (const std::string& line : content) {
+                out << line << '\n';
+            }
+            out << indent << "</" << element << ">\n";
+        }
+
+        /// Writes a single ctsxml report covering every shard, in the layout of the first complete shard report, with an
+        /// error test case for each of @p failedShards.
+        bool MergeShardReports(const std::vector<ShardReport>& shards, const std::vector<FailedShard>& failedShards, double wallSeconds,
+                               const std::string& path)
+        {
+            const ShardReport& base = shards.front();
+
+            std::string testSuite = base.testSuite;
+            for (const char* counter : {"errors", "failures", "skipped", "tests"}) {
+                uint64_t total = 0;
+                for (const ShardReport& shard : shards) {
+                    total += GetCountAttribute(shard.testSuite, counter);
+                }
+                if (strcmp(counter, "errors") == 0 || strcmp(counter, "tests") == 0) {
+                    total += failedShards.size();
+                }
+                SetAttribute(testSuite, counter, std::to_string(total));
+            }
+            char time[32];
+            snprintf(time, sizeof(time), "%.3f", wallSeconds);
+            SetAttribute(testSuite, "time", time);
+
+            // Without recorded durations every shard has the user's filter; with them each has its own list of names, or
+            // "~*" (serialized by Catch2 as "&quot;~*&quot;") if it has none.
+            std::vector<std::string> filters;
+            for (const ShardReport& shard : shards) {
+                const bool matchesNothing = shard.filters == "~*" || shard.filters == "&quot;~*&quot;";
+                if (!matchesNothing && std::find(filters.begin(), filters.end(), shard.filters) == filters.end()) {
+                    filters.push_back(shard.filters);
+                }
+            }
+            std::string mergedFilters;
+            for (const std::string& filter : filters) {
+                mergedFilters += (mergedFilters.empty() ? "" : ",") + filter;
+            }
+
+            std::vector<std::string> timedSubmission;
+            std::vector<std::string> swapchainFormats;
+            std::set<std::string> seenSwapchainFormats;
+            std::vector<std::string> testCaseTimings;
+            std::vector<std::string> testCases;
+            std::vector<std::string> systemOut;
+            std::vector<std::string> systemErr;
+            uint64_t testSuccessCount = 0;
+            uint64_t testFailureCount = 0;
+            uint64_t pipelineCreationCount = 0;
+            double pipelineCreationMs = 0;
+            for (const ShardReport& shard : shards) {
+                if (timedSubmission.empty()) {
+                    timedSubmission = shard.timedSubmission;
+                }
+                for (const std::string& format : shard.swapchainFormats) {
+                    if (seenSwapchainFormats.insert(format).second) {
+                        swapchainFormats.push_back(format);
+                    }
+                }
+                testCaseTimings.insert(testCaseTimings.end(), shard.testCaseTimings.begin(), shard.testCaseTimings.end());
+                testCases.insert(testCases.end(), shard.testCases.begin(), shard.testCases.end());
+                systemOut.insert(systemOut.end(), shard.systemOut.begin(), shard.systemOut.end());
+                systemErr.insert(systemErr.end(), shard.systemErr.begin(), shard.systemErr.end());
+                testSuccessCount += shard.testSuccessCount;
+                testFailureCount += shard.testFailureCount;
+                pipelineCreationCount += shard.pipelineCreationCount;
+                pipelineCreationMs += shard.pipelineCreationMs;
+            }
+            testFailureCount += failedShards.size();
+            // One element per line, so sorting the lines sorts the test cases by name as in an unsharded report.
+            std::sort(testCaseTimings.begin(), testCaseTimings.end());
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            for (size_t i = 0; i < base.lines.size(); ++i) {
+                const std::string& line = base.lines[i];
+                const std::string trimmed = Trim(line);
+                const std::string indent = line.substr(0, line.size() - trimmed.size());
+                if (line == base.testSuite) {
+                    out << testSuite << '\n';
+                }
+                else if (trimmed.compare(0, 32, "<property name=\"filters\" value=\"") == 0) {
+                    std::string filtersLine = line;
+                    SetAttribute(filtersLine, "value", mergedFilters);
+                    out << filtersLine << '\n';
+                }
+                else if (trimmed.compare(0, 13, "<cts:results ") == 0) {
+                    out << indent << "<cts:results testSuccessCount=\"" << testSuccessCount << "\" testFailureCount=\"" << testFailureCount
+                        << "\"/>\n";
+                    if (!timedSubmission.empty()) {
+                        WriteElementContent(out, indent, "cts:timedSubmission", timedSubmission);
+                    }
+                    if (!swapchainFormats.empty()) {
+                        WriteElementContent(out, indent, "cts:swapchainFormats", swapchainFormats);
+                    }
+                    if (pipelineCreationCount > 0) {
+                        out << indent << "<cts:pipelineCreation count=\"" << pipelineCreationCount << "\" ms=\"" << pipelineCreationMs
+                            << "\"/>\n";
+                    }
+                    if (!testCaseTimings.empty()) {
+                        WriteElementContent(out, indent, "cts:testCaseTimings", testCaseTimings);
+                    }
+                }
+                else if (trimmed == "<cts:timedSubmission>" || trimmed == "<cts:swapchainFormats>" || trimmed == "<cts:testCaseTimings>") {
+                    // Written after the results, above.
+                    const std::string element = trimmed.substr(1, trimmed.size() - 2);
+                    CollectElementContent(base.lines, i, element);
+                }
+                else if (trimmed.compare(0, 22, "<cts:pipelineCreation ") == 0) {
+                    // Written after the results, above.
+                }
+                else if (trimmed == "</cts:ctsConformanceReport>") {
+                    out << line << '\n';
+                    for (const std::string& testCase : testCases) {
+                        out << testCase << '\n';
+                    }
+                    for (const FailedShard& failed : failedShards) {
+                        const std::string message = "Shard " + std::to_string(failed.index) + " exited with code " +
+                                                    std::to_string(failed.exitCode) + " without a complete report; see " + failed.logPath;
+                        out << indent << "<testcase classname=\"conformance_cli\" name=\"Shard " << failed.index
+                            << "\" time=\"0\" status=\"run\">\n"
+                            << indent << "  <error message=\"" << EscapeXml(message) << "\" type=\"ShardFailure\"/>\n"
+                            << indent << "</testcase>\n";
+                    }
+                    WriteElementContent(out, indent, "system-out", systemOut);
+                    WriteElementContent(out, indent, "system-err", systemErr);
+                    // Skip the base shard's own test cases and output; ParseShardReport checked that its test suite is closed.
+                    while (i + 1 < base.lines.size() && Trim(base.lines[i + 1]) != "</testsuite>") {
+                        ++i;
+                    }
+                }
+                else {
+                    out << line << '\n';
+                }
+            }
+            return bool(out);
+        }
+
+        /// The directory part of @p path including its trailing separator, or empty if it has none.
+        std::string GetDirectory(const std::string& path)
+        {
+            const size_t separator = path.find_last_of("/\\");
+            return separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+        }
+
+        std::string StripXmlExtension(const std::string& path)
+        {
+            const std::string extension = ".xml";
+            if (path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+                return path.substr(0, path.size() - extension.size());
+            }
+            return path;
+        }
+
+        uint32_t GetTestCaseCount()
+        {
+            uint32_t count = 0;
+            if (xrcEnumerateTestCases(0, &count, nullptr) != XRC_SUCCESS) {
+                count = 0;
+            }
+            xrcCleanup();
+            return count;
+        }
+    }  // namespace
+
+    int ExtractShardCount(std::vector<std::string>& args)
+    {
+        int shardCount = 0;
+        for (size_t i = 0; i < args.size();) {
+            const size_t begin = i;
+            std::string value;
+            if (!MatchOption(args, i, {"--shards"}, value)) {
+                ++i;
+                continue;
+            }
+            char* end = nullptr;
+            const long parsed = strtol(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || parsed < 1 || parsed > 1024) {
+                return -1;
+            }
+            shardCount = int(parsed);
+            args.erase(args.begin() + begin, args.begin() + i);
+            i = begin;
+        }
+        return shardCount;
+    }
+
+    int RunShardedConformanceTests(const char* executable, const std::vector<std::string>& args, int shardCount)
+    {
+        ReporterArgs reporterArgs;
+        std::vector<std::string> shardArgs = StripReporterArgs(args, reporterArgs);
+        const std::string reportPath = !reporterArgs.ctsxmlOut.empty()    ? reporterArgs.ctsxmlOut
+                                       : !reporterArgs.defaultOut.empty() ? reporterArgs.defaultOut
+                                                                          : DefaultReportFile;
+        if (reporterArgs.otherReporters) {
+            std::cerr << "Only the ctsxml reporter is supported with --shards; other reporters are ignored.\n";
+        }
+
+        // Cap the shard count to the number of test cases so that no shard is started with nothing to do.
+        const uint32_t testCaseCount = GetTestCaseCount();
+        if (testCaseCount > 0 && uint32_t(shardCount) > testCaseCount) {
+            shardCount = int(testCaseCount);
+        }
+
+        std::string durationsPath = FindOptionValue(shardArgs, "--shardDurations");
+        if (durationsPath.empty()) {
+            // Next to the report rather than in the working directory, so that runs with different outputs stay apart.
+            durationsPath = GetDirectory(reportPath) + DefaultDurationsFile;
+            if (FileExists(durationsPath)) {
+                shardArgs.push_back("--shardDurations");
+                shardArgs.push_back(durationsPath);
+            }
+        }
+
+        // A shard may legitimately select no tests or only skipped tests; the merged report decides the overall result.
+        const bool allowNoTests = std::find(shardArgs.begin(), shardArgs.end(), "--allow-running-no-tests") != shardArgs.end();
+        if (!allowNoTests) {
+            shardArgs.push_back("--allow-running-no-tests");
+        }
+
+        // Each shard appends its timings to its own file and compares against the shared history, which only this
+        // process appends to once every shard has finished.
+        const std::string timingHistoryPath = FindOptionValue(shardArgs, "--timingHistory");
+
+        const std::string executablePath = GetExecutablePath(executable);
+        const std::string shardPathBase = StripXmlExtension(reportPath);
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::string> shardReports(shardCount);
+        std::vector<std::string> shardLogs(shardCount);
+        std::vector<std::string> shardDurations(shardCount);
+        std::vector<std::string> shardTimingHistories;
+        std::vector<ShardProcess> processes(shardCount);
+        std::vector<bool> started(shardCount, false);
+        for (int shard = 0; shard < shardCount; ++shard) {
+            const std::string shardPath = shardPathBase + ".shard" + std::to_string(shard);
+            shardReports[shard] = shardPath + ".xml";
+            shardLogs[shard] = shardPath + ".log";
+            shardDurations[shard] = shardPath + ".durations.txt";
+
+            std::vector<std::string> thisShardArgs = shardArgs;
+            thisShardArgs.insert(thisShardArgs.end(), {"--shard-count", std::to_string(shardCount), "--shard-index", std::to_string(shard),
+                                                       "--reporter", "ctsxml::out=" + shardReports[shard], "--recordDurations",
+                                                       shardDurations[shard]});
+            if (!timingHistoryPath.empty()) {
+                shardTimingHistories.push_back(shardPath + ".timing.tsv");
+                thisShardArgs.insert(thisShardArgs.end(), {"--timingHistoryOut", shardTimingHistories.back()});
+            }
+            started[shard] = StartShard(executablePath, thisShardArgs, shardLogs[shard], processes[shard]);
+            if (!started[shard]) {
+                std::cerr << "Failed to start shard " << shard << " (" << executablePath << ")\n";
+            }
+        }
+
+        int exitCode = 0;
+        std::vector<ShardReport> reports;
+        std::vector<FailedShard> failedShards;
+        for (int shard = 0; shard < shardCount; ++shard) {
+            const int shardExitCode = started[shard] ? WaitForShard(processes[shard]) : -1;
+            ShardReport report;
+            const bool hasReport = started[shard] && ParseShardReport(shardReports[shard], report);
+            if (hasReport) {
+                reports.push_back(std::move(report));
+            }
+            else {
+                failedShards.push_back(FailedShard{shard, shardExitCode, shardLogs[shard]});
+            }
+
+            std::cout << "Shard " << shard << ": exit code " << shardExitCode;
+            if (hasReport) {
+                std::cout << ", " << reports.back().testSuccessCount << " passed, " << reports.back().testFailureCount << " failed";
+            }
+            else {
+                std::cout << ", no complete report";
+            }
+            std::cout << " (log: " << shardLogs[shard] << ")\n";
+
+            if (shardExitCode != 0 && shardExitCode != 1) {
+                exitCode = 2;
+            }
+            else if (shardExitCode == 1 && exitCode == 0) {
+                exitCode = 1;
+            }
+        }
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Keep the durations of every test case ever timed, updated with the ones from this run.
+        TestDurations durations = ReadTestDurations(durationsPath);
+        for (const std::string& shardDurationsPath : shardDurations) {
+            for (const auto& entry : ReadTestDurations(shardDurationsPath)) {
+                durations[entry.first] = entry.second;
+            }
+            std::remove(shardDurationsPath.c_str());
+        }
+        if (!durations.empty() && !WriteTestDurations(durationsPath, durations)) {
+            std::cerr << "Could not write test durations to " << durationsPath << "\n";
+        }
+
+        if (!timingHistoryPath.empty() && !AppendShardTimingHistories(timingHistoryPath, shardTimingHistories)) {
+            std::cerr << "Could not append to timing history " << timingHistoryPath << "\n";
+        }
+
+        if (reports.empty()) {
+            std::cerr << "No shard wrote a complete report; not writing " << reportPath << "\n";
+            return 2;
+        }
+        if (!MergeShardReports(reports, failedShards, wallSeconds, reportPath)) {
+            std::cerr << "Could not write the merged report to " << reportPath << "\n";
+            return 2;
+        }
+
+        uint64_t testSuccessCount = 0;
+        uint64_t testFailureCount = 0;
+        for (const ShardReport& report : reports) {
+            testSuccessCount += report.testSuccessCount;
+            testFailureCount += report.testFailureCount;
+        }
+        testFailureCount += failedShards.size();
+        std::cout << "Ran " << shardCount << " shards in " << wallSeconds << " s\n"
+                  << "Test Success Count: " << testSuccessCount << "\n"
+                  << "Test Failure Count: " << testFailureCount << "\n"
+                  << "Merged report: " << reportPath << "\n";
+
+        if (exitCode == 0 && (testFailureCount > 0 || (!allowNoTests && testSuccessCount == 0))) {
+            exitCode = 1;
+        }
+        if (!failedShards.empty()) {
+            exitCode = 2;
+        }
+        return exitCode;
+    }
+}  // namespace Conformance
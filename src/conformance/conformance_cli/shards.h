@@ -0,0 +1,26 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    /// Removes `--shards N` (or `--shards=N`) from @p args.
+    /// Returns N, 0 if the option is absent, or -1 if its value is not a positive number.
+    int ExtractShardCount(std::vector<std::string>& args);
+
+    /// Runs the conformance tests selected by @p args in @p shardCount child processes of @p executable, each running a
+    /// disjoint subset of the test cases with Catch2's `--shard-count` and `--shard-index`.
+    ///
+    /// Shards are balanced by the test case durations recorded in earlier sharded runs, which are kept in the file given
+    /// by `--shardDurations` (default `conformance_shard_durations.txt`). Each child writes its own ctsxml report and
+    /// console log next to the requested ctsxml output; those reports are merged into the requested output once every
+    /// shard has finished.
+    ///
+    /// Returns the exit code for conformance_cli: 0 if all tests passed, 1 if tests failed, 2 if tests failed to run.
+    int RunShardedConformanceTests(const char* executable, const std::vector<std::string>& args, int shardCount);
+}  // namespace Conformance
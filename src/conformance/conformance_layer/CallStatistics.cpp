@@ -0,0 +1,88 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CallStatistics.h"
+
+#include "LatencyHistograms.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    /// Set once xrcGetRuntimeCallStatistics has been looked up; until then calls are not timed at all.
+    std::atomic<bool> g_statisticsRequested{false};
+
+    /// One thread's totals. Only the owning thread writes them, so recording is a plain load and store on a cache line
+    /// that no other thread writes; the atomics only make the reads from ConformanceLayer_GetRuntimeCallStatistics safe.
+    struct ThreadTotals
+    {
+        std::atomic<uint64_t> callCount{0};
+        std::atomic<uint64_t> callNanoseconds{0};
+    };
+
+    // Every thread that has recorded a call. Entries outlive their threads so that their calls stay in the totals.
+    std::mutex g_threadsMutex;
+    std::vector<std::unique_ptr<ThreadTotals>> g_threads;
+
+    thread_local ThreadTotals* t_threadTotals = nullptr;
+
+    ThreadTotals& GetThreadTotals()
+    {
+        if (t_threadTotals == nullptr) {
+            std::unique_ptr<ThreadTotals> totals(new ThreadTotals());
+            t_threadTotals = totals.get();
+            std::lock_guard<std::mutex> lock(g_threadsMutex);
+            g_threads.push_back(std::move(totals));
+        }
+        return *t_threadTotals;
+    }
+}  // namespace
+
+bool RuntimeCallTimingEnabled()
+{
+    return g_statisticsRequested.load(std::memory_order_relaxed) || LatencyHistogramsEnabled();
+}
+
+void EnableRuntimeCallStatistics()
+{
+    g_statisticsRequested.store(true, std::memory_order_relaxed);
+}
+
+void RecordRuntimeCall(size_t commandIndex, std::chrono::steady_clock::duration duration)
+{
+    if (LatencyHistogramsEnabled()) {
+        RecordLatency(commandIndex, duration);
+    }
+    ThreadTotals& totals = GetThreadTotals();
+    totals.callCount.store(totals.callCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    totals.callNanoseconds.store(totals.callNanoseconds.load(std::memory_order_relaxed) +
+                                     std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+                                 std::memory_order_relaxed);
+}
+
+XRAPI_ATTR void XRAPI_CALL ConformanceLayer_GetRuntimeCallStatistics(XrcRuntimeCallStatistics* statistics)
+{
+    statistics->callCount = 0;
+    statistics->callNanoseconds = 0;
+    std::lock_guard<std::mutex> lock(g_threadsMutex);
+    for (const std::unique_ptr<ThreadTotals>& totals : g_threads) {
+        statistics->callCount += totals->callCount.load(std::memory_order_relaxed);
+        statistics->callNanoseconds += totals->callNanoseconds.load(std::memory_order_relaxed);
+    }
+}
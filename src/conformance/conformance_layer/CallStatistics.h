@@ -0,0 +1,37 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <conformance/utilities/runtime_call_statistics.h>
+
+#include <chrono>
+#include <cstddef>
+
+/// True if calls passed down to the runtime should be timed and passed to RecordRuntimeCall: once
+/// xrcGetRuntimeCallStatistics has been looked up, or if latency histograms are enabled. Otherwise the generated hooks
+/// skip the clock reads entirely.
+bool RuntimeCallTimingEnabled();
+
+/// Called when xrcGetRuntimeCallStatistics is looked up, so that only applications that read the totals pay for them.
+void EnableRuntimeCallStatistics();
+
+/// Adds a call passed down to the runtime, and the time the runtime took, to the totals returned by
+/// ConformanceLayer_GetRuntimeCallStatistics and, if enabled, to the latency histogram of command @p commandIndex.
+void RecordRuntimeCall(size_t commandIndex, std::chrono::steady_clock::duration duration);
+
+/// The conformance layer's implementation of xrcGetRuntimeCallStatistics.
+XRAPI_ATTR void XRAPI_CALL ConformanceLayer_GetRuntimeCallStatistics(XrcRuntimeCallStatistics* statistics);
@@ -18,6 +18,7 @@
 
 #include "gen_dispatch.h"
 #include <cstdint>
+#include <mutex>
 
 // Implementation of methods are distributed across multiple files, based on the primary handle type.
 // IConformanceHooks provides empty default implementations of all OpenXR functions. Only provide an override
@@ -48,7 +49,7 @@ struct ConformanceHooks : ConformanceHooksBase
 
     // Defined in Session.cpp
     XrResult xrCreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session) override;
-    //XrResult xrDestroySession(XrSession session) override;
+    XrResult xrDestroySession(XrSession session) override;
     XrResult xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) override;
     XrResult xrLocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState, uint32_t viewCapacityInput,
                            uint32_t* viewCountOutput, XrView* views) override;
@@ -131,6 +132,11 @@ struct ConformanceHooks : ConformanceHooksBase
 #endif
 
 private:
+    /// Held by xrPollEvent from calling the runtime until the event has been validated, and by xrDestroySession,
+    /// so that a session cannot be destroyed on another thread in between and make a valid event look like it
+    /// refers to an unknown handle.
+    std::mutex sessionLifetimeMutex;
+
     /// returns true if there are array outputs to validate.
     bool checkTwoCallIdiomFunc(const char* function, XrResult result, uint32_t capacityInput, const uint32_t* countOutput, void* array);
 
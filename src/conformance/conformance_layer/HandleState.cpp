@@ -19,9 +19,12 @@
 #include "Common.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <stddef.h>
 #include <string>
 #include <type_traits>
@@ -40,15 +43,43 @@ namespace
         }
     };
 
-    std::unordered_map<HandleStateKey, std::unique_ptr<HandleState>, HandleStateKeyHash> g_handleStates;
-    std::mutex g_handleStatesMutex;
+    using HandleStateMap = std::unordered_map<HandleStateKey, std::unique_ptr<HandleState>, HandleStateKeyHash>;
+
+    /// One shard of the handle state table.
+    /// Lookups only take a shared lock on the shard owning the key, so intercepted calls made
+    /// from several threads do not serialize on each other. Each shard starts on its own cache line,
+    /// so taking the lock of one shard does not invalidate the line holding its neighbor's lock.
+    struct alignas(64) HandleStateShard
+    {
+        std::shared_timed_mutex mutex;
+        HandleStateMap handleStates;
+    };
+
+    constexpr std::size_t HandleStateShardCountLog2 = 6;
+    constexpr std::size_t HandleStateShardCount = std::size_t(1) << HandleStateShardCountLog2;
+
+    std::array<HandleStateShard, HandleStateShardCount> g_handleStateShards;
+
+    /// Serializes registration and unregistration. Unregistering a handle walks its children,
+    /// which may live in any shard, so writers must not interleave. Lookups never take this.
+    std::mutex g_handleStatesWriteMutex;
+
+    HandleStateShard& GetShard(const HandleStateKey& key)
+    {
+        // Handle values are frequently aligned pointers, so mix the bits (Fibonacci hashing)
+        // before picking a shard rather than using the low bits directly.
+        const uint64_t hash = uint64_t(HandleStateKeyHash()(key)) * UINT64_C(0x9E3779B97F4A7C15);
+        return g_handleStateShards[static_cast<std::size_t>(hash >> (64 - HandleStateShardCountLog2))];
+    }
 }  // namespace
 
 void RegisterHandleState(std::unique_ptr<HandleState> handleState)
 {
-    std::unique_lock<std::mutex> lock(g_handleStatesMutex);
+    std::unique_lock<std::mutex> lock(g_handleStatesWriteMutex);
     HandleStateKey mapKey(handleState->handle, handleState->type);
-    auto it = g_handleStates.insert(std::pair<HandleStateKey, std::unique_ptr<HandleState>>(mapKey, std::move(handleState)));
+    HandleStateShard& shard = GetShard(mapKey);
+    std::unique_lock<std::shared_timed_mutex> shardLock(shard.mutex);
+    auto it = shard.handleStates.insert(std::pair<HandleStateKey, std::unique_ptr<HandleState>>(mapKey, std::move(handleState)));
     if (!it.second) {
         throw HandleException(std::string("Encountered duplicate ") + to_string(mapKey.second) + " handle with value " +
                               std::to_string(mapKey.first));
@@ -57,8 +88,11 @@ void RegisterHandleState(std::unique_ptr<HandleState> handleState)
 
 void UnregisterHandleStateInternal(std::unique_lock<std::mutex>& lockProof, HandleStateKey key)
 {
-    auto it = g_handleStates.find(key);
-    if (it == g_handleStates.end()) {
+    // Holding the write mutex means no other thread modifies any shard, so finding without
+    // the shard lock is safe; the shard lock is only needed to exclude readers while erasing.
+    HandleStateShard& shard = GetShard(key);
+    auto it = shard.handleStates.find(key);
+    if (it == shard.handleStates.end()) {
         throw HandleException(std::string("Encountered unknown ") + to_string(key.second) + " handle with value " +
                               std::to_string(key.first));
     }
@@ -81,20 +115,22 @@ void UnregisterHandleStateInternal(std::unique_lock<std::mutex>& lockProof, Hand
     }
 
     // Finally remove self from map.
-    g_handleStates.erase(it);
+    std::unique_lock<std::shared_timed_mutex> shardLock(shard.mutex);
+    shard.handleStates.erase(it);
 }
 
 void UnregisterHandleState(HandleStateKey key)
 {
-    std::unique_lock<std::mutex> lock(g_handleStatesMutex);
+    std::unique_lock<std::mutex> lock(g_handleStatesWriteMutex);
     UnregisterHandleStateInternal(lock, key);
 }
 
 HandleState* GetHandleState(HandleStateKey key)
 {
-    std::unique_lock<std::mutex> lock(g_handleStatesMutex);
-    auto it = g_handleStates.find(key);
-    if (it == g_handleStates.end()) {
+    HandleStateShard& shard = GetShard(key);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto it = shard.handleStates.find(key);
+    if (it == shard.handleStates.end()) {
         throw HandleNotFoundException(std::string("Encountered unknown ") + to_string(key.second) + " handle with value " +
                                       std::to_string(key.first));
     }
@@ -78,6 +78,7 @@ XrResult ConformanceHooks::xrEnumerateEnvironmentBlendModes(XrInstance instance,
 
 XrResult ConformanceHooks::xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData)
 {
+    std::unique_lock<std::mutex> sessionLifetimeLock(sessionLifetimeMutex);
     const XrResult result = ConformanceHooksBase::xrPollEvent(instance, eventData);
 
     if (result == XR_EVENT_UNAVAILABLE) {
@@ -0,0 +1,260 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LatencyHistograms.h"
+
+#include "common/platform_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Log-linear buckets in the style of HdrHistogram: values below 2^kSubBucketBits nanoseconds get a bucket each, and
+    // every larger power of two is split into 2^kSubBucketBits equal buckets, so each bucket is within ~3% of its values.
+    constexpr int kSubBucketBits = 5;
+    constexpr uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+    // 2^40 ns is about 18 minutes; anything longer lands in the last bucket.
+    constexpr int kMaxExponent = 40;
+    constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+    int FloorLog2(uint64_t value)
+    {
+        int result = 0;
+        for (int shift = 32; shift > 0; shift /= 2) {
+            if (value >> shift) {
+                value >>= shift;
+                result += shift;
+            }
+        }
+        return result;
+    }
+
+    size_t BucketIndex(uint64_t value)
+    {
+        if (value < kSubBucketCount) {
+            return size_t(value);
+        }
+        const int exponent = FloorLog2(value);
+        if (exponent > kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        const uint64_t subBucket = (value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+        return size_t((exponent - kSubBucketBits + 1) * kSubBucketCount + subBucket);
+    }
+
+    /// The largest value that falls into bucket @p index.
+    uint64_t BucketHighestValue(size_t index)
+    {
+        const uint64_t group = index / kSubBucketCount;
+        const uint64_t subBucket = index % kSubBucketCount;
+        if (group == 0) {
+            return subBucket;
+        }
+        return ((kSubBucketCount + subBucket + 1) << (group - 1)) - 1;
+    }
+
+    struct Histogram
+    {
+        std::atomic<uint64_t> counts[kBucketCount];
+        std::atomic<uint64_t> maxNanoseconds;
+    };
+
+    /// One thread's histograms. Only the owning thread adds to them; DumpLatencyHistograms drains them with atomic exchanges,
+    /// so recording never waits for a dump.
+    struct ThreadHistograms
+    {
+        ThreadHistograms() : commands(new std::atomic<Histogram*>[g_hookedCommandCount])
+        {
+            for (size_t i = 0; i < g_hookedCommandCount; ++i) {
+                commands[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~ThreadHistograms()
+        {
+            for (size_t i = 0; i < g_hookedCommandCount; ++i) {
+                delete commands[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        /// Allocated on a command's first call on this thread, since most threads only ever call a few commands.
+        std::unique_ptr<std::atomic<Histogram*>[]> commands;
+    };
+
+    // Every thread that has recorded a call. Entries outlive their threads so that their calls still appear in the dump,
+    // and are freed when the layer is unloaded.
+    std::mutex g_threadsMutex;
+    std::vector<std::unique_ptr<ThreadHistograms>> g_threads;
+
+    thread_local ThreadHistograms* t_threadHistograms = nullptr;
+
+    ThreadHistograms& GetThreadHistograms()
+    {
+        if (t_threadHistograms == nullptr) {
+            std::unique_ptr<ThreadHistograms> histograms(new ThreadHistograms());
+            t_threadHistograms = histograms.get();
+            std::lock_guard<std::mutex> lock(g_threadsMutex);
+            g_threads.push_back(std::move(histograms));
+        }
+        return *t_threadHistograms;
+    }
+
+    const std::string& GetOutputPath()
+    {
+        // The secure variant ignores the variable in elevated processes, so it cannot be used to make them write files.
+        static const std::string path = PlatformUtilsGetSecureEnv(CONFORMANCE_LAYER_LATENCY_HISTOGRAMS_ENV);
+        return path;
+    }
+
+    /// The value at quantile @p quantile of @p totalCount values in @p counts, as the highest value of its bucket.
+    uint64_t ValueAtQuantile(const std::vector<uint64_t>& counts, uint64_t totalCount, double quantile)
+    {
+        uint64_t rank = uint64_t(quantile * double(totalCount) + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return BucketHighestValue(i);
+            }
+        }
+        return BucketHighestValue(counts.size() - 1);
+    }
+
+    void AppendMicroseconds(std::string& json, const char* name, uint64_t nanoseconds)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "\"%s\":%" PRIu64 ".%03u", name, nanoseconds / 1000, unsigned(nanoseconds % 1000));
+        json += buffer;
+    }
+}  // namespace
+
+bool LatencyHistogramsEnabled()
+{
+    return !GetOutputPath().empty();
+}
+
+void RecordLatency(size_t commandIndex, std::chrono::steady_clock::duration duration)
+{
+    const int64_t signedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    const uint64_t nanoseconds = signedNanoseconds > 0 ? uint64_t(signedNanoseconds) : 0;
+
+    std::atomic<Histogram*>& slot = GetThreadHistograms().commands[commandIndex];
+    Histogram* histogram = slot.load(std::memory_order_relaxed);
+    if (histogram == nullptr) {
+        histogram = new Histogram();
+        slot.store(histogram, std::memory_order_release);
+    }
+
+    histogram->counts[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    // Only this thread raises the maximum, so a plain load and store cannot lose a larger value to another writer.
+    if (nanoseconds > histogram->maxNanoseconds.load(std::memory_order_relaxed)) {
+        histogram->maxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+namespace
+{
+    /// Appends the call count and p50/p99/p99.9/max latency of every command called to the output file as one line of JSON.
+    void DumpLatencyHistograms()
+    {
+        std::string json = "{\"unit\":\"us\",\"commands\":{";
+
+        std::vector<uint64_t> counts(kBucketCount);
+        bool firstCommand = true;
+        {
+            std::lock_guard<std::mutex> lock(g_threadsMutex);
+            for (size_t command = 0; command < g_hookedCommandCount; ++command) {
+                std::fill(counts.begin(), counts.end(), 0);
+                uint64_t totalCount = 0;
+                uint64_t maxNanoseconds = 0;
+                for (const std::unique_ptr<ThreadHistograms>& thread : g_threads) {
+                    Histogram* histogram = thread->commands[command].load(std::memory_order_acquire);
+                    if (histogram == nullptr) {
+                        continue;
+                    }
+                    for (size_t i = 0; i < kBucketCount; ++i) {
+                        const uint64_t count = histogram->counts[i].exchange(0, std::memory_order_relaxed);
+                        counts[i] += count;
+                        totalCount += count;
+                    }
+                    const uint64_t threadMax = histogram->maxNanoseconds.exchange(0, std::memory_order_relaxed);
+                    maxNanoseconds = threadMax > maxNanoseconds ? threadMax : maxNanoseconds;
+                }
+                if (totalCount == 0) {
+                    continue;
+                }
+
+                // Bucket bounds overestimate slightly; never report a percentile above the exact maximum.
+                auto percentile = [&](double quantile) {
+                    const uint64_t value = ValueAtQuantile(counts, totalCount, quantile);
+                    return value < maxNanoseconds ? value : maxNanoseconds;
+                };
+
+                json += firstCommand ? "\"" : ",\"";
+                json += g_hookedCommandNames[command];
+                json += "\":{\"count\":" + std::to_string(totalCount) + ",";
+                AppendMicroseconds(json, "p50", percentile(0.5));
+                json += ",";
+                AppendMicroseconds(json, "p99", percentile(0.99));
+                json += ",";
+                AppendMicroseconds(json, "p99.9", percentile(0.999));
+                json += ",";
+                AppendMicroseconds(json, "max", maxNanoseconds);
+                json += "}";
+                firstCommand = false;
+            }
+        }
+        json += "}}\n";
+
+        if (firstCommand) {
+            return;
+        }
+
+        // The line is written at once, so that several processes can share a file.
+        std::ofstream file(GetOutputPath(), std::ios::app);
+        file.write(json.data(), json.size());
+    }
+
+    /// Dumps the histograms when the layer library is unloaded: by the loader once no instance uses the layer any more,
+    /// or at process exit. Defined after g_threads, so it is destroyed first, while the histograms still exist.
+    struct DumpAtUnload
+    {
+        DumpAtUnload()
+        {
+            // Constructed now so that the path outlives this object.
+            GetOutputPath();
+        }
+
+        ~DumpAtUnload()
+        {
+            if (LatencyHistogramsEnabled()) {
+                DumpLatencyHistograms();
+            }
+        }
+    } g_dumpAtUnload;
+}  // namespace
@@ -0,0 +1,37 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/// Names of the commands with generated hooks, indexed by the command index passed to RecordLatency.
+/// Defined in gen_dispatch.cpp.
+extern const char* const g_hookedCommandNames[];
+extern const size_t g_hookedCommandCount;
+
+/// Environment variable naming the file that latency histograms are appended to. Unset or empty disables them.
+#define CONFORMANCE_LAYER_LATENCY_HISTOGRAMS_ENV "CONFORMANCE_LAYER_LATENCY_HISTOGRAMS"
+
+/// True if CONFORMANCE_LAYER_LATENCY_HISTOGRAMS was set when the layer was first used. Read once.
+bool LatencyHistogramsEnabled();
+
+/// Adds one call of command @p commandIndex taking @p duration in the runtime to the calling thread's histograms.
+/// Lock-free except for the first call on each thread.
+/// The histograms are shared by all instances, and are appended to the output file once, when the layer is unloaded.
+void RecordLatency(size_t commandIndex, std::chrono::steady_clock::duration duration);
+
@@ -199,6 +199,12 @@ XrResult ConformanceHooks::xrCreateSession(XrInstance instance, const XrSessionC
     return result;
 }
 
+XrResult ConformanceHooks::xrDestroySession(XrSession session)
+{
+    std::unique_lock<std::mutex> lock(sessionLifetimeMutex);
+    return ConformanceHooksBase::xrDestroySession(session);
+}
+
 XrResult ConformanceHooks::xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo)
 {
     CustomSessionState* const customSessionState = GetCustomSessionState(session);
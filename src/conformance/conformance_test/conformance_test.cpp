@@ -23,7 +23,9 @@
 #include "graphics_plugin.h"
 #include "platform_utils.hpp"  // for OPENXR_API_LAYER_PATH_ENV_VAR
 #include "report.h"
+#include "timing_history.h"
 #include "utilities/git_revision.h"
+#include "utilities/test_durations.h"
 #include "utilities/utils.h"
 
 #include "catch_reporter_cts.h"
@@ -33,6 +35,7 @@
 #include <catch2/catch_test_case_info.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/internal/catch_clara.hpp>                    // for customizing arg parsing
+#include <catch2/internal/catch_string_manip.hpp>             // for trim
 #include <catch2/internal/catch_test_case_registry_impl.hpp>  // for getAllTestCasesSorted
 #include <catch2/reporters/catch_reporter_event_listener.hpp>
 #include <catch2/reporters/catch_reporter_registrars.hpp>
@@ -46,6 +49,8 @@
 #include <cstring>
 #include <streambuf>
 #include <algorithm>
+#include <chrono>
+#include <numeric>
 
 using namespace Conformance;
 
@@ -451,6 +456,11 @@ namespace
             ("Specify a graphics plugin to use. Required.")
                 .required()
 
+            | Opt(options.vulkanPipelineCacheFile, "path")  // Vulkan pipeline cache file
+                  ["--vulkanPipelineCache"]                 //
+              ("Keep the Vulkan pipeline cache in this file between runs. Default is to not keep it.")
+                  .optional()
+
             | Opt(parseDesiredApiVersion,
                   "1.0|1.1")        // OpenXR version
                   ["--apiVersion"]  //
@@ -526,6 +536,41 @@ namespace
                   ["--autoSkipTimeout"]("Automatic Skip Timeout (in milliseconds) for tests which support it")
                       .optional()
 
+            | Opt(options.shardDurationsFile, "path")  // balance shards by recorded durations
+                  ["--shardDurations"]                 //
+              ("Balance the shards selected by --shard-count and --shard-index using the test case durations in this file.")
+                  .optional()
+
+            | Opt(options.recordDurationsFile, "path")  // record test case durations
+                  ["--recordDurations"]                 //
+              ("Write the duration of each test case run to this file, for use with --shardDurations.")
+                  .optional()
+
+            | Opt(options.runtimeCallTiming)  // time OpenXR calls
+                  ["--xrCallTiming"]          //
+              ("Count and time the OpenXR calls made in each test case and section. Implied by --timingHistory.")
+                  .optional()
+
+            | Opt(options.timingHistoryFile, "path")  // timing history
+                  ["--timingHistory"]                 //
+              ("Append the time spent in each test case and section, and in the OpenXR calls made in it, to this file.")
+                  .optional()
+
+            | Opt(options.timingRegressionPercent, "percent")  // timing regressions
+                  ["--timingRegressionThreshold"]              //
+              ("Report test cases and sections that took this many percent longer than their last entry in --timingHistory.")
+                  .optional()
+
+            | Opt(options.timingHistoryOutFile, "path")  // timing history output
+                  ["--timingHistoryOut"]                 //
+              ("Append this run's timings to this file instead of to --timingHistory.")
+                  .optional()
+
+            | Opt(options.frameSchedulingBenchmarkFile, "path")  // frame scheduling benchmark output
+                  ["--frameSchedulingCsv"]                       //
+              ("Append the per-frame measurements of the [benchmark] frame scheduling test to this CSV file.")
+                  .optional()
+
             //
             | Opt([&](bool enabled) { options.debugMode = enabled; })  //
                   ["-D"]["--debugMode"]                                //
@@ -534,6 +579,101 @@ namespace
 
         return cli;
     }
+
+    std::string QuoteTestName(const std::string& name)
+    {
+        std::string quoted = "\"";
+        for (char c : name) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + '"';
+    }
+
+    // Replaces the test spec with the names of the test cases in this process's shard, so that shards are balanced by
+    // the durations recorded in earlier runs rather than by test count. Every shard computes the same assignment.
+    void SelectDurationBalancedShard(Catch::ConfigData& configData, const TestDurations& durations)
+    {
+        Catch::ConfigData unshardedData = configData;
+        unshardedData.shardCount = 1;
+        unshardedData.shardIndex = 0;
+        const Catch::Config unshardedConfig(unshardedData);
+        const std::vector<Catch::TestCaseHandle> testCases =
+            Catch::filterTests(Catch::getAllTestCasesSorted(unshardedConfig), unshardedConfig.testSpec(), unshardedConfig);
+
+        // Test cases that have not been timed yet are assumed to take the average time.
+        std::vector<double> testDurations(testCases.size(), -1.0);
+        double knownTotal = 0;
+        size_t knownCount = 0;
+        for (size_t i = 0; i < testCases.size(); ++i) {
+            auto it = durations.find(testCases[i].getTestCaseInfo().name);
+            if (it != durations.end()) {
+                testDurations[i] = it->second;
+                knownTotal += it->second;
+                knownCount++;
+            }
+        }
+        const double defaultDuration = knownCount > 0 ? knownTotal / knownCount : 1.0;
+        for (double& duration : testDurations) {
+            duration = duration < 0 ? defaultDuration : duration;
+        }
+
+        // Longest first, each to the shard with the least time so far. Ties are broken by name, not by run order,
+        // which may be random and differ between shards.
+        std::vector<size_t> order(testCases.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (testDurations[a] != testDurations[b]) {
+                return testDurations[a] > testDurations[b];
+            }
+            return testCases[a].getTestCaseInfo().name < testCases[b].getTestCaseInfo().name;
+        });
+        std::vector<double> shardTotals(configData.shardCount, 0.0);
+        std::string spec;
+        for (size_t i : order) {
+            auto shard = std::min_element(shardTotals.begin(), shardTotals.end());
+            *shard += testDurations[i];
+            if (shard - shardTotals.begin() == configData.shardIndex) {
+                spec += (spec.empty() ? "" : ",") + QuoteTestName(testCases[i].getTestCaseInfo().name);
+            }
+        }
+
+        if (spec.empty()) {
+            // More shards than test cases: match nothing.
+            spec = "~*";
+            configData.allowZeroTests = true;
+        }
+        configData.testsOrTags = {spec};
+        configData.shardCount = 1;
+        configData.shardIndex = 0;
+    }
+
+    void RecordTimingHistory(const Options& options, const XrInstanceProperties& instanceProperties, const ConformanceReport& report)
+    {
+        if (options.timingRegressionPercent > 0) {
+            const std::vector<TimingRegression> regressions =
+                FindTimingRegressions(options.timingHistoryFile, report, options.timingRegressionPercent);
+            for (const TimingRegression& regression : regressions) {
+                ReportF("Timing regression: %s took %.3f s, was %.3f s with %s (OpenXR calls: %.3f s, was %.3f s)", regression.path.c_str(),
+                        regression.currentSeconds, regression.previousSeconds, regression.previousRuntime.c_str(),
+                        regression.currentCallSeconds, regression.previousCallSeconds);
+            }
+            ReportF("%zu test cases or sections took more than %g%% longer than in %s", regressions.size(),
+                    options.timingRegressionPercent, options.timingHistoryFile.c_str());
+        }
+
+        const std::string runtime = std::string(instanceProperties.runtimeName) + " " +
+                                    std::to_string(XR_VERSION_MAJOR(instanceProperties.runtimeVersion)) + "." +
+                                    std::to_string(XR_VERSION_MINOR(instanceProperties.runtimeVersion)) + "." +
+                                    std::to_string(XR_VERSION_PATCH(instanceProperties.runtimeVersion));
+        const std::string& historyOutFile = options.timingHistoryOutFile.empty() ? options.timingHistoryFile : options.timingHistoryOutFile;
+        if (!AppendTimingHistory(historyOutFile, runtime, report)) {
+            ReportConsoleOnlyF("Could not append to timing history %s", historyOutFile.c_str());
+        }
+    }
+
     bool UpdateOptionsFromCommandLine(Catch::Session& catchSession, int argc, const char* const* argv)
     {
         auto& globalData = GetGlobalData();
@@ -555,6 +695,10 @@ namespace
         globalData.rightHandUnderTest = globalData.options.rightHandEnabled;
         globalData.conformanceReport.apiVersion = globalData.options.desiredApiVersionValue;
 
+        if (result == 0 && !globalData.options.shardDurationsFile.empty() && catchSession.configData().shardCount > 1) {
+            SelectDurationBalancedShard(catchSession.configData(), ReadTestDurations(globalData.options.shardDurationsFile));
+        }
+
         if (!(catchSession.configData().listTests || catchSession.configData().listTags || catchSession.configData().listListeners ||
               catchSession.configData().listReporters)) {
             // Check for required parameters, if we are actually going to run tests
@@ -568,6 +712,30 @@ namespace
         return result == 0;
     }
 
+    /// A point in time, and the totals of the OpenXR calls that the conformance layer had passed to the runtime by then.
+    struct TimingSnapshot
+    {
+        std::chrono::steady_clock::time_point time;
+        XrcRuntimeCallStatistics calls{};
+
+        static TimingSnapshot Now()
+        {
+            TimingSnapshot snapshot;
+            GetGlobalData().GetRuntimeCallStatistics(snapshot.calls);
+            snapshot.time = std::chrono::steady_clock::now();
+            return snapshot;
+        }
+
+        /// Adds the time and calls since this snapshot to @p timing.
+        void AddElapsedTo(ConformanceReport::Timing& timing) const
+        {
+            const TimingSnapshot now = Now();
+            timing.duration += now.time - time;
+            timing.runtimeCallCount += now.calls.callCount - calls.callCount;
+            timing.runtimeCallTime += std::chrono::nanoseconds(now.calls.callNanoseconds - calls.callNanoseconds);
+        }
+    };
+
     // Implements a class that listens to the results of individual test runs. This is used for
     // collecting telemetry.
     struct ConformanceTestListener : Catch::EventListenerBase
@@ -576,13 +744,22 @@ namespace
 
         using EventListenerBase::EventListenerBase;  // inherit constructor
 
+        void testCaseStarting(Catch::TestCaseInfo const& testInfo) override
+        {
+            Base::testCaseStarting(testInfo);
+            m_testCaseStart = std::chrono::steady_clock::now();
+        }
+
         void testCaseEnded(Catch::TestCaseStats const& testCaseStats) override
         {
             Base::testCaseEnded(testCaseStats);
 
             Conformance::GlobalData& globalData = Conformance::GetGlobalData();
-            globalData.conformanceReport.results[testCaseStats.testInfo->name].testSuccessCount += testCaseStats.totals.testCases.passed;
-            globalData.conformanceReport.results[testCaseStats.testInfo->name].testFailureCount += testCaseStats.totals.testCases.failed;
+            auto& score = globalData.conformanceReport.results[testCaseStats.testInfo->name];
+            score.testSuccessCount += testCaseStats.totals.testCases.passed;
+            score.testFailureCount += testCaseStats.totals.testCases.failed;
+            m_testCaseDurations[testCaseStats.testInfo->name] +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - m_testCaseStart).count();
         }
 
         void sectionStarting(Catch::SectionInfo const& sectionInfo) override
@@ -594,6 +771,13 @@ namespace
             g_conformanceLaunchSettings->message(MessageType_TestSectionStarting,
                                                  (indentStr + "Executing \"" + sectionInfo.name + "\" tests...\n").c_str());
             m_sectionIndent++;
+
+            // Same path as the ctsxml reporter uses for the section.
+            std::string path = Catch::trim(sectionInfo.name);
+            if (!m_sections.empty()) {
+                path = m_sections.back().first + '/' + path;
+            }
+            m_sections.emplace_back(std::move(path), TimingSnapshot::Now());
         }
         void sectionEnded(Catch::SectionStats const& sectionStats) override
         {
@@ -607,6 +791,12 @@ namespace
 
             Base::sectionEnded(sectionStats);
             m_sectionIndent--;
+
+            if (!m_sections.empty()) {
+                Conformance::GlobalData& globalData = Conformance::GetGlobalData();
+                m_sections.back().second.AddElapsedTo(globalData.conformanceReport.sectionTimings[m_sections.back().first]);
+                m_sections.pop_back();
+            }
         }
 
         void noMatchingTestCases(Catch::StringRef unmatchedSpec) override
@@ -619,9 +809,19 @@ namespace
         {
             Conformance::GlobalData& globalData = Conformance::GetGlobalData();
             globalData.conformanceReport.totals = testRunStats.totals;
+
+            if (!globalData.options.recordDurationsFile.empty() &&
+                !WriteTestDurations(globalData.options.recordDurationsFile, m_testCaseDurations)) {
+                ReportConsoleOnlyF("Could not write test durations to %s", globalData.options.recordDurationsFile.c_str());
+            }
         }
 
         int m_sectionIndent{0};
+        std::chrono::steady_clock::time_point m_testCaseStart;
+        /// Wall time of each test case, summed over all of its runs, for --recordDurations.
+        TestDurations m_testCaseDurations;
+        /// Path and start of each section being run, outermost first.
+        std::vector<std::pair<std::string, TimingSnapshot>> m_sections;
     };
     CATCH_REGISTER_LISTENER(ConformanceTestListener)
     CATCH_REGISTER_REPORTER("ctsxml", Catch::CTSReporter)
@@ -710,7 +910,10 @@ XrcResult XRAPI_CALL xrcRunConformanceTests(const ConformanceLaunchSettings* con
     *failureCount = 0;
     bool conformanceTestsRun = false;
     try {
-        Conformance::g_reportCallback = [&](const char* message) { conformanceLaunchSettings->message(MessageType_Stdout, message); };
+        // By value: the callback is also used by xrcCleanup, after this function has returned.
+        Conformance::g_reportCallback = [conformanceLaunchSettings](const char* message) {
+            conformanceLaunchSettings->message(MessageType_Stdout, message);
+        };
 
 #if defined(XR_OS_LINUX) || defined(XR_OS_APPLE) || defined(XR_OS_WINDOWS)
         // Disable loader error output by default, as we intentionally generate errors.
@@ -770,6 +973,10 @@ XrcResult XRAPI_CALL xrcRunConformanceTests(const ConformanceLaunchSettings* con
             const auto& totals = globalData.conformanceReport.totals;
             conformanceTestsRun = true;
 
+            if (!skipActuallyTesting && !globalData.options.timingHistoryFile.empty()) {
+                RecordTimingHistory(globalData.options, globalData.instanceProperties, globalData.conformanceReport);
+            }
+
             // a list option was used so no tests could have run
             if (skipActuallyTesting) {
                 *testResult = XRC_TEST_RESULT_SUCCESS;
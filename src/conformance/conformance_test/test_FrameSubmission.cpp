@@ -14,11 +14,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "RGBAImage.h"
 #include "composition_utils.h"
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "report.h"
+#include "utilities/colors.h"
 #include "utilities/throw_helpers.h"
+#include "utilities/utils.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
@@ -26,10 +29,23 @@
 #include <openxr/openxr.h>
 #include <openxr/openxr_reflection.h>
 
+// Include all dependencies of openxr_platform as configured
+#include "common/xr_dependencies.h"
+#include <openxr/openxr_platform.h>
+
 #include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
 #include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
+#include <vector>
 
 #define ENUM_LIST(name, val) name,
 constexpr XrEnvironmentBlendMode SupportedBlendModes[] = {XR_LIST_ENUM_XrEnvironmentBlendMode(ENUM_LIST)};
@@ -449,4 +465,746 @@ namespace Conformance
         REQUIRE_MSG(averageBeginTime.count() / (double)averageDisplayPeriod.count() < 0.1,
                     "Begin frame overhead in pipelined frame submission is too high");
     }
+
+    // Submits projection layers whose views are consecutive slices of one array swapchain, drawn with
+    // IGraphicsPlugin::RenderMultiview: in a single pass where the graphics plugin supports multiview, otherwise view by view.
+    // ProjectionSinglePassMultiview checks the result visually.
+    TEST_CASE("Single_Pass_Multiview_Frame_Submission", "")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            // Nothing to check - no graphics plugin means no frame submission
+            return;
+        }
+
+        CompositionHelper compositionHelper("Single Pass Multiview Frame Submission");
+        compositionHelper.GetInteractionManager().AttachActionSets();
+        compositionHelper.BeginSession();
+
+        SimpleProjectionLayerHelper simpleProjectionLayerHelper(compositionHelper, true);
+
+        constexpr int frameCount = 30;
+        int frame = 0;
+        int renderedFrames = 0;
+        RenderLoop(compositionHelper.GetSession(), [&](const XrFrameState& frameState) {
+            std::vector<XrCompositionLayerBaseHeader*> layers;
+            if (XrCompositionLayerBaseHeader* projLayer = simpleProjectionLayerHelper.TryGetUpdatedProjectionLayer(frameState)) {
+                layers.push_back(projLayer);
+                ++renderedFrames;
+            }
+            compositionHelper.EndFrame(frameState.predictedDisplayTime, layers);
+            return ++frame < frameCount;
+        }).Loop();
+
+        if (renderedFrames == 0) {
+            WARN("Views were never located, so no projection layer was rendered");
+        }
+    }
+
+    namespace
+    {
+        using SteadyTime = std::chrono::steady_clock::time_point;
+
+        /// How the frame loop of Frame_Scheduling_Benchmark is split across threads.
+        enum class FrameThreadTopology
+        {
+            /// One thread waits, simulates, then begins, renders and ends each frame.
+            SingleThread,
+            /// A simulation thread waits and simulates; the render thread begins, renders and ends frames, as in
+            /// Timed_Pipelined_Frame_Submission.
+            RenderThread,
+            /// A thread that does nothing but call xrWaitFrame feeds a simulation thread, which feeds the render thread.
+            WaitThread,
+        };
+
+        const char* ToString(FrameThreadTopology topology)
+        {
+            switch (topology) {
+            case FrameThreadTopology::SingleThread:
+                return "single_thread";
+            case FrameThreadTopology::RenderThread:
+                return "render_thread";
+            case FrameThreadTopology::WaitThread:
+                return "wait_thread";
+            }
+            return "unknown";
+        }
+
+        struct FrameSchedulingConfig
+        {
+            FrameThreadTopology topology;
+            /// Most frames waited for but not yet ended at any time.
+            int pipelineDepth;
+            /// Fraction of the display period busy simulating after xrWaitFrame returns, standing in for CPU load.
+            double simulationLoad;
+            /// Fraction of the display period busy between xrBeginFrame and xrEndFrame, standing in for GPU load.
+            double renderLoad;
+        };
+
+        /// Timestamps of one frame. Each field is written by the thread running that stage of the frame and read once all
+        /// threads are joined.
+        struct FrameRecord
+        {
+            XrFrameState frameState{XR_TYPE_FRAME_STATE};
+            SteadyTime waitStart;
+            SteadyTime waitEnd;
+            SteadyTime beginStart;
+            SteadyTime beginEnd;
+            SteadyTime endStart;
+            SteadyTime endEnd;
+        };
+
+        /// Hands frame indices from one pipeline stage to the next. -1 tells the receiver to stop.
+        class FrameHandOff
+        {
+        public:
+            void Push(int frame)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_frames.push(frame);
+                m_cv.notify_one();
+            }
+
+            int Pop()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&] { return !m_frames.empty(); });
+                const int frame = m_frames.front();
+                m_frames.pop();
+                return frame;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::queue<int> m_frames;
+        };
+
+        /// Maps steady clock times to XrTime using XR_KHR_convert_timespec_time or
+        /// XR_KHR_win32_convert_performance_counter_time, if the runtime supports it.
+        class XrTimeConverter
+        {
+        public:
+            static const char* ExtensionName()
+            {
+#if defined(XR_USE_PLATFORM_WIN32)
+                return XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME;
+#elif defined(XR_USE_TIMESPEC)
+                return XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME;
+#else
+                return nullptr;
+#endif
+            }
+
+            static bool IsSupported()
+            {
+                return ExtensionName() != nullptr && GetGlobalData().IsInstanceExtensionSupported(ExtensionName());
+            }
+
+            /// @p instance must have been created with ExtensionName() enabled if IsSupported().
+            explicit XrTimeConverter(XrInstance instance) : m_instance(instance)
+            {
+                if (!IsSupported()) {
+                    return;
+                }
+#if defined(XR_USE_PLATFORM_WIN32)
+                m_convertCounter = GetInstanceExtensionFunction<PFN_xrConvertWin32PerformanceCounterToTimeKHR>(
+                    instance, "xrConvertWin32PerformanceCounterToTimeKHR");
+#elif defined(XR_USE_TIMESPEC)
+                m_convertTimespec =
+                    GetInstanceExtensionFunction<PFN_xrConvertTimespecTimeToTimeKHR>(instance, "xrConvertTimespecTimeToTimeKHR");
+#endif
+                Calibrate();
+            }
+
+            bool IsAvailable() const
+            {
+                return m_available;
+            }
+
+            /// Measures the offset between the clocks again, taking the sample that was least disturbed by the conversion
+            /// call itself. Called before every measurement so that clock drift does not accumulate.
+            void Calibrate()
+            {
+                std::chrono::nanoseconds bestBracket = std::chrono::nanoseconds::max();
+                for (int sample = 0; sample < 5; ++sample) {
+                    XrTime now;
+                    const SteadyTime before = std::chrono::steady_clock::now();
+                    if (!NowAsXrTime(&now)) {
+                        m_available = false;
+                        return;
+                    }
+                    const SteadyTime after = std::chrono::steady_clock::now();
+                    if (after - before < bestBracket) {
+                        bestBracket = after - before;
+                        m_reference = before + (after - before) / 2;
+                        m_referenceXrTime = now;
+                    }
+                }
+                m_available = true;
+            }
+
+            XrTime ToXrTime(SteadyTime time) const
+            {
+                return m_referenceXrTime + std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_reference).count();
+            }
+
+        private:
+            bool NowAsXrTime(XrTime* time) const
+            {
+#if defined(XR_USE_PLATFORM_WIN32)
+                LARGE_INTEGER counter;
+                QueryPerformanceCounter(&counter);
+                return m_convertCounter != nullptr && XR_SUCCEEDED(m_convertCounter(m_instance, &counter, time));
+#elif defined(XR_USE_TIMESPEC)
+                timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                return m_convertTimespec != nullptr && XR_SUCCEEDED(m_convertTimespec(m_instance, &now, time));
+#else
+                (void)time;
+                return false;
+#endif
+            }
+
+            XrInstance m_instance;
+            bool m_available{false};
+            SteadyTime m_reference;
+            XrTime m_referenceXrTime{0};
+#if defined(XR_USE_PLATFORM_WIN32)
+            PFN_xrConvertWin32PerformanceCounterToTimeKHR m_convertCounter{nullptr};
+#elif defined(XR_USE_TIMESPEC)
+            PFN_xrConvertTimespecTimeToTimeKHR m_convertTimespec{nullptr};
+#endif
+        };
+
+        double ToMilliseconds(std::chrono::steady_clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        double ToMilliseconds(XrDuration duration)
+        {
+            return duration / 1e6;
+        }
+
+        std::string CsvField(const std::string& text)
+        {
+            if (text.find_first_of(",\"\n") == std::string::npos) {
+                return text;
+            }
+            std::string quoted = "\"";
+            for (char c : text) {
+                quoted += c;
+                if (c == '"') {
+                    quoted += '"';
+                }
+            }
+            return quoted + "\"";
+        }
+
+        // Busy-waiting is more accurate than "sleeping" which can have several milliseconds of additional delay.
+        void BusyWait(std::chrono::nanoseconds duration)
+        {
+            const SteadyTime end = std::chrono::steady_clock::now() + duration;
+            while (std::chrono::steady_clock::now() < end) {
+                std::this_thread::yield();
+            }
+        }
+    }  // namespace
+
+    // Runs the frame loop with every combination of thread topology, pipeline depth and simulation ("CPU") and render
+    // ("GPU") load, recording the timing of each frame, so that the frame scheduling of runtimes can be compared.
+    // Hidden: run it explicitly with "[benchmark]". Results are appended to --frameSchedulingCsv and summarized per
+    // configuration in the report. Nothing is required of the runtime beyond producing frames.
+    TEST_CASE("Frame_Scheduling_Benchmark", "[.][benchmark]")
+    {
+        GlobalData& globalData = GetGlobalData();
+
+        constexpr int warmupFrameCount = 45;     // Frames run before measuring each configuration, to settle the runtime.
+        constexpr int measuredFrameCount = 180;  // Frames measured in each configuration.
+        constexpr int frameCount = warmupFrameCount + measuredFrameCount;
+        const double loads[] = {0.3, 0.6, 0.9};
+
+        std::vector<FrameSchedulingConfig> configs;
+        for (FrameThreadTopology topology :
+             {FrameThreadTopology::SingleThread, FrameThreadTopology::RenderThread, FrameThreadTopology::WaitThread}) {
+            // A single thread can never have more than one frame in flight.
+            const int maxDepth = topology == FrameThreadTopology::SingleThread ? 1 : 3;
+            for (int depth = 1; depth <= maxDepth; ++depth) {
+                for (double simulationLoad : loads) {
+                    for (double renderLoad : loads) {
+                        configs.push_back({topology, depth, simulationLoad, renderLoad});
+                    }
+                }
+            }
+        }
+
+        std::vector<const char*> extensions;
+        if (XrTimeConverter::IsSupported()) {
+            extensions.push_back(XrTimeConverter::ExtensionName());
+        }
+
+        // With a graphics plugin, frames carry a rendered projection layer as in Timed_Pipelined_Frame_Submission.
+        // Without one (e.g. a headless session), frames are submitted without layers, which still exercises frame timing.
+        std::unique_ptr<CompositionHelper> compositionHelper;
+        std::unique_ptr<SimpleProjectionLayerHelper> projectionLayerHelper;
+        std::unique_ptr<AutoBasicInstance> headlessInstance;
+        std::unique_ptr<AutoBasicSession> headlessSession;
+        XrInstance instance;
+        XrSession session;
+        if (globalData.IsUsingGraphicsPlugin()) {
+            compositionHelper = std::make_unique<CompositionHelper>("Frame Scheduling Benchmark", extensions);
+            compositionHelper->GetInteractionManager().AttachActionSets();
+            compositionHelper->BeginSession();
+            projectionLayerHelper = std::make_unique<SimpleProjectionLayerHelper>(*compositionHelper);
+            instance = compositionHelper->GetInstance();
+            session = compositionHelper->GetSession();
+        }
+        else {
+            headlessInstance = std::make_unique<AutoBasicInstance>(extensions);
+            headlessSession =
+                std::make_unique<AutoBasicSession>(AutoBasicSession::createSession | AutoBasicSession::beginSession, *headlessInstance);
+            instance = *headlessInstance;
+            session = *headlessSession;
+        }
+
+        XrTimeConverter timeConverter(instance);
+        if (!timeConverter.IsAvailable()) {
+            WARN("Runtime time cannot be converted to a system clock; predicted display time error is not recorded");
+        }
+
+        const std::string runtime = std::string(globalData.instanceProperties.runtimeName) + " " +
+                                    std::to_string(XR_VERSION_MAJOR(globalData.instanceProperties.runtimeVersion)) + "." +
+                                    std::to_string(XR_VERSION_MINOR(globalData.instanceProperties.runtimeVersion)) + "." +
+                                    std::to_string(XR_VERSION_PATCH(globalData.instanceProperties.runtimeVersion));
+
+        const std::string& csvPath = globalData.options.frameSchedulingBenchmarkFile;
+        const bool isNewFile = !std::ifstream(csvPath).good();
+        std::ofstream csv(csvPath, std::ios::app);
+        REQUIRE_MSG(csv.good(), "Cannot open " << csvPath);
+        if (isNewFile) {
+            csv << "runtime,topology,pipelineDepth,simulationLoad,renderLoad,frame,displayPeriodMs,waitFrameMs,wakeIntervalMs,"
+                   "wakeJitterMs,missedVsyncs,beginFrameMs,endFrameMs,wakeToSubmitMs,predictedLeadMs,displayErrorMs,wakeToDisplayMs\n";
+        }
+
+        for (const FrameSchedulingConfig& config : configs) {
+            std::vector<FrameRecord> frames(frameCount);
+            XrResult waitResult = XR_SUCCESS;
+            XrResult renderResult = XR_SUCCESS;
+
+            // Each stage returns false to stop the loop.
+            auto waitStage = [&](int frame) {
+                FrameRecord& record = frames[frame];
+                record.waitStart = std::chrono::steady_clock::now();
+                waitResult = xrWaitFrame(session, nullptr, &record.frameState);
+                record.waitEnd = std::chrono::steady_clock::now();
+                return waitResult == XR_SUCCESS;
+            };
+            auto simulateStage = [&](int frame) {
+                const XrDuration period = frames[frame].frameState.predictedDisplayPeriod;
+                BusyWait(std::chrono::nanoseconds(static_cast<int64_t>(period * config.simulationLoad)));
+            };
+            auto renderStage = [&](int frame) {
+                FrameRecord& record = frames[frame];
+                record.beginStart = std::chrono::steady_clock::now();
+                renderResult = xrBeginFrame(session, nullptr);
+                record.beginEnd = std::chrono::steady_clock::now();
+                if (XR_FAILED(renderResult)) {
+                    return false;
+                }
+
+                std::vector<XrCompositionLayerBaseHeader*> layers;
+                if (projectionLayerHelper) {
+                    if (XrCompositionLayerBaseHeader* projLayer = projectionLayerHelper->TryGetUpdatedProjectionLayer(record.frameState)) {
+                        layers.push_back(projLayer);
+                    }
+                }
+                const auto renderTime =
+                    std::chrono::nanoseconds(static_cast<int64_t>(record.frameState.predictedDisplayPeriod * config.renderLoad));
+                BusyWait(renderTime - (std::chrono::steady_clock::now() - record.beginEnd));
+
+                XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
+                frameEndInfo.environmentBlendMode = globalData.GetOptions().environmentBlendModeValue;
+                frameEndInfo.displayTime = record.frameState.predictedDisplayTime;
+                frameEndInfo.layerCount = (uint32_t)layers.size();
+                frameEndInfo.layers = layers.data();
+                record.endStart = std::chrono::steady_clock::now();
+                renderResult = xrEndFrame(session, &frameEndInfo);
+                record.endEnd = std::chrono::steady_clock::now();
+                return XR_SUCCEEDED(renderResult);
+            };
+
+            // Tokens for frames that may be waited for; the render stage returns one when it ends a frame.
+            FrameHandOff framesInFlight;
+            for (int i = 0; i < config.pipelineDepth; ++i) {
+                framesInFlight.Push(0);
+            }
+            FrameHandOff toSimulate;
+            FrameHandOff toRender;
+
+            // Waits for each frame in turn, handing it on to @p next, until the render stage stops or a wait fails.
+            auto waitLoop = [&](FrameHandOff& next, bool simulate) {
+                ATTACH_THREAD;
+                for (int frame = 0; frame < frameCount; ++frame) {
+                    if (framesInFlight.Pop() < 0 || !waitStage(frame)) {
+                        break;
+                    }
+                    if (simulate) {
+                        simulateStage(frame);
+                    }
+                    next.Push(frame);
+                }
+                next.Push(-1);
+                DETACH_THREAD;
+            };
+
+            std::vector<std::thread> threads;
+            if (config.topology == FrameThreadTopology::SingleThread) {
+                for (int frame = 0; frame < frameCount; ++frame) {
+                    if (!waitStage(frame)) {
+                        break;
+                    }
+                    simulateStage(frame);
+                    if (!renderStage(frame)) {
+                        break;
+                    }
+                }
+            }
+            else {
+                if (config.topology == FrameThreadTopology::RenderThread) {
+                    threads.emplace_back([&] { waitLoop(toRender, true); });
+                }
+                else {
+                    threads.emplace_back([&] { waitLoop(toSimulate, false); });
+                    threads.emplace_back([&] {
+                        ATTACH_THREAD;
+                        for (int frame; (frame = toSimulate.Pop()) >= 0;) {
+                            simulateStage(frame);
+                            toRender.Push(frame);
+                        }
+                        toRender.Push(-1);
+                        DETACH_THREAD;
+                    });
+                }
+
+                // Rendering stays on this thread, which owns the graphics plugin.
+                for (int frame; (frame = toRender.Pop()) >= 0;) {
+                    if (!renderStage(frame)) {
+                        framesInFlight.Push(-1);
+                        break;
+                    }
+                    framesInFlight.Push(0);
+                }
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            REQUIRE_RESULT_SUCCEEDED(waitResult);
+            REQUIRE_RESULT_SUCCEEDED(renderResult);
+
+            timeConverter.Calibrate();
+
+            std::vector<double> wakeJitter, wakeToSubmit, displayError, wakeToDisplay;
+            int missedVsyncs = 0;
+            for (int frame = warmupFrameCount; frame < frameCount; ++frame) {
+                const FrameRecord& record = frames[frame];
+                const FrameRecord& previous = frames[frame - 1];
+                const XrDuration period = record.frameState.predictedDisplayPeriod;
+                const XrDuration displayInterval = record.frameState.predictedDisplayTime - previous.frameState.predictedDisplayTime;
+
+                // xrWaitFrame should wake the application once per displayed frame: compare its cadence with the
+                // cadence of the display times it predicts.
+                const double wakeInterval = ToMilliseconds(record.waitEnd - previous.waitEnd);
+                const double jitter = wakeInterval - ToMilliseconds(displayInterval);
+                const int missed =
+                    period > 0 ? std::max(0, static_cast<int>(std::llround(double(displayInterval) / double(period))) - 1) : 0;
+                const double submit = ToMilliseconds(record.endEnd - record.waitEnd);
+                wakeJitter.push_back(std::abs(jitter));
+                wakeToSubmit.push_back(submit);
+                missedVsyncs += missed;
+
+                csv << CsvField(runtime) << ',' << ToString(config.topology) << ',' << config.pipelineDepth << ','
+                    << config.simulationLoad << ',' << config.renderLoad << ',' << frame - warmupFrameCount << ','
+                    << ToMilliseconds(period) << ',' << ToMilliseconds(record.waitEnd - record.waitStart) << ',' << wakeInterval
+                    << ',' << jitter << ',' << missed << ',' << ToMilliseconds(record.beginEnd - record.beginStart) << ','
+                    << ToMilliseconds(record.endEnd - record.endStart) << ',' << submit << ',';
+
+                if (timeConverter.IsAvailable() && period > 0) {
+                    // The display time actually achieved is not observable, so take the first vsync of the runtime's
+                    // predicted cadence that comes after xrEndFrame returned.
+                    const XrTime predicted = record.frameState.predictedDisplayTime;
+                    const XrTime wake = timeConverter.ToXrTime(record.waitEnd);
+                    const XrTime submitted = timeConverter.ToXrTime(record.endEnd);
+                    const XrDuration lateBy = std::max<XrDuration>(0, submitted - predicted);
+                    const XrTime displayed = predicted + (lateBy + period - 1) / period * period;
+                    displayError.push_back(ToMilliseconds(displayed - predicted));
+                    wakeToDisplay.push_back(ToMilliseconds(displayed - wake));
+                    csv << ToMilliseconds(predicted - wake) << ',' << displayError.back() << ',' << wakeToDisplay.back();
+                }
+                else {
+                    csv << ",,";
+                }
+                csv << '\n';
+            }
+
+            std::string displayErrorSummary;
+            if (!displayError.empty()) {
+                AppendSprintf(displayErrorSummary, ", display error p50 %.3f p99 %.3f ms", Percentile(displayError, 0.5),
+                              Percentile(displayError, 0.99));
+            }
+            ReportF("%-13s depth %d sim %2.0f%% render %2.0f%%: %3d missed vsyncs, wake jitter p50 %.3f p99 %.3f ms, "
+                    "wake to submit p50 %.3f p99 %.3f p99.9 %.3f ms%s",
+                    ToString(config.topology), config.pipelineDepth, config.simulationLoad * 100, config.renderLoad * 100, missedVsyncs,
+                    Percentile(wakeJitter, 0.5), Percentile(wakeJitter, 0.99), Percentile(wakeToSubmit, 0.5),
+                    Percentile(wakeToSubmit, 0.99), Percentile(wakeToSubmit, 0.999), displayErrorSummary.c_str());
+        }
+
+        REQUIRE_MSG(csv.good(), "Failed to write " << csvPath);
+    }
+
+    // Renders blocks of 64, 512 and 4096 cubes into a projection layer and reports the time spent rendering each frame, to
+    // measure how the mesh drawing of the graphics plugin scales with the number of drawables. Each block is rendered with one
+    // swapchain per view, then with the views in one array swapchain drawn in a single pass where the graphics plugin can.
+    // Hidden: run it explicitly with "[benchmark]". Nothing is required of the runtime beyond producing frames.
+    TEST_CASE("Mesh_Draw_Benchmark", "[.][benchmark]")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            SKIP("Cannot benchmark rendering without a graphics plugin");
+        }
+
+        constexpr int warmupFrameCount = 30;     // Frames rendered before measuring each scene, to settle the runtime.
+        constexpr int measuredFrameCount = 120;  // Frames measured for each scene.
+
+        CompositionHelper compositionHelper("Mesh Draw Benchmark");
+        compositionHelper.GetInteractionManager().AttachActionSets();
+        compositionHelper.BeginSession();
+        SimpleProjectionLayerHelper separateLayerHelper(compositionHelper);
+        SimpleProjectionLayerHelper multiviewLayerHelper(compositionHelper, true);
+
+        for (int gridSize : {4, 8, 16}) {
+            // A one meter block of gridSize^3 cubes, two meters in front of the viewer, tinted by position.
+            const float spacing = 1.0f / gridSize;
+            std::vector<Cube> cubes;
+            cubes.reserve(gridSize * gridSize * gridSize);
+            for (int x = 0; x < gridSize; ++x) {
+                for (int y = 0; y < gridSize; ++y) {
+                    for (int z = 0; z < gridSize; ++z) {
+                        const XrVector3f position{(x + 0.5f) * spacing - 0.5f, (y + 0.5f) * spacing - 0.5f, -2.0f - z * spacing};
+                        const XrColor4f tint{float(x) / gridSize, float(y) / gridSize, float(z) / gridSize, 1.0f};
+                        cubes.push_back(Cube::Make(position, spacing * 0.5f, Quat::Identity, tint));
+                    }
+                }
+            }
+
+            for (bool singlePassMultiview : {false, true}) {
+                SimpleProjectionLayerHelper& projectionLayerHelper = singlePassMultiview ? multiviewLayerHelper : separateLayerHelper;
+                std::vector<double> renderTimes;
+                int frame = 0;
+                RenderLoop(compositionHelper.GetSession(), [&](const XrFrameState& frameState) {
+                    std::vector<XrCompositionLayerBaseHeader*> layers;
+                    const auto renderStart = std::chrono::steady_clock::now();
+                    if (XrCompositionLayerBaseHeader* projLayer = projectionLayerHelper.TryGetUpdatedProjectionLayer(frameState, cubes)) {
+                        layers.push_back(projLayer);
+                        if (frame >= warmupFrameCount) {
+                            renderTimes.push_back(ToMilliseconds(std::chrono::steady_clock::now() - renderStart));
+                        }
+                    }
+                    compositionHelper.EndFrame(frameState.predictedDisplayTime, layers);
+                    return ++frame < warmupFrameCount + measuredFrameCount;
+                }).Loop();
+
+                const char* layout = singlePassMultiview ? "single-pass multiview" : "separate swapchains";
+                if (renderTimes.empty()) {
+                    WARN("No frame of " << cubes.size() << " cubes was rendered with " << layout);
+                    continue;
+                }
+                ReportF("%4d cubes, %-21s: render p50 %.3f p99 %.3f ms over %d frames", (int)cubes.size(), layout,
+                        Percentile(renderTimes, 0.5), Percentile(renderTimes, 0.99), (int)renderTimes.size());
+            }
+        }
+    }
+
+    TEST_CASE("Image_Upload_Benchmark", "[.][benchmark]")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            SKIP("Cannot benchmark image uploads without a graphics plugin");
+        }
+
+        constexpr int warmupFrameCount = 10;    // Frames uploaded before measuring each configuration, to settle the runtime.
+        constexpr int measuredFrameCount = 60;  // Frames measured for each configuration.
+
+        CompositionHelper compositionHelper("Image Upload Benchmark");
+        compositionHelper.GetInteractionManager().AttachActionSets();
+        compositionHelper.BeginSession();
+        const XrSpace viewSpace = compositionHelper.CreateReferenceSpace(XR_REFERENCE_SPACE_TYPE_VIEW);
+
+        for (int imageSize : {256, 1024, 2048}) {
+            RGBAImage image(imageSize, imageSize);
+            image.DrawRect(0, 0, imageSize, imageSize, Colors::Blue);
+            image.DrawRect(imageSize / 4, imageSize / 4, imageSize / 2, imageSize / 2, Colors::Green);
+            image.ConvertToSRGB();
+            const double imageMegabytes = double(imageSize) * imageSize * 4 / (1024 * 1024);
+
+            for (int swapchainsPerFrame : {1, 8}) {
+                // Uploading to every slice of an array swapchain takes a different path in some plugins (glTexSubImage3D in OpenGL).
+                for (uint32_t arraySize : {1u, 2u}) {
+                    // One quad per swapchain, as when streaming several text or image panels every frame.
+                    auto swapchainCreateInfo = compositionHelper.DefaultColorSwapchainCreateInfo(
+                        imageSize, imageSize, 0, globalData.graphicsPlugin->GetSRGBA8Format());
+                    swapchainCreateInfo.usageFlags |= XR_SWAPCHAIN_USAGE_TRANSFER_DST_BIT;
+                    swapchainCreateInfo.arraySize = arraySize;
+                    std::vector<XrSwapchain> swapchains;
+                    std::vector<XrCompositionLayerBaseHeader*> layers;
+                    for (int i = 0; i < swapchainsPerFrame; ++i) {
+                        swapchains.push_back(compositionHelper.CreateSwapchain(swapchainCreateInfo));
+                        const XrPosef pose{Quat::Identity, {(i % 4) * 0.25f - 0.375f, (i / 4) * 0.25f - 0.125f, -1.5f}};
+                        layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(
+                            compositionHelper.CreateQuadLayer(swapchains.back(), viewSpace, 0.2f, pose)));
+                    }
+
+                    std::vector<double> uploadTimes;
+                    double displayPeriod = 0;
+                    int frame = 0;
+                    RenderLoop(compositionHelper.GetSession(), [&](const XrFrameState& frameState) {
+                        const auto uploadStart = std::chrono::steady_clock::now();
+                        for (XrSwapchain swapchain : swapchains) {
+                            compositionHelper.AcquireWaitReleaseImage(swapchain, [&](const XrSwapchainImageBaseHeader* swapchainImage) {
+                                for (uint32_t arraySlice = 0; arraySlice < arraySize; ++arraySlice) {
+                                    globalData.graphicsPlugin->CopyRGBAImage(swapchainImage, arraySlice, image);
+                                }
+                            });
+                        }
+                        // Plugins that submit uploads without waiting (Vulkan, D3D12) would otherwise only be timed on recording.
+                        globalData.graphicsPlugin->Flush();
+                        if (frame >= warmupFrameCount) {
+                            uploadTimes.push_back(ToMilliseconds(std::chrono::steady_clock::now() - uploadStart));
+                            displayPeriod = ToMilliseconds(frameState.predictedDisplayPeriod);
+                        }
+                        compositionHelper.EndFrame(frameState.predictedDisplayTime, layers);
+                        return ++frame < warmupFrameCount + measuredFrameCount;
+                    }).Loop();
+
+                    for (XrSwapchain swapchain : swapchains) {
+                        compositionHelper.DestroySwapchain(swapchain);
+                    }
+
+                    // Throughput counts the time spent acquiring, uploading, releasing and waiting for the uploads to complete.
+                    double totalUploadTime = 0;
+                    for (double uploadTime : uploadTimes) {
+                        totalUploadTime += uploadTime;
+                    }
+                    const int uploadsPerFrame = swapchainsPerFrame * int(arraySize);
+                    const double uploadCount = double(uploadTimes.size()) * uploadsPerFrame;
+                    const double megabytesPerSecond = totalUploadTime > 0 ? imageMegabytes * uploadCount * 1000 / totalUploadTime : 0;
+                    const double uploadsPerDisplayPeriod = totalUploadTime > 0 ? displayPeriod * uploadCount / totalUploadTime : 0;
+                    ReportF("%4dx%-4d x %2d per frame (%u slice(s)): %.1f MB/s, %.1f uploads per display period, "
+                            "frame upload p50 %.3f p99 %.3f ms",
+                            imageSize, imageSize, uploadsPerFrame, arraySize, megabytesPerSecond, uploadsPerDisplayPeriod,
+                            Percentile(uploadTimes, 0.5), Percentile(uploadTimes, 0.99));
+                }
+            }
+        }
+    }
+
+    // Measures RGBAImage::PutText in glyphs per second, for text that needs a fresh layout and for text whose layout is cached.
+    TEST_CASE("Text_Render_Benchmark", "[.][benchmark]")
+    {
+        constexpr int iterationCount = 500;
+        constexpr int pixelHeight = 48;
+        const std::string paragraph =
+            "Press the select button on each controller in turn, then hold the menu button until the quad turns green. "
+            "Release it and repeat with the other hand.";
+
+        // Counts the glyphs drawn; whitespace only advances the pen.
+        auto countGlyphs = [](const std::string& text) {
+            return (double)std::count_if(text.begin(), text.end(), [](char c) { return !std::isspace((unsigned char)c); });
+        };
+
+        RGBAImage image(1024, 512);
+        const XrRect2Di rect{{16, 16}, {image.width - 32, image.height - 32}};
+
+        // The first use of a pixel height bakes its glyph atlas, which every later image shares.
+        for (int atlasPixelHeight : {37, 41, 53}) {
+            RGBAImage atlasImage(64, 64);
+            Stopwatch atlasStopwatch(true);
+            atlasImage.PutText(XrRect2Di{{0, 0}, {64, 64}}, "A", atlasPixelHeight, Colors::Green);
+            ReportF("First text at %d pixels high (atlas bake): %.3f ms", atlasPixelHeight,
+                    std::chrono::duration<double, std::milli>(atlasStopwatch.Elapsed()).count());
+        }
+
+        // Whether or not its layout is cached, the same text must render the same pixels.
+        {
+            const std::string text = paragraph + " (check)";
+            RGBAImage uncached(image.width, image.height);
+            uncached.PutText(rect, text.c_str(), pixelHeight, Colors::Green);
+            RGBAImage cached(image.width, image.height);
+            cached.PutText(rect, text.c_str(), pixelHeight, Colors::Green);
+            REQUIRE(memcmp(uncached.pixels.data(), cached.pixels.data(), uncached.pixels.size() * sizeof(RGBA8Color)) == 0);
+        }
+
+        // A distinct suffix per iteration misses the run cache, so each call lays the text out again.
+        double uncachedGlyphs = 0;
+        Stopwatch uncachedStopwatch(true);
+        for (int i = 0; i < iterationCount; ++i) {
+            const std::string text = paragraph + " (" + std::to_string(i) + ")";
+            uncachedGlyphs += countGlyphs(text);
+            image.PutText(rect, text.c_str(), pixelHeight, Colors::UniqueColors[i % Colors::UniqueColors.size()]);
+        }
+        const double uncachedSeconds = std::chrono::duration<double>(uncachedStopwatch.Elapsed()).count();
+
+        // Color is not part of the cache key, so recoloring the same text only blends the glyphs.
+        double cachedGlyphs = 0;
+        Stopwatch cachedStopwatch(true);
+        for (int i = 0; i < iterationCount; ++i) {
+            cachedGlyphs += countGlyphs(paragraph);
+            image.PutText(rect, paragraph.c_str(), pixelHeight, Colors::UniqueColors[i % Colors::UniqueColors.size()]);
+        }
+        const double cachedSeconds = std::chrono::duration<double>(cachedStopwatch.Elapsed()).count();
+
+        ReportF("%d pixels high, %d calls: layout and blend %.0f glyphs/s (%.3f ms per call), cached layout %.0f glyphs/s (%.3f ms per call)",
+                pixelHeight, iterationCount, uncachedGlyphs / uncachedSeconds, uncachedSeconds * 1000 / iterationCount,
+                cachedGlyphs / cachedSeconds, cachedSeconds * 1000 / iterationCount);
+    }
+
+    // Measures RGBAImage::ConvertToSRGB at 1K, 4K and 8K, after checking its lookup table against ColorUtils::ToSRGB for every pixel.
+    TEST_CASE("RGBAImage_ConvertToSRGB_Benchmark", "[.][benchmark]")
+    {
+        constexpr int iterationCount = 5;
+
+        for (int imageSize : {1024, 4096, 8192}) {
+            // Every byte value appears in every channel, in no particular order.
+            RGBAImage linear(imageSize, imageSize);
+            uint32_t state = 2463534242u;
+            for (RGBA8Color& pixel : linear.pixels) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                pixel.Pixel = state;
+            }
+
+            // The per-channel double precision conversion ConvertToSRGB replaced, timed once.
+            RGBAImage reference = linear;
+            Stopwatch referenceStopwatch(true);
+            for (RGBA8Color& pixel : reference.pixels) {
+                pixel.Channels.R = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.R / 255.0) * 255.0);
+                pixel.Channels.G = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.G / 255.0) * 255.0);
+                pixel.Channels.B = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.B / 255.0) * 255.0);
+            }
+            const double referenceMilliseconds = std::chrono::duration<double, std::milli>(referenceStopwatch.Elapsed()).count();
+
+            std::vector<double> convertTimes;
+            for (int i = 0; i < iterationCount; ++i) {
+                RGBAImage image = linear;
+                Stopwatch stopwatch(true);
+                image.ConvertToSRGB();
+                convertTimes.push_back(std::chrono::duration<double, std::milli>(stopwatch.Elapsed()).count());
+                REQUIRE(memcmp(image.pixels.data(), reference.pixels.data(), image.pixels.size() * sizeof(RGBA8Color)) == 0);
+            }
+
+            ReportF("%4dx%-4d: ConvertToSRGB p50 %.3f p99 %.3f ms over %d runs, per-channel ToSRGB %.3f ms", imageSize, imageSize,
+                    Percentile(convertTimes, 0.5), Percentile(convertTimes, 0.99), iterationCount, referenceMilliseconds);
+        }
+    }
 }  // namespace Conformance
@@ -468,6 +468,31 @@ namespace Conformance
         RenderLoop(session, updateLayers).Loop();
     }
 
+    TEST_CASE("ProjectionSinglePassMultiview", "[composition][interactive]")
+    {
+        CompositionHelper compositionHelper("Projection Single Pass Multiview");
+        InteractiveLayerManager interactiveLayerManager(
+            compositionHelper, "projection_separate.png",
+            "Uses consecutive slices of a single texture array for the projection layer views, and draws them in one pass where "
+            "the graphics plugin supports multiview. Should look the same as Projection Separate Swapchains.");
+        XrSession session = compositionHelper.GetSession();
+        InteractionManager& interactionManager = compositionHelper.GetInteractionManager();
+        interactionManager.AttachActionSets();
+        compositionHelper.BeginSession();
+
+        SimpleProjectionLayerHelper simpleProjectionLayerHelper(compositionHelper, true);
+
+        auto updateLayers = [&](const XrFrameState& frameState) {
+            std::vector<XrCompositionLayerBaseHeader*> layers;
+            if (XrCompositionLayerBaseHeader* projLayer = simpleProjectionLayerHelper.TryGetUpdatedProjectionLayer(frameState)) {
+                layers.push_back(projLayer);
+            }
+            return interactiveLayerManager.EndFrame(frameState, layers);
+        };
+
+        RenderLoop(session, updateLayers).Loop();
+    }
+
     TEST_CASE("QuadHands", "[composition][interactive]")
     {
         GlobalData& globalData = GetGlobalData();
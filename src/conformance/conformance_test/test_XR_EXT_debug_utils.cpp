@@ -19,6 +19,7 @@
 #include "utilities/utils.h"
 #include "conformance_utils.h"
 #include "conformance_framework.h"
+#include "report.h"
 #include "utilities/throw_helpers.h"
 #include "common/hex_and_handles.h"
 
@@ -29,6 +30,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <utility>
 #include <vector>
 #include <string>
@@ -1286,4 +1288,117 @@ namespace Conformance
 #undef CHK_XR
     }
 
+    static XRAPI_ATTR XrBool32 XRAPI_CALL countDebugUtilsMessages(XrDebugUtilsMessageSeverityFlagsEXT, XrDebugUtilsMessageTypeFlagsEXT,
+                                                                  const XrDebugUtilsMessengerCallbackDataEXT*, void* userData)
+    {
+        ++*reinterpret_cast<uint64_t*>(userData);
+        return XR_FALSE;
+    }
+
+    // Measures how naming objects and submitting messages that refer to them scale with the number of named objects.
+    TEST_CASE("XR_EXT_debug_utils_Object_Name_Benchmark", "[.][benchmark]")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsInstanceExtensionSupported(XR_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
+            SKIP(XR_EXT_DEBUG_UTILS_EXTENSION_NAME " not supported");
+        }
+
+        AutoBasicInstance instance({XR_EXT_DEBUG_UTILS_EXTENSION_NAME});
+        AutoBasicSession session(AutoBasicSession::createSession, instance);
+
+        auto pfn_create_debug_utils_messager_ext =
+            GetInstanceExtensionFunction<PFN_xrCreateDebugUtilsMessengerEXT>(instance, "xrCreateDebugUtilsMessengerEXT");
+        auto pfn_destroy_debug_utils_messager_ext =
+            GetInstanceExtensionFunction<PFN_xrDestroyDebugUtilsMessengerEXT>(instance, "xrDestroyDebugUtilsMessengerEXT");
+        auto pfn_submit_dmsg = GetInstanceExtensionFunction<PFN_xrSubmitDebugUtilsMessageEXT>(instance, "xrSubmitDebugUtilsMessageEXT");
+        auto pfn_set_obj_name = GetInstanceExtensionFunction<PFN_xrSetDebugUtilsObjectNameEXT>(instance, "xrSetDebugUtilsObjectNameEXT");
+
+        uint64_t messageCount = 0;
+        XrDebugUtilsMessengerCreateInfoEXT dbg_msg_ci = {XR_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT};
+        dbg_msg_ci.messageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+        dbg_msg_ci.messageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        dbg_msg_ci.userCallback = countDebugUtilsMessages;
+        dbg_msg_ci.userData = reinterpret_cast<void*>(&messageCount);
+        XrDebugUtilsMessengerEXT debug_utils_messenger = XR_NULL_HANDLE;
+        REQUIRE_RESULT(XR_SUCCESS, pfn_create_debug_utils_messager_ext(instance, &dbg_msg_ci, &debug_utils_messenger));
+
+        RandEngine& randEngine = globalData.GetRandEngine();
+        constexpr size_t messageIterations = 10000;
+        std::vector<XrSpace> spaces;
+
+        for (size_t objectCount : {10, 100, 1000, 10000, 100000}) {
+            // Create the reference spaces to name until there are objectCount of them; only naming them is timed.
+            const size_t previousCount = spaces.size();
+            while (spaces.size() < objectCount) {
+                XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+                createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+                createInfo.poseInReferenceSpace = XrPosef{{0, 0, 0, 1}, {0, 0, 0}};
+                XrSpace space = XR_NULL_HANDLE;
+                XrResult result = xrCreateReferenceSpace(session, &createInfo, &space);
+                if (result == XR_ERROR_LIMIT_REACHED) {
+                    break;
+                }
+                REQUIRE_RESULT(XR_SUCCESS, result);
+                spaces.push_back(space);
+            }
+            if (spaces.size() < objectCount) {
+                WARN("Runtime space limit reached at " << spaces.size() << " spaces");
+                break;
+            }
+
+            std::vector<std::string> names;
+            for (size_t i = previousCount; i < objectCount; ++i) {
+                names.push_back("Space " + std::to_string(i + 1));
+            }
+            std::vector<XrResult> nameResults(names.size(), XR_ERROR_RUNTIME_FAILURE);
+            XrDebugUtilsObjectNameInfoEXT nameInfo{XR_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT};
+            nameInfo.objectType = XR_OBJECT_TYPE_SPACE;
+
+            Stopwatch nameStopwatch(true);
+            for (size_t i = 0; i < names.size(); ++i) {
+                nameInfo.objectHandle = MakeHandleGeneric(spaces[previousCount + i]);
+                nameInfo.objectName = names[i].c_str();
+                nameResults[i] = pfn_set_obj_name(instance, &nameInfo);
+            }
+            const auto nameTime = nameStopwatch.Elapsed();
+            for (XrResult result : nameResults) {
+                REQUIRE_RESULT(XR_SUCCESS, result);
+            }
+
+            // Submit messages referring to random named objects, for which the loader looks up the names.
+            std::vector<uint64_t> messageHandles;
+            for (size_t i = 0; i < messageIterations; ++i) {
+                messageHandles.push_back(MakeHandleGeneric(spaces[randEngine.RandSizeT(0, spaces.size())]));
+            }
+            std::vector<XrResult> messageResults(messageIterations, XR_ERROR_RUNTIME_FAILURE);
+            XrDebugUtilsMessengerCallbackDataEXT callback_data{XR_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT};
+            callback_data.messageId = "Benchmark";
+            callback_data.functionName = "XR_EXT_debug_utils_Object_Name_Benchmark";
+            callback_data.message = "Benchmark";
+            XrDebugUtilsObjectNameInfoEXT object{XR_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT};
+            object.objectType = XR_OBJECT_TYPE_SPACE;
+            callback_data.objectCount = 1;
+            callback_data.objects = &object;
+
+            const uint64_t previousMessageCount = messageCount;
+            Stopwatch messageStopwatch(true);
+            for (size_t i = 0; i < messageIterations; ++i) {
+                object.objectHandle = messageHandles[i];
+                messageResults[i] = pfn_submit_dmsg(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT,
+                                                    XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT, &callback_data);
+            }
+            const auto messageTime = messageStopwatch.Elapsed();
+            for (XrResult result : messageResults) {
+                REQUIRE_RESULT(XR_SUCCESS, result);
+            }
+            REQUIRE(messageCount - previousMessageCount == messageIterations);
+
+            ReportF("%6zu named objects: %.0fns per object named, %.0fns per message", objectCount,
+                    double(nameTime.count()) / double(names.size()), double(messageTime.count()) / double(messageIterations));
+        }
+
+        // The spaces are destroyed along with the session.
+        REQUIRE_RESULT(XR_SUCCESS, pfn_destroy_debug_utils_messager_ext(debug_utils_messenger));
+    }
+
 }  // namespace Conformance
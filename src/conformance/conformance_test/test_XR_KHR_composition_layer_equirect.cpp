@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "RGBAImage.h"
+#include "asset_loader.h"
 #include "composition_utils.h"
 #include "conformance_framework.h"
 #include "conformance_utils.h"
@@ -293,6 +294,13 @@ namespace Conformance
         {
             INFO("Test condition description: " << testCase.description);
             std::string testTitle = SubtestTitle("Equirect layer", testCaseIdx, equirectTestCases);
+
+            // Decode the images while the session is being set up.
+            EquirectImageCache().Prefetch(testCase.imagePath);
+            if (testCase.exampleImagePath != nullptr) {
+                globalData.GetAssetLoader().LoadImage(testCase.exampleImagePath);
+            }
+
             CompositionHelper compositionHelper(testTitle.c_str(), {XR_KHR_COMPOSITION_LAYER_EQUIRECT_EXTENSION_NAME});
 
             std::ostringstream oss;
@@ -305,7 +313,7 @@ namespace Conformance
 
             const XrSpace space = compositionHelper.CreateReferenceSpace(testCase.spaceType);
 
-            std::shared_ptr<RGBAImage> image = EquirectImageCache().Load(testCase.imagePath);
+            std::shared_ptr<const RGBAImage> image = EquirectImageCache().Load(testCase.imagePath);
             int32_t imageWidth = image->width;
             int32_t imageHeight = image->height;
 
@@ -2,12 +2,17 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include "asset_loader.h"
 #include "composition_utils.h"
 #include "conformance_framework.h"
+#include "conformance_utils.h"
+#include "cts_tinygltf.h"
 #include "graphics_plugin.h"
+#include "report.h"
 
 #include "common/xr_linear.h"
 #include "gltf/GltfHelper.h"
+#include "pbr/PbrModel.h"
 #include "utilities/array_size.h"
 #include "utilities/throw_helpers.h"
 #include "utilities/types_and_constants.h"
@@ -16,12 +21,19 @@
 #include <catch2/catch_test_macros.hpp>
 #include <openxr/openxr.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <future>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -30,6 +42,216 @@ namespace Conformance
 {
     using namespace openxr::math_operators;
 
+    namespace
+    {
+        // Interleaved layout of the benchmark mesh: float3 position, float3 normal, float4 tangent,
+        // normalized ushort2 texcoord and normalized ubyte4 color.
+        constexpr size_t BenchmarkVertexStride = 48;
+
+        /// Builds a single-primitive glTF model with interleaved vertex attributes and 16 or 32-bit indices.
+        tinygltf::Model MakeDecodeBenchmarkModel(uint32_t vertexCount)
+        {
+            const bool shortIndices = vertexCount <= 65536;
+            const size_t indexSize = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+            const size_t indexCount = size_t(vertexCount) * 3;
+            const size_t vertexBytes = BenchmarkVertexStride * vertexCount;
+
+            tinygltf::Model model;
+            model.buffers.emplace_back();
+            std::vector<unsigned char>& data = model.buffers[0].data;
+            data.resize(vertexBytes + indexSize * indexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                unsigned char* vertex = data.data() + BenchmarkVertexStride * v;
+                const float floats[10] = {v * 0.001f, v * 0.002f, v * 0.003f, 0, 0, 1, 1, 0, 0, (v % 2) ? 1.0f : -1.0f};
+                memcpy(vertex, floats, sizeof(floats));
+                const uint16_t texCoord[2] = {uint16_t(v * 7), uint16_t(v * 13)};
+                memcpy(vertex + 40, texCoord, sizeof(texCoord));
+                const uint8_t color[4] = {uint8_t(v), uint8_t(v >> 8), uint8_t(v * 3), 255};
+                memcpy(vertex + 44, color, sizeof(color));
+            }
+            for (size_t i = 0; i < indexCount; ++i) {
+                const uint32_t index = uint32_t((i * 7919) % vertexCount);
+                if (shortIndices) {
+                    const uint16_t shortIndex = uint16_t(index);
+                    memcpy(data.data() + vertexBytes + i * indexSize, &shortIndex, indexSize);
+                }
+                else {
+                    memcpy(data.data() + vertexBytes + i * indexSize, &index, indexSize);
+                }
+            }
+
+            tinygltf::BufferView vertexView;
+            vertexView.buffer = 0;
+            vertexView.byteLength = vertexBytes;
+            vertexView.byteStride = BenchmarkVertexStride;
+            vertexView.target = TINYGLTF_TARGET_ARRAY_BUFFER;
+            model.bufferViews.push_back(vertexView);
+
+            tinygltf::BufferView indexView;
+            indexView.buffer = 0;
+            indexView.byteOffset = vertexBytes;
+            indexView.byteLength = indexSize * indexCount;
+            indexView.target = TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER;
+            model.bufferViews.push_back(indexView);
+
+            tinygltf::Primitive primitive;
+            primitive.mode = TINYGLTF_MODE_TRIANGLES;
+            auto addAccessor = [&](const char* attribute, int type, int componentType, bool normalized, size_t byteOffset) {
+                tinygltf::Accessor accessor;
+                accessor.bufferView = 0;
+                accessor.byteOffset = byteOffset;
+                accessor.count = vertexCount;
+                accessor.type = type;
+                accessor.componentType = componentType;
+                accessor.normalized = normalized;
+                primitive.attributes[attribute] = (int)model.accessors.size();
+                model.accessors.push_back(accessor);
+            };
+            addAccessor("POSITION", TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT, false, 0);
+            addAccessor("NORMAL", TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT, false, 12);
+            addAccessor("TANGENT", TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT, false, 24);
+            addAccessor("TEXCOORD_0", TINYGLTF_TYPE_VEC2, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, true, 40);
+            addAccessor("COLOR_0", TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, true, 44);
+
+            tinygltf::Accessor indexAccessor;
+            indexAccessor.bufferView = 1;
+            indexAccessor.count = indexCount;
+            indexAccessor.type = TINYGLTF_TYPE_SCALAR;
+            indexAccessor.componentType = shortIndices ? TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT : TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+            primitive.indices = (int)model.accessors.size();
+            model.accessors.push_back(indexAccessor);
+
+            model.meshes.emplace_back();
+            model.meshes[0].primitives.push_back(primitive);
+            return model;
+        }
+
+        /// Decodes the benchmark mesh one element and one component at a time, as GltfHelper used to.
+        GltfHelper::Primitive ReadDecodeBenchmarkPrimitivePerElement(const tinygltf::Model& model)
+        {
+            const tinygltf::Primitive& gltfPrimitive = model.meshes[0].primitives[0];
+            const unsigned char* vertices = model.buffers[0].data.data();
+            const size_t vertexCount = model.accessors[gltfPrimitive.attributes.at("POSITION")].count;
+
+            GltfHelper::Primitive primitive;
+            primitive.Vertices.resize(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                memcpy(&primitive.Vertices[v].Position, vertices + BenchmarkVertexStride * v, sizeof(XrVector3f));
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                memcpy(&primitive.Vertices[v].Normal, vertices + BenchmarkVertexStride * v + 12, sizeof(XrVector3f));
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                memcpy(&primitive.Vertices[v].Tangent, vertices + BenchmarkVertexStride * v + 24, sizeof(XrVector4f));
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                uint16_t texCoord[2];
+                memcpy(texCoord, vertices + BenchmarkVertexStride * v + 40, sizeof(texCoord));
+                primitive.Vertices[v].TexCoord0.x = texCoord[0] / (float)std::numeric_limits<uint16_t>::max();
+                primitive.Vertices[v].TexCoord0.y = texCoord[1] / (float)std::numeric_limits<uint16_t>::max();
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                const uint8_t* color = vertices + BenchmarkVertexStride * v + 44;
+                primitive.Vertices[v].Color0.r = color[0] / (float)std::numeric_limits<uint8_t>::max();
+                primitive.Vertices[v].Color0.g = color[1] / (float)std::numeric_limits<uint8_t>::max();
+                primitive.Vertices[v].Color0.b = color[2] / (float)std::numeric_limits<uint8_t>::max();
+                primitive.Vertices[v].Color0.a = color[3] / (float)std::numeric_limits<uint8_t>::max();
+            }
+
+            const tinygltf::Accessor& indexAccessor = model.accessors[gltfPrimitive.indices];
+            const unsigned char* indices = vertices + model.bufferViews[indexAccessor.bufferView].byteOffset;
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+                    uint16_t index;
+                    memcpy(&index, indices + i * sizeof(index), sizeof(index));
+                    primitive.Indices.push_back(index);
+                }
+                else {
+                    uint32_t index;
+                    memcpy(&index, indices + i * sizeof(index), sizeof(index));
+                    primitive.Indices.push_back(index);
+                }
+            }
+            return primitive;
+        }
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+
+        // Exposes the resolve step of a model instance without a graphics plugin.
+        class ResolveBenchmarkModelInstance : public Pbr::ModelInstance
+        {
+        public:
+            explicit ResolveBenchmarkModelInstance(std::shared_ptr<const Pbr::Model> model) : Pbr::ModelInstance(std::move(model))
+            {
+            }
+
+            const std::vector<XrMatrix4x4f>& Resolve(bool transpose)
+            {
+                ResolveTransformsAndVisibilities(transpose);
+                return GetResolvedTransforms();
+            }
+        };
+
+        // Resolves every node of the model one at a time with XrMatrix4x4f_Multiply, as ModelInstance used to.
+        void ResolveAllNodesScalar(const Pbr::Model& model, const std::vector<XrMatrix4x4f>& localTransforms, bool transpose,
+                                   std::vector<XrMatrix4x4f>& worldTransforms, std::vector<XrMatrix4x4f>& resolvedTransforms)
+        {
+            const auto& nodes = model.GetNodes();
+            for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+                const Pbr::NodeIndex_t parentNodeIndex = nodes[nodeIndex].GetParentNodeIndex();
+                if (parentNodeIndex == Pbr::Model::RootParentNodeIndex) {
+                    worldTransforms[nodeIndex] = localTransforms[nodeIndex];
+                }
+                else {
+                    XrMatrix4x4f_Multiply(&worldTransforms[nodeIndex], &worldTransforms[parentNodeIndex], &localTransforms[nodeIndex]);
+                }
+                if (transpose) {
+                    XrMatrix4x4f_Transpose(&resolvedTransforms[nodeIndex], &worldTransforms[nodeIndex]);
+                }
+                else {
+                    resolvedTransforms[nodeIndex] = worldTransforms[nodeIndex];
+                }
+            }
+        }
+
+        XrMatrix4x4f MakeResolveBenchmarkTransform(uint32_t seed, float angleInRadians)
+        {
+            const XrVector3f axis{0.48f, 0.6f, 0.64f};
+            XrQuaternionf rotation;
+            XrQuaternionf_CreateFromAxisAngle(&rotation, &axis, angleInRadians + 0.01f * (seed % 7));
+            const XrVector3f translation{0.01f * (seed % 5), 0.02f, -0.01f * (seed % 3)};
+            const XrVector3f scale{1.0f, 1.0f, 1.0f};
+            XrMatrix4x4f transform;
+            XrMatrix4x4f_CreateTranslationRotationScale(&transform, &translation, &rotation, &scale);
+            return transform;
+        }
+
+#if defined(__linux__)
+        /// Reads a memory field of /proc/self/status, such as "VmHWM", in bytes, or returns 0 if it is missing.
+        uint64_t ReadProcStatusBytes(const char* field)
+        {
+            const std::string prefix = std::string(field) + ":";
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while (std::getline(status, line)) {
+                if (line.compare(0, prefix.size(), prefix) == 0) {
+                    return std::stoull(line.substr(prefix.size())) * 1024;  // The kernel reports kB.
+                }
+            }
+            return 0;
+        }
+
+        /// Resets VmHWM to the current resident set size, so it tracks the peak of what runs next.
+        bool ResetPeakResidentSetSize()
+        {
+            std::ofstream clearRefs("/proc/self/clear_refs");
+            clearRefs << "5";
+            clearRefs.flush();
+            return clearRefs.good();
+        }
+#endif  // defined(__linux__)
+    }  // namespace
+
     TEST_CASE("glTFRendering", "[self_test][composition][interactive]")
     {
         GlobalData& globalData = GetGlobalData();
@@ -190,17 +412,15 @@ namespace Conformance
         std::vector<GLTFModelInstanceHandle> gltfModelInstances(gripSpaces.size(), GLTFModelInstanceHandle{});
 
         auto makeModelBuilder = [](const glTFTestCase& tCase) -> Gltf::ModelBuilder {
-            // Load the model file into memory
-            auto modelData = ReadFileBytes(tCase.filePath, "glTF binary");
-
-            // Load the model into an intermediate form
+            // Read the model file and load it into an intermediate form
             // This does parsing and tangent generation, which can take a while
-            return Gltf::ModelBuilder(LoadGLTF(modelData));
+            return Gltf::ModelBuilder(LoadGLTFFile(tCase.filePath));
         };
         auto setupTest = [&]() {
             std::fill(gltfModelInstances.begin(), gltfModelInstances.end(), GLTFModelInstanceHandle{});
 
-            makeModelBuilderTask = std::async(std::launch::async, makeModelBuilder, testCase);
+            makeModelBuilderTask =
+                GetGlobalData().GetAssetLoader().Run([testCase, makeModelBuilder] { return makeModelBuilder(testCase); });
 
             // Configure the interactive layer manager with the corresponding description and image
             std::ostringstream oss;
@@ -303,4 +523,235 @@ namespace Conformance
         };
         RenderLoop(session, updateLayers).Loop();
     }
+
+    // Compares GltfHelper's vertex and index decoding with a per-element reference decode of the same mesh.
+    TEST_CASE("glTF_Decode_Benchmark", "[.][benchmark]")
+    {
+        constexpr int iterationCount = 20;
+
+        for (uint32_t vertexCount : {65536u, 1048576u}) {
+            const tinygltf::Model model = MakeDecodeBenchmarkModel(vertexCount);
+            const tinygltf::Primitive& gltfPrimitive = model.meshes[0].primitives[0];
+
+            const GltfHelper::Primitive expected = ReadDecodeBenchmarkPrimitivePerElement(model);
+            const GltfHelper::Primitive decoded = GltfHelper::ReadPrimitive(model, gltfPrimitive);
+            REQUIRE(decoded.Vertices.size() == expected.Vertices.size());
+            REQUIRE(memcmp(decoded.Vertices.data(), expected.Vertices.data(), sizeof(GltfHelper::Vertex) * expected.Vertices.size()) == 0);
+            REQUIRE(decoded.Indices == expected.Indices);
+
+            std::vector<std::chrono::nanoseconds> perElementTimes;
+            std::vector<std::chrono::nanoseconds> helperTimes;
+            for (int i = 0; i < iterationCount; ++i) {
+                Stopwatch perElementStopwatch(true);
+                const GltfHelper::Primitive perElement = ReadDecodeBenchmarkPrimitivePerElement(model);
+                perElementTimes.push_back(perElementStopwatch.Elapsed());
+
+                Stopwatch helperStopwatch(true);
+                const GltfHelper::Primitive helper = GltfHelper::ReadPrimitive(model, gltfPrimitive);
+                helperTimes.push_back(helperStopwatch.Elapsed());
+            }
+
+            const double megabytes = model.buffers[0].data.size() / (1024.0 * 1024.0);
+            const double perElementMs = Milliseconds(Percentile(perElementTimes, 0.5)).count();
+            const double helperMs = Milliseconds(Percentile(helperTimes, 0.5)).count();
+            ReportF("%7u vertices (%.1f MB): per-element %.3fms (%.0f MB/s), GltfHelper %.3fms (%.0f MB/s), %.2fx", vertexCount, megabytes,
+                    perElementMs, megabytes * 1000 / perElementMs, helperMs, megabytes * 1000 / helperMs, perElementMs / helperMs);
+        }
+    }
+
+    // Compares reading the primitives of the gltf_examples models one at a time, the way Gltf::ModelBuilder used to, with reading them
+    // on worker threads through PrimitiveCache::ReadPrimitives, and times whole ModelBuilder constructions.
+    TEST_CASE("glTF_Model_Build_Benchmark", "[.][benchmark]")
+    {
+        constexpr int roundCount = 10;
+        const char* const modelFiles[] = {"VertexColorTest.glb",     "MetalRoughSpheres.glb",       "MetalRoughSpheresNoTextures.glb",
+                                          "NormalTangentTest.glb",   "NormalTangentMirrorTest.glb", "TextureSettingsTest.glb",
+                                          "AlphaBlendModeTest.glb",  "AnisotropyBarnLamp.glb"};
+
+        size_t modelsMeasured = 0;
+        for (const char* modelFile : modelFiles) {
+            std::shared_ptr<const tinygltf::Model> model;
+            try {
+                model = LoadGLTFFile(modelFile);
+            }
+            catch (const std::exception& e) {
+                // Without git-lfs, the models are only pointer files.
+                WARN("Cannot load " << modelFile << ": " << e.what());
+                continue;
+            }
+
+            std::vector<const tinygltf::Primitive*> gltfPrimitives;
+            for (const tinygltf::Mesh& mesh : model->meshes) {
+                for (const tinygltf::Primitive& gltfPrimitive : mesh.primitives) {
+                    gltfPrimitives.push_back(&gltfPrimitive);
+                }
+            }
+
+            std::vector<std::chrono::nanoseconds> serialTimes;
+            std::vector<std::chrono::nanoseconds> parallelTimes;
+            std::vector<std::chrono::nanoseconds> buildTimes;
+            for (int round = 0; round < roundCount; ++round) {
+                GltfHelper::PrimitiveCache serialCache{*model};
+                Stopwatch serialStopwatch(true);
+                for (const tinygltf::Primitive* gltfPrimitive : gltfPrimitives) {
+                    (void)serialCache.ReadPrimitive(*gltfPrimitive);
+                }
+                serialTimes.push_back(serialStopwatch.Elapsed());
+
+                GltfHelper::PrimitiveCache parallelCache{*model};
+                Stopwatch parallelStopwatch(true);
+                parallelCache.ReadPrimitives(gltfPrimitives);
+                parallelTimes.push_back(parallelStopwatch.Elapsed());
+
+                if (round == 0) {
+                    for (const tinygltf::Primitive* gltfPrimitive : gltfPrimitives) {
+                        const GltfHelper::Primitive& serial = serialCache.ReadPrimitive(*gltfPrimitive);
+                        const GltfHelper::Primitive& parallel = parallelCache.ReadPrimitive(*gltfPrimitive);
+                        REQUIRE(parallel.Vertices.size() == serial.Vertices.size());
+                        REQUIRE(memcmp(parallel.Vertices.data(), serial.Vertices.data(),
+                                       sizeof(GltfHelper::Vertex) * serial.Vertices.size()) == 0);
+                        REQUIRE(parallel.Indices == serial.Indices);
+                    }
+                }
+
+                Stopwatch buildStopwatch(true);
+                const Gltf::ModelBuilder modelBuilder(model);
+                buildTimes.push_back(buildStopwatch.Elapsed());
+            }
+
+            const double serialMs = Milliseconds(Percentile(serialTimes, 0.5)).count();
+            const double parallelMs = Milliseconds(Percentile(parallelTimes, 0.5)).count();
+            ReportF("%-31s %3zu primitives: serial %.3fms, parallel %.3fms (%.2fx), ModelBuilder %.3fms", modelFile, gltfPrimitives.size(),
+                    serialMs, parallelMs, parallelMs > 0 ? serialMs / parallelMs : 0.0, Milliseconds(Percentile(buildTimes, 0.5)).count());
+            ++modelsMeasured;
+        }
+        if (modelsMeasured == 0) {
+            SKIP("None of the gltf_examples models could be loaded");
+        }
+        ReportF("Primitives are read on up to %u threads", std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // Compares resolving a skeleton-like node tree after a few joints move with resolving every node, the way ModelInstance used to.
+    TEST_CASE("PbrModelInstance_Resolve_Benchmark", "[.][benchmark]")
+    {
+        constexpr uint32_t nodeCount = 4096;
+        constexpr int updateCount = 1000;
+        constexpr int roundCount = 9;
+
+        // A 4-ary tree, so the animated joints near the leaves have small subtrees.
+        auto model = std::make_shared<Pbr::Model>();
+        std::vector<XrMatrix4x4f> localTransforms{model->GetNode(Pbr::RootNodeIndex).GetLocalTransform()};
+        for (uint32_t i = 1; i < nodeCount; ++i) {
+            localTransforms.push_back(MakeResolveBenchmarkTransform(i, 0.0f));
+            model->AddNode(localTransforms.back(), (Pbr::NodeIndex_t)((i - 1) / 4), "node" + std::to_string(i));
+        }
+        const std::vector<Pbr::NodeIndex_t> animatedJoints{200, 300, 400, 500};
+
+        for (bool transpose : {false, true}) {
+            ResolveBenchmarkModelInstance instance(model);
+            std::vector<XrMatrix4x4f> worldTransforms(nodeCount);
+            std::vector<XrMatrix4x4f> expected(nodeCount);
+
+            // The incremental resolve must match a full scalar resolve bit for bit.
+            for (int update = 0; update < 3; ++update) {
+                for (Pbr::NodeIndex_t joint : animatedJoints) {
+                    localTransforms[joint] = MakeResolveBenchmarkTransform(joint, 0.1f * update);
+                    instance.SetNodeTransform(joint, localTransforms[joint]);
+                }
+                ResolveAllNodesScalar(*model, localTransforms, transpose, worldTransforms, expected);
+                const std::vector<XrMatrix4x4f>& resolved = instance.Resolve(transpose);
+                REQUIRE(resolved.size() == expected.size());
+                REQUIRE(memcmp(resolved.data(), expected.data(), sizeof(XrMatrix4x4f) * expected.size()) == 0);
+            }
+
+            std::vector<XrMatrix4x4f> scalarLocalTransforms = localTransforms;
+            std::vector<std::chrono::nanoseconds> scalarTimes;
+            std::vector<std::chrono::nanoseconds> fullTimes;
+            std::vector<std::chrono::nanoseconds> jointTimes;
+            for (int round = 0; round < roundCount; ++round) {
+                Stopwatch scalarStopwatch(true);
+                for (int update = 0; update < updateCount; ++update) {
+                    scalarLocalTransforms[Pbr::RootNodeIndex] = MakeResolveBenchmarkTransform(0, 0.001f * update);
+                    ResolveAllNodesScalar(*model, scalarLocalTransforms, transpose, worldTransforms, expected);
+                }
+                scalarTimes.push_back(scalarStopwatch.Elapsed());
+
+                // Moving the root dirties every node.
+                Stopwatch fullStopwatch(true);
+                for (int update = 0; update < updateCount; ++update) {
+                    instance.SetNodeTransform(Pbr::RootNodeIndex, MakeResolveBenchmarkTransform(0, 0.001f * update));
+                    instance.Resolve(transpose);
+                }
+                fullTimes.push_back(fullStopwatch.Elapsed());
+
+                Stopwatch jointStopwatch(true);
+                for (int update = 0; update < updateCount; ++update) {
+                    for (Pbr::NodeIndex_t joint : animatedJoints) {
+                        instance.SetNodeTransform(joint, MakeResolveBenchmarkTransform(joint, 0.001f * update));
+                    }
+                    instance.Resolve(transpose);
+                }
+                jointTimes.push_back(jointStopwatch.Elapsed());
+            }
+
+            // Round medians are in milliseconds per updateCount updates, so scale them to microseconds per update.
+            const double usPerUpdate = 1000.0 / updateCount;
+            const double scalarUs = Milliseconds(Percentile(scalarTimes, 0.5)).count() * usPerUpdate;
+            const double fullUs = Milliseconds(Percentile(fullTimes, 0.5)).count() * usPerUpdate;
+            const double jointUs = Milliseconds(Percentile(jointTimes, 0.5)).count() * usPerUpdate;
+            ReportF("%u nodes, transpose %d: scalar full resolve %.2fus, full resolve %.2fus (%.2fx), %zu animated joints %.2fus (%.1fx)",
+                    nodeCount, transpose ? 1 : 0, scalarUs, fullUs, scalarUs / fullUs, animatedJoints.size(), jointUs, scalarUs / jointUs);
+        }
+    }
+
+    // Measures how far loading a generated GLB raises the peak resident memory, relative to the size of the file.
+    TEST_CASE("glTF_Load_Peak_Memory_Benchmark", "[.][benchmark]")
+    {
+#if !defined(__linux__)
+        SKIP("Peak resident memory is only measured on Linux");
+#else
+        if (!ResetPeakResidentSetSize()) {
+            SKIP("Cannot reset the peak resident memory through /proc/self/clear_refs");
+        }
+
+        TempDirectory directory("glTF_Load_Peak_Memory_Benchmark_");
+        if (directory.path().empty()) {
+            SKIP("Cannot create a temporary directory for the GLB");
+        }
+        const std::string path = directory.path() + "/model.glb";
+
+        constexpr int roundCount = 3;
+        uint32_t vertexCount;
+        {
+            tinygltf::Model model = MakeDecodeBenchmarkModel(1048576);
+            vertexCount = (uint32_t)model.accessors[0].count;
+            std::ofstream file(path, std::ios::binary);
+            tinygltf::TinyGLTF writer;
+            REQUIRE(writer.WriteGltfSceneToStream(&model, file, false, true));
+        }
+        const uint64_t fileBytes = ReadFileBytes(path.c_str()).size();
+
+        // Each load includes decoding the primitive, so the peak covers everything a model builder holds at once.
+        std::vector<uint64_t> peaks;
+        std::vector<std::chrono::nanoseconds> times;
+        for (int round = 0; round < roundCount; ++round) {
+            REQUIRE(ResetPeakResidentSetSize());
+            const uint64_t baselineBytes = ReadProcStatusBytes("VmRSS");
+            Stopwatch stopwatch(true);
+            std::shared_ptr<const tinygltf::Model> model = LoadGLTFFile(path.c_str());
+            const GltfHelper::Primitive primitive = GltfHelper::ReadPrimitive(*model, model->meshes[0].primitives[0]);
+            times.push_back(stopwatch.Elapsed());
+            REQUIRE(primitive.Vertices.size() == vertexCount);
+            const uint64_t peakBytes = ReadProcStatusBytes("VmHWM");
+            peaks.push_back(peakBytes > baselineBytes ? peakBytes - baselineBytes : 0);
+        }
+        std::remove(path.c_str());
+
+        constexpr double bytesPerMegabyte = 1024.0 * 1024.0;
+        const double peakMb = Percentile(peaks, 0.5) / bytesPerMegabyte;
+        const double fileMb = fileBytes / bytesPerMegabyte;
+        ReportF("%u vertices: LoadGLTFFile + ReadPrimitive of a %.1f MB GLB, peak +%.1f MB (%.2fx the file) in %.3fms", vertexCount, fileMb,
+                peakMb, peakMb / fileMb, Milliseconds(Percentile(times, 0.5)).count());
+#endif  // !defined(__linux__)
+    }
 }  // namespace Conformance
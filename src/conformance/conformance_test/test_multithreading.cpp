@@ -17,6 +17,7 @@
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "graphics_plugin.h"
+#include "report.h"
 #include "swapchain_image_data.h"
 #include "utilities/throw_helpers.h"
 #include "utilities/utils.h"
@@ -284,6 +285,69 @@ namespace Conformance
         }
     }
 
+    // InitSessionEnvironment
+    //
+    // Begins a session with actions and spaces, attaches its action set and runs the session to the focused state.
+    void InitSessionEnvironment(ThreadTestEnvironment& env)
+    {
+        env.GetAutoBasicSession().Init(AutoBasicSession::beginSession | AutoBasicSession::createActions |
+                                       AutoBasicSession::createSpaces | AutoBasicSession::createSwapchains);
+
+        // AutoBasicSession does not add vibrations or attach action sets
+        {
+            XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
+            actionInfo.subactionPaths = env.GetAutoBasicSession().handSubactionArray.data();
+            actionInfo.countSubactionPaths = (uint32_t)env.GetAutoBasicSession().handSubactionArray.size();
+
+            actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
+            strcpy(actionInfo.actionName, "haptics");
+            strcpy(actionInfo.localizedActionName, "haptics");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.hapticsAction));
+
+            actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+            strcpy(actionInfo.actionName, "grip_pose");
+            strcpy(actionInfo.localizedActionName, "Grip pose");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.gripPoseAction));
+
+            // Ensure the actions are bound
+            XrPath interactionProfilePath = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/interaction_profiles/khr/simple_controller",
+                                                 &interactionProfilePath));
+            XrPath gripPathL = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/input/grip/pose", &gripPathL));
+            XrPath gripPathR = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/input/grip/pose", &gripPathR));
+            XrPath hapticPathL = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/output/haptic", &hapticPathL));
+            XrPath hapticPathR = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/output/haptic", &hapticPathR));
+            std::vector<XrActionSuggestedBinding> bindings{{env.gripPoseAction, gripPathL},
+                                                           {env.gripPoseAction, gripPathR},
+                                                           {env.hapticsAction, hapticPathL},
+                                                           {env.hapticsAction, hapticPathR}};
+            XrInteractionProfileSuggestedBinding suggestedBindings = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+            suggestedBindings.interactionProfile = interactionProfilePath;
+            suggestedBindings.suggestedBindings = (const XrActionSuggestedBinding*)bindings.data();
+            suggestedBindings.countSuggestedBindings = (uint32_t)bindings.size();
+            XRC_CHECK_THROW_XRCMD(xrSuggestInteractionProfileBindings(env.GetAutoBasicSession().GetInstance(), &suggestedBindings));
+
+            XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+            attachInfo.countActionSets = 1;
+            attachInfo.actionSets = &env.GetAutoBasicSession().actionSet;
+            XRC_CHECK_THROW_XRCMD(xrAttachSessionActionSets(env.GetAutoBasicSession(), &attachInfo));
+        }
+
+        // Get frames iterating to the point of app focused state. This will draw frames along the way.
+        FrameIterator frameIterator(&env.GetAutoBasicSession());
+        frameIterator.RunToSessionState(XR_SESSION_STATE_FOCUSED);
+
+        env.lastFrameTime = frameIterator.frameState.predictedDisplayTime;
+    }
+
     TEST_CASE("multithreading", "")
     {
         // As of May 2019, Catch2 documents that multithreaded tests must not access test primitives (e.g. REQUIRE)
@@ -332,62 +396,7 @@ namespace Conformance
         // Exercise session multithreading.
         {
             ThreadTestEnvironment env(invocationCount);
-            env.GetAutoBasicSession().Init(AutoBasicSession::beginSession | AutoBasicSession::createActions |
-                                           AutoBasicSession::createSpaces | AutoBasicSession::createSwapchains);
-
-            // AutoBasicSession does not add vibrations or attach action sets
-            {
-                XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
-                actionInfo.subactionPaths = env.GetAutoBasicSession().handSubactionArray.data();
-                actionInfo.countSubactionPaths = (uint32_t)env.GetAutoBasicSession().handSubactionArray.size();
-
-                actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
-                strcpy(actionInfo.actionName, "haptics");
-                strcpy(actionInfo.localizedActionName, "haptics");
-                XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.hapticsAction));
-
-                actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
-                strcpy(actionInfo.actionName, "grip_pose");
-                strcpy(actionInfo.localizedActionName, "Grip pose");
-                XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.gripPoseAction));
-
-                // Ensure the actions are bound
-                XrPath interactionProfilePath = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/interaction_profiles/khr/simple_controller",
-                                                     &interactionProfilePath));
-                XrPath gripPathL = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/input/grip/pose", &gripPathL));
-                XrPath gripPathR = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/input/grip/pose", &gripPathR));
-                XrPath hapticPathL = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/output/haptic", &hapticPathL));
-                XrPath hapticPathR = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/output/haptic", &hapticPathR));
-                std::vector<XrActionSuggestedBinding> bindings{{env.gripPoseAction, gripPathL},
-                                                               {env.gripPoseAction, gripPathR},
-                                                               {env.hapticsAction, hapticPathL},
-                                                               {env.hapticsAction, hapticPathR}};
-                XrInteractionProfileSuggestedBinding suggestedBindings = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
-                suggestedBindings.interactionProfile = interactionProfilePath;
-                suggestedBindings.suggestedBindings = (const XrActionSuggestedBinding*)bindings.data();
-                suggestedBindings.countSuggestedBindings = (uint32_t)bindings.size();
-                XRC_CHECK_THROW_XRCMD(xrSuggestInteractionProfileBindings(env.GetAutoBasicSession().GetInstance(), &suggestedBindings));
-
-                XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
-                attachInfo.countActionSets = 1;
-                attachInfo.actionSets = &env.GetAutoBasicSession().actionSet;
-                XRC_CHECK_THROW_XRCMD(xrAttachSessionActionSets(env.GetAutoBasicSession(), &attachInfo));
-            }
-
-            // Get frames iterating to the point of app focused state. This will draw frames along the way.
-            FrameIterator frameIterator(&env.GetAutoBasicSession());
-            frameIterator.RunToSessionState(XR_SESSION_STATE_FOCUSED);
-
-            env.lastFrameTime = frameIterator.frameState.predictedDisplayTime;
+            InitSessionEnvironment(env);
 
             GlobalData& globalData = GetGlobalData();
 
@@ -587,9 +596,8 @@ namespace Conformance
         XRC_CHECK_THROW_XRCMD(xrDestroySpace(space));
     }
 
-    void Exercise_xrLocateSpace(ThreadTestEnvironment& env)
+    void Exercise_xrLocateSpace(ThreadTestEnvironment& env, RandEngine& randEngine)
     {
-        RandEngine& randEngine = GetGlobalData().GetRandEngine();
         auto spaces = env.GetAutoBasicSession().spaceVector;
 
         const size_t iterationCount = 100;  // To do: Make this configurable.
@@ -603,6 +611,11 @@ namespace Conformance
         }
     }
 
+    void Exercise_xrLocateSpace(ThreadTestEnvironment& env)
+    {
+        Exercise_xrLocateSpace(env, GetGlobalData().GetRandEngine());
+    }
+
     void Exercise_xrDestroySpace(ThreadTestEnvironment& env)
     {
         return Exercise_xrCreateReferenceSpace(env);
@@ -879,10 +892,8 @@ namespace Conformance
         return Exercise_xrCreateAction(env);
     }
 
-    void Exercise_xrSyncActions(ThreadTestEnvironment& env)
+    void Exercise_xrSyncActions(ThreadTestEnvironment& env, RandEngine& randEngine)
     {
-        RandEngine& randEngine = GetGlobalData().GetRandEngine();
-
         // References to AutoBasicSession members.
         XrSession session = env.GetAutoBasicSession().GetSession();
         XrActionSet& actionSet = env.GetAutoBasicSession().actionSet;
@@ -1014,6 +1025,11 @@ namespace Conformance
         }
     }
 
+    void Exercise_xrSyncActions(ThreadTestEnvironment& env)
+    {
+        Exercise_xrSyncActions(env, GetGlobalData().GetRandEngine());
+    }
+
     void Exercise_xrSetInteractionProfileSuggestedBindings(ThreadTestEnvironment& env)
     {
         return Exercise_xrSyncActions(env);
@@ -1144,4 +1160,83 @@ namespace Conformance
         {"xrApplyHapticFeedback", CallRequirement::session, Exercise_xrApplyHapticFeedback},
         {"xrStopHapticFeedback", CallRequirement::session, Exercise_xrStopHapticFeedback}};
 
+    // ContentionThreadFunction
+    //
+    // Executes a single thread of the contention benchmark, alternating between locating spaces and
+    // syncing and reading actions, the calls a render thread and an input thread make every frame.
+    // Each thread draws from its own RandEngine so that the threads do not serialize on the global one.
+    void ContentionThreadFunction(ThreadTestEnvironment& env, uint64_t seed, std::vector<std::chrono::nanoseconds>& invocationTimes)
+    {
+        RandEngine randEngine(seed);
+        env.WaitToBegin();
+
+        for (uint32_t i = 0; i < env.InvocationCount(); ++i) {
+            try {
+                Stopwatch stopwatch(true);
+                if (i % 2 == 0) {
+                    Exercise_xrLocateSpace(env, randEngine);
+                }
+                else {
+                    Exercise_xrSyncActions(env, randEngine);
+                }
+                invocationTimes.push_back(stopwatch.Elapsed());
+            }
+            catch (const std::exception& ex) {
+                env.AppendError(ex.what());
+            }
+        }
+    }
+
+    // Measures how the calls made every frame scale with the number of threads making them concurrently.
+    TEST_CASE("multithreading_Contention_Benchmark", "[.][benchmark]")
+    {
+        const uint32_t invocationCount = 200;
+        double singleThreadRate = 0;
+
+        for (size_t threadCount : {1, 2, 4, 8}) {
+            ThreadTestEnvironment env(invocationCount);
+            InitSessionEnvironment(env);
+
+            GlobalData& globalData = GetGlobalData();
+
+            if (globalData.GetGraphicsPlugin()) {
+                globalData.GetGraphicsPlugin()->MakeCurrent(false);
+            }
+
+            std::vector<std::vector<std::chrono::nanoseconds>> invocationTimes(threadCount);
+            std::vector<std::thread>& threadVector = env.ThreadVector();
+
+            const uint64_t seed = globalData.GetRandEngine().GetSeed();
+            for (size_t i = 0; i < threadCount; ++i)
+                threadVector.emplace_back(std::thread(ContentionThreadFunction, std::ref(env), seed + i, std::ref(invocationTimes[i])));
+
+            Stopwatch stopwatch(true);
+            env.SignalBegin();
+
+            for (size_t i = 0; i < threadCount; ++i)
+                threadVector[i].join();
+
+            const double elapsedMs = std::chrono::duration<double, std::milli>(stopwatch.Elapsed()).count();
+
+            if (globalData.GetGraphicsPlugin()) {
+                globalData.GetGraphicsPlugin()->MakeCurrent(true);
+            }
+
+            REQUIRE_MSG(env.ErrorCount() == 0, env.OutputText())
+
+            std::vector<std::chrono::nanoseconds> allTimes;
+            for (auto& threadTimes : invocationTimes)
+                allTimes.insert(allTimes.end(), threadTimes.begin(), threadTimes.end());
+            using Milliseconds = std::chrono::duration<double, std::milli>;
+
+            // Each invocation makes 100 xrLocateSpace calls, or 100 xrSyncActions calls along with their action state queries.
+            const double rate = allTimes.size() / elapsedMs;
+            if (threadCount == 1) {
+                singleThreadRate = rate;
+            }
+            ReportF("%zu thread(s): %.1f invocations/ms (%.2fx one thread), invocation p50 %.3fms, p99 %.3fms", threadCount, rate,
+                    singleThreadRate > 0 ? rate / singleThreadRate : 0.0, Milliseconds(Percentile(allTimes, 0.5)).count(),
+                    Milliseconds(Percentile(allTimes, 0.99)).count());
+        }
+    }
 }  // namespace Conformance
@@ -16,18 +16,127 @@
 
 #include "conformance_framework.h"
 #include "conformance_utils.h"
+#include "environment.h"
+#include "platform_utils.hpp"  // for OPENXR_API_LAYER_PATH_ENV_VAR
+#include "report.h"
 #include "utilities/types_and_constants.h"
 #include "utilities/utils.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <openxr/openxr.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace Conformance
 {
+    namespace
+    {
+#if defined(XR_OS_LINUX) || defined(XR_OS_APPLE) || defined(XR_OS_WINDOWS)
+        /// A temporary directory of explicit API layer manifests, added to the loader's API layer search path for its lifetime.
+        /// The layers are never enabled, so their libraries do not need to exist.
+        class FakeApiLayerManifestTree
+        {
+        public:
+            explicit FakeApiLayerManifestTree(int layerCount)
+                : m_directory("xrCreateInstance_Benchmark_layers_"), m_previousSearchPath(PlatformUtilsGetEnv(OPENXR_API_LAYER_PATH_ENV_VAR))
+            {
+                if (m_directory.path().empty()) {
+                    return;
+                }
+#if defined(XR_OS_WINDOWS)
+                const char pathSeparator = ';';
+#else
+                const char pathSeparator = ':';
+#endif
+                for (int i = 0; i < layerCount; ++i) {
+                    const std::string name = "XR_APILAYER_BENCHMARK_fake_" + std::to_string(i);
+                    m_files.push_back(m_directory.path() + "/" + name + ".json");
+                    std::ofstream manifest(m_files.back());
+                    manifest << "{\n"
+                                "    \"file_format_version\": \"1.0.0\",\n"
+                                "    \"api_layer\": {\n"
+                                "        \"name\": \""
+                             << name
+                             << "\",\n"
+                                "        \"library_path\": \"XrApiLayer_benchmark_fake\",\n"
+                                "        \"api_version\": \"1.0\",\n"
+                                "        \"implementation_version\": \"1\",\n"
+                                "        \"description\": \"Fake API layer for the instance creation benchmark\"\n"
+                                "    }\n"
+                                "}\n";
+                }
+
+                std::string searchPath = m_directory.path();
+                if (!m_previousSearchPath.empty()) {
+                    searchPath = m_previousSearchPath + pathSeparator + searchPath;
+                }
+                SetEnv(OPENXR_API_LAYER_PATH_ENV_VAR, searchPath.c_str(), true);
+            }
+
+            ~FakeApiLayerManifestTree()
+            {
+                SetEnv(OPENXR_API_LAYER_PATH_ENV_VAR, m_previousSearchPath.c_str(), true);
+                for (const std::string& file : m_files) {
+                    std::remove(file.c_str());
+                }
+            }
+
+            /// False if the temporary directory could not be created, in which case the search path is unchanged.
+            bool IsValid() const
+            {
+                return !m_directory.path().empty();
+            }
+
+        private:
+            TempDirectory m_directory;
+            std::string m_previousSearchPath;
+            std::vector<std::string> m_files;
+        };
+#endif  // defined(XR_OS_LINUX) || defined(XR_OS_APPLE) || defined(XR_OS_WINDOWS)
+
+        /// Creates and destroys instanceCount instances in a row, reporting the time taken by xrCreateInstance.
+        void MeasureInstanceCreation(const char* label, int instanceCount)
+        {
+            GlobalData& globalData = GetGlobalData();
+
+            XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+            strcpy(createInfo.applicationInfo.applicationName, "conformance test");
+            createInfo.applicationInfo.applicationVersion = 1;
+            createInfo.applicationInfo.apiVersion = globalData.options.desiredApiVersionValue;
+            if (globalData.requiredPlatformInstanceCreateStruct) {
+                createInfo.next = globalData.requiredPlatformInstanceCreateStruct;
+            }
+            createInfo.enabledApiLayerCount = (uint32_t)globalData.enabledAPILayerNames.size();
+            createInfo.enabledApiLayerNames = globalData.enabledAPILayerNames.data();
+            auto enabledExtensions = StringVec(globalData.requiredPlatformInstanceExtensions);
+            createInfo.enabledExtensionCount = (uint32_t)enabledExtensions.size();
+            createInfo.enabledExtensionNames = enabledExtensions.data();
+
+            uint32_t layerCount = 0;
+            REQUIRE_RESULT(xrEnumerateApiLayerProperties(0, &layerCount, nullptr), XR_SUCCESS);
+
+            std::vector<std::chrono::nanoseconds> createTimes;
+            for (int i = 0; i < instanceCount; ++i) {
+                XrInstance instance = XR_NULL_HANDLE_CPP;
+                Stopwatch stopwatch(true);
+                REQUIRE_RESULT(xrCreateInstance(&createInfo, &instance), XR_SUCCESS);
+                createTimes.push_back(stopwatch.Elapsed());
+                REQUIRE_RESULT(xrDestroyInstance(instance), XR_SUCCESS);
+            }
+
+            using Milliseconds = std::chrono::duration<double, std::milli>;
+            ReportF("%s (%u API layers found): first %.3fms, p50 %.3fms, p99 %.3fms", label, layerCount,
+                    Milliseconds(createTimes.front()).count(), Milliseconds(Percentile(createTimes, 0.5)).count(),
+                    Milliseconds(Percentile(createTimes, 0.99)).count());
+        }
+    }  // namespace
 
     TEST_CASE("xrCreateInstance", "")
     {
@@ -295,4 +404,22 @@ namespace Conformance
         }
     }
 
+    // Measures xrCreateInstance as an application restarting its instance repeatedly sees it, with and without many API layer
+    // manifests for the loader to discover.
+    TEST_CASE("xrCreateInstance_Benchmark", "[.][benchmark]")
+    {
+        constexpr int instanceCount = 100;
+
+        MeasureInstanceCreation("Default search path", instanceCount);
+
+#if defined(XR_OS_LINUX) || defined(XR_OS_APPLE) || defined(XR_OS_WINDOWS)
+        for (int layerCount : {32, 256}) {
+            FakeApiLayerManifestTree tree(layerCount);
+            REQUIRE_MSG(tree.IsValid(), "Cannot create a temporary directory for the API layer manifests");
+            const std::string label = std::to_string(layerCount) + " fake API layer manifests";
+            MeasureInstanceCreation(label.c_str(), instanceCount);
+        }
+#endif  // defined(XR_OS_LINUX) || defined(XR_OS_APPLE) || defined(XR_OS_WINDOWS)
+    }
+
 }  // namespace Conformance
@@ -17,11 +17,14 @@
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "matchers.h"
+#include "report.h"
 #include "utilities/utils.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <openxr/openxr.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <initializer_list>
 #include <string>
@@ -31,6 +34,36 @@
 
 namespace Conformance
 {
+    namespace
+    {
+        /// Resolves every command of the registry once, returning how many were resolved.
+        size_t ResolveAllCommands(XrInstance instance, const FunctionInfoMap& functionInfoMap)
+        {
+            size_t resolved = 0;
+            for (auto& functionInfo : functionInfoMap) {
+                if (instance == XR_NULL_HANDLE && !functionInfo.second.nullInstanceOk) {
+                    continue;
+                }
+                PFN_xrVoidFunction f = nullptr;
+                if (XR_SUCCEEDED(xrGetInstanceProcAddr(instance, functionInfo.first.c_str(), &f)) && f != nullptr) {
+                    ++resolved;
+                }
+            }
+            return resolved;
+        }
+
+        void ReportResolveTimes(const char* label, const std::vector<std::chrono::nanoseconds>& passTimes, size_t commandsPerPass)
+        {
+            std::chrono::nanoseconds total{0};
+            for (auto passTime : passTimes) {
+                total += passTime;
+            }
+            const double nsPerCommand = commandsPerPass == 0 ? 0.0 : double(total.count()) / double(passTimes.size() * commandsPerPass);
+            using Microseconds = std::chrono::duration<double, std::micro>;
+            ReportF("%s: %zu commands, %.1fns per command, pass p50 %.2fus, p99 %.2fus", label, commandsPerPass, nsPerCommand,
+                    Microseconds(Percentile(passTimes, 0.5)).count(), Microseconds(Percentile(passTimes, 0.99)).count());
+        }
+    }  // namespace
 
     TEST_CASE("xrGetInstanceProcAddr", "")
     {
@@ -154,4 +187,49 @@ namespace Conformance
             }
         }
     }
+
+    // Measures the cost of resolving every command in the registry, as an application does after each instance creation.
+    TEST_CASE("xrGetInstanceProcAddr_Benchmark", "[.][benchmark]")
+    {
+        const FunctionInfoMap& functionInfoMap = GetFunctionInfoMap();
+        constexpr int passCount = 1000;
+        constexpr int instanceCount = 20;
+
+        {
+            std::vector<std::chrono::nanoseconds> passTimes;
+            size_t resolved = 0;
+            for (int pass = 0; pass < passCount; ++pass) {
+                Stopwatch stopwatch(true);
+                resolved = ResolveAllCommands(XR_NULL_HANDLE, functionInfoMap);
+                passTimes.push_back(stopwatch.Elapsed());
+            }
+            ReportResolveTimes("XR_NULL_HANDLE", passTimes, resolved);
+        }
+
+        {
+            AutoBasicInstance instance;
+            std::vector<std::chrono::nanoseconds> passTimes;
+            size_t resolved = 0;
+            for (int pass = 0; pass < passCount; ++pass) {
+                Stopwatch stopwatch(true);
+                resolved = ResolveAllCommands(instance, functionInfoMap);
+                passTimes.push_back(stopwatch.Elapsed());
+            }
+            REQUIRE(resolved > 0);
+            ReportResolveTimes("Instance", passTimes, resolved);
+        }
+
+        // A fresh instance each time, as on a device hot-plug or session restart.
+        {
+            std::vector<std::chrono::nanoseconds> passTimes;
+            size_t resolved = 0;
+            for (int pass = 0; pass < instanceCount; ++pass) {
+                AutoBasicInstance instance;
+                Stopwatch stopwatch(true);
+                resolved = ResolveAllCommands(instance, functionInfoMap);
+                passTimes.push_back(stopwatch.Elapsed());
+            }
+            ReportResolveTimes("New instance", passTimes, resolved);
+        }
+    }
 }  // namespace Conformance
@@ -3,8 +3,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "RGBAImage.h"
+#include "asset_loader.h"
 
 #include "utilities/colors.h"
+#include "utilities/lru_cache.h"
 #include "conformance_framework.h"
 #include "report.h"
 
@@ -27,11 +29,21 @@
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RGBAIMAGE_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RGBAIMAGE_USE_NEON
+#endif
+
 namespace
 {
     // Convert R32G32B32A_FLOAT to R8G8B8A8_UNORM.
@@ -93,16 +105,17 @@ namespace
             }
         }
 
+        /// Returns the glyph atlas for @p pixelHeight, baking it on first use. Atlases are shared by all images.
         static std::shared_ptr<const BakedFont> GetOrCreate(int pixelHeight)
         {
-            std::unordered_map<int, std::shared_ptr<BakedFont>> s_bakedFonts;
+            static std::mutex s_bakedFontsMutex;
+            static std::unordered_map<int, std::shared_ptr<const BakedFont>> s_bakedFonts;
+
+            std::lock_guard<std::mutex> lock(s_bakedFontsMutex);
             auto it = s_bakedFonts.find(pixelHeight);
             if (it == s_bakedFonts.end()) {
-                std::shared_ptr<BakedFont> font = std::make_shared<BakedFont>(pixelHeight);
-                s_bakedFonts.insert({pixelHeight, font});
-                return font;
+                it = s_bakedFonts.emplace(pixelHeight, std::make_shared<const BakedFont>(pixelHeight)).first;
             }
-
             return it->second;
         }
 
@@ -179,12 +192,45 @@ namespace Conformance
 
         return image;
     }
+}  // namespace Conformance
 
-    void RGBAImage::PutText(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color, WordWrap wordWrap)
+namespace
+{
+    /// One row of one glyph, already clipped to the destination rect and image.
+    struct GlyphRowSpan
+    {
+        size_t destOffset;
+        const uint8_t* coverage;
+        int32_t count;
+    };
+
+    /// Where each visible glyph row of a PutText call lands in the image.
+    /// Does not depend on the text color, which is only applied when blending.
+    struct TextRun
+    {
+        std::shared_ptr<const BakedFont> font;  // owns the memory the spans point into
+        std::vector<GlyphRowSpan> spans;
+    };
+
+    using TextRunKey = std::tuple<std::string, int /* pixelHeight */, int32_t /* rect x */, int32_t /* rect y */, int32_t /* rect width */,
+                                  int32_t /* rect height */, Conformance::WordWrap, int32_t /* image width */, int32_t /* image height */>;
+
+    /// Interactive tests draw the same descriptions over and over, so keep their layouts.
+    Conformance::LruCache<TextRunKey, std::shared_ptr<const TextRun>>& GetTextRunCache()
+    {
+        static Conformance::LruCache<TextRunKey, std::shared_ptr<const TextRun>> cache(16 * 1024 * 1024);
+        return cache;
+    }
+
+    std::shared_ptr<const TextRun> LayOutText(const XrRect2Di& rect, const char* text, int pixelHeight, Conformance::WordWrap wordWrap,
+                                              int32_t imageWidth, int32_t imageHeight)
     {
-        const std::shared_ptr<const BakedFont> font = BakedFont::GetOrCreate(pixelHeight);
-        if (!font)
-            return;
+        using Conformance::ReportConsoleOnlyF;
+        using Conformance::WordWrap;
+
+        auto run = std::make_shared<TextRun>();
+        run->font = BakedFont::GetOrCreate(pixelHeight);
+        const BakedFont* const font = run->font.get();
 
         float xadvance = (float)rect.offset.x;
         int yadvance =
@@ -192,7 +238,7 @@ namespace Conformance
 
         const char* const fullText = text;
 
-        // Loop through each character and copy over the chracters' glyphs.
+        // Loop through each character and record where the rows of its glyph go.
         for (; *text; text++) {
             if (*text == '\n') {
                 xadvance = (float)rect.offset.x;
@@ -240,38 +286,118 @@ namespace Conformance
                 }
             }
 
+            // Clip the glyph columns once, rather than every pixel.
+            const int glyphX = (int)std::lround(bakedChar.xoff + xadvance);
+            const int firstX = std::max({glyphX, 0, rect.offset.x});
+            const int endX = std::min({glyphX + characterWidth, imageWidth, rect.offset.x + rect.extent.width});
+
             // For each row of the glyph bitmap
-            for (int cy = 0; cy < characterHeight; cy++) {
+            for (int cy = 0; cy < characterHeight && firstX < endX; cy++) {
                 // Compute the destination row in the image.
                 const int destY = yadvance + cy + (int)bakedChar.yoff;
-                if (destY < 0 || destY >= height || destY < rect.offset.y || destY >= rect.offset.y + rect.extent.height) {
+                if (destY < 0 || destY >= imageHeight || destY < rect.offset.y || destY >= rect.offset.y + rect.extent.height) {
                     continue;  // Don't bother copying if out of bounds.
                 }
 
-                // Get a pointer to the src and dest row.
                 const uint8_t* const srcGlyphRow = font->GetBakedCharRow(bakedChar, cy);
-                RGBA8Color* const destImageRow = pixels.data() + (destY * width);
+                run->spans.push_back(GlyphRowSpan{(size_t)destY * imageWidth + firstX, srcGlyphRow + bakedChar.x0 + (firstX - glyphX),
+                                                  endX - firstX});
+            }
 
-                for (int cx = 0; cx < characterWidth; cx++) {
-                    const int destX = (int)std::lround(bakedChar.xoff + xadvance) + cx;
-                    if (destX < 0 || destX >= width || destX < rect.offset.x || destX >= rect.offset.x + rect.extent.width) {
-                        continue;  // Don't bother copying if out of bounds.
-                    }
+            xadvance += bakedChar.xadvance;
+        }
 
-                    // Glyphs are 0-255 intensity.
-                    const uint8_t srcGlyphPixel = srcGlyphRow[cx + bakedChar.x0];
+        return run;
+    }
 
-                    // Do blending (assuming premultiplication).
-                    RGBA8Color pixel = destImageRow[destX];
-                    pixel.Channels.R = (uint8_t)(srcGlyphPixel * color.r) + (pixel.Channels.R * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.G = (uint8_t)(srcGlyphPixel * color.g) + (pixel.Channels.G * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.B = (uint8_t)(srcGlyphPixel * color.b) + (pixel.Channels.B * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.A = (uint8_t)(srcGlyphPixel * color.a) + (pixel.Channels.A * (255 - srcGlyphPixel) / 255);
-                    destImageRow[destX] = pixel;
-                }
-            }
+    /// Blends a row of glyph coverage (0-255 intensity) over the destination, assuming premultiplication.
+    /// @p colorTerms holds the text color scaled by each coverage value.
+    void BlendGlyphRow(Conformance::RGBA8Color* dest, const uint8_t* coverage, int32_t count, const std::array<uint32_t, 256>& colorTerms)
+    {
+        int32_t i = 0;
+#if defined(RGBAIMAGE_USE_SSE2)
+        // dest * (255 - coverage) / 255 per channel, four pixels at a time. x / 255 == (x + 1 + (x >> 8)) >> 8 for x <= 255 * 255.
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+        for (; i + 4 <= count; i += 4) {
+            uint32_t coverage4;
+            std::memcpy(&coverage4, coverage + i, sizeof(coverage4));
+            __m128i spread = _mm_cvtsi32_si128((int)coverage4);
+            spread = _mm_unpacklo_epi8(spread, spread);
+            spread = _mm_unpacklo_epi16(spread, spread);                     // each coverage value in all four channels
+            const __m128i inverse = _mm_andnot_si128(spread, _mm_set1_epi8(-1));  // 255 - coverage
+
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi8(inverse, zero));
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi8(inverse, zero));
+            lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+
+            const __m128i terms = _mm_setr_epi32((int)colorTerms[coverage[i]], (int)colorTerms[coverage[i + 1]],
+                                                 (int)colorTerms[coverage[i + 2]], (int)colorTerms[coverage[i + 3]]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_add_epi8(_mm_packus_epi16(lo, hi), terms));
+        }
+#elif defined(RGBAIMAGE_USE_NEON)
+        // dest * (255 - coverage) / 255 per channel, four pixels at a time. x / 255 == (x + 1 + (x >> 8)) >> 8 for x <= 255 * 255.
+        const uint8x8_t spreadLo = {0, 0, 0, 0, 1, 1, 1, 1};
+        const uint8x8_t spreadHi = {2, 2, 2, 2, 3, 3, 3, 3};
+        const uint16x8_t one = vdupq_n_u16(1);
+        for (; i + 4 <= count; i += 4) {
+            uint32_t coverage4;
+            std::memcpy(&coverage4, coverage + i, sizeof(coverage4));
+            const uint8x8_t coverage8 = vreinterpret_u8_u32(vdup_n_u32(coverage4));
+
+            const uint8x16_t pixels = vld1q_u8(reinterpret_cast<const uint8_t*>(dest + i));
+            uint16x8_t lo = vmull_u8(vget_low_u8(pixels), vmvn_u8(vtbl1_u8(coverage8, spreadLo)));
+            uint16x8_t hi = vmull_u8(vget_high_u8(pixels), vmvn_u8(vtbl1_u8(coverage8, spreadHi)));
+            lo = vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8));
+            hi = vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8));
+
+            const uint32_t terms[4] = {colorTerms[coverage[i]], colorTerms[coverage[i + 1]], colorTerms[coverage[i + 2]],
+                                       colorTerms[coverage[i + 3]]};
+            const uint8x16_t blended = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+            vst1q_u8(reinterpret_cast<uint8_t*>(dest + i), vaddq_u8(blended, vreinterpretq_u8_u32(vld1q_u32(terms))));
+        }
+#endif
+        for (; i < count; i++) {
+            const uint8_t srcGlyphPixel = coverage[i];
+            Conformance::RGBA8Color pixel = dest[i];
+            Conformance::RGBA8Color term;
+            term.Pixel = colorTerms[srcGlyphPixel];
+            pixel.Channels.R = term.Channels.R + (pixel.Channels.R * (255 - srcGlyphPixel) / 255);
+            pixel.Channels.G = term.Channels.G + (pixel.Channels.G * (255 - srcGlyphPixel) / 255);
+            pixel.Channels.B = term.Channels.B + (pixel.Channels.B * (255 - srcGlyphPixel) / 255);
+            pixel.Channels.A = term.Channels.A + (pixel.Channels.A * (255 - srcGlyphPixel) / 255);
+            dest[i] = pixel;
+        }
+    }
+}  // namespace
 
-            xadvance += bakedChar.xadvance;
+namespace Conformance
+{
+    void RGBAImage::PutText(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color, WordWrap wordWrap)
+    {
+        const TextRunKey key{text,     pixelHeight, rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height,
+                             wordWrap, width,       height};
+        std::shared_ptr<const TextRun> run;
+        if (!GetTextRunCache().TryGet(key, run)) {
+            run = LayOutText(rect, text, pixelHeight, wordWrap, width, height);
+            GetTextRunCache().Insert(key, run, sizeof(TextRun) + run->spans.size() * sizeof(GlyphRowSpan) + std::get<0>(key).size());
+        }
+
+        // The color contribution for every coverage value, truncated as the per-channel blend always has been.
+        std::array<uint32_t, 256> colorTerms;
+        for (int srcGlyphPixel = 0; srcGlyphPixel < 256; ++srcGlyphPixel) {
+            RGBA8Color term;
+            term.Channels.R = (uint8_t)(srcGlyphPixel * color.r);
+            term.Channels.G = (uint8_t)(srcGlyphPixel * color.g);
+            term.Channels.B = (uint8_t)(srcGlyphPixel * color.b);
+            term.Channels.A = (uint8_t)(srcGlyphPixel * color.a);
+            colorTerms[srcGlyphPixel] = term.Pixel;
+        }
+
+        for (const GlyphRowSpan& span : run->spans) {
+            BlendGlyphRow(pixels.data() + span.destOffset, span.coverage, span.count, colorTerms);
         }
     }
 
@@ -320,10 +446,19 @@ namespace Conformance
 
     void RGBAImage::ConvertToSRGB()
     {
+        // There are only 256 possible inputs per channel, so evaluate ColorUtils::ToSRGB once for each.
+        static const std::array<uint8_t, 256> linearToSRGB = [] {
+            std::array<uint8_t, 256> table;
+            for (int value = 0; value < 256; ++value) {
+                table[value] = (uint8_t)(ColorUtils::ToSRGB((double)value / 255.0) * 255.0);
+            }
+            return table;
+        }();
+
         for (RGBA8Color& pixel : pixels) {
-            pixel.Channels.R = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.R / 255.0) * 255.0);
-            pixel.Channels.G = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.G / 255.0) * 255.0);
-            pixel.Channels.B = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.B / 255.0) * 255.0);
+            pixel.Channels.R = linearToSRGB[pixel.Channels.R];
+            pixel.Channels.G = linearToSRGB[pixel.Channels.G];
+            pixel.Channels.B = linearToSRGB[pixel.Channels.B];
         }
     }
 
@@ -340,7 +475,22 @@ namespace Conformance
         }
     }
 
-    std::shared_ptr<RGBAImage> RGBAImageCache::Load(const char* path)
+    void RGBAImageCache::Prefetch(const char* path)
+    {
+        if (!IsValid()) {
+            throw std::logic_error("RGBAImageCache accessed before initialization");
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(*m_cacheMutex);
+            if (m_imageCache.count(path) != 0) {
+                return;
+            }
+        }
+        GetGlobalData().GetAssetLoader().LoadImage(path);
+    }
+
+    std::shared_ptr<const RGBAImage> RGBAImageCache::Load(const char* path)
     {
         if (!IsValid()) {
             throw std::logic_error("RGBAImageCache accessed before initialization");
@@ -357,7 +507,10 @@ namespace Conformance
 
         ReportConsoleOnlyF("Loading and caching image: %s", path);
 
-        auto image = std::make_shared<RGBAImage>(RGBAImage::Load(path));
+        // Usually already prefetched, see Prefetch. This cache keeps the image from here on.
+        AssetLoader& assetLoader = GetGlobalData().GetAssetLoader();
+        std::shared_ptr<const RGBAImage> image = assetLoader.LoadImage(path).Get();
+        assetLoader.Release(path);
 
         std::lock_guard<std::mutex> guard(*m_cacheMutex);
         // If the key already exists then the existing image will be returned.
@@ -77,12 +77,16 @@ namespace Conformance
             return m_cacheMutex != nullptr;
         }
 
-        std::shared_ptr<RGBAImage> Load(const char* path);
+        /// Starts loading the image on the global asset loader, unless it is already cached.
+        void Prefetch(const char* path);
+
+        /// Returns the image, waiting for the global asset loader if it is not loaded yet.
+        std::shared_ptr<const RGBAImage> Load(const char* path);
 
     private:
         // in unique_ptr to make it moveable
         std::unique_ptr<std::mutex> m_cacheMutex;
-        std::map<std::string, std::shared_ptr<RGBAImage>> m_imageCache;
+        std::map<std::string, std::shared_ptr<const RGBAImage>> m_imageCache;
     };
 
     /// Copy a contiguous image into a buffer for GPU usage - with stride/pitch.
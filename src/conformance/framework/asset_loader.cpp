@@ -0,0 +1,131 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "asset_loader.h"
+
+#include "utilities/utils.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace Conformance
+{
+    AssetLoader::AssetLoader(uint32_t workerCount)
+    {
+        workerCount = std::max(workerCount, 1u);
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back(&AssetLoader::WorkerThread, this);
+        }
+    }
+
+    AssetLoader::~AssetLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_stopping = true;
+        }
+        m_queueCondition.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    uint32_t AssetLoader::DefaultWorkerCount()
+    {
+        // Loading is a mix of I/O and decoding, and should not compete much with the frame loop.
+        return std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, 4u);
+    }
+
+    AssetLoader::FileHandle AssetLoader::ReadFile(const std::string& path)
+    {
+        return Request<std::vector<uint8_t>>(m_fileRequests, path, [path] {
+            return std::make_shared<const std::vector<uint8_t>>(ReadFileBytes(path.c_str()));
+        });
+    }
+
+    AssetLoader::ImageHandle AssetLoader::LoadImage(const std::string& path)
+    {
+        return Request<RGBAImage>(m_imageRequests, path,
+                                  [path] { return std::make_shared<const RGBAImage>(RGBAImage::Load(path.c_str())); });
+    }
+
+    void AssetLoader::Release(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_requestsMutex);
+        m_fileRequests.erase(path);
+        m_imageRequests.erase(path);
+    }
+
+    AssetLoaderStats AssetLoader::GetStats() const
+    {
+        AssetLoaderStats stats;
+        stats.requests = m_stats->requests;
+        stats.blockedWaits = m_stats->blockedWaits;
+        stats.blockedTime = std::chrono::nanoseconds(m_stats->blockedNanoseconds);
+        return stats;
+    }
+
+    template <typename T>
+    AssetLoader::Handle<T> AssetLoader::Request(std::map<std::string, std::shared_future<std::shared_ptr<const T>>>& requests,
+                                                const std::string& path, std::function<std::shared_ptr<const T>()> load)
+    {
+        m_stats->requests++;
+
+        std::shared_future<std::shared_ptr<const T>> future;
+        {
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+            auto it = requests.find(path);
+            if (it != requests.end()) {
+                return Handle<T>(it->second, m_stats);
+            }
+
+            auto task = std::make_shared<std::packaged_task<std::shared_ptr<const T>()>>(std::move(load));
+            future = task->get_future().share();
+            requests.emplace(path, future);
+
+            Enqueue([task] { (*task)(); });
+        }
+        return Handle<T>(std::move(future), m_stats);
+    }
+
+    void AssetLoader::Enqueue(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_queue.emplace(std::move(job));
+        }
+        m_queueCondition.notify_one();
+    }
+
+    void AssetLoader::WorkerThread()
+    {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCondition.wait(lock, [&] { return m_stopping || !m_queue.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+                job = std::move(m_queue.front());
+                m_queue.pop();
+            }
+            // Exceptions are captured by the packaged_task and rethrown from Handle::Get.
+            job();
+        }
+    }
+
+    void PrefetchKnownAssets(AssetLoader& assetLoader)
+    {
+        // Keep in sync with the pbr_assets copied next to the conformance binaries.
+        // The composition images are far larger and only used by a few tests, which prefetch them themselves.
+        static const char* const PbrFiles[] = {"brdf_lut.png"};
+
+        for (const char* file : PbrFiles) {
+            assetLoader.ReadFile(file);
+        }
+    }
+}  // namespace Conformance
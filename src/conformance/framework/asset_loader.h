@@ -0,0 +1,162 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "RGBAImage.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Conformance
+{
+    /**
+     * @defgroup cts_assets Asset loading
+     * @ingroup cts_framework
+     */
+    ///@{
+
+    /// Counters describing how often callers had to wait for an asset that was still loading.
+    struct AssetLoaderStats
+    {
+        uint64_t requests{0};
+        uint64_t blockedWaits{0};
+        std::chrono::nanoseconds blockedTime{0};
+    };
+
+    /// Reads asset files and decodes images on a small pool of worker threads, so they can be requested
+    /// (or prefetched) well before the frame loop needs them. Results are kept by path until @ref Release,
+    /// so callers that keep the asset themselves should release it once they have it.
+    class AssetLoader
+    {
+        struct SharedStats
+        {
+            std::atomic<uint64_t> requests{0};
+            std::atomic<uint64_t> blockedWaits{0};
+            std::atomic<int64_t> blockedNanoseconds{0};
+        };
+
+    public:
+        /// An asset that may still be loading.
+        template <typename T>
+        class Handle
+        {
+        public:
+            Handle() = default;
+
+            bool IsValid() const noexcept
+            {
+                return m_future.valid();
+            }
+
+            /// Whether @ref Get would return without blocking.
+            bool IsReady() const
+            {
+                return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+            /// Returns the asset, blocking until it is loaded and counting the time spent blocked.
+            /// Rethrows the exception if loading failed.
+            std::shared_ptr<const T> Get() const
+            {
+                if (!IsReady()) {
+                    const auto start = std::chrono::steady_clock::now();
+                    m_future.wait();
+                    const auto blocked = std::chrono::steady_clock::now() - start;
+                    m_stats->blockedWaits++;
+                    m_stats->blockedNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(blocked).count();
+                }
+                return m_future.get();
+            }
+
+        private:
+            friend class AssetLoader;
+
+            Handle(std::shared_future<std::shared_ptr<const T>> future, std::shared_ptr<SharedStats> stats)
+                : m_future(std::move(future)), m_stats(std::move(stats))
+            {
+            }
+
+            std::shared_future<std::shared_ptr<const T>> m_future;
+            std::shared_ptr<SharedStats> m_stats;
+        };
+
+        using FileHandle = Handle<std::vector<uint8_t>>;
+        using ImageHandle = Handle<RGBAImage>;
+
+        /// @param workerCount number of loading threads, at least 1.
+        explicit AssetLoader(uint32_t workerCount = DefaultWorkerCount());
+
+        /// Waits for loads in progress; any not yet started are abandoned.
+        ~AssetLoader();
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        /// Starts reading a file (or Android asset) unless it was already requested.
+        FileHandle ReadFile(const std::string& path);
+
+        /// Starts loading and decoding an image as with @ref RGBAImage::Load, unless it was already requested.
+        ImageHandle LoadImage(const std::string& path);
+
+        /// Forgets the file and image loaded from @p path, so the loader no longer keeps them alive.
+        /// Outstanding handles still complete; a later request loads the asset again.
+        void Release(const std::string& path);
+
+        /// Runs @p work on a loading thread, for other slow preparation such as parsing models.
+        /// Unlike file and image requests, the result is not shared or kept by the loader.
+        template <typename TWork>
+        auto Run(TWork&& work) -> std::future<decltype(work())>
+        {
+            using Result = decltype(work());
+            // std::function needs a copyable target, and packaged_task is move-only.
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<TWork>(work));
+            std::future<Result> future = task->get_future();
+            Enqueue([task] { (*task)(); });
+            return future;
+        }
+
+        AssetLoaderStats GetStats() const;
+
+        static uint32_t DefaultWorkerCount();
+
+    private:
+        template <typename T>
+        Handle<T> Request(std::map<std::string, std::shared_future<std::shared_ptr<const T>>>& requests, const std::string& path,
+                          std::function<std::shared_ptr<const T>()> load);
+
+        void Enqueue(std::function<void()> job);
+
+        void WorkerThread();
+
+        std::shared_ptr<SharedStats> m_stats = std::make_shared<SharedStats>();
+
+        std::mutex m_requestsMutex;
+        std::map<std::string, std::shared_future<std::shared_ptr<const std::vector<uint8_t>>>> m_fileRequests;
+        std::map<std::string, std::shared_future<std::shared_ptr<const RGBAImage>>> m_imageRequests;
+
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCondition;
+        std::queue<std::function<void()>> m_queue;
+        bool m_stopping{false};
+        std::vector<std::thread> m_workers;
+    };
+
+    /// Starts loading the assets that every graphics plugin needs, so they are ready by the time
+    /// the first session initializes the plugin. Tests prefetch the larger assets that only they use.
+    void PrefetchKnownAssets(AssetLoader& assetLoader);
+
+    ///@}
+}  // namespace Conformance
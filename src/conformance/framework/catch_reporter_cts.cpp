@@ -227,6 +227,7 @@ namespace Catch
                 xml.writeAttribute("name"_sr, name);
             }
             xml.writeAttribute("time"_sr, formatDuration(sectionNode.stats.durationInSeconds));
+            writeSectionTiming(name);
             // This is not ideal, but it should be enough to mimic gtest's
             // junit output.
             // Ideally the JUnit reporter would also handle `skipTest`
@@ -251,6 +252,23 @@ namespace Catch
                 writeSection(className, name, *childNode, testOkToFail);
     }
 
+    void CTSReporter::writeSectionTiming(std::string const& sectionPath)
+    {
+        // Catch2 only reports the time of the last run of a section; these cover all of its runs.
+        const Conformance::GlobalData& globalData = Conformance::GetGlobalData();
+        const auto& sectionTimings = globalData.GetConformanceReport().sectionTimings;
+        auto it = sectionTimings.find(sectionPath);
+        if (it == sectionTimings.end()) {
+            return;
+        }
+        const Conformance::ConformanceReport::Timing& timing = it->second;
+        xml.writeAttribute("cts:totalTime"_sr, formatDuration(std::chrono::duration<double>(timing.duration).count()));
+        if (globalData.getRuntimeCallStatistics != nullptr) {
+            xml.writeAttribute("cts:xrCallCount"_sr, timing.runtimeCallCount);
+            xml.writeAttribute("cts:xrCallTime"_sr, std::chrono::duration<double>(timing.runtimeCallTime).count());
+        }
+    }
+
     void CTSReporter::writeAssertions(SectionNode const& sectionNode)
     {
         for (auto const& assertionOrBenchmark : sectionNode.assertionsAndBenchmarks) {
@@ -50,6 +50,9 @@ namespace Catch
 
         void writeSection(std::string const& className, std::string const& rootName, SectionNode const& sectionNode, bool testOkToFail);
 
+        /// Writes the cumulative time and OpenXR call totals recorded for a section, if any.
+        void writeSectionTiming(std::string const& sectionPath);
+
         void writeAssertions(SectionNode const& sectionNode);
         void writeAssertion(AssertionStats const& stats);
 
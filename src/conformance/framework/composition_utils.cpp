@@ -339,7 +339,10 @@ namespace Conformance
 
     void CompositionHelper::EndFrame(XrTime predictedDisplayTime, std::vector<XrCompositionLayerBaseHeader*> layers)
     {
-        layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&m_testNameQuad));
+        // Without a graphics plugin there is no swapchain to show the test name in, and a layer without one is invalid.
+        if (m_testNameQuad.subImage.swapchain != XR_NULL_HANDLE) {
+            layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&m_testNameQuad));
+        }
 
         XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
         frameEndInfo.environmentBlendMode = GetGlobalData().GetOptions().environmentBlendModeValue;
@@ -611,12 +614,32 @@ namespace Conformance
         return &m_projections.back();
     }
 
-    BaseProjectionLayerHelper::BaseProjectionLayerHelper(CompositionHelper& compositionHelper, XrReferenceSpaceType spaceType)
+    BaseProjectionLayerHelper::BaseProjectionLayerHelper(CompositionHelper& compositionHelper, XrReferenceSpaceType spaceType,
+                                                         bool singleArraySwapchain)
         : m_compositionHelper(compositionHelper), m_localSpace(compositionHelper.CreateReferenceSpace(spaceType, Pose::Identity))
     {
         const std::vector<XrViewConfigurationView> viewProperties = compositionHelper.EnumerateConfigurationViews();
 
         m_projLayer = compositionHelper.CreateProjectionLayer(m_localSpace);
+
+        // Slices of an array swapchain all have the same size, so views can only share one if their recommended sizes match.
+        const bool sameRecommendedSize =
+            std::all_of(viewProperties.begin(), viewProperties.end(), [&](const XrViewConfigurationView& viewProperty) {
+                return viewProperty.recommendedImageRectWidth == viewProperties[0].recommendedImageRectWidth &&
+                       viewProperty.recommendedImageRectHeight == viewProperties[0].recommendedImageRectHeight;
+            });
+        if (singleArraySwapchain && m_projLayer->viewCount > 1 && sameRecommendedSize) {
+            XrSwapchainCreateInfo createInfo = compositionHelper.DefaultColorSwapchainCreateInfo(
+                viewProperties[0].recommendedImageRectWidth, viewProperties[0].recommendedImageRectHeight);
+            createInfo.arraySize = m_projLayer->viewCount;
+            const XrSwapchain swapchain = compositionHelper.CreateSwapchain(createInfo);
+            for (uint32_t j = 0; j < m_projLayer->viewCount; j++) {
+                const_cast<XrSwapchainSubImage&>(m_projLayer->views[j].subImage) = compositionHelper.MakeDefaultSubImage(swapchain, j);
+            }
+            m_swapchains.push_back(swapchain);
+            return;
+        }
+
         for (uint32_t j = 0; j < m_projLayer->viewCount; j++) {
             const XrSwapchain swapchain = compositionHelper.CreateSwapchain(compositionHelper.DefaultColorSwapchainCreateInfo(
                 viewProperties[j].recommendedImageRectWidth, viewProperties[j].recommendedImageRectHeight));
@@ -628,30 +651,89 @@ namespace Conformance
     // out of line to provide key function
     BaseProjectionLayerHelper::ViewRenderer::~ViewRenderer() = default;
 
+    // out of line to provide key function
+    BaseProjectionLayerHelper::MultiviewRenderer::~MultiviewRenderer() = default;
+
+    bool BaseProjectionLayerHelper::TryLocateViews(const XrFrameState& frameState, XrViewState& viewState, std::vector<XrView>& views)
+    {
+        auto viewData = m_compositionHelper.LocateViews(m_localSpace, frameState.predictedDisplayTime);
+        viewState = std::get<XrViewState>(viewData);
+
+        const XrViewStateFlags requiredFlags = XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT;
+        if ((viewState.viewStateFlags & requiredFlags) != requiredFlags) {
+            return false;
+        }
+
+        views = std::move(std::get<std::vector<XrView>>(viewData));
+        for (uint32_t viewIndex = 0; viewIndex < GetViewCount(); viewIndex++) {
+            auto& projectionView = const_cast<XrCompositionLayerProjectionView&>(m_projLayer->views[viewIndex]);
+            projectionView.fov = views[viewIndex].fov;
+            projectionView.pose = views[viewIndex].pose;
+        }
+        return true;
+    }
+
     XrCompositionLayerBaseHeader* BaseProjectionLayerHelper::TryGetUpdatedProjectionLayer(const XrFrameState& frameState,
                                                                                           ViewRenderer& renderer)
     {
-        auto viewData = m_compositionHelper.LocateViews(m_localSpace, frameState.predictedDisplayTime);
-        const auto& viewState = std::get<XrViewState>(viewData);
+        XrViewState viewState;
+        std::vector<XrView> views;
+        if (!TryLocateViews(frameState, viewState, views)) {
+            // Cannot use the projection layer because the swapchains it uses may not have ever been acquired and released.
+            return nullptr;
+        }
 
-        if (viewState.viewStateFlags & XR_VIEW_STATE_POSITION_VALID_BIT && viewState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT) {
-            const auto& views = std::get<std::vector<XrView>>(viewData);
+        auto renderView = [&](uint32_t viewIndex, const XrSwapchainImageBaseHeader* swapchainImage) {
+            auto& projectionView = const_cast<XrCompositionLayerProjectionView&>(m_projLayer->views[viewIndex]);
+            renderer.RenderView(*this, viewIndex, viewState, views[viewIndex], projectionView, swapchainImage);
+        };
 
+        if (UsesSingleArraySwapchain()) {
+            // Render every view into its slice of the one array swapchain image.
+            m_compositionHelper.AcquireWaitReleaseImage(m_swapchains[0], [&](const XrSwapchainImageBaseHeader* swapchainImage) {
+                for (uint32_t viewIndex = 0; viewIndex < GetViewCount(); viewIndex++) {
+                    renderView(viewIndex, swapchainImage);
+                }
+            });
+        }
+        else {
             // Render into each view swapchain using the recommended view fov and pose.
             for (uint32_t viewIndex = 0; viewIndex < GetViewCount(); viewIndex++) {
                 m_compositionHelper.AcquireWaitReleaseImage(m_swapchains[viewIndex], [&](const XrSwapchainImageBaseHeader* swapchainImage) {
-                    auto& projectionView = const_cast<XrCompositionLayerProjectionView&>(m_projLayer->views[viewIndex]);
-                    auto& view = views[viewIndex];
-                    projectionView.fov = view.fov;
-                    projectionView.pose = view.pose;
-                    renderer.RenderView(*this, viewIndex, viewState, view, projectionView, swapchainImage);
+                    renderView(viewIndex, swapchainImage);
                 });
             }
+        }
 
-            return reinterpret_cast<XrCompositionLayerBaseHeader*>(m_projLayer);
+        return reinterpret_cast<XrCompositionLayerBaseHeader*>(m_projLayer);
+    }
+
+    XrCompositionLayerBaseHeader* BaseProjectionLayerHelper::TryGetUpdatedProjectionLayer(const XrFrameState& frameState,
+                                                                                          MultiviewRenderer& renderer)
+    {
+        XrViewState viewState;
+        std::vector<XrView> views;
+        if (!TryLocateViews(frameState, viewState, views)) {
+            // Cannot use the projection layer because the swapchains it uses may not have ever been acquired and released.
+            return nullptr;
         }
-        // Cannot use the projection layer because the swapchains it uses may not have ever been acquired and released.
-        return nullptr;
+
+        auto projectionViews = const_cast<XrCompositionLayerProjectionView*>(m_projLayer->views);
+        if (UsesSingleArraySwapchain()) {
+            // One acquire for all the views, so the graphics plugin can draw them in a single pass.
+            m_compositionHelper.AcquireWaitReleaseImage(m_swapchains[0], [&](const XrSwapchainImageBaseHeader* swapchainImage) {
+                renderer.RenderViews(*this, viewState, {views.data(), views.size()}, {projectionViews, GetViewCount()}, swapchainImage);
+            });
+        }
+        else {
+            for (uint32_t viewIndex = 0; viewIndex < GetViewCount(); viewIndex++) {
+                m_compositionHelper.AcquireWaitReleaseImage(m_swapchains[viewIndex], [&](const XrSwapchainImageBaseHeader* swapchainImage) {
+                    renderer.RenderViews(*this, viewState, {&views[viewIndex], 1}, {&projectionViews[viewIndex], 1}, swapchainImage);
+                });
+            }
+        }
+
+        return reinterpret_cast<XrCompositionLayerBaseHeader*>(m_projLayer);
     }
 
 }  // namespace Conformance
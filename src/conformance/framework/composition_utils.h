@@ -17,6 +17,7 @@
 #pragma once
 
 #include "RGBAImage.h"
+#include "asset_loader.h"
 #include "utilities/colors.h"
 #include "common/xr_linear.h"
 #include "utilities/xr_math_operators.h"
@@ -288,12 +289,15 @@ namespace Conformance
         XrCompositionLayerQuad m_testNameQuad{XR_TYPE_COMPOSITION_LAYER_QUAD};
     };
 
-    /// Helper class to provide projection layer rendering. Each view of the projection is a separate swapchain.
+    /// Helper class to provide projection layer rendering. By default each view of the projection is a separate swapchain.
     /// Typically wrapped by another utility providing an implementation of @ref BaseProjectionLayerHelper::ViewRenderer
+    /// or @ref BaseProjectionLayerHelper::MultiviewRenderer
     class BaseProjectionLayerHelper
     {
     public:
-        BaseProjectionLayerHelper(CompositionHelper& compositionHelper, XrReferenceSpaceType spaceType);
+        /// If @p singleArraySwapchain is set and all views share the same recommended size, the views are instead
+        /// the consecutive slices of one array swapchain, which allows single-pass multiview rendering.
+        BaseProjectionLayerHelper(CompositionHelper& compositionHelper, XrReferenceSpaceType spaceType, bool singleArraySwapchain = false);
 
         class ViewRenderer
         {
@@ -310,10 +314,30 @@ namespace Conformance
                                     const XrSwapchainImageBaseHeader* swapchainImage) = 0;
         };
 
+        class MultiviewRenderer
+        {
+        public:
+            virtual ~MultiviewRenderer();
+            /// Called once per acquired swapchain image with every view that image holds:
+            /// all of them when using a single array swapchain, otherwise one at a time.
+            /// Usually must call @ref IGraphicsPlugin::ClearImageSlice for each projection view's array index,
+            /// then IGraphicsPlugin::RenderMultiview with @p projectionViews , @p swapchainImage ,
+            /// and the geometry to draw.
+            /// Projection view pose/fov fields are preset to match the corresponding view fields.
+            /// Views are located relative to GetLocalSpace()
+            virtual void RenderViews(const BaseProjectionLayerHelper& projectionLayerHelper, const XrViewState& viewState,
+                                     span<const XrView> views, span<XrCompositionLayerProjectionView> projectionViews,
+                                     const XrSwapchainImageBaseHeader* swapchainImage) = 0;
+        };
+
         /// Gets view state/location, then for each view, calls your ViewRenderer from within
         /// CompositionHelper::AcquireWaitReleaseImage after clearing the image slice for you.
         XrCompositionLayerBaseHeader* TryGetUpdatedProjectionLayer(const XrFrameState& frameState, ViewRenderer& renderer);
 
+        /// Gets view state/location, then for each swapchain, calls your MultiviewRenderer from within
+        /// CompositionHelper::AcquireWaitReleaseImage with the views it holds.
+        XrCompositionLayerBaseHeader* TryGetUpdatedProjectionLayer(const XrFrameState& frameState, MultiviewRenderer& renderer);
+
         XrSpace GetLocalSpace() const
         {
             return m_localSpace;
@@ -324,18 +348,31 @@ namespace Conformance
             return m_projLayer->viewCount;
         }
 
+        /// True if the views are slices of a single array swapchain.
+        bool UsesSingleArraySwapchain() const
+        {
+            return m_swapchains.size() == 1 && GetViewCount() > 1;
+        }
+
     private:
+        /// Locate the views and, if they are valid, copy their fov and pose into the projection views.
+        bool TryLocateViews(const XrFrameState& frameState, XrViewState& viewState, std::vector<XrView>& views);
+
         CompositionHelper& m_compositionHelper;
         XrSpace m_localSpace;
         XrCompositionLayerProjection* m_projLayer;
         std::vector<XrSwapchain> m_swapchains;
     };
 
-    /// Helper class to provide simple world-locked projection layer of some cubes. Each view of the projection is a separate swapchain.
+    /// Helper class to provide simple world-locked projection layer of some cubes. Each view of the projection is a separate swapchain,
+    /// unless @p singlePassMultiview is set, in which case the views share an array swapchain where possible and are drawn
+    /// with IGraphicsPlugin::RenderMultiview.
     class SimpleProjectionLayerHelper
     {
     public:
-        SimpleProjectionLayerHelper(CompositionHelper& compositionHelper) : m_baseHelper(compositionHelper, XR_REFERENCE_SPACE_TYPE_LOCAL)
+        SimpleProjectionLayerHelper(CompositionHelper& compositionHelper, bool singlePassMultiview = false)
+            : m_baseHelper(compositionHelper, XR_REFERENCE_SPACE_TYPE_LOCAL, singlePassMultiview)
+            , m_singlePassMultiview(singlePassMultiview)
         {
         }
 
@@ -344,6 +381,10 @@ namespace Conformance
                                                                        Cube::Make({-1, 0, -2}), Cube::Make({1, 0, -2}),
                                                                        Cube::Make({0, -1, -2}), Cube::Make({0, 1, -2})})
         {
+            if (m_singlePassMultiview) {
+                MultiviewRenderer renderer(cubes);
+                return m_baseHelper.TryGetUpdatedProjectionLayer(frameState, renderer);
+            }
             ViewRenderer renderer(cubes);
             return m_baseHelper.TryGetUpdatedProjectionLayer(frameState, renderer);
         }
@@ -374,6 +415,30 @@ namespace Conformance
         private:
             const std::vector<Cube>& m_cubes;
         };
+
+        class MultiviewRenderer : public BaseProjectionLayerHelper::MultiviewRenderer
+        {
+        public:
+            MultiviewRenderer(const std::vector<Cube>& cubes) : m_cubes(cubes)
+            {
+            }
+
+            ~MultiviewRenderer() override = default;
+            void RenderViews(const BaseProjectionLayerHelper& /* projectionLayerHelper */, const XrViewState& /* viewState */,
+                             span<const XrView> /* views */, span<XrCompositionLayerProjectionView> projectionViews,
+                             const XrSwapchainImageBaseHeader* swapchainImage) override
+            {
+                for (const XrCompositionLayerProjectionView& projectionView : projectionViews) {
+                    GetGlobalData().graphicsPlugin->ClearImageSlice(swapchainImage, projectionView.subImage.imageArrayIndex);
+                }
+                GetGlobalData().graphicsPlugin->RenderMultiview(projectionViews, swapchainImage, RenderParams{}.Draw(m_cubes));
+            }
+
+        private:
+            const std::vector<Cube>& m_cubes;
+        };
+
+        bool m_singlePassMultiview;
     };
 
     const XrVector3f UpVector{0, 1, 0};
@@ -462,7 +527,11 @@ namespace Conformance
             {
                 XrSwapchain exampleSwapchain;
                 if (exampleImage) {
-                    exampleSwapchain = m_compositionHelper.CreateStaticSwapchainImage(RGBAImage::Load(exampleImage));
+                    // Tests may have prefetched it; the swapchain is the only copy needed afterwards.
+                    AssetLoader& assetLoader = GetGlobalData().GetAssetLoader();
+                    std::shared_ptr<const RGBAImage> image = assetLoader.LoadImage(exampleImage).Get();
+                    assetLoader.Release(exampleImage);
+                    exampleSwapchain = m_compositionHelper.CreateStaticSwapchainImage(*image);
                 }
                 else {
                     RGBAImage image(256, 256);
@@ -15,9 +15,11 @@
 // limitations under the License.
 
 #include "conformance_framework.h"
+#include "asset_loader.h"
 
 #include "composition_utils.h"  // for Colors
 #include "graphics_plugin.h"
+#include "gltf/GltfHelper.h"
 #include "interaction_info.h"
 #include "platform_plugin.h"
 #include "report.h"
@@ -37,6 +39,10 @@
 #include <unordered_map>
 #include <utility>
 
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
 namespace Conformance
 {
 
@@ -49,6 +55,23 @@ namespace Conformance
 
     static constexpr auto kGetSystemPollingTimeout = std::chrono::seconds(10);
 
+    /// Keeps the library containing @p address loaded until the process exits, even once the loader has released it.
+    static bool PinLibraryContaining(const void* address)
+    {
+#if defined(_WIN32)
+        HMODULE module = nullptr;
+        return GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                                  reinterpret_cast<LPCSTR>(address), &module) != FALSE;
+#else
+        Dl_info info{};
+        if (dladdr(address, &info) == 0 || info.dli_fname == nullptr) {
+            return false;
+        }
+        // Takes a reference that is never released.
+        return dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD) != nullptr;
+#endif
+    }
+
     static std::unique_ptr<GlobalData> globalDataInstance;
 
     void ResetGlobalData()
@@ -151,6 +174,10 @@ namespace Conformance
                 AppendSprintf(reportString, "    %s\n", spec.c_str());
             }
         }
+        if (pipelineCreationCount > 0) {
+            AppendSprintf(reportString, "Graphics pipelines created: %llu (%.1f ms)\n", (unsigned long long)pipelineCreationCount,
+                          std::chrono::duration<double, std::milli>(pipelineCreationTime).count());
+        }
 
         return reportString;
     }
@@ -227,6 +254,9 @@ namespace Conformance
             for (auto& str : requiredGraphicsInstanceExtensions) {
                 globalData.enabledInstanceExtensionNames.push_back_unique(str);
             }
+
+            // Start reading and decoding the images that rendering tests use while the rest of initialization runs.
+            PrefetchKnownAssets(GetAssetLoader());
         }
 
         // Identify available API layers, and enable at least the conformance layer if available.
@@ -272,6 +302,17 @@ namespace Conformance
             return false;
         }
 
+        // The conformance layer counts and times the calls it passes to the runtime once asked for the totals. It is loaded
+        // and unloaded with each instance, so keep it loaded for its totals to cover the whole run.
+        if ((options.runtimeCallTiming || !options.timingHistoryFile.empty()) && IsAPILayerEnabled(kConformanceLayerName)) {
+            PFN_xrcGetRuntimeCallStatistics getStatistics = nullptr;
+            if (XR_SUCCEEDED(xrGetInstanceProcAddr(autoInstance, XRC_GET_RUNTIME_CALL_STATISTICS_NAME,
+                                                   reinterpret_cast<PFN_xrVoidFunction*>(&getStatistics))) &&
+                getStatistics != nullptr && PinLibraryContaining(reinterpret_cast<const void*>(getStatistics))) {
+                getRuntimeCallStatistics = getStatistics;
+            }
+        }
+
         /// @todo Also query extensions provided by any layers that are enabled.
         availableInstanceExtensionNames.clear();
         for (auto& value : availableInstanceExtensions) {
@@ -434,9 +475,22 @@ namespace Conformance
             platformPlugin->Shutdown();
         }
 
+        if (assetLoader) {
+            const AssetLoaderStats stats = assetLoader->GetStats();
+            ReportConsoleOnlyF("Asset loader: %llu requests, blocked waiting for %llu of them for a total of %.1f ms",
+                               (unsigned long long)stats.requests, (unsigned long long)stats.blockedWaits,
+                               std::chrono::duration<double, std::milli>(stats.blockedTime).count());
+            assetLoader.reset();
+        }
+        ReportCacheStatsConsoleOnly("Decoded glTF image", GltfHelper::GetDecodedImageCacheStats());
+
         isInitialized = false;
     }
 
+    GlobalData::GlobalData() = default;
+
+    GlobalData::~GlobalData() = default;
+
     RandEngine& GlobalData::GetRandEngine()
     {
         return randEngine;
@@ -472,6 +526,15 @@ namespace Conformance
         return conformanceReport;
     }
 
+    bool GlobalData::GetRuntimeCallStatistics(XrcRuntimeCallStatistics& statistics) const
+    {
+        if (getRuntimeCallStatistics == nullptr) {
+            return false;
+        }
+        getRuntimeCallStatistics(&statistics);
+        return true;
+    }
+
     bool GlobalData::IsAPILayerEnabled(const char* layerName) const
     {
         std::lock_guard<std::recursive_mutex> lock(dataMutex);
@@ -521,6 +584,16 @@ namespace Conformance
         return graphicsPlugin;
     }
 
+    AssetLoader& GlobalData::GetAssetLoader()
+    {
+        std::lock_guard<std::recursive_mutex> lock(dataMutex);
+
+        if (!assetLoader) {
+            assetLoader = std::make_unique<AssetLoader>();
+        }
+        return *assetLoader;
+    }
+
     bool GlobalData::IsGraphicsPluginRequired() const
     {
         // A graphics system must be specified unless a headless extension is enabled.
@@ -546,6 +619,13 @@ namespace Conformance
         conformanceReport.swapchainFormats.emplace_back(format, name);
     }
 
+    void GlobalData::RecordGraphicsPipelineCreation(uint64_t count, std::chrono::nanoseconds time)
+    {
+        std::unique_lock<std::recursive_mutex> lock(dataMutex);
+        conformanceReport.pipelineCreationCount += count;
+        conformanceReport.pipelineCreationTime += time;
+    }
+
     XrColor4f GlobalData::GetClearColorForBackground() const
     {
         switch (options.environmentBlendModeValue) {
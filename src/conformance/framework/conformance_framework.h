@@ -22,6 +22,7 @@
 #include "utilities/types_and_constants.h"
 #include "utilities/utils.h"
 #include "utilities/android_declarations.h"
+#include "utilities/runtime_call_statistics.h"
 
 #include <openxr/openxr.h>
 #include <openxr/openxr_reflection.h>
@@ -30,6 +31,7 @@
 #include <catch2/catch_message.hpp>
 #include <catch2/catch_tostring.hpp>
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -124,6 +126,7 @@
 
 namespace Conformance
 {
+    class AssetLoader;
     class FeatureSet;
     struct IGraphicsPlugin;
     struct IPlatformPlugin;
@@ -143,6 +146,10 @@ namespace Conformance
         /// Default is none. Must be manually specified.
         std::string graphicsPlugin{};
 
+        /// File that the Vulkan graphics plugin keeps its pipeline cache in between runs. Default is empty: the cache only
+        /// lives as long as the process.
+        std::string vulkanPipelineCacheFile{};
+
         /// Options include: "1.0" "1.1"
         /// Default is 1.1.
         std::string desiredApiVersion{"1.1"};
@@ -221,6 +228,34 @@ namespace Conformance
         /// before beginning a test case.
         bool pollGetSystem{false};
 
+        /// File of per-test-case durations (see @ref TestDurations) used to balance the shards selected with
+        /// Catch2's --shard-count and --shard-index by time rather than by test count. Used by conformance_cli --shards.
+        /// Default is empty (Catch2's own sharding).
+        std::string shardDurationsFile;
+
+        /// File to write the duration of each test case run to when the run ends. Default is empty (not written).
+        std::string recordDurationsFile;
+
+        /// If true, the conformance layer counts and times the OpenXR calls it passes to the runtime, and the ctsxml report
+        /// includes them with the test case and section timings. Implied by timingHistoryFile. Default is false, since
+        /// timing every call adds overhead of its own.
+        bool runtimeCallTiming{false};
+
+        /// Append-only file that the timing of each test case and section, and of the OpenXR calls made in it, is added
+        /// to when the run ends (see @ref AppendTimingHistory). Default is empty (not written).
+        std::string timingHistoryFile;
+
+        /// If positive, test cases and sections that took more than this many percent longer than their last entry in
+        /// timingHistoryFile are reported as regressions. Default is 0 (not compared).
+        double timingRegressionPercent{0};
+
+        /// If not empty, this run's timings are appended here instead of to timingHistoryFile, which is then only read for
+        /// the regression comparison. Used by conformance_cli --shards so that only the parent appends to the history.
+        std::string timingHistoryOutFile;
+
+        /// File that the per-frame measurements of the [benchmark] frame scheduling test are appended to as CSV.
+        std::string frameSchedulingBenchmarkFile{"frame_scheduling_benchmark.csv"};
+
         /// Defines if executing in debug mode. By default this follows the build type.
         bool debugMode
         {
@@ -310,6 +345,16 @@ namespace Conformance
         std::string GetReportString() const;
 
     public:
+        /// Time spent in a test case or section, summed over all of its runs, and the OpenXR calls that the conformance
+        /// layer passed down to the runtime meanwhile (from any thread).
+        class Timing
+        {
+        public:
+            std::chrono::nanoseconds duration{};
+            uint64_t runtimeCallCount{};
+            std::chrono::nanoseconds runtimeCallTime{};
+        };
+
         class Score
         {
         public:
@@ -324,17 +369,23 @@ namespace Conformance
 
         XrVersion apiVersion{XR_CURRENT_API_VERSION};
         std::unordered_map<std::string, Score> results;
+        /// Timing of each section, by "test case/section/..." path as in the ctsxml report.
+        std::map<std::string, Timing> sectionTimings;
         std::vector<std::string> unmatchedTestSpecs;
         Catch::Totals totals{};
         TimedSubmissionResults timedSubmission;
         std::vector<std::pair<int64_t, std::string>> swapchainFormats;
+        /// Graphics pipelines created by the graphics plugin, and the total time spent creating them.
+        uint64_t pipelineCreationCount{};
+        std::chrono::nanoseconds pipelineCreationTime{};
     };
 
     // A single place where all singleton data hangs off of.
     class GlobalData
     {
     public:
-        GlobalData() = default;
+        GlobalData();
+        ~GlobalData();
 
         // Non-copyable
         GlobalData(const GlobalData&) = delete;
@@ -363,6 +414,10 @@ namespace Conformance
         /// case sensitive check.
         bool IsAPILayerEnabled(const char* layerName) const;
 
+        /// Gets the totals for the OpenXR calls that the conformance layer has passed to the runtime so far in this run.
+        /// Returns false if the conformance layer is not in use.
+        bool GetRuntimeCallStatistics(XrcRuntimeCallStatistics& statistics) const;
+
         /// case sensitive check.
         bool IsInstanceExtensionEnabled(const char* extensionName) const;
 
@@ -375,6 +430,10 @@ namespace Conformance
         /// Returns a copy of the IGraphicsPlugin.
         std::shared_ptr<IGraphicsPlugin> GetGraphicsPlugin();
 
+        /// Returns the loader used to read and decode test assets off the frame loop thread.
+        /// Known assets are prefetched by Initialize when a graphics plugin is in use.
+        AssetLoader& GetAssetLoader();
+
         /// Returns true if under the current test environment we require a graphics plugin. This may
         /// be false, for example, if the XR_MND_headless extension is enabled.
         bool IsGraphicsPluginRequired() const;
@@ -388,6 +447,9 @@ namespace Conformance
         /// Record a swapchain format as being supported and tested.
         void PushSwapchainFormat(int64_t format, const std::string& name);
 
+        /// Record graphics pipelines created by the graphics plugin, e.g. when it releases its device.
+        void RecordGraphicsPipelineCreation(uint64_t count, std::chrono::nanoseconds time);
+
         /// Calculate the clear color to use for the background based on the XrEnvironmentBlendMode in use.
         XrColor4f GetClearColorForBackground() const;
 
@@ -414,12 +476,18 @@ namespace Conformance
 
         XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
 
+        /// The conformance layer's xrcGetRuntimeCallStatistics. The layer library is kept loaded once this is set.
+        PFN_xrcGetRuntimeCallStatistics getRuntimeCallStatistics{nullptr};
+
         FunctionInfo nullFunctionInfo;
 
         std::shared_ptr<IPlatformPlugin> platformPlugin;
 
         std::shared_ptr<IGraphicsPlugin> graphicsPlugin;
 
+        /// Created on first use, and destroyed (joining its threads) by Shutdown.
+        std::unique_ptr<AssetLoader> assetLoader;
+
         /// Specifies invalid values, which aren't XR_NULL_HANDLE. Used to exercise invalid handles.
         XrInstance invalidInstance{XRC_INVALID_INSTANCE_VALUE};
         XrSession invalidSession{XRC_INVALID_SESSION_VALUE};
@@ -22,6 +22,7 @@
 
 #include <openxr/openxr.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdint>
@@ -416,6 +417,19 @@ namespace Conformance
         bool running{};
     };
 
+    /// Returns the sample at @p quantile (0 to 1) of @p values, rounded to the nearest rank, or zero if there are no samples.
+    /// Used by the `[benchmark]` tests to report medians and tail latencies.
+    template <typename T>
+    T Percentile(std::vector<T> values, double quantile)
+    {
+        if (values.empty()) {
+            return T{};
+        }
+        const size_t index = std::min(static_cast<size_t>(quantile * (values.size() - 1) + 0.5), values.size() - 1);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
     /// Implements a countdown timer.
     class CountdownTimer
     {
@@ -17,10 +17,16 @@
 #include <tinygltf/tiny_gltf.h>
 #include <mikktspace.h>
 
+#include <algorithm>
+#include <array>
 #include <assert.h>
+#include <atomic>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -28,10 +34,21 @@
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #define TRIANGLE_VERTEX_COUNT 3  // #define so it can be used in lambdas without capture
 
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so neither needs extra compiler flags or runtime dispatch.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLTFHELPER_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GLTFHELPER_USE_NEON
+#endif
+
 #ifdef _WIN32
 
 #ifndef NOMINMAX
@@ -143,12 +160,16 @@ namespace
     template <>
     float ReadNormalizedFloat<float>(const uint8_t* ptr)
     {
-        return *reinterpret_cast<const float*>(ptr);
+        float value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
     }
     template <>
     float ReadNormalizedFloat<uint16_t>(const uint8_t* ptr)
     {
-        return *reinterpret_cast<const uint16_t*>(ptr) / (float)std::numeric_limits<uint16_t>::max();
+        uint16_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value / (float)std::numeric_limits<uint16_t>::max();
     }
     template <>
     float ReadNormalizedFloat<uint8_t>(const uint8_t* ptr)
@@ -156,6 +177,129 @@ namespace
         return *reinterpret_cast<const uint8_t*>(ptr) / (float)std::numeric_limits<uint8_t>::max();
     }
 
+    // Converts the first four components at ptr to floats, normalizing integer components like ReadNormalizedFloat does.
+    // All four components must be readable even when fewer are used.
+    template <typename T>
+    void ReadFourNormalizedFloats(const uint8_t* ptr, float out[4]);
+    template <>
+    void ReadFourNormalizedFloats<float>(const uint8_t* ptr, float out[4])
+    {
+        memcpy(out, ptr, sizeof(float) * 4);
+    }
+    template <>
+    void ReadFourNormalizedFloats<uint16_t>(const uint8_t* ptr, float out[4])
+    {
+#if defined(GLTFHELPER_USE_SSE2)
+        const __m128i widened = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr)), _mm_setzero_si128());
+        _mm_storeu_ps(out, _mm_div_ps(_mm_cvtepi32_ps(widened), _mm_set1_ps((float)std::numeric_limits<uint16_t>::max())));
+#elif defined(GLTFHELPER_USE_NEON)
+        uint16_t components[4];
+        memcpy(components, ptr, sizeof(components));
+        const uint32x4_t widened = vmovl_u16(vld1_u16(components));
+        vst1q_f32(out, vdivq_f32(vcvtq_f32_u32(widened), vdupq_n_f32((float)std::numeric_limits<uint16_t>::max())));
+#else
+        for (size_t c = 0; c < 4; c++) {
+            out[c] = ReadNormalizedFloat<uint16_t>(ptr + sizeof(uint16_t) * c);
+        }
+#endif
+    }
+    template <>
+    void ReadFourNormalizedFloats<uint8_t>(const uint8_t* ptr, float out[4])
+    {
+#if defined(GLTFHELPER_USE_SSE2)
+        int32_t packed;
+        memcpy(&packed, ptr, sizeof(packed));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i widened = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+        _mm_storeu_ps(out, _mm_div_ps(_mm_cvtepi32_ps(widened), _mm_set1_ps((float)std::numeric_limits<uint8_t>::max())));
+#elif defined(GLTFHELPER_USE_NEON)
+        uint32_t packed;
+        memcpy(&packed, ptr, sizeof(packed));
+        const uint32x4_t widened = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed)))));
+        vst1q_f32(out, vdivq_f32(vcvtq_f32_u32(widened), vdupq_n_f32((float)std::numeric_limits<uint8_t>::max())));
+#else
+        for (size_t c = 0; c < 4; c++) {
+            out[c] = ReadNormalizedFloat<uint8_t>(ptr + c);
+        }
+#endif
+    }
+
+    // Strided gather/convert shared by the vertex attribute readers: reads `count` elements of `ComponentCount` (at most 4)
+    // components spaced `srcStride` bytes apart, and writes them as floats to `dst`, spaced `dstStride` bytes apart.
+    // Elements are converted four components at a time; the last few elements, where that could read past `srcEnd`,
+    // are converted one component at a time instead.
+    template <typename TComponentType, size_t ComponentCount>
+    void ReadStridedNormalizedFloats(const uint8_t* src, size_t srcStride, const uint8_t* srcEnd, uint8_t* dst, size_t dstStride,
+                                     size_t count)
+    {
+        static_assert(ComponentCount <= 4, "At most four components are converted at a time");
+        const size_t readBytes = sizeof(TComponentType) * 4;
+        size_t i = 0;
+        for (; i < count && src + readBytes <= srcEnd; i++, src += srcStride, dst += dstStride) {
+            float components[4];
+            ReadFourNormalizedFloats<TComponentType>(src, components);
+            memcpy(dst, components, sizeof(float) * ComponentCount);
+        }
+        for (; i < count; i++, src += srcStride, dst += dstStride) {
+            for (size_t c = 0; c < ComponentCount; c++) {
+                const float component = ReadNormalizedFloat<TComponentType>(src + sizeof(TComponentType) * c);
+                memcpy(dst + sizeof(float) * c, &component, sizeof(float));
+            }
+        }
+    }
+
+    // Widens glTF indices to 32 bits, eight or sixteen at a time where SIMD is available.
+    template <typename TSrcIndex>
+    void WidenIndices(const uint8_t* src, uint32_t* dst, size_t count)
+    {
+        size_t i = 0;
+#if defined(GLTFHELPER_USE_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        if (sizeof(TSrcIndex) == 2) {
+            for (; i + 8 <= count; i += 8) {
+                const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(indices, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(indices, zero));
+            }
+        }
+        else if (sizeof(TSrcIndex) == 1) {
+            for (; i + 16 <= count; i += 16) {
+                const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i low = _mm_unpacklo_epi8(indices, zero);
+                const __m128i high = _mm_unpackhi_epi8(indices, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), _mm_unpackhi_epi16(high, zero));
+            }
+        }
+#elif defined(GLTFHELPER_USE_NEON)
+        if (sizeof(TSrcIndex) == 2) {
+            for (; i + 8 <= count; i += 8) {
+                const uint16x8_t indices = vreinterpretq_u16_u8(vld1q_u8(src + i * 2));
+                vst1q_u32(dst + i, vmovl_u16(vget_low_u16(indices)));
+                vst1q_u32(dst + i + 4, vmovl_u16(vget_high_u16(indices)));
+            }
+        }
+        else if (sizeof(TSrcIndex) == 1) {
+            for (; i + 16 <= count; i += 16) {
+                const uint8x16_t indices = vld1q_u8(src + i);
+                const uint16x8_t low = vmovl_u8(vget_low_u8(indices));
+                const uint16x8_t high = vmovl_u8(vget_high_u8(indices));
+                vst1q_u32(dst + i, vmovl_u16(vget_low_u16(low)));
+                vst1q_u32(dst + i + 4, vmovl_u16(vget_high_u16(low)));
+                vst1q_u32(dst + i + 8, vmovl_u16(vget_low_u16(high)));
+                vst1q_u32(dst + i + 12, vmovl_u16(vget_high_u16(high)));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            TSrcIndex index;
+            memcpy(&index, src + i * sizeof(TSrcIndex), sizeof(TSrcIndex));
+            dst[i] = index;
+        }
+    }
+
     XrMatrix4x4f Double4x4ToXrMatrix4x4f(const XrMatrix4x4f& defaultMatrix, const std::vector<double>& doubleData)
     {
         if (doubleData.size() != 16) {
@@ -222,12 +366,15 @@ namespace
         // Resize the vertices vector, if necessary, to include room for the attribute data.
         // If there are multiple attributes for a primitive, the first one will resize, and the subsequent will not need to.
         primitive.Vertices.resize(accessor.count);
+        if (primitive.Vertices.empty()) {
+            return;
+        }
 
         // Copy the attribute value over from the glTF buffer into the appropriate vertex field.
         const uint8_t* bufferPtr = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
-        for (size_t i = 0; i < accessor.count; i++, bufferPtr += stride) {
-            primitive.Vertices[i].Tangent = *reinterpret_cast<const XrVector4f*>(bufferPtr);
-        }
+        ReadStridedNormalizedFloats<float, 4>(bufferPtr, stride, buffer.data.data() + buffer.data.size(),
+                                              reinterpret_cast<uint8_t*>(&primitive.Vertices.data()->Tangent), sizeof(GltfHelper::Vertex),
+                                              accessor.count);
     }
 
     // Reads the TexCoord data (VEC2) from a glTF primitive into a GltfHelper Primitive.
@@ -244,13 +391,15 @@ namespace
         // Resize the vertices vector, if necessary, to include room for the attribute data.
         // If there are multiple attributes for a primitive, the first one will resize, and the subsequent will not need to.
         primitive.Vertices.resize(accessor.count);
+        if (primitive.Vertices.empty()) {
+            return;
+        }
 
         // Copy the attribute value over from the glTF buffer into the appropriate vertex field.
         const uint8_t* bufferPtr = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
-        for (size_t i = 0; i < accessor.count; i++, bufferPtr += stride) {
-            (primitive.Vertices[i].*field).x = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 0);
-            (primitive.Vertices[i].*field).y = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 1);
-        }
+        ReadStridedNormalizedFloats<TComponentType, 2>(bufferPtr, stride, buffer.data.data() + buffer.data.size(),
+                                                       reinterpret_cast<uint8_t*>(&(primitive.Vertices.data()->*field)),
+                                                       sizeof(GltfHelper::Vertex), accessor.count);
     }
 
     // Reads the TexCoord data (VEC2) from a glTF primitive into a GltfHelper Primitive.
@@ -296,18 +445,21 @@ namespace
         // Resize the vertices vector, if necessary, to include room for the attribute data.
         // If there are multiple attributes for a primitive, the first one will resize, and the subsequent will not need to.
         primitive.Vertices.resize(accessor.count);
+        if (primitive.Vertices.empty()) {
+            return;
+        }
 
         // Copy the attribute value over from the glTF buffer into the appropriate vertex field.
         const uint8_t* bufferPtr = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
-        for (size_t i = 0; i < accessor.count; i++, bufferPtr += stride) {
-            (primitive.Vertices[i].*field).r = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 0);
-            (primitive.Vertices[i].*field).g = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 1);
-            (primitive.Vertices[i].*field).b = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 2);
-
-            if (componentCount == 4)  // Alpha
-            {
-                (primitive.Vertices[i].*field).a = ReadNormalizedFloat<TComponentType>(bufferPtr + sizeof(TComponentType) * 3);
-            }
+        const uint8_t* bufferEnd = buffer.data.data() + buffer.data.size();
+        uint8_t* fieldPtr = reinterpret_cast<uint8_t*>(&(primitive.Vertices.data()->*field));
+        if (componentCount == 4) {
+            ReadStridedNormalizedFloats<TComponentType, 4>(bufferPtr, stride, bufferEnd, fieldPtr, sizeof(GltfHelper::Vertex),
+                                                           accessor.count);
+        }
+        else {
+            ReadStridedNormalizedFloats<TComponentType, 3>(bufferPtr, stride, bufferEnd, fieldPtr, sizeof(GltfHelper::Vertex),
+                                                           accessor.count);
         }
     }
 
@@ -368,12 +520,15 @@ namespace
         // Resize the vertices vector, if necessary, to include room for the attribute data.
         // If there are multiple attributes for a primitive, the first one will resize, and the subsequent will not need to.
         primitive.Vertices.resize(accessor.count);
+        if (primitive.Vertices.empty()) {
+            return;
+        }
 
         // Copy the attribute value over from the glTF buffer into the appropriate vertex field.
         const uint8_t* bufferPtr = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
-        for (size_t i = 0; i < accessor.count; i++, bufferPtr += stride) {
-            (primitive.Vertices[i].*field) = *reinterpret_cast<const XrVector3f*>(bufferPtr);
-        }
+        ReadStridedNormalizedFloats<float, 3>(bufferPtr, stride, buffer.data.data() + buffer.data.size(),
+                                              reinterpret_cast<uint8_t*>(&(primitive.Vertices.data()->*field)), sizeof(GltfHelper::Vertex),
+                                              accessor.count);
     }
 
     // Load a primitive's (vertex) attributes. Vertex attributes can be positions, normals, tangents, texture coordinates, colors, and more.
@@ -442,10 +597,10 @@ namespace
             throw std::runtime_error("Unexpected number of indices for triangle primitive");
         }
 
-        const TSrcIndex* indexBuffer = reinterpret_cast<const TSrcIndex*>(buffer.data.data() + bufferView.byteOffset + accessor.byteOffset);
-        for (uint32_t i = 0; i < accessor.count; i++) {
-            primitive.Indices.push_back(*(indexBuffer + i));
-        }
+        const size_t startIndex = primitive.Indices.size();
+        primitive.Indices.resize(startIndex + accessor.count);
+        WidenIndices<TSrcIndex>(buffer.data.data() + bufferView.byteOffset + accessor.byteOffset, primitive.Indices.data() + startIndex,
+                                accessor.count);
     }
 
     // Reads index data from a glTF primitive into a GltfHelper Primitive.
@@ -546,13 +701,18 @@ namespace GltfHelper
         return primitive;
     }
 
-    const Primitive& PrimitiveCache::ReadPrimitive(const tinygltf::Primitive& gltfPrimitive)
+    PrimitiveCache::PrimitiveKey PrimitiveCache::MakeKey(const tinygltf::Primitive& gltfPrimitive)
     {
         PrimitiveAttributesVec attributesVec{};
         for (auto const& attr : gltfPrimitive.attributes) {
             attributesVec.push_back(std::make_pair(attr.first, attr.second));
         }
-        PrimitiveKey key = std::make_pair(attributesVec, gltfPrimitive.indices);
+        return std::make_pair(attributesVec, gltfPrimitive.indices);
+    }
+
+    const Primitive& PrimitiveCache::ReadPrimitive(const tinygltf::Primitive& gltfPrimitive)
+    {
+        PrimitiveKey key = MakeKey(gltfPrimitive);
         auto primitiveIt = m_primitiveCache.find(key);
         if (primitiveIt != m_primitiveCache.end()) {
             return primitiveIt->second;
@@ -562,6 +722,65 @@ namespace GltfHelper
         return m_primitiveCache.emplace(key, std::move(primitive)).first->second;
     }
 
+    void PrimitiveCache::ReadPrimitives(span<const tinygltf::Primitive* const> gltfPrimitives)
+    {
+        // Find the distinct primitives that still need reading, mapped to their index in pending.
+        std::map<PrimitiveKey, size_t> pendingIndices;
+        std::vector<const tinygltf::Primitive*> pending;
+        for (const tinygltf::Primitive* gltfPrimitive : gltfPrimitives) {
+            PrimitiveKey key = MakeKey(*gltfPrimitive);
+            if (m_primitiveCache.count(key) != 0) {
+                continue;
+            }
+            if (pendingIndices.emplace(std::move(key), pending.size()).second) {
+                pending.push_back(gltfPrimitive);
+            }
+        }
+        if (pending.empty()) {
+            return;
+        }
+
+        // Reading a primitive only reads the (const) model, and MikkTSpace keeps no global state, so primitives
+        // can be read concurrently. Workers claim the next unread primitive, so one large primitive does not hold up the rest.
+        std::vector<Primitive> primitives(pending.size());
+        std::atomic<size_t> nextPrimitive{0};
+        auto worker = [&] {
+            for (size_t i = nextPrimitive++; i < pending.size(); i = nextPrimitive++) {
+                primitives[i] = GltfHelper::ReadPrimitive(m_model, *pending[i]);
+            }
+        };
+
+        const size_t workerCount = std::min<size_t>(pending.size(), std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::future<void>> workers;
+        for (size_t i = 1; i < workerCount; ++i) {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        std::exception_ptr firstError;
+        try {
+            worker();
+        }
+        catch (...) {
+            firstError = std::current_exception();
+        }
+        for (std::future<void>& w : workers) {
+            try {
+                w.get();
+            }
+            catch (...) {
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+
+        for (const auto& pendingIndex : pendingIndices) {
+            m_primitiveCache.emplace(pendingIndex.first, std::move(primitives[pendingIndex.second]));
+        }
+    }
+
     Material ReadMaterial(const tinygltf::Model& gltfModel, const tinygltf::Material& gltfMaterial)
     {
         // Read an optional VEC4 parameter if available, otherwise use the default.
@@ -684,6 +903,40 @@ namespace GltfHelper
         return false;
     }
 
+    namespace
+    {
+        /// The fields of a tinygltf::Image filled in by tinygltf::LoadImageData
+        struct DecodedImage
+        {
+            int width;
+            int height;
+            int component;
+            int bits;
+            int pixel_type;
+            std::vector<unsigned char> pixels;
+        };
+
+        using DecodedImageCacheKey =
+            std::tuple<std::array<uint64_t, 2> /* content hash */, size_t /* content size */, int /* req_width */, int /* req_height */>;
+        using DecodedImageCache = Conformance::LruCache<DecodedImageCacheKey, std::shared_ptr<const DecodedImage>>;
+
+        DecodedImageCache& GetDecodedImageCache()
+        {
+            static DecodedImageCache cache(64 * 1024 * 1024);
+            return cache;
+        }
+    }  // namespace
+
+    void SetDecodedImageCacheBudget(size_t bytes)
+    {
+        GetDecodedImageCache().SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats GetDecodedImageCacheStats()
+    {
+        return GetDecodedImageCache().GetStats();
+    }
+
     bool PassThroughKTX2(tinygltf::Image* image, const int image_idx, std::string* err, std::string* warn, int req_width, int req_height,
                          const unsigned char* bytes, int size, void* /* user_data */) noexcept
     {
@@ -696,8 +949,26 @@ namespace GltfHelper
         }
 
         if (!IsKTX2(*image)) {
-            // forward to base implementation if the image isn't ktx2
-            return tinygltf::LoadImageData(image, image_idx, err, warn, req_width, req_height, bytes, size, nullptr);
+            // forward to base implementation if the image isn't ktx2, unless the same content was decoded recently
+            const DecodedImageCacheKey cacheKey{Conformance::Image::ContentHash({bytes, static_cast<size_t>(size)}),
+                                                static_cast<size_t>(size), req_width, req_height};
+            std::shared_ptr<const DecodedImage> decoded;
+            if (GetDecodedImageCache().TryGet(cacheKey, decoded)) {
+                image->width = decoded->width;
+                image->height = decoded->height;
+                image->component = decoded->component;
+                image->bits = decoded->bits;
+                image->pixel_type = decoded->pixel_type;
+                image->image = decoded->pixels;
+                return true;
+            }
+            if (!tinygltf::LoadImageData(image, image_idx, err, warn, req_width, req_height, bytes, size, nullptr)) {
+                return false;
+            }
+            decoded = std::make_shared<const DecodedImage>(
+                DecodedImage{image->width, image->height, image->component, image->bits, image->pixel_type, image->image});
+            GetDecodedImageCache().Insert(cacheKey, std::move(decoded), image->image.size());
+            return true;
         }
 
         image->image = std::vector<unsigned char>(bytes, bytes + size);
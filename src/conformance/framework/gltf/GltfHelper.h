@@ -13,6 +13,7 @@
 #pragma once
 
 #include <utilities/image.h>
+#include <utilities/lru_cache.h>
 
 #include "common/xr_linear.h"
 
@@ -105,9 +106,15 @@ namespace GltfHelper
         }
         const Primitive& ReadPrimitive(const tinygltf::Primitive& gltfPrimitive);
 
+        // Reads all of the given primitives that are not cached yet, decoding independent primitives on worker threads.
+        // Later ReadPrimitive calls for them are cache hits. Exceptions from reading a primitive are rethrown here.
+        void ReadPrimitives(span<const tinygltf::Primitive* const> gltfPrimitives);
+
     private:
         using PrimitiveAttributesVec = std::vector<std::pair<std::string, int>>;  // first is name, second is accessor
         using PrimitiveKey = std::pair<PrimitiveAttributesVec, int>;              // first is attributes, second is indices
+        static PrimitiveKey MakeKey(const tinygltf::Primitive& gltfPrimitive);
+
         std::reference_wrapper<const tinygltf::Model> m_model;
         std::map<PrimitiveKey, Primitive> m_primitiveCache{};
     };
@@ -129,6 +136,14 @@ namespace GltfHelper
     bool PassThroughKTX2(tinygltf::Image* image, const int image_idx, std::string* err, std::string* warn, int req_width, int req_height,
                          const unsigned char* bytes, int size, void* /* user_data */) noexcept;
 
+    /// Sets the memory budget for the decoded copies of non-KTX2 images kept by @ref PassThroughKTX2,
+    /// which let identical image content in later models be copied rather than decoded again. Entries are keyed by a hash of the
+    /// encoded image, which is not kept. Pass 0 to disable.
+    void SetDecodedImageCacheBudget(size_t bytes);
+
+    /// Hit, miss and occupancy counters of the decoded image cache used by @ref PassThroughKTX2.
+    Conformance::LruCacheStats GetDecodedImageCacheStats();
+
     /// Converts the image to RGBA if necessary. Requires a temporary buffer only if it needs to be converted.
     Conformance::Image::Image DecodeImage(const tinygltf::Image& image, bool sRGB,
                                           span<const Conformance::Image::FormatParams> supportedFormats, std::vector<uint8_t>& tempBuffer);
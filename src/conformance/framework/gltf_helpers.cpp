@@ -7,6 +7,7 @@
 #include "gltf/GltfHelper.h"
 
 #include "utilities/throw_helpers.h"
+#include "utilities/utils.h"
 #include "cts_tinygltf.h"
 
 namespace Conformance
@@ -39,4 +40,10 @@ namespace Conformance
         }
         return std::const_pointer_cast<const tinygltf::Model>(std::move(model));
     }
+
+    std::shared_ptr<const tinygltf::Model> LoadGLTFFile(const char* path)
+    {
+        const std::vector<uint8_t> data = ReadFileBytes(path, "glTF binary");
+        return LoadGLTF(data);
+    }
 }  // namespace Conformance
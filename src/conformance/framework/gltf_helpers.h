@@ -30,4 +30,8 @@ namespace Conformance
     /// Load a glTF file from memory into a shared pointer, throwing on errors, using the provided loader.
     std::shared_ptr<const tinygltf::Model> LoadGLTF(span<const uint8_t> data, tinygltf::TinyGLTF& loader);
 
+    /// Read a glTF binary file and load it into a shared pointer, throwing on errors. The file contents are released once
+    /// parsed, but tinygltf copies the binary chunk into its own buffers, so both are held at the peak.
+    std::shared_ptr<const tinygltf::Model> LoadGLTFFile(const char* path);
+
 }  // namespace Conformance
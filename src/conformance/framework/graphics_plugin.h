@@ -401,6 +401,18 @@ namespace Conformance
         /// Render a list of drawables to a swapchain image. ClearImageSlice must be called first to clear internal state.
         virtual void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                                 const RenderParams& params) = 0;
+
+        /// Render the same drawables to several views of one array swapchain image; each layer view selects its slice with
+        /// subImage.imageArrayIndex. ClearImageSlice must be called for each slice first.
+        /// Plugins that support single-pass multiview rendering draw all views in one pass when the views allow it;
+        /// this default renders each view in turn.
+        virtual void RenderMultiview(span<const XrCompositionLayerProjectionView> layerViews,
+                                     const XrSwapchainImageBaseHeader* colorSwapchainImage, const RenderParams& params)
+        {
+            for (const XrCompositionLayerProjectionView& layerView : layerViews) {
+                RenderView(layerView, colorSwapchainImage, params);
+            }
+        }
     };
 
     /// Create a graphics plugin for the graphics API specified in the options.
@@ -16,10 +16,12 @@
 
 #if defined(XR_USE_GRAPHICS_API_D3D11)
 
+#include "asset_loader.h"
 #include "conformance_framework.h"
 #include "graphics_plugin.h"
 #include "graphics_plugin_d3d11_gltf.h"
 #include "graphics_plugin_impl_helpers.h"
+#include "report.h"
 #include "swapchain_image_data.h"
 
 #include "common/xr_linear.h"
@@ -392,9 +394,10 @@ namespace Conformance
                 m_pbrResources->SetLight({0.0f, 0.7071067811865475f, 0.7071067811865475f}, Pbr::RGB::White);
 
                 // Read the BRDF Lookup Table used by the PBR system into a DirectX texture.
-                std::vector<byte> brdfLutFileData = ReadFileBytes("brdf_lut.png");
+                std::shared_ptr<const std::vector<uint8_t>> brdfLutFileData =
+                    GetGlobalData().GetAssetLoader().ReadFile("brdf_lut.png").Get();
                 Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> brdfLutResourceView =
-                    Pbr::D3D11Texture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData.data(), (uint32_t)brdfLutFileData.size());
+                    Pbr::D3D11Texture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData->data(), (uint32_t)brdfLutFileData->size());
                 m_pbrResources->SetBrdfLut(brdfLutResourceView.Get());
             }
 
@@ -434,6 +437,9 @@ namespace Conformance
         m_meshes.clear();
         m_gltfInstances.clear();
         m_gltfModels.clear();
+        if (m_pbrResources) {
+            ReportCacheStatsConsoleOnly("glTF image texture", m_pbrResources->GetImageTextureCacheStats());
+        }
         m_pbrResources.reset();
 
         d3d11DeviceContext.Reset();
@@ -16,6 +16,7 @@
 
 #if defined(XR_USE_GRAPHICS_API_D3D12)
 
+#include "asset_loader.h"
 #include "conformance_framework.h"
 #include "gltf_helpers.h"
 #include "graphics_plugin.h"
@@ -599,6 +600,9 @@ namespace Conformance
         dsvHeap.Reset();
         m_swapchainImageDataMap.Reset();
 
+        if (m_pbrResources) {
+            ReportCacheStatsConsoleOnly("glTF image texture", m_pbrResources->GetImageTextureCacheStats());
+        }
         m_pbrResources.reset();
         d3d12Device.Reset();
     }
@@ -1213,10 +1217,10 @@ namespace Conformance
                                                                  reinterpret_cast<void**>(cmdList.ReleaseAndGetAddressOf())));
             XRC_CHECK_THROW_HRCMD(cmdList->SetName(L"CTS PBR image upload command list"));
 
-            std::vector<byte> fileData = ReadFileBytes(fileName);
+            std::shared_ptr<const std::vector<uint8_t>> fileData = GetGlobalData().GetAssetLoader().ReadFile(fileName).Get();
             std::vector<ComPtr<ID3D12Resource>> stagingResources{};
             D3D12ResourceWithSRVDesc texture = Pbr::D3D12Texture::LoadTextureImage(
-                *m_pbrResources, cmdList.Get(), std::back_inserter(stagingResources), sRGB, fileData.data(), (uint32_t)fileData.size());
+                *m_pbrResources, cmdList.Get(), std::back_inserter(stagingResources), sRGB, fileData->data(), (uint32_t)fileData->size());
             XRC_CHECK_THROW_HRCMD(cmdList->Close());
             XRC_CHECK_THROW(m_queueWrapper->ExecuteCommandList(cmdList.Get()));
             m_queueWrapper->CPUWaitOnFence();
@@ -16,10 +16,12 @@
 
 #ifdef XR_USE_GRAPHICS_API_METAL
 
+#include "asset_loader.h"
 #include "conformance_framework.h"
 #include "graphics_plugin.h"
 #include "graphics_plugin_impl_helpers.h"
 #include "graphics_plugin_metal_gltf.h"
+#include "report.h"
 #include "swapchain_image_data.h"
 
 #include "common/xr_dependencies.h"
@@ -997,9 +999,9 @@ namespace Conformance
             Pbr::MetalTexture::CreateFlatCubeTexture(*pbrResources, Pbr::RGBA::Black, MTL::PixelFormatRGBA8Unorm, MTLSTR("blackCubeMap"));
         pbrResources->SetEnvironmentMap(blackCubeMap.get(), blackCubeMap.get());
 
-        std::vector<uint8_t> brdfLutFileData = ReadFileBytes("brdf_lut.png");
+        std::shared_ptr<const std::vector<uint8_t>> brdfLutFileData = GetGlobalData().GetAssetLoader().ReadFile("brdf_lut.png").Get();
         NS::SharedPtr<MTL::Texture> brdfLutTexture = Pbr::MetalTexture::LoadTextureImage(
-            *pbrResources, false, brdfLutFileData.data(), (uint32_t)brdfLutFileData.size(), MTLSTR("brdf_lut.png"));
+            *pbrResources, false, brdfLutFileData->data(), (uint32_t)brdfLutFileData->size(), MTLSTR("brdf_lut.png"));
         pbrResources->SetBrdfLut(brdfLutTexture.get());
 
         return true;
@@ -1011,6 +1013,9 @@ namespace Conformance
         m_meshes.clear();
         m_gltfInstances.clear();
         m_gltfModels.clear();
+        if (pbrResources) {
+            ReportCacheStatsConsoleOnly("glTF image texture", pbrResources->GetImageTextureCacheStats());
+        }
         pbrResources.reset();
 
         m_depthStencilState.reset();
@@ -17,12 +17,14 @@
 #ifdef XR_USE_GRAPHICS_API_OPENGL
 
 #include "RGBAImage.h"
+#include "asset_loader.h"
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "gltf_helpers.h"
 #include "graphics_plugin.h"
 #include "graphics_plugin_impl_helpers.h"
 #include "graphics_plugin_opengl_gltf.h"
+#include "mesh_instancing.h"
 #include "report.h"
 #include "swapchain_image_data.h"
 
@@ -51,6 +53,7 @@
 #include <array>
 #include <assert.h>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <stddef.h>
 #include <string>
@@ -180,15 +183,34 @@ namespace Conformance
 
         in vec3 VertexPos;
         in vec3 VertexColor;
+        in mat4 InstanceModel;
+        in vec4 InstanceTintColor;
 
         out vec3 PSVertexColor;
 
-        uniform mat4 ModelViewProjection;
-        uniform vec4 tintColor;
+        uniform mat4 ViewProjection;
 
         void main() {
-           gl_Position = ModelViewProjection * vec4(VertexPos, 1.0);
-           PSVertexColor = mix(VertexColor, tintColor.rgb, tintColor.a);
+           gl_Position = ViewProjection * (InstanceModel * vec4(VertexPos, 1.0));
+           PSVertexColor = mix(VertexColor, InstanceTintColor.rgb, InstanceTintColor.a);
+        }
+        )_";
+
+    // Body of the vertex shader for single-pass multiview rendering (GL_OVR_multiview2);
+    // prefixed with the version, extension and num_views layout when compiled for a given view count.
+    static const char* MultiviewVertexShaderGlslBody = R"_(
+        in vec3 VertexPos;
+        in vec3 VertexColor;
+        in mat4 InstanceModel;
+        in vec4 InstanceTintColor;
+
+        out vec3 PSVertexColor;
+
+        uniform mat4 ViewProjection[VIEW_COUNT];
+
+        void main() {
+           gl_Position = ViewProjection[gl_ViewID_OVR] * (InstanceModel * vec4(VertexPos, 1.0));
+           PSVertexColor = mix(VertexColor, InstanceTintColor.rgb, InstanceTintColor.a);
         }
         )_";
 
@@ -211,8 +233,9 @@ namespace Conformance
         GLuint m_indexBuffer{0};
         uint32_t m_numIndices;
 
-        OpenGLMesh(GLint vertexAttribCoords, GLint vertexAttribColor,  //
-                   const uint16_t* idx_data, uint32_t idx_count,       //
+        OpenGLMesh(GLint vertexAttribCoords, GLint vertexAttribColor,            //
+                   GLint instanceAttribModel, GLint instanceAttribTintColor,  //
+                   const uint16_t* idx_data, uint32_t idx_count,                 //
                    const Geometry::Vertex* vtx_data, uint32_t vtx_count)
         {
             m_numIndices = idx_count;
@@ -235,6 +258,14 @@ namespace Conformance
             XRC_CHECK_THROW_GLCMD(glVertexAttribPointer(vertexAttribColor, 3, GL_FLOAT, GL_FALSE, sizeof(Geometry::Vertex),
                                                         reinterpret_cast<const void*>(sizeof(XrVector3f))));
 
+            // Per-instance attributes; their buffer and offsets are set for each batch in RenderView.
+            for (GLint column = 0; column < 4; ++column) {
+                XRC_CHECK_THROW_GLCMD(glEnableVertexAttribArray(instanceAttribModel + column));
+                XRC_CHECK_THROW_GLCMD(glVertexAttribDivisor(instanceAttribModel + column, 1));
+            }
+            XRC_CHECK_THROW_GLCMD(glEnableVertexAttribArray(instanceAttribTintColor));
+            XRC_CHECK_THROW_GLCMD(glVertexAttribDivisor(instanceAttribTintColor, 1));
+
             valid = true;
         }
 
@@ -437,7 +468,25 @@ namespace Conformance
         void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                         const RenderParams& params) override;
 
+        void RenderMultiview(span<const XrCompositionLayerProjectionView> layerViews, const XrSwapchainImageBaseHeader* colorSwapchainImage,
+                             const RenderParams& params) override;
+
     private:
+        struct MultiviewProgram
+        {
+            GLuint program{0};
+            GLint viewProjectionUniformLocation{0};
+        };
+
+        /// Get (compiling on first use) the multiview variant of m_program for the given number of views.
+        const MultiviewProgram& GetMultiviewProgram(uint32_t viewCount);
+
+        /// Set the viewport, scissor and fixed-function state shared by all cube and mesh rendering.
+        void SetRenderState(const XrRect2Di& imageRect);
+
+        /// Draw the cubes and meshes of `params` with whichever program is bound, one instanced draw per mesh.
+        void DrawMeshInstances(const RenderParams& params);
+
         bool initialized = false;
         bool deviceInitialized = false;
 
@@ -462,10 +511,17 @@ namespace Conformance
         SwapchainImageDataMap<OpenGLSwapchainImageData> m_swapchainImageDataMap;
         GLuint m_swapchainFramebuffer{0};
         GLuint m_program{0};
-        GLint m_modelViewProjectionUniformLocation{0};
-        GLint m_tintColorUniformLocation{0};
+        PixelUnpackBufferRing m_pixelUnpackBuffers;
+        GLint m_viewProjectionUniformLocation{0};
         GLint m_vertexAttribCoords{0};
         GLint m_vertexAttribColor{0};
+        GLint m_instanceAttribModel{0};
+        GLint m_instanceAttribTintColor{0};
+        GLuint m_instanceBuffer{0};
+        MeshInstanceList m_meshInstances;
+        bool m_supportsMultiview{false};
+        GLint m_maxMultiviewViews{0};
+        std::map<uint32_t, MultiviewProgram> m_multiviewPrograms;
         MeshHandle m_cubeMesh{};
         VectorWithGenerationCountedHandles<OpenGLMesh, MeshHandle> m_meshes;
         // This is fine to be a shared_ptr because Model doesn't directly hold any graphics state.
@@ -736,11 +792,19 @@ namespace Conformance
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
 
-        m_modelViewProjectionUniformLocation = glGetUniformLocation(m_program, "ModelViewProjection");
-        m_tintColorUniformLocation = glGetUniformLocation(m_program, "tintColor");
+        m_viewProjectionUniformLocation = glGetUniformLocation(m_program, "ViewProjection");
 
         m_vertexAttribCoords = glGetAttribLocation(m_program, "VertexPos");
         m_vertexAttribColor = glGetAttribLocation(m_program, "VertexColor");
+        m_instanceAttribModel = glGetAttribLocation(m_program, "InstanceModel");
+        m_instanceAttribTintColor = glGetAttribLocation(m_program, "InstanceTintColor");
+
+        XRC_CHECK_THROW_GLCMD(glGenBuffers(1, &m_instanceBuffer));
+
+        m_supportsMultiview = GlSupportsMultiview();
+        if (m_supportsMultiview) {
+            XRC_CHECK_THROW_GLCMD(glGetIntegerv(GL_MAX_VIEWS_OVR, &m_maxMultiviewViews));
+        }
 
         m_cubeMesh = MakeCubeMesh();
 
@@ -751,9 +815,9 @@ namespace Conformance
         m_pbrResources->SetEnvironmentMap(blackCubeMap, blackCubeMap);
 
         // Read the BRDF Lookup Table used by the PBR system into a GL texture.
-        std::vector<unsigned char> brdfLutFileData = ReadFileBytes("brdf_lut.png");
+        std::shared_ptr<const std::vector<uint8_t>> brdfLutFileData = GetGlobalData().GetAssetLoader().ReadFile("brdf_lut.png").Get();
         auto brdLutResourceView = std::make_shared<Pbr::ScopedGLTexture>(
-            Pbr::GLTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData.data(), (uint32_t)brdfLutFileData.size()));
+            Pbr::GLTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData->data(), (uint32_t)brdfLutFileData->size()));
         m_pbrResources->SetBrdfLut(brdLutResourceView);
     }
 
@@ -815,6 +879,15 @@ namespace Conformance
         if (m_program != 0) {
             glDeleteProgram(m_program);
         }
+        if (m_instanceBuffer != 0) {
+            glDeleteBuffers(1, &m_instanceBuffer);
+            m_instanceBuffer = 0;
+        }
+        for (const auto& entry : m_multiviewPrograms) {
+            glDeleteProgram(entry.second.program);
+        }
+        m_multiviewPrograms.clear();
+        m_pixelUnpackBuffers.Reset();
 
         // Reset the swapchains to avoid calling Vulkan functions in the dtors after
         // we've shut down the device.
@@ -823,6 +896,9 @@ namespace Conformance
         m_meshes.clear();
         m_gltfInstances.clear();
         m_gltfModels.clear();
+        if (m_pbrResources) {
+            ReportCacheStatsConsoleOnly("glTF image texture", m_pbrResources->GetImageTextureCacheStats());
+        }
         m_pbrResources.reset();
 
         deleteGLContext();
@@ -1003,25 +1079,11 @@ namespace Conformance
         std::tie(swapchainData, imageIndex) = m_swapchainImageDataMap.GetDataAndIndexFromBasePointer(swapchainImage);
 
         const uint32_t colorTexture = reinterpret_cast<const XrSwapchainImageOpenGLKHR*>(swapchainImage)->image;
-        const GLint mip = 0;
-        const GLint x = 0;
-        const GLint z = arraySlice;
         const GLsizei w = swapchainData->Width();
         const GLsizei h = swapchainData->Height();
-        if (swapchainData->HasMultipleSlices()) {
-            XRC_CHECK_THROW_GLCMD(glBindTexture(GL_TEXTURE_2D_ARRAY, colorTexture));
-            for (GLint y = 0; y < h; ++y) {
-                const void* pixels = &image.pixels[(h - 1 - y) * w];
-                XRC_CHECK_THROW_GLCMD(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mip, x, y, z, w, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
-        else {
-            XRC_CHECK_THROW_GLCMD(glBindTexture(GL_TEXTURE_2D, colorTexture));
-            for (GLint y = 0; y < h; ++y) {
-                const void* pixels = &image.pixels[(h - 1 - y) * w];
-                XRC_CHECK_THROW_GLCMD(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, w, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
+        const GLenum target = swapchainData->HasMultipleSlices() ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+        XRC_CHECK_THROW_GLCMD(glBindTexture(target, colorTexture));
+        m_pixelUnpackBuffers.UploadFlippedRGBA8(target, static_cast<GLint>(arraySlice), w, h, image.pixels.data());
     }
 
     void OpenGLGraphicsPlugin::ClearImageSlice(const XrSwapchainImageBaseHeader* colorSwapchainImage, uint32_t imageArrayIndex,
@@ -1068,8 +1130,8 @@ namespace Conformance
 
     MeshHandle OpenGLGraphicsPlugin::MakeSimpleMesh(span<const uint16_t> idx, span<const Geometry::Vertex> vtx)
     {
-        auto handle = m_meshes.emplace_back(m_vertexAttribCoords, m_vertexAttribColor, idx.data(), (uint32_t)idx.size(), vtx.data(),
-                                            (uint32_t)vtx.size());
+        auto handle = m_meshes.emplace_back(m_vertexAttribCoords, m_vertexAttribColor, m_instanceAttribModel, m_instanceAttribTintColor,
+                                            idx.data(), (uint32_t)idx.size(), vtx.data(), (uint32_t)vtx.size());
 
         return handle;
     }
@@ -1124,18 +1186,7 @@ namespace Conformance
 
         CheckFramebuffer(m_swapchainFramebuffer);
 
-        GLint x = layerView.subImage.imageRect.offset.x;
-        GLint y = layerView.subImage.imageRect.offset.y;
-        GLsizei w = layerView.subImage.imageRect.extent.width;
-        GLsizei h = layerView.subImage.imageRect.extent.height;
-        XRC_CHECK_THROW_GLCMD(glViewport(x, y, w, h));
-        XRC_CHECK_THROW_GLCMD(glScissor(x, y, w, h));
-
-        XRC_CHECK_THROW_GLCMD(glEnable(GL_SCISSOR_TEST));
-        XRC_CHECK_THROW_GLCMD(glEnable(GL_DEPTH_TEST));
-        XRC_CHECK_THROW_GLCMD(glEnable(GL_CULL_FACE));
-        XRC_CHECK_THROW_GLCMD(glFrontFace(GL_CW));
-        XRC_CHECK_THROW_GLCMD(glCullFace(GL_BACK));
+        SetRenderState(layerView.subImage.imageRect);
 
         // Set shaders and uniform variables.
         XRC_CHECK_THROW_GLCMD(glUseProgram(m_program));
@@ -1146,39 +1197,9 @@ namespace Conformance
         XrMatrix4x4f toView = Matrix::FromPose(pose);
         XrMatrix4x4f view = Matrix::InvertRigidBody(toView);
         XrMatrix4x4f vp = proj * view;
-        MeshHandle lastMeshHandle;
-
-        const auto drawMesh = [this, &vp, &lastMeshHandle](const MeshDrawable mesh) {
-            OpenGLMesh& glMesh = m_meshes[mesh.handle];
-            if (mesh.handle != lastMeshHandle) {
-                // We are now rendering a new mesh
-                XRC_CHECK_THROW_GLCMD(glBindVertexArray(glMesh.m_vao));
-                XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ARRAY_BUFFER, glMesh.m_vertexBuffer));
-                XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glMesh.m_indexBuffer));
-
-                lastMeshHandle = mesh.handle;
-            }
-
-            // Compute the model-view-projection transform and set it..
-            XrMatrix4x4f model =
-                Matrix::FromTranslationRotationScale(mesh.params.pose.position, mesh.params.pose.orientation, mesh.params.scale);
-            XrMatrix4x4f mvp = vp * model;
-            glUniformMatrix4fv(m_modelViewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&mvp));
-            glUniform4fv(m_tintColorUniformLocation, 1, reinterpret_cast<const GLfloat*>(&mesh.tintColor));
-
-            // Draw the mesh.
-            glDrawElements(GL_TRIANGLES, GLsizei(glMesh.m_numIndices), GL_UNSIGNED_SHORT, nullptr);
-        };
-
-        // Render each cube
-        for (const Cube& cube : params.cubes) {
-            drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
-        }
+        glUniformMatrix4fv(m_viewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&vp));
 
-        // Render each mesh
-        for (const auto& mesh : params.meshes) {
-            drawMesh(mesh);
-        }
+        DrawMeshInstances(params);
 
         // Render each gltf
         for (const auto& gltfDrawable : params.glTFs) {
@@ -1198,6 +1219,163 @@ namespace Conformance
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    void OpenGLGraphicsPlugin::SetRenderState(const XrRect2Di& imageRect)
+    {
+        GLint x = imageRect.offset.x;
+        GLint y = imageRect.offset.y;
+        GLsizei w = imageRect.extent.width;
+        GLsizei h = imageRect.extent.height;
+        XRC_CHECK_THROW_GLCMD(glViewport(x, y, w, h));
+        XRC_CHECK_THROW_GLCMD(glScissor(x, y, w, h));
+
+        XRC_CHECK_THROW_GLCMD(glEnable(GL_SCISSOR_TEST));
+        XRC_CHECK_THROW_GLCMD(glEnable(GL_DEPTH_TEST));
+        XRC_CHECK_THROW_GLCMD(glEnable(GL_CULL_FACE));
+        XRC_CHECK_THROW_GLCMD(glFrontFace(GL_CW));
+        XRC_CHECK_THROW_GLCMD(glCullFace(GL_BACK));
+    }
+
+    void OpenGLGraphicsPlugin::DrawMeshInstances(const RenderParams& params)
+    {
+        // Group the cubes and meshes by mesh and stream their transforms and tint colors into the instance buffer.
+        // Respecifying the whole buffer each view orphans the previous storage, so this never waits on earlier draws.
+        m_meshInstances.Build(params, m_cubeMesh);
+        span<const MeshInstanceData> instances = m_meshInstances.Instances();
+        if (!instances.empty()) {
+            XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+            XRC_CHECK_THROW_GLCMD(
+                glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(instances.size() * sizeof(MeshInstanceData)), instances.data(), GL_STREAM_DRAW));
+        }
+
+        // Draw each mesh once, with all of its instances.
+        for (const MeshInstanceBatch& batch : m_meshInstances.Batches()) {
+            OpenGLMesh& glMesh = m_meshes[batch.mesh];
+            XRC_CHECK_THROW_GLCMD(glBindVertexArray(glMesh.m_vao));
+            XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glMesh.m_indexBuffer));
+
+            // Point the instance attributes at this batch's range of the instance buffer.
+            XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+            const size_t batchOffset = batch.firstInstance * sizeof(MeshInstanceData);
+            for (GLint column = 0; column < 4; ++column) {
+                const size_t offset = batchOffset + offsetof(MeshInstanceData, model) + column * 4 * sizeof(float);
+                XRC_CHECK_THROW_GLCMD(glVertexAttribPointer(m_instanceAttribModel + column, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstanceData),
+                                                            reinterpret_cast<const void*>(offset)));
+            }
+            const size_t tintOffset = batchOffset + offsetof(MeshInstanceData, tintColor);
+            XRC_CHECK_THROW_GLCMD(glVertexAttribPointer(m_instanceAttribTintColor, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstanceData),
+                                                        reinterpret_cast<const void*>(tintOffset)));
+
+            XRC_CHECK_THROW_GLCMD(glDrawElementsInstanced(GL_TRIANGLES, GLsizei(glMesh.m_numIndices), GL_UNSIGNED_SHORT, nullptr,
+                                                          GLsizei(batch.instanceCount)));
+        }
+    }
+
+    const OpenGLGraphicsPlugin::MultiviewProgram& OpenGLGraphicsPlugin::GetMultiviewProgram(uint32_t viewCount)
+    {
+        auto it = m_multiviewPrograms.find(viewCount);
+        if (it != m_multiviewPrograms.end()) {
+            return it->second;
+        }
+
+        const std::string vertexShaderSource = "#version 410\n"
+                                               "#extension GL_OVR_multiview2 : require\n"
+                                               "#define VIEW_COUNT " +
+                                               std::to_string(viewCount) + "\nlayout(num_views = VIEW_COUNT) in;\n" +
+                                               MultiviewVertexShaderGlslBody;
+        const char* vertexShaderSourcePtr = vertexShaderSource.c_str();
+
+        GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertexShader, 1, &vertexShaderSourcePtr, nullptr);
+        glCompileShader(vertexShader);
+        CheckGLShader(vertexShader);
+
+        GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragmentShader, 1, &FragmentShaderGlsl, nullptr);
+        glCompileShader(fragmentShader);
+        CheckGLShader(fragmentShader);
+
+        MultiviewProgram multiviewProgram;
+        multiviewProgram.program = glCreateProgram();
+        glAttachShader(multiviewProgram.program, vertexShader);
+        glAttachShader(multiviewProgram.program, fragmentShader);
+        // Mesh vertex arrays are shared with m_program, so the attributes must be at the same locations.
+        glBindAttribLocation(multiviewProgram.program, m_vertexAttribCoords, "VertexPos");
+        glBindAttribLocation(multiviewProgram.program, m_vertexAttribColor, "VertexColor");
+        glBindAttribLocation(multiviewProgram.program, m_instanceAttribModel, "InstanceModel");
+        glBindAttribLocation(multiviewProgram.program, m_instanceAttribTintColor, "InstanceTintColor");
+        glLinkProgram(multiviewProgram.program);
+        CheckGLProgram(multiviewProgram.program);
+
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+
+        multiviewProgram.viewProjectionUniformLocation = glGetUniformLocation(multiviewProgram.program, "ViewProjection");
+
+        return m_multiviewPrograms.emplace(viewCount, multiviewProgram).first->second;
+    }
+
+    void OpenGLGraphicsPlugin::RenderMultiview(span<const XrCompositionLayerProjectionView> layerViews,
+                                               const XrSwapchainImageBaseHeader* colorSwapchainImage, const RenderParams& params)
+    {
+        OpenGLSwapchainImageData* swapchainData;
+        uint32_t imageIndex;
+        std::tie(swapchainData, imageIndex) = m_swapchainImageDataMap.GetDataAndIndexFromBasePointer(colorSwapchainImage);
+
+        // Single-pass rendering needs the views to be consecutive slices sharing one image rect,
+        // and glTF models are drawn by the PBR renderer, which has no multiview variant.
+        bool singlePass = m_supportsMultiview && layerViews.size() > 1 && int64_t(layerViews.size()) <= m_maxMultiviewViews &&
+                          swapchainData->HasMultipleSlices() && !swapchainData->IsMultisample() && params.glTFs.empty();
+        for (size_t i = 1; singlePass && i < layerViews.size(); ++i) {
+            const XrSwapchainSubImage& first = layerViews[0].subImage;
+            const XrSwapchainSubImage& subImage = layerViews[i].subImage;
+            singlePass = subImage.imageArrayIndex == first.imageArrayIndex + i &&
+                         subImage.imageRect.offset.x == first.imageRect.offset.x &&
+                         subImage.imageRect.offset.y == first.imageRect.offset.y &&
+                         subImage.imageRect.extent.width == first.imageRect.extent.width &&
+                         subImage.imageRect.extent.height == first.imageRect.extent.height;
+        }
+        if (!singlePass) {
+            IGraphicsPlugin::RenderMultiview(layerViews, colorSwapchainImage, params);
+            return;
+        }
+
+        const GLsizei viewCount = GLsizei(layerViews.size());
+        const GLint baseViewIndex = GLint(layerViews[0].subImage.imageArrayIndex);
+
+        XRC_CHECK_THROW_GLCMD(glBindFramebuffer(GL_FRAMEBUFFER, m_swapchainFramebuffer));
+
+        const GLuint colorTexture = reinterpret_cast<const XrSwapchainImageOpenGLKHR*>(colorSwapchainImage)->image;
+        const GLuint depthTexture = swapchainData->GetDepthImageForColorIndex(imageIndex).image;
+        XRC_CHECK_THROW_GLCMD(
+            glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorTexture, 0, baseViewIndex, viewCount));
+        XRC_CHECK_THROW_GLCMD(
+            glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, baseViewIndex, viewCount));
+
+        CheckFramebuffer(m_swapchainFramebuffer);
+
+        SetRenderState(layerViews[0].subImage.imageRect);
+
+        const MultiviewProgram& multiviewProgram = GetMultiviewProgram(uint32_t(viewCount));
+        XRC_CHECK_THROW_GLCMD(glUseProgram(multiviewProgram.program));
+
+        // All the views' view-projection transforms go up in one uniform array.
+        std::vector<XrMatrix4x4f> viewProjections(layerViews.size());
+        for (size_t i = 0; i < layerViews.size(); ++i) {
+            XrMatrix4x4f proj;
+            XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_OPENGL, layerViews[i].fov, 0.05f, 100.0f);
+            XrMatrix4x4f view = Matrix::InvertRigidBody(Matrix::FromPose(layerViews[i].pose));
+            viewProjections[i] = proj * view;
+        }
+        XRC_CHECK_THROW_GLCMD(glUniformMatrix4fv(multiviewProgram.viewProjectionUniformLocation, viewCount, GL_FALSE,
+                                                 reinterpret_cast<const GLfloat*>(viewProjections.data())));
+
+        DrawMeshInstances(params);
+
+        glBindVertexArray(0);
+        glUseProgram(0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
     std::shared_ptr<IGraphicsPlugin> CreateGraphicsPlugin_OpenGL(std::shared_ptr<IPlatformPlugin> platformPlugin)
     {
         return std::make_shared<OpenGLGraphicsPlugin>(std::move(platformPlugin));
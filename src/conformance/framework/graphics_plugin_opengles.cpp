@@ -16,10 +16,12 @@
 
 #ifdef XR_USE_GRAPHICS_API_OPENGL_ES
 
+#include "asset_loader.h"
 #include "conformance_framework.h"
 #include "graphics_plugin.h"
 #include "graphics_plugin_impl_helpers.h"
 #include "graphics_plugin_opengl_gltf.h"
+#include "mesh_instancing.h"
 #include "report.h"
 #include "swapchain_image_data.h"
 
@@ -30,6 +32,7 @@
 #include "pbr/OpenGL/GLResources.h"
 #include "pbr/OpenGL/GLTexture.h"
 #include "utilities/Geometry.h"
+#include "utilities/opengl_utils.h"
 #include "utilities/swapchain_format_data.h"
 #include "utilities/swapchain_parameters.h"
 #include "utilities/throw_helpers.h"
@@ -40,6 +43,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -71,15 +75,16 @@ namespace Conformance
 
     in vec3 VertexPos;
     in vec3 VertexColor;
+    in mat4 InstanceModel;
+    in vec4 InstanceTintColor;
 
     out vec3 PSVertexColor;
 
-    uniform mat4 ModelViewProjection;
-    uniform vec4 tintColor;
+    uniform mat4 ViewProjection;
 
     void main() {
-       gl_Position = ModelViewProjection * vec4(VertexPos, 1.0);
-       PSVertexColor = mix(VertexColor, tintColor.rgb, tintColor.a);
+       gl_Position = ViewProjection * (InstanceModel * vec4(VertexPos, 1.0));
+       PSVertexColor = mix(VertexColor, InstanceTintColor.rgb, InstanceTintColor.a);
     }
     )_";
 
@@ -102,8 +107,9 @@ namespace Conformance
         GLuint m_indexBuffer{0};
         uint32_t m_numIndices;
 
-        OpenGLESMesh(GLint vertexAttribCoords, GLint vertexAttribColor,  //
-                     const uint16_t* idx_data, uint32_t idx_count,       //
+        OpenGLESMesh(GLint vertexAttribCoords, GLint vertexAttribColor,            //
+                     GLint instanceAttribModel, GLint instanceAttribTintColor,  //
+                     const uint16_t* idx_data, uint32_t idx_count,                 //
                      const Geometry::Vertex* vtx_data, uint32_t vtx_count)
         {
             m_numIndices = idx_count;
@@ -126,6 +132,14 @@ namespace Conformance
             glVertexAttribPointer(vertexAttribColor, 3, GL_FLOAT, GL_FALSE, sizeof(Geometry::Vertex),
                                   reinterpret_cast<const void*>(sizeof(XrVector3f)));
 
+            // Per-instance attributes; their buffer and offsets are set for each batch in RenderView.
+            for (GLint column = 0; column < 4; ++column) {
+                glEnableVertexAttribArray(instanceAttribModel + column);
+                glVertexAttribDivisor(instanceAttribModel + column, 1);
+            }
+            glEnableVertexAttribArray(instanceAttribTintColor);
+            glVertexAttribDivisor(instanceAttribTintColor, 1);
+
             valid = true;
         }
 
@@ -312,6 +326,9 @@ namespace Conformance
     private:
         bool initialized{false};
 
+        /// Draw the cubes and meshes of `params` with the bound program, one instanced draw per mesh.
+        void DrawMeshInstances(const RenderParams& params);
+
         void InitializeResources();
         void ShutdownResources();
         XrVersion OpenGLESVersionOfContext = 0;
@@ -324,10 +341,14 @@ namespace Conformance
 
         GLuint m_swapchainFramebuffer{0};
         GLuint m_program{0};
-        GLint m_modelViewProjectionUniformLocation{0};
-        GLint m_tintColorUniformLocation{0};
+        PixelUnpackBufferRing m_pixelUnpackBuffers;
+        GLint m_viewProjectionUniformLocation{0};
         GLint m_vertexAttribCoords{0};
         GLint m_vertexAttribColor{0};
+        GLint m_instanceAttribModel{0};
+        GLint m_instanceAttribTintColor{0};
+        GLuint m_instanceBuffer{0};
+        MeshInstanceList m_meshInstances;
         MeshHandle m_cubeMesh{};
         VectorWithGenerationCountedHandles<OpenGLESMesh, MeshHandle> m_meshes;
         // This is fine to be a shared_ptr because Model doesn't directly hold any graphics state.
@@ -408,18 +429,8 @@ namespace Conformance
 
         const uint32_t img = swapchainData->GetTypedImage(imageIndex).image;
         GL(glBindTexture(target, img));
-        if (isArray) {
-            for (GLuint y = 0; y < height; ++y) {
-                const void* pixels = &image.pixels[(height - 1 - y) * width];
-                GL(glTexSubImage3D(target, 0, 0, y, arraySlice, width, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
-        else {
-            for (GLuint y = 0; y < height; ++y) {
-                const void* pixels = &image.pixels[(height - 1 - y) * width];
-                GL(glTexSubImage2D(target, 0, 0, y, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
+        m_pixelUnpackBuffers.UploadFlippedRGBA8(target, static_cast<GLint>(arraySlice), static_cast<GLsizei>(width),
+                                                static_cast<GLsizei>(height), image.pixels.data());
         GL(glBindTexture(target, 0));
     }
 
@@ -564,11 +575,14 @@ namespace Conformance
         GL(glDeleteShader(vertexShader));
         GL(glDeleteShader(fragmentShader));
 
-        m_modelViewProjectionUniformLocation = glGetUniformLocation(m_program, "ModelViewProjection");
-        m_tintColorUniformLocation = glGetUniformLocation(m_program, "tintColor");
+        m_viewProjectionUniformLocation = glGetUniformLocation(m_program, "ViewProjection");
 
         m_vertexAttribCoords = glGetAttribLocation(m_program, "VertexPos");
         m_vertexAttribColor = glGetAttribLocation(m_program, "VertexColor");
+        m_instanceAttribModel = glGetAttribLocation(m_program, "InstanceModel");
+        m_instanceAttribTintColor = glGetAttribLocation(m_program, "InstanceTintColor");
+
+        GL(glGenBuffers(1, &m_instanceBuffer));
 
         m_cubeMesh = MakeCubeMesh();
 
@@ -579,9 +593,9 @@ namespace Conformance
         m_pbrResources->SetEnvironmentMap(blackCubeMap, blackCubeMap);
 
         // Read the BRDF Lookup Table used by the PBR system into a GL texture.
-        std::vector<unsigned char> brdfLutFileData = ReadFileBytes("brdf_lut.png");
+        std::shared_ptr<const std::vector<uint8_t>> brdfLutFileData = GetGlobalData().GetAssetLoader().ReadFile("brdf_lut.png").Get();
         auto brdLutResourceView = std::make_shared<Pbr::ScopedGLTexture>(
-            Pbr::GLTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData.data(), (uint32_t)brdfLutFileData.size()));
+            Pbr::GLTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData->data(), (uint32_t)brdfLutFileData->size()));
         m_pbrResources->SetBrdfLut(brdLutResourceView);
     }
 
@@ -594,6 +608,11 @@ namespace Conformance
             if (m_program != 0) {
                 GL(glDeleteProgram(m_program));
             }
+            if (m_instanceBuffer != 0) {
+                GL(glDeleteBuffers(1, &m_instanceBuffer));
+                m_instanceBuffer = 0;
+            }
+            m_pixelUnpackBuffers.Reset();
 
             m_swapchainImageDataMap.Reset();
 
@@ -601,6 +620,9 @@ namespace Conformance
             m_meshes.clear();
             m_gltfInstances.clear();
             m_gltfModels.clear();
+            if (m_pbrResources) {
+                ReportCacheStatsConsoleOnly("glTF image texture", m_pbrResources->GetImageTextureCacheStats());
+            }
             m_pbrResources.reset();
 
             ksGpuWindow_Destroy(&window);
@@ -1245,8 +1267,8 @@ namespace Conformance
 
     MeshHandle OpenGLESGraphicsPlugin::MakeSimpleMesh(span<const uint16_t> idx, span<const Geometry::Vertex> vtx)
     {
-        auto handle = m_meshes.emplace_back(m_vertexAttribCoords, m_vertexAttribColor, idx.data(), (uint32_t)idx.size(), vtx.data(),
-                                            (uint32_t)vtx.size());
+        auto handle = m_meshes.emplace_back(m_vertexAttribCoords, m_vertexAttribColor, m_instanceAttribModel, m_instanceAttribTintColor,
+                                            idx.data(), (uint32_t)idx.size(), vtx.data(), (uint32_t)vtx.size());
 
         return handle;
     }
@@ -1274,6 +1296,40 @@ namespace Conformance
         return m_gltfInstances[handle].GetModelInstance();
     }
 
+    void OpenGLESGraphicsPlugin::DrawMeshInstances(const RenderParams& params)
+    {
+        // Group the cubes and meshes by mesh and stream their transforms and tint colors into the instance buffer.
+        // Respecifying the whole buffer each view orphans the previous storage, so this never waits on earlier draws.
+        m_meshInstances.Build(params, m_cubeMesh);
+        span<const MeshInstanceData> instances = m_meshInstances.Instances();
+        if (!instances.empty()) {
+            GL(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+            GL(glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(instances.size() * sizeof(MeshInstanceData)), instances.data(), GL_STREAM_DRAW));
+        }
+
+        // Draw each mesh once, with all of its instances.
+        for (const MeshInstanceBatch& batch : m_meshInstances.Batches()) {
+            OpenGLESMesh& glMesh = m_meshes[batch.mesh];
+            GL(glBindVertexArray(glMesh.m_vao));
+            GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glMesh.m_indexBuffer));
+
+            // Point the instance attributes at this batch's range of the instance buffer.
+            GL(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+            const size_t batchOffset = batch.firstInstance * sizeof(MeshInstanceData);
+            for (GLint column = 0; column < 4; ++column) {
+                const size_t offset = batchOffset + offsetof(MeshInstanceData, model) + column * 4 * sizeof(float);
+                GL(glVertexAttribPointer(m_instanceAttribModel + column, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstanceData),
+                                         reinterpret_cast<const void*>(offset)));
+            }
+            const size_t tintOffset = batchOffset + offsetof(MeshInstanceData, tintColor);
+            GL(glVertexAttribPointer(m_instanceAttribTintColor, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstanceData),
+                                     reinterpret_cast<const void*>(tintOffset)));
+
+            GL(glDrawElementsInstanced(GL_TRIANGLES, GLsizei(glMesh.m_numIndices), GL_UNSIGNED_SHORT, nullptr,
+                                       GLsizei(batch.instanceCount)));
+        }
+    }
+
     void OpenGLESGraphicsPlugin::RenderView(const XrCompositionLayerProjectionView& layerView,
                                             const XrSwapchainImageBaseHeader* colorSwapchainImage, const RenderParams& params)
     {
@@ -1323,40 +1379,9 @@ namespace Conformance
         XrMatrix4x4f toView = Matrix::FromPose(pose);
         XrMatrix4x4f view = Matrix::InvertRigidBody(toView);
         XrMatrix4x4f vp = proj * view;
+        GL(glUniformMatrix4fv(m_viewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&vp)));
 
-        MeshHandle lastMeshHandle;
-
-        const auto drawMesh = [this, &vp, &lastMeshHandle](const MeshDrawable mesh) {
-            OpenGLESMesh& glMesh = m_meshes[mesh.handle];
-            if (mesh.handle != lastMeshHandle) {
-                // We are now rendering a new mesh
-                GL(glBindVertexArray(glMesh.m_vao));
-                glBindBuffer(GL_ARRAY_BUFFER, glMesh.m_vertexBuffer);
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glMesh.m_indexBuffer);
-
-                lastMeshHandle = mesh.handle;
-            }
-
-            // Compute the model-view-projection transform and set it..
-            XrMatrix4x4f model =
-                Matrix::FromTranslationRotationScale(mesh.params.pose.position, mesh.params.pose.orientation, mesh.params.scale);
-            XrMatrix4x4f mvp = vp * model;
-            GL(glUniformMatrix4fv(m_modelViewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&mvp)));
-            GL(glUniform4fv(m_tintColorUniformLocation, 1, reinterpret_cast<const GLfloat*>(&mesh.tintColor)));
-
-            // Draw the mesh.
-            GL(glDrawElements(GL_TRIANGLES, glMesh.m_numIndices, GL_UNSIGNED_SHORT, nullptr));
-        };
-
-        // Render each cube
-        for (const Cube& cube : params.cubes) {
-            drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
-        }
-
-        // Render each mesh
-        for (const auto& mesh : params.meshes) {
-            drawMesh(mesh);
-        }
+        DrawMeshInstances(params);
 
         // Render each gltf
         for (const auto& gltfDrawable : params.glTFs) {
@@ -16,11 +16,13 @@
 
 #ifdef XR_USE_GRAPHICS_API_VULKAN
 #include "RGBAImage.h"
+#include "asset_loader.h"
 #include "conformance_utils.h"
 #include "gltf_helpers.h"
 #include "graphics_plugin.h"
 #include "graphics_plugin_impl_helpers.h"
 #include "graphics_plugin_vulkan_gltf.h"
+#include "mesh_instancing.h"
 #include "report.h"
 #include "swapchain_image_data.h"
 
@@ -85,12 +87,14 @@ namespace Conformance
 
     layout (std140, push_constant) uniform buf
     {
-        mat4 mvp;
-        vec4 tintColor;
+        mat4 viewProjection;
     } ubuf;
 
     layout (location = 0) in vec3 Position;
     layout (location = 1) in vec3 Color;
+    // Per instance: MeshInstanceData
+    layout (location = 2) in mat4 InstanceModel;
+    layout (location = 6) in vec4 InstanceTintColor;
 
     layout (location = 0) out vec4 oColor;
     out gl_PerVertex
@@ -100,9 +104,40 @@ namespace Conformance
 
     void main()
     {
-        oColor.rgb = mix(Color.rgb, ubuf.tintColor.rgb, ubuf.tintColor.a);
+        oColor.rgb = mix(Color.rgb, InstanceTintColor.rgb, InstanceTintColor.a);
         oColor.a  = 1.0;
-        gl_Position = ubuf.mvp * vec4(Position, 1);
+        gl_Position = ubuf.viewProjection * (InstanceModel * vec4(Position, 1));
+    }
+)_";
+
+    constexpr char MultiviewVertexShaderGlsl[] =
+        R"_(
+    #version 430
+    #extension GL_ARB_separate_shader_objects : enable
+    #extension GL_EXT_multiview : enable
+
+    layout (std140, push_constant) uniform buf
+    {
+        mat4 viewProjection[2];
+    } ubuf;
+
+    layout (location = 0) in vec3 Position;
+    layout (location = 1) in vec3 Color;
+    // Per instance: MeshInstanceData
+    layout (location = 2) in mat4 InstanceModel;
+    layout (location = 6) in vec4 InstanceTintColor;
+
+    layout (location = 0) out vec4 oColor;
+    out gl_PerVertex
+    {
+        vec4 gl_Position;
+    };
+
+    void main()
+    {
+        oColor.rgb = mix(Color.rgb, InstanceTintColor.rgb, InstanceTintColor.a);
+        oColor.a  = 1.0;
+        gl_Position = ubuf.viewProjection[gl_ViewIndex] * (InstanceModel * vec4(Position, 1));
     }
 )_";
 
@@ -122,49 +157,57 @@ namespace Conformance
 )_";
 #endif  // USE_ONLINE_VULKAN_SHADERC
 
+    /// View mask of the multiview render passes: a stereo pair, in two consecutive array slices.
+    constexpr uint32_t StereoViewMask = 0x3;
+
+    /// A render pass and the pipeline for drawing meshes into it. Created once per device for each combination of formats,
+    /// sample count and view mask (see VulkanGraphicsPlugin::GetRenderPassState), and shared by every swapchain using it.
+    struct VulkanRenderPassState
+    {
+        VulkanRenderPassState() = default;
+        VulkanRenderPassState(const VulkanRenderPassState&) = delete;
+        RenderPass m_rp{};
+        Pipeline m_pipe{};
+    };
+
     struct VulkanArraySliceState
     {
         VulkanArraySliceState() = default;
         VulkanArraySliceState(const VulkanArraySliceState&) = delete;
         std::vector<RenderTarget> m_renderTarget;  // per swapchain index
-        RenderPass m_rp{};
-        Pipeline m_pipe{};
+        const VulkanRenderPassState* m_renderPassState{nullptr};
 
-        void init(const VulkanDebugObjectNamer& namer, VkDevice device, uint32_t capacity, const VkExtent2D size, VkFormat colorFormat,
-                  VkFormat depthFormat, VkSampleCountFlagBits sampleCount, const PipelineLayout& layout, const ShaderProgram& sp,
-                  const VkVertexInputBindingDescription& bindDesc, span<const VkVertexInputAttributeDescription> attrDesc)
+        void init(uint32_t capacity, const VulkanRenderPassState& renderPassState)
         {
             m_renderTarget.resize(capacity);
-            m_rp.Create(namer, device, colorFormat, depthFormat, sampleCount);
-            VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_VIEWPORT};
-            m_pipe.Create(device, size, layout, m_rp, sp, bindDesc, attrDesc, dynamicStates);
+            m_renderPassState = &renderPassState;
         }
 
         void Reset()
         {
-            m_pipe.Reset();
-            m_rp.Reset();
             m_renderTarget.clear();
+            m_renderPassState = nullptr;
         }
     };
 
     /// Vulkan data used per swapchain. One per XrSwapchain handle.
     class VulkanSwapchainImageData : public SwapchainImageDataBase<XrSwapchainImageVulkanKHR>
     {
-        void init(uint32_t capacity, VkFormat colorFormat, const PipelineLayout& layout, const ShaderProgram& sp,
-                  const VkVertexInputBindingDescription& bindDesc, span<const VkVertexInputAttributeDescription> attrDesc)
+        void init(uint32_t capacity, const VulkanRenderPassState& renderPassState)
         {
             m_depthBuffer.resize(capacity);
             for (auto& slice : m_slices) {
-                slice.init(m_namer, m_vkDevice, capacity, m_size, colorFormat, m_depthFormat, m_sampleCount, layout, sp, bindDesc,
-                           attrDesc);
+                slice.init(capacity, renderPassState);
             }
         }
 
     public:
+        /// Depth format of the depth buffers allocated when there is no depth swapchain.
+        static constexpr VkFormat FallbackDepthFormat = VK_FORMAT_D32_SFLOAT;
+
+        /// @param renderPassState must match the color format and sample count of @p swapchainCreateInfo, and FallbackDepthFormat.
         VulkanSwapchainImageData(const VulkanDebugObjectNamer& namer, uint32_t capacity, const XrSwapchainCreateInfo& swapchainCreateInfo,
-                                 VkDevice device, MemoryAllocator* memAllocator, const PipelineLayout& layout, const ShaderProgram& sp,
-                                 const VkVertexInputBindingDescription& bindDesc, span<const VkVertexInputAttributeDescription> attrDesc)
+                                 VkDevice device, MemoryAllocator* memAllocator, const VulkanRenderPassState& renderPassState)
             : SwapchainImageDataBase(XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR, capacity, swapchainCreateInfo)
             , m_namer(namer)
             , m_vkDevice(device)
@@ -173,13 +216,14 @@ namespace Conformance
             , m_sampleCount{(VkSampleCountFlagBits)swapchainCreateInfo.sampleCount}
             , m_slices(swapchainCreateInfo.arraySize)
         {
-            init(capacity, (VkFormat)swapchainCreateInfo.format, layout, sp, bindDesc, attrDesc);
+            init(capacity, renderPassState);
         }
 
+        /// @param renderPassState must match the color format and sample count of @p swapchainCreateInfo, and the format of
+        /// @p depthSwapchainCreateInfo.
         VulkanSwapchainImageData(const VulkanDebugObjectNamer& namer, uint32_t capacity, const XrSwapchainCreateInfo& swapchainCreateInfo,
                                  XrSwapchain depthSwapchain, const XrSwapchainCreateInfo& depthSwapchainCreateInfo, VkDevice device,
-                                 MemoryAllocator* memAllocator, const PipelineLayout& layout, const ShaderProgram& sp,
-                                 const VkVertexInputBindingDescription& bindDesc, span<const VkVertexInputAttributeDescription> attrDesc)
+                                 MemoryAllocator* memAllocator, const VulkanRenderPassState& renderPassState)
             : SwapchainImageDataBase(XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR, capacity, swapchainCreateInfo, depthSwapchain,
                                      depthSwapchainCreateInfo)
             , m_namer(namer)
@@ -190,7 +234,7 @@ namespace Conformance
             , m_depthFormat((VkFormat)depthSwapchainCreateInfo.format)
             , m_slices(swapchainCreateInfo.arraySize)
         {
-            init(capacity, (VkFormat)swapchainCreateInfo.format, layout, sp, bindDesc, attrDesc);
+            init(capacity, renderPassState);
         }
 
         ~VulkanSwapchainImageData() override
@@ -203,7 +247,7 @@ namespace Conformance
                               VkRenderPassBeginInfo* renderPassBeginInfo)
         {
             RenderTarget& rt = m_slices[arraySlice].m_renderTarget[index];
-            RenderPass& rp = m_slices[arraySlice].m_rp;
+            const RenderPass& rp = m_slices[arraySlice].m_renderPassState->m_rp;
             if (rt.fb == VK_NULL_HANDLE) {
                 rt.Create(m_namer, m_vkDevice, GetTypedImage(index).image, GetDepthImageForColorIndex(index).image, secondAttachmentAspect,
                           arraySlice, m_size, rp);
@@ -215,7 +259,34 @@ namespace Conformance
 
         void BindPipeline(VkCommandBuffer buf, uint32_t arraySlice)
         {
-            vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, m_slices[arraySlice].m_pipe.pipe);
+            vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, m_slices[arraySlice].m_renderPassState->m_pipe.pipe);
+        }
+
+        /// @param renderPassState must match the single-view render pass state, with the StereoViewMask view mask.
+        void SetMultiviewRenderPassState(const VulkanRenderPassState& renderPassState)
+        {
+            m_multiviewRenderPassState = &renderPassState;
+        }
+
+        /// Null unless the swapchain can be rendered with VK_KHR_multiview.
+        const VulkanRenderPassState* GetMultiviewRenderPassState() const
+        {
+            return m_multiviewRenderPassState;
+        }
+
+        /// Like BindRenderTarget, for the multiview render pass drawing the stereo pair starting at @p baseArraySlice.
+        void BindMultiviewRenderTarget(uint32_t index, uint32_t baseArraySlice, const VkRect2D& renderArea,
+                                       VkImageAspectFlags secondAttachmentAspect, VkRenderPassBeginInfo* renderPassBeginInfo)
+        {
+            RenderTarget& rt = m_multiviewRenderTargets[std::make_pair(index, baseArraySlice)];
+            const RenderPass& rp = m_multiviewRenderPassState->m_rp;
+            if (rt.fb == VK_NULL_HANDLE) {
+                rt.Create(m_namer, m_vkDevice, GetTypedImage(index).image, GetDepthImageForColorIndex(index).image, secondAttachmentAspect,
+                          baseArraySlice, m_size, rp);
+            }
+            renderPassBeginInfo->renderPass = rp.pass;
+            renderPassBeginInfo->framebuffer = rt.fb;
+            renderPassBeginInfo->renderArea = renderArea;
         }
 
         void TransitionLayout(uint32_t imageIndex, CmdBuffer* cmdBuffer, VkImageLayout newLayout)
@@ -228,6 +299,8 @@ namespace Conformance
             for (auto& slice : m_slices) {
                 slice.Reset();
             }
+            m_multiviewRenderTargets.clear();
+            m_multiviewRenderPassState = nullptr;
             m_depthBuffer.clear();
             SwapchainImageDataBase::Reset();
         }
@@ -255,9 +328,11 @@ namespace Conformance
         VkExtent2D m_size{};
         VkSampleCountFlagBits m_sampleCount;
         std::vector<DepthBuffer> m_depthBuffer;  // per swapchain index
-        VkFormat m_depthFormat{VK_FORMAT_D32_SFLOAT};
+        VkFormat m_depthFormat{FallbackDepthFormat};
 
         std::vector<VulkanArraySliceState> m_slices;
+        const VulkanRenderPassState* m_multiviewRenderPassState{nullptr};
+        std::map<std::pair<uint32_t, uint32_t>, RenderTarget> m_multiviewRenderTargets;  // by swapchain index and base slice
     };
 
 #if defined(USE_MIRROR_WINDOW)
@@ -550,6 +625,26 @@ namespace Conformance
     constexpr VkVertexInputAttributeDescription VulkanMesh::c_attrDesc[];
     constexpr VkVertexInputBindingDescription VulkanMesh::c_bindingDesc;
 
+    /// Vertex input of the mesh pipeline: the vertices of a VulkanMesh in binding 0, and one MeshInstanceData per instance in binding 1.
+    struct MeshPipelineVertexInput
+    {
+        static constexpr uint32_t c_instanceBinding = 1;
+        static constexpr VkVertexInputBindingDescription c_bindingDesc[2] = {
+            VulkanMesh::c_bindingDesc, {c_instanceBinding, sizeof(MeshInstanceData), VK_VERTEX_INPUT_RATE_INSTANCE}};
+        // The instance model matrix takes one location per column.
+        static constexpr VkVertexInputAttributeDescription c_attrDesc[7] = {
+            VulkanMesh::c_attrDesc[0],
+            VulkanMesh::c_attrDesc[1],
+            {2, c_instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(MeshInstanceData, model)},
+            {3, c_instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(MeshInstanceData, model) + 4 * sizeof(float)},
+            {4, c_instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(MeshInstanceData, model) + 8 * sizeof(float)},
+            {5, c_instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(MeshInstanceData, model) + 12 * sizeof(float)},
+            {6, c_instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(MeshInstanceData, tintColor)}};
+    };
+    constexpr uint32_t MeshPipelineVertexInput::c_instanceBinding;
+    constexpr VkVertexInputBindingDescription MeshPipelineVertexInput::c_bindingDesc[];
+    constexpr VkVertexInputAttributeDescription MeshPipelineVertexInput::c_attrDesc[];
+
     struct VulkanGraphicsPlugin : public IGraphicsPlugin
     {
         VulkanGraphicsPlugin(const std::shared_ptr<IPlatformPlugin>& /*unused*/);
@@ -560,6 +655,7 @@ namespace Conformance
         {
             if (m_vkDevice != VK_NULL_HANDLE) {
                 vkDeviceWaitIdle(m_vkDevice);
+                m_stagingRing.WaitIdle();
             }
         }
 
@@ -669,9 +765,24 @@ namespace Conformance
         void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                         const RenderParams& params) override;
 
+        void RenderMultiview(span<const XrCompositionLayerProjectionView> layerViews, const XrSwapchainImageBaseHeader* colorSwapchainImage,
+                             const RenderParams& params) override;
+
         /// Get data on a known swapchain format
         const SwapchainFormatData& FindFormatData(int64_t format) const;
 
+        /// Gets the render pass and mesh pipeline for these formats, sample count and multiview view mask, creating them (and
+        /// warming up the glTF pipelines for a single-view render pass) the first time, so that no pipeline is compiled while
+        /// recording a frame.
+        const VulkanRenderPassState& GetRenderPassState(VkFormat colorFormat, VkFormat depthFormat, VkSampleCountFlagBits sampleCount,
+                                                        uint32_t viewMask = 0);
+
+        /// Lets swapchains with more than one array slice render stereo pairs in a single pass, when VK_KHR_multiview is enabled.
+        void InitMultiview(VulkanSwapchainImageData& swapchainData);
+
+        /// Records one instanced draw per mesh for the cubes and meshes of params, into the current render pass.
+        void DrawMeshInstances(const RenderParams& params);
+
 #if defined(USE_CHECKPOINTS)
         void Checkpoint(std::string msg)
         {
@@ -714,15 +825,25 @@ namespace Conformance
         VkSemaphore m_vkDrawDone{VK_NULL_HANDLE};
 
         MemoryAllocator m_memAllocator{};
+        PipelineCache m_pipelineCache{};
         ShaderProgram m_shaderProgram{};
+        bool m_supportsMultiview{false};
+        ShaderProgram m_multiviewShaderProgram{};  // Only created if m_supportsMultiview
         CmdBuffer m_cmdBuffer{};
+        StagingBufferRing m_stagingRing{};
         PipelineLayout m_pipelineLayout{};
         MeshHandle m_cubeMesh{};
         VectorWithGenerationCountedHandles<VulkanMesh, MeshHandle> m_meshes;
+        MeshInstanceList m_meshInstances;
+        StructuredBuffer<MeshInstanceData> m_instanceBuffer{};
+        uint32_t m_instanceBufferCapacity{0};
         // This is fine to be a shared_ptr because Model doesn't directly hold any graphics state.
         VectorWithGenerationCountedHandles<std::shared_ptr<Pbr::Model>, GLTFModelHandle> m_gltfModels;
         VectorWithGenerationCountedHandles<VulkanGLTF, GLTFModelInstanceHandle> m_gltfInstances;
         std::unique_ptr<Pbr::VulkanResources> m_pbrResources;
+        // Keyed by color format, depth format, sample count and view mask; see GetRenderPassState.
+        std::map<std::tuple<VkFormat, VkFormat, VkSampleCountFlagBits, uint32_t>, std::unique_ptr<VulkanRenderPassState>>
+            m_renderPassStates;
 
 #if defined(USE_MIRROR_WINDOW)
         Swapchain m_swapchain{};
@@ -1119,6 +1240,7 @@ namespace Conformance
         }
 
         VkResult err;
+        bool hasPhysicalDeviceProperties2 = false;
         {
             // Note: This cannot outlive the extensionNames above, since it's just a collection of views into that string!
             std::vector<const char*> extensions;
@@ -1141,6 +1263,11 @@ namespace Conformance
                 if (isExtSupported(VK_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
                     extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
                 }
+                // Required by VK_KHR_multiview on Vulkan 1.0
+                hasPhysicalDeviceProperties2 = isExtSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+                if (hasPhysicalDeviceProperties2) {
+                    extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+                }
                 // TODO add back VK_EXT_debug_report code for compatibility with older systems? (Android)
             }
 
@@ -1243,12 +1370,33 @@ namespace Conformance
 
         std::vector<const char*> deviceExtensions;
 
+        // Single-pass stereo rendering (see RenderMultiview) uses VK_KHR_multiview when available. Every device exposing the
+        // extension supports its multiview feature.
+        m_supportsMultiview = false;
+        if (hasPhysicalDeviceProperties2) {
+            uint32_t extensionCount = 0;
+            XRC_CHECK_THROW_VKCMD(vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, nullptr));
+            std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+            XRC_CHECK_THROW_VKCMD(
+                vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, availableExtensions.data()));
+            m_supportsMultiview =
+                std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties& properties) {
+                    return 0 == strcmp(VK_KHR_MULTIVIEW_EXTENSION_NAME, properties.extensionName);
+                });
+        }
+        VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR};
+        if (m_supportsMultiview) {
+            deviceExtensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+            multiviewFeatures.multiview = VK_TRUE;
+        }
+
         VkPhysicalDeviceFeatures features{};
         // features.samplerAnisotropy = VK_TRUE;
         // Setting this quiets down a validation error triggered by the Oculus runtime
         // features.shaderStorageImageMultisample = VK_TRUE;
 
         VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+        deviceInfo.pNext = m_supportsMultiview ? &multiviewFeatures : nullptr;
         deviceInfo.flags = VkDeviceCreateFlags(deviceCreationFlags);
         deviceInfo.queueCreateInfoCount = 1;
         deviceInfo.pQueueCreateInfos = &queueInfo;
@@ -1272,6 +1420,7 @@ namespace Conformance
         vkGetDeviceQueue(m_vkDevice, queueInfo.queueFamilyIndex, 0, &m_vkQueue);
 
         m_memAllocator.Init(m_vkPhysicalDevice, m_vkDevice);
+        m_pipelineCache.Init(m_vkPhysicalDevice, m_vkDevice, GetGlobalData().options.vulkanPipelineCacheFile);
 
         InitializeResources();
 
@@ -1326,6 +1475,23 @@ namespace Conformance
         m_shaderProgram.LoadVertexShader(vertexSPIRV);
         m_shaderProgram.LoadFragmentShader(fragmentSPIRV);
 
+        if (m_supportsMultiview) {
+#ifdef USE_ONLINE_VULKAN_SHADERC
+            auto multiviewVertexSPIRV =
+                CompileGlslShader("multiview vertex", shaderc_glsl_default_vertex_shader, MultiviewVertexShaderGlsl);
+#else
+            std::vector<uint32_t> multiviewVertexSPIRV = SPV_PREFIX
+#include "vert_multiview.spv"  // IWYU pragma: keep
+                SPV_SUFFIX;
+#endif
+            if (multiviewVertexSPIRV.empty())
+                XRC_THROW("Failed to compile multiview vertex shader");
+
+            m_multiviewShaderProgram.Init(m_vkDevice);
+            m_multiviewShaderProgram.LoadVertexShader(multiviewVertexSPIRV);
+            m_multiviewShaderProgram.LoadFragmentShader(fragmentSPIRV);
+        }
+
         // Semaphore to block on draw complete
         VkSemaphoreCreateInfo semInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
         XRC_CHECK_THROW_VKCMD(vkCreateSemaphore(m_vkDevice, &semInfo, nullptr, &m_vkDrawDone));
@@ -1334,6 +1500,9 @@ namespace Conformance
         if (!m_cmdBuffer.Init(m_namer, m_vkDevice, m_queueFamilyIndex))
             XRC_THROW("Failed to create command buffer");
 
+        // Enough for a few full-screen RGBA images; grows if a larger image is uploaded.
+        m_stagingRing.Init(m_namer, m_vkDevice, m_memAllocator, m_queueFamilyIndex, 16 * 1024 * 1024);
+
         m_pipelineLayout.Create(m_vkDevice);
         XRC_CHECK_THROW_VKCMD(
             m_namer.SetName(VK_OBJECT_TYPE_PIPELINE_LAYOUT, (uint64_t)m_pipelineLayout.layout, "CTS graphics pipeline layout"));
@@ -1342,7 +1511,8 @@ namespace Conformance
 
         m_cubeMesh = MakeCubeMesh();
 
-        m_pbrResources = std::make_unique<Pbr::VulkanResources>(m_namer, m_vkPhysicalDevice, m_vkDevice, m_queueFamilyIndex);
+        m_pbrResources =
+            std::make_unique<Pbr::VulkanResources>(m_namer, m_vkPhysicalDevice, m_vkDevice, m_queueFamilyIndex, &m_pipelineCache);
         m_pbrResources->SetLight({0.0f, 0.7071067811865475f, 0.7071067811865475f}, Pbr::RGB::White);
 
         auto blackCubeMap =
@@ -1350,9 +1520,9 @@ namespace Conformance
         m_pbrResources->SetEnvironmentMap(blackCubeMap, blackCubeMap);
 
         // Read the BRDF Lookup Table used by the PBR system into a Vulkan texture.
-        std::vector<unsigned char> brdfLutFileData = ReadFileBytes("brdf_lut.png");
+        std::shared_ptr<const std::vector<uint8_t>> brdfLutFileData = GetGlobalData().GetAssetLoader().ReadFile("brdf_lut.png").Get();
         auto brdLutResourceView = std::make_shared<Pbr::VulkanTextureBundle>(
-            Pbr::VulkanTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData.data(), (uint32_t)brdfLutFileData.size()));
+            Pbr::VulkanTexture::LoadTextureImage(*m_pbrResources, false, brdfLutFileData->data(), (uint32_t)brdfLutFileData->size()));
         m_pbrResources->SetBrdfLut(brdLutResourceView);
 
 #if defined(USE_MIRROR_WINDOW)
@@ -1381,9 +1551,13 @@ namespace Conformance
             // Reset the swapchains to avoid calling Vulkan functions in the dtors after
             // we've shut down the device.
 
+            if (m_pbrResources) {
+                ReportCacheStatsConsoleOnly("glTF image texture", m_pbrResources->GetImageTextureCacheStats());
+            }
             m_pbrResources.reset();
 
             m_swapchainImageDataMap.Reset();
+            m_renderPassStates.clear();
             m_cubeMesh = {};
             m_meshes.clear();
             m_gltfInstances.clear();
@@ -1397,15 +1571,23 @@ namespace Conformance
                 m_vkDrawDone = VK_NULL_HANDLE;
             }
 
+            m_stagingRing.Reset();
+            m_instanceBuffer.Reset();
+            m_instanceBufferCapacity = 0;
             m_cmdBuffer.Reset();
             m_pipelineLayout.Reset();
             m_shaderProgram.Reset();
+            m_multiviewShaderProgram.Reset();
+            m_supportsMultiview = false;
             m_memAllocator.Reset();
 
 #if defined(USE_MIRROR_WINDOW)
             m_swapchain.Reset();
             m_swapchainImageData.clear();
 #endif
+            GetGlobalData().RecordGraphicsPipelineCreation(m_pipelineCache.createdCount, m_pipelineCache.creationTime);
+            m_pipelineCache.Reset();
+
             vkDestroyDevice(m_vkDevice, nullptr);
             m_vkDevice = VK_NULL_HANDLE;
         }
@@ -1717,11 +1899,47 @@ namespace Conformance
         return VK_FORMAT_R8G8B8A8_SRGB;
     }
 
+    const VulkanRenderPassState& VulkanGraphicsPlugin::GetRenderPassState(VkFormat colorFormat, VkFormat depthFormat,
+                                                                          VkSampleCountFlagBits sampleCount, uint32_t viewMask)
+    {
+        std::unique_ptr<VulkanRenderPassState>& state =
+            m_renderPassStates[std::make_tuple(colorFormat, depthFormat, sampleCount, viewMask)];
+        if (!state) {
+            auto newState = std::make_unique<VulkanRenderPassState>();
+            newState->m_rp.Create(m_namer, m_vkDevice, colorFormat, depthFormat, sampleCount, viewMask);
+            VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_VIEWPORT};
+            const ShaderProgram& shaderProgram = viewMask != 0 ? m_multiviewShaderProgram : m_shaderProgram;
+            newState->m_pipe.Create(m_vkDevice, VkExtent2D{}, m_pipelineLayout, newState->m_rp, shaderProgram,
+                                    MeshPipelineVertexInput::c_bindingDesc, MeshPipelineVertexInput::c_attrDesc, dynamicStates,
+                                    &m_pipelineCache);
+            // glTF models are only drawn by RenderView.
+            if (viewMask == 0) {
+                m_pbrResources->WarmUpPipelines(newState->m_rp.pass, sampleCount);
+            }
+            state = std::move(newState);
+        }
+        return *state;
+    }
+
+    void VulkanGraphicsPlugin::InitMultiview(VulkanSwapchainImageData& swapchainData)
+    {
+        if (m_supportsMultiview && swapchainData.HasMultipleSlices()) {
+            const XrSwapchainCreateInfo& createInfo = swapchainData.GetCreateInfo();
+            const VulkanRenderPassState& renderPassState =
+                GetRenderPassState((VkFormat)createInfo.format, (VkFormat)swapchainData.GetDepthFormat(),
+                                   (VkSampleCountFlagBits)createInfo.sampleCount, StereoViewMask);
+            swapchainData.SetMultiviewRenderPassState(renderPassState);
+        }
+    }
+
     ISwapchainImageData* VulkanGraphicsPlugin::AllocateSwapchainImageData(size_t size, const XrSwapchainCreateInfo& swapchainCreateInfo)
     {
+        const VulkanRenderPassState& renderPassState =
+            GetRenderPassState((VkFormat)swapchainCreateInfo.format, VulkanSwapchainImageData::FallbackDepthFormat,
+                               (VkSampleCountFlagBits)swapchainCreateInfo.sampleCount);
         auto typedResult = std::make_unique<VulkanSwapchainImageData>(m_namer, uint32_t(size), swapchainCreateInfo, m_vkDevice,
-                                                                      &m_memAllocator, m_pipelineLayout, m_shaderProgram,
-                                                                      VulkanMesh::c_bindingDesc, VulkanMesh::c_attrDesc);
+                                                                      &m_memAllocator, renderPassState);
+        InitMultiview(*typedResult);
 
         // Cast our derived type to the caller-expected type.
         auto ret = static_cast<ISwapchainImageData*>(typedResult.get());
@@ -1735,10 +1953,13 @@ namespace Conformance
         size_t size, const XrSwapchainCreateInfo& colorSwapchainCreateInfo, XrSwapchain depthSwapchain,
         const XrSwapchainCreateInfo& depthSwapchainCreateInfo)
     {
-
-        auto typedResult = std::make_unique<VulkanSwapchainImageData>(
-            m_namer, uint32_t(size), colorSwapchainCreateInfo, depthSwapchain, depthSwapchainCreateInfo, m_vkDevice, &m_memAllocator,
-            m_pipelineLayout, m_shaderProgram, VulkanMesh::c_bindingDesc, VulkanMesh::c_attrDesc);
+        const VulkanRenderPassState& renderPassState =
+            GetRenderPassState((VkFormat)colorSwapchainCreateInfo.format, (VkFormat)depthSwapchainCreateInfo.format,
+                               (VkSampleCountFlagBits)colorSwapchainCreateInfo.sampleCount);
+        auto typedResult =
+            std::make_unique<VulkanSwapchainImageData>(m_namer, uint32_t(size), colorSwapchainCreateInfo, depthSwapchain,
+                                                       depthSwapchainCreateInfo, m_vkDevice, &m_memAllocator, renderPassState);
+        InitMultiview(*typedResult);
 
         // Cast our derived type to the caller-expected type.
         auto ret = static_cast<ISwapchainImageData*>(typedResult.get());
@@ -1761,58 +1982,16 @@ namespace Conformance
         uint32_t w = image.width;
         uint32_t h = image.height;
 
-        // Create a linear staging buffer
-        VkImageCreateInfo imgInfo{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
-        imgInfo.imageType = VK_IMAGE_TYPE_2D;
-
         int64_t imageFormat = swapchainData->GetCreateInfo().format;
         XRC_CHECK_THROW(imageFormat == GetSRGBA8Format());
 
-        imgInfo.format = static_cast<VkFormat>(imageFormat);
-        imgInfo.extent = {w, h, 1};
-        imgInfo.mipLevels = 1;
-        imgInfo.arrayLayers = 1;
-        imgInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-        imgInfo.tiling = VK_IMAGE_TILING_LINEAR;
-        imgInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        imgInfo.initialLayout = VK_IMAGE_LAYOUT_PREINITIALIZED;
-        VkImage stagingImage{VK_NULL_HANDLE};
-        XRC_CHECK_THROW_VKCMD(vkCreateImage(m_vkDevice, &imgInfo, nullptr, &stagingImage));
-
-        VkMemoryRequirements memReq{};
-        vkGetImageMemoryRequirements(m_vkDevice, stagingImage, &memReq);
-        VkDeviceMemory stagingMemory{VK_NULL_HANDLE};
-        m_memAllocator.Allocate(memReq, &stagingMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        XRC_CHECK_THROW_VKCMD(vkBindImageMemory(m_vkDevice, stagingImage, stagingMemory, 0));
-
-        VkImageSubresource imgSubRes{};
-        imgSubRes.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        imgSubRes.mipLevel = 0;
-        imgSubRes.arrayLayer = 0;
-        VkSubresourceLayout layout{};
-        vkGetImageSubresourceLayout(m_vkDevice, stagingImage, &imgSubRes, &layout);
-
-        uint8_t* data{nullptr};
-        XRC_CHECK_THROW_VKCMD(vkMapMemory(m_vkDevice, stagingMemory, layout.offset, layout.size, 0, (void**)&data));
-        image.CopyWithStride(data, static_cast<uint32_t>(layout.rowPitch), static_cast<uint32_t>(layout.offset));
-        vkUnmapMemory(m_vkDevice, stagingMemory);
-
-        m_cmdBuffer.Clear();
-        m_cmdBuffer.Begin();
+        // Write the pixels into the persistently-mapped staging ring; the region is reused once this upload's fence signals.
+        const VkDeviceSize imageSize = VkDeviceSize(w) * h * sizeof(RGBA8Color);
+        StagingBufferRing::Upload upload = m_stagingRing.Acquire(imageSize);
+        image.CopyWithStride(upload.data, w * static_cast<uint32_t>(sizeof(RGBA8Color)), 0);
 
-        // Switch the staging buffer from PREINITIALIZED -> TRANSFER_SRC_OPTIMAL
+        VkCommandBuffer cmdBuffer = upload.cmdBuffer->buf;
         VkImageMemoryBarrier imgBarrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-        imgBarrier.srcAccessMask = 0;
-        imgBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        imgBarrier.oldLayout = VK_IMAGE_LAYOUT_PREINITIALIZED;
-        imgBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        imgBarrier.srcQueueFamilyIndex = m_queueFamilyIndex;
-        imgBarrier.dstQueueFamilyIndex = m_queueFamilyIndex;
-        imgBarrier.image = stagingImage;
-        imgBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-        vkCmdPipelineBarrier(m_cmdBuffer.buf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
-                             &imgBarrier);
 
         // Switch the destination image from COLOR_ATTACHMENT_OPTIMAL -> TRANSFER_DST_OPTIMAL
         //
@@ -1831,16 +2010,15 @@ namespace Conformance
         imgBarrier.dstQueueFamilyIndex = m_queueFamilyIndex;
         imgBarrier.image = swapchainImageVk->image;
         imgBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, arraySlice, 1};
-        vkCmdPipelineBarrier(m_cmdBuffer.buf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
                              &imgBarrier);
 
-        // Blit staging -> swapchain
-        VkImageBlit blit = {{VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
-                            {{0, 0, 0}, {(int32_t)w, (int32_t)h, 1}},
-                            {VK_IMAGE_ASPECT_COLOR_BIT, 0, arraySlice, 1},
-                            {{0, 0, 0}, {(int32_t)w, (int32_t)h, 1}}};
-        vkCmdBlitImage(m_cmdBuffer.buf, stagingImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, swapchainImageVk->image,
-                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_NEAREST);
+        // Copy staging -> swapchain
+        VkBufferImageCopy region{};
+        region.bufferOffset = upload.offset;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, arraySlice, 1};
+        region.imageExtent = {w, h, 1};
+        vkCmdCopyBufferToImage(cmdBuffer, upload.buffer, swapchainImageVk->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
         // Switch the destination image from TRANSFER_DST_OPTIMAL -> COLOR_ATTACHMENT_OPTIMAL
         //
@@ -1860,15 +2038,10 @@ namespace Conformance
         imgBarrier.dstQueueFamilyIndex = m_queueFamilyIndex;
         imgBarrier.image = swapchainImageVk->image;
         imgBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, arraySlice, 1};
-        vkCmdPipelineBarrier(m_cmdBuffer.buf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr,
-                             0, nullptr, 1, &imgBarrier);
-
-        m_cmdBuffer.End();
-        m_cmdBuffer.Exec(m_vkQueue);
-        m_cmdBuffer.Wait();
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr, 0,
+                             nullptr, 1, &imgBarrier);
 
-        vkDestroyImage(m_vkDevice, stagingImage, nullptr);
-        vkFreeMemory(m_vkDevice, stagingMemory, nullptr);
+        m_stagingRing.Submit(m_vkQueue);
     }
 
     void VulkanGraphicsPlugin::SetViewportAndScissor(const VkRect2D& rect)
@@ -2006,6 +2179,50 @@ namespace Conformance
         return m_gltfInstances[handle].GetModelInstance();
     }
 
+    void VulkanGraphicsPlugin::DrawMeshInstances(const RenderParams& params)
+    {
+        m_meshInstances.Build(params, m_cubeMesh);
+        span<const MeshInstanceData> instances = m_meshInstances.Instances();
+        if (instances.empty()) {
+            return;
+        }
+
+        // RenderView and RenderMultiview wait for their command buffer to complete, so the instance buffer is never in use by the
+        // GPU here.
+        if (instances.size() > m_instanceBufferCapacity) {
+            uint32_t capacity = std::max<uint32_t>(m_instanceBufferCapacity * 2, 256);
+            while (capacity < instances.size()) {
+                capacity *= 2;
+            }
+            m_instanceBuffer.Reset();
+            m_instanceBuffer.Init(m_vkDevice, m_memAllocator);
+            m_instanceBuffer.Create(capacity, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            XRC_CHECK_THROW_VKCMD(m_namer.SetName(VK_OBJECT_TYPE_BUFFER, (uint64_t)m_instanceBuffer.buf, "CTS mesh instance buffer"));
+            m_instanceBufferCapacity = capacity;
+        }
+        m_instanceBuffer.Update(instances);
+
+        for (const MeshInstanceBatch& batch : m_meshInstances.Batches()) {
+            VulkanMesh& vkMesh = m_meshes[batch.mesh];
+
+            // Bind index and vertex buffers
+            vkCmdBindIndexBuffer(m_cmdBuffer.buf, vkMesh.m_DrawBuffer.idx.buf, 0, VK_INDEX_TYPE_UINT16);
+
+            CHECKPOINT();
+
+            const VkBuffer vertexBuffers[] = {vkMesh.m_DrawBuffer.vtx.buf, m_instanceBuffer.buf};
+            const VkDeviceSize offsets[] = {0, 0};
+            vkCmdBindVertexBuffers(m_cmdBuffer.buf, 0, 2, vertexBuffers, offsets);
+
+            CHECKPOINT();
+
+            // Draw every instance of the mesh.
+            vkCmdDrawIndexed(m_cmdBuffer.buf, vkMesh.m_DrawBuffer.count.idx, batch.instanceCount, 0, 0, batch.firstInstance);
+
+            CHECKPOINT();
+        }
+    }
+
     void VulkanGraphicsPlugin::RenderView(const XrCompositionLayerProjectionView& layerView,
                                           const XrSwapchainImageBaseHeader* colorSwapchainImage, const RenderParams& params)
     {
@@ -2052,50 +2269,16 @@ namespace Conformance
         XrMatrix4x4f toView = Matrix::FromPose(pose);
         XrMatrix4x4f view = Matrix::InvertRigidBody(toView);
         XrMatrix4x4f vp = proj * view;
-        MeshHandle lastMeshHandle;
 
-        const auto drawMesh = [this, &vp, &lastMeshHandle](const MeshDrawable mesh) {
-            VulkanMesh& vkMesh = m_meshes[mesh.handle];
-            if (mesh.handle != lastMeshHandle) {
-                // We are now rendering a new mesh
+        // Push the view-projection transform once; the model transforms and tint colors are per instance.
+        VulkanUniformBuffer ubuf;
+        ubuf.viewProjection = vp;
+        vkCmdPushConstants(m_cmdBuffer.buf, m_pipelineLayout.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VulkanUniformBuffer), &ubuf);
 
-                // Bind index and vertex buffers
-                vkCmdBindIndexBuffer(m_cmdBuffer.buf, vkMesh.m_DrawBuffer.idx.buf, 0, VK_INDEX_TYPE_UINT16);
-
-                CHECKPOINT();
-
-                VkDeviceSize offset = 0;
-                vkCmdBindVertexBuffers(m_cmdBuffer.buf, 0, 1, &vkMesh.m_DrawBuffer.vtx.buf, &offset);
-
-                CHECKPOINT();
-                lastMeshHandle = mesh.handle;
-            }
-
-            // Compute the model-view-projection transform and push it.
-            XrMatrix4x4f model =
-                Matrix::FromTranslationRotationScale(mesh.params.pose.position, mesh.params.pose.orientation, mesh.params.scale);
-            VulkanUniformBuffer ubuf;
-            ubuf.tintColor = mesh.tintColor;
-            ubuf.mvp = vp * model;
-            vkCmdPushConstants(m_cmdBuffer.buf, m_pipelineLayout.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VulkanUniformBuffer), &ubuf);
-
-            CHECKPOINT();
-
-            // Draw the mesh.
-            vkCmdDrawIndexed(m_cmdBuffer.buf, vkMesh.m_DrawBuffer.count.idx, 1, 0, 0, 0);
-
-            CHECKPOINT();
-        };
-
-        // Render each cube
-        for (const Cube& cube : params.cubes) {
-            drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
-        }
+        CHECKPOINT();
 
-        // Render each mesh
-        for (const auto& mesh : params.meshes) {
-            drawMesh(mesh);
-        }
+        // Render the cubes and meshes, one instanced draw per mesh
+        DrawMeshInstances(params);
 
         // Render each gltf
         for (const auto& gltfDrawable : params.glTFs) {
@@ -2125,6 +2308,89 @@ namespace Conformance
 
         m_pbrResources->Wait();
 
+#if defined(USE_MIRROR_WINDOW)
+        // Cycle the window's swapchain on the last view rendered
+        if (swapchainData == &m_swapchainImageData.back()) {
+            m_swapchain.Acquire();
+            m_swapchain.Present(m_vkQueue);
+        }
+#endif
+    }
+
+    void VulkanGraphicsPlugin::RenderMultiview(span<const XrCompositionLayerProjectionView> layerViews,
+                                               const XrSwapchainImageBaseHeader* colorSwapchainImage, const RenderParams& params)
+    {
+        VulkanSwapchainImageData* swapchainData;
+        uint32_t imageIndex;
+        std::tie(swapchainData, imageIndex) = m_swapchainImageDataMap.GetDataAndIndexFromBasePointer(colorSwapchainImage);
+
+        // Single-pass rendering needs a stereo pair in consecutive slices sharing one image rect, since the multiview vertex
+        // shader holds two view-projection transforms, and glTF models are drawn by the PBR renderer, which has no multiview variant.
+        bool singlePass = swapchainData->GetMultiviewRenderPassState() != nullptr && layerViews.size() == 2 && params.glTFs.empty();
+        if (singlePass) {
+            const XrSwapchainSubImage& first = layerViews[0].subImage;
+            const XrSwapchainSubImage& second = layerViews[1].subImage;
+            singlePass = second.imageArrayIndex == first.imageArrayIndex + 1 && second.imageRect.offset.x == first.imageRect.offset.x &&
+                         second.imageRect.offset.y == first.imageRect.offset.y &&
+                         second.imageRect.extent.width == first.imageRect.extent.width &&
+                         second.imageRect.extent.height == first.imageRect.extent.height;
+        }
+        if (!singlePass) {
+            IGraphicsPlugin::RenderMultiview(layerViews, colorSwapchainImage, params);
+            return;
+        }
+
+        m_cmdBuffer.Clear();
+        m_cmdBuffer.Begin();
+
+        CHECKPOINT();
+
+        const XrRect2Di& r = layerViews[0].subImage.imageRect;
+        VkRect2D renderArea = {{r.offset.x, r.offset.y}, {uint32_t(r.extent.width), uint32_t(r.extent.height)}};
+        SetViewportAndScissor(renderArea);
+
+        // may be depth, stencil, or both
+        const SwapchainFormatData& secondFormatData = FindFormatData(swapchainData->GetDepthFormat());
+        VkImageAspectFlags secondAttachmentAspect = ComputeAspectFlags(secondFormatData);
+
+        // Just bind the render target covering both slices, ClearImageSlice will have cleared them.
+        VkRenderPassBeginInfo renderPassBeginInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+        swapchainData->BindMultiviewRenderTarget(imageIndex, layerViews[0].subImage.imageArrayIndex, renderArea, secondAttachmentAspect,
+                                                 &renderPassBeginInfo);
+
+        vkCmdBeginRenderPass(m_cmdBuffer.buf, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        CHECKPOINT();
+
+        vkCmdBindPipeline(m_cmdBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, swapchainData->GetMultiviewRenderPassState()->m_pipe.pipe);
+
+        CHECKPOINT();
+
+        // Push both view-projection transforms; the vertex shader picks one with gl_ViewIndex.
+        VulkanMultiviewUniformBuffer ubuf;
+        for (size_t i = 0; i < layerViews.size(); ++i) {
+            XrMatrix4x4f proj;
+            XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_VULKAN, layerViews[i].fov, 0.05f, 100.0f);
+            XrMatrix4x4f view = Matrix::InvertRigidBody(Matrix::FromPose(layerViews[i].pose));
+            ubuf.viewProjection[i] = proj * view;
+        }
+        vkCmdPushConstants(m_cmdBuffer.buf, m_pipelineLayout.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VulkanMultiviewUniformBuffer),
+                           &ubuf);
+
+        CHECKPOINT();
+
+        // Render the cubes and meshes to both views, one instanced draw per mesh
+        DrawMeshInstances(params);
+
+        vkCmdEndRenderPass(m_cmdBuffer.buf);
+
+        CHECKPOINT();
+
+        m_cmdBuffer.End();
+        m_cmdBuffer.Exec(m_vkQueue);
+        // XXX Should double-buffer the command buffers, for now just flush
+        m_cmdBuffer.Wait();
+
 #if defined(USE_MIRROR_WINDOW)
         // Cycle the window's swapchain on the last view rendered
         if (swapchainData == &m_swapchainImageData.back()) {
@@ -0,0 +1,69 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mesh_instancing.h"
+
+#include "utilities/xr_math_operators.h"
+
+namespace Conformance
+{
+    uint32_t MeshInstanceList::FindOrAddBatch(MeshHandle mesh)
+    {
+        // Scenes use a handful of distinct meshes, and drawables sharing a mesh tend to be adjacent,
+        // so check the most recently used batch before scanning.
+        if (!m_batchIndices.empty() && m_batches[m_batchIndices.back()].mesh == mesh) {
+            return m_batchIndices.back();
+        }
+        for (uint32_t i = 0; i < m_batches.size(); ++i) {
+            if (m_batches[i].mesh == mesh) {
+                return i;
+            }
+        }
+        m_batches.push_back(MeshInstanceBatch{mesh, 0, 0});
+        return static_cast<uint32_t>(m_batches.size() - 1);
+    }
+
+    void MeshInstanceList::Build(const RenderParams& params, MeshHandle cubeMesh)
+    {
+        m_instances.clear();
+        m_batches.clear();
+        m_batchIndices.clear();
+
+        // First pass: assign each drawable to a batch and count the instances per batch.
+        for (size_t i = 0; i < params.cubes.size(); ++i) {
+            uint32_t batch = FindOrAddBatch(cubeMesh);
+            m_batches[batch].instanceCount++;
+            m_batchIndices.push_back(batch);
+        }
+        for (const MeshDrawable& mesh : params.meshes) {
+            uint32_t batch = FindOrAddBatch(mesh.handle);
+            m_batches[batch].instanceCount++;
+            m_batchIndices.push_back(batch);
+        }
+
+        uint32_t firstInstance = 0;
+        for (MeshInstanceBatch& batch : m_batches) {
+            batch.firstInstance = firstInstance;
+            firstInstance += batch.instanceCount;
+            // Reused below as the write cursor for the batch.
+            batch.instanceCount = 0;
+        }
+        m_instances.resize(firstInstance);
+
+        // Second pass: write each instance into its batch's range.
+        const auto addInstance = [this](uint32_t batchIndex, const DrawableParams& drawable, const XrColor4f& tintColor) {
+            MeshInstanceBatch& batch = m_batches[batchIndex];
+            MeshInstanceData& instance = m_instances[batch.firstInstance + batch.instanceCount++];
+            instance.model = Matrix::FromTranslationRotationScale(drawable.pose.position, drawable.pose.orientation, drawable.scale);
+            instance.tintColor = tintColor;
+        };
+        size_t drawableIndex = 0;
+        for (const Cube& cube : params.cubes) {
+            addInstance(m_batchIndices[drawableIndex++], cube.params, cube.tintColor);
+        }
+        for (const MeshDrawable& mesh : params.meshes) {
+            addInstance(m_batchIndices[drawableIndex++], mesh.params, mesh.tintColor);
+        }
+    }
+}  // namespace Conformance
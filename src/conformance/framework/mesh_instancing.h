@@ -0,0 +1,61 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "graphics_plugin.h"
+
+#include <openxr/openxr.h>
+#include <nonstd/span.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Conformance
+{
+    /// Per-instance data for instanced cube and mesh drawing, laid out for use as an instance-rate vertex buffer.
+    struct MeshInstanceData
+    {
+        /// Column-major model-to-world transform.
+        XrMatrix4x4f model;
+        XrColor4f tintColor;
+    };
+
+    /// A contiguous run of instances in a @ref MeshInstanceList that share a mesh, drawable with one instanced draw call.
+    struct MeshInstanceBatch
+    {
+        MeshHandle mesh;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    /// Groups the cubes and meshes of a @ref RenderParams by mesh, so that each distinct mesh is drawn with a single
+    /// instanced draw call instead of one draw per drawable.
+    ///
+    /// Keeps its storage between calls to @ref Build so that per-frame use does not allocate.
+    class MeshInstanceList
+    {
+    public:
+        /// Rebuild the instance and batch lists from `params`. Cubes are drawn with `cubeMesh`.
+        /// Batches appear in the order their mesh is first used, and instances keep their relative order within a batch.
+        void Build(const RenderParams& params, MeshHandle cubeMesh);
+
+        span<const MeshInstanceData> Instances() const
+        {
+            return m_instances;
+        }
+
+        span<const MeshInstanceBatch> Batches() const
+        {
+            return m_batches;
+        }
+
+    private:
+        uint32_t FindOrAddBatch(MeshHandle mesh);
+
+        std::vector<MeshInstanceData> m_instances;
+        std::vector<MeshInstanceBatch> m_batches;
+        std::vector<uint32_t> m_batchIndices;
+    };
+}  // namespace Conformance
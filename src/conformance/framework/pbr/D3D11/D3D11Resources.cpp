@@ -17,6 +17,7 @@
 #include "../D3DCommon.h"
 #include "../../gltf/GltfHelper.h"
 #include "../PbrMaterial.h"
+#include "../PbrTexture.h"
 
 #include "utilities/throw_helpers.h"
 
@@ -169,6 +170,7 @@ namespace Pbr
             Microsoft::WRL::ComPtr<ID3D11DepthStencilState> DepthStencilStates[2][2];  // Two dimensions for [ReverseZ][NoWrite]
             std::vector<Conformance::Image::FormatParams> SupportedTextureFormats;
             mutable D3D11TextureCache SolidColorTextureCache;
+            mutable ImageTextureCache<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> GltfImageTextureCache;
         };
         PrimitiveCollection<D3D11Primitive> Primitives;
 
@@ -277,7 +279,8 @@ namespace Pbr
             // TODO: Generate mipmaps if sampler's minification filter (minFilter) uses mipmapping.
             // TODO: If texture is not power-of-two and (sampler has wrapping=repeat/mirrored_repeat OR minFilter uses
             // mipmapping), resize to power-of-two.
-            textureView = LoadGLTFImage(*this, *image, sRGB);
+            textureView =
+                m_impl->Resources.GltfImageTextureCache.FindOrCreate(*image, sRGB, [&] { return LoadGLTFImage(*this, *image, sRGB); });
             m_impl->loaderResources.imageMap[imageKey] = textureView;
         }
 
@@ -365,6 +368,16 @@ namespace Pbr
         return m_impl->Resources.SolidColorTextureCache.CreateTypedSolidColorTexture(*this, color, sRGB);
     }
 
+    void D3D11Resources::SetImageTextureCacheBudget(size_t bytes)
+    {
+        m_impl->Resources.GltfImageTextureCache.SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats D3D11Resources::GetImageTextureCacheStats() const
+    {
+        return m_impl->Resources.GltfImageTextureCache.GetStats();
+    }
+
     void D3D11Resources::Bind(_In_ ID3D11DeviceContext* context) const
     {
         context->UpdateSubresource(m_impl->Resources.SceneConstantBuffer.Get(), 0, nullptr, &m_impl->SceneBuffer, 0, 0);
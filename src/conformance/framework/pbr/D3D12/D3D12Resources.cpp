@@ -19,6 +19,7 @@
 #include "../../RGBAImage.h"
 #include "../../gltf/GltfHelper.h"
 #include "../PbrMaterial.h"
+#include "../PbrTexture.h"
 
 #include "utilities/d3d12_queue_wrapper.h"
 #include "utilities/d3d12_utils.h"
@@ -243,6 +244,7 @@ namespace Pbr
             std::unique_ptr<D3D12PipelineStates> PipelineStates{};
             std::vector<Conformance::Image::FormatParams> SupportedTextureFormats;
             mutable D3D12TextureCache SolidColorTextureCache;
+            mutable ImageTextureCache<std::shared_ptr<Conformance::D3D12ResourceWithSRVDesc>> GltfImageTextureCache;
         };
         PrimitiveCollection<D3D12Primitive> Primitives;
 
@@ -356,8 +358,10 @@ namespace Pbr
             // TODO: Generate mipmaps if sampler's minification filter (minFilter) uses mipmapping.
             // TODO: If texture is not power-of-two and (sampler has wrapping=repeat/mirrored_repeat OR minFilter uses
             // mipmapping), resize to power-of-two.
-            textureView = std::make_shared<Conformance::D3D12ResourceWithSRVDesc>(
-                LoadGLTFImage(*this, copyCommandList, stagingResources, *image, sRGB));
+            textureView = m_impl->Resources.GltfImageTextureCache.FindOrCreate(*image, sRGB, [&] {
+                return std::make_shared<Conformance::D3D12ResourceWithSRVDesc>(
+                    LoadGLTFImage(*this, copyCommandList, stagingResources, *image, sRGB));
+            });
             m_impl->loaderResources.imageMap[imageKey] = textureView;
         }
 
@@ -477,6 +481,16 @@ namespace Pbr
         return m_impl->Resources.SolidColorTextureCache.CreateTypedSolidColorTexture(*this, copyCommandList, stagingResources, color, sRGB);
     }
 
+    void D3D12Resources::SetImageTextureCacheBudget(size_t bytes)
+    {
+        m_impl->Resources.GltfImageTextureCache.SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats D3D12Resources::GetImageTextureCacheStats() const
+    {
+        return m_impl->Resources.GltfImageTextureCache.GetStats();
+    }
+
     span<const Conformance::Image::FormatParams> D3D12Resources::GetSupportedFormats() const
     {
         if (m_impl->Resources.SupportedTextureFormats.size() == 0) {
@@ -14,6 +14,7 @@
 #include "../PbrSharedState.h"
 
 #include "utilities/d3d12_utils.h"
+#include "utilities/lru_cache.h"
 #include "utilities/throw_helpers.h"
 
 #include <nonstd/span.hpp>
@@ -106,6 +107,11 @@ namespace Pbr
         Conformance::D3D12ResourceWithSRVDesc CreateTypedSolidColorTexture(ID3D12GraphicsCommandList* copyCommandList,
                                                                            StagingResources stagingResources, RGBAColor color, bool sRGB);
 
+        /// Textures created from glTF images are shared by all models loaded through these resources when the image contents match.
+        /// Sets how many bytes of image data that cache may hold, or gets its hit and miss counters.
+        void SetImageTextureCacheBudget(size_t bytes);
+        Conformance::LruCacheStats GetImageTextureCacheStats() const;
+
         /// Get the cached list of texture formats supported by the device
         span<const Conformance::Image::FormatParams> GetSupportedFormats() const;
 
@@ -32,10 +32,17 @@
 
 namespace
 {
-    // Load a glTF node from the tinygltf object model. This will process the node's mesh (if specified) and then recursively load the child
-    // nodes too.
+    // A glTF primitive to be added to the PBR model, along with the transform of the node referencing it.
+    struct NodePrimitive
+    {
+        Pbr::NodeIndex_t transformIndex;
+        const tinygltf::Primitive* gltfPrimitive;
+    };
+
+    // Load a glTF node from the tinygltf object model. This adds the node's transform to the Pbr Model and records the primitives
+    // of the node's mesh (if specified), then recursively loads the child nodes too.
     void LoadNode(Pbr::NodeIndex_t parentNodeIndex, const tinygltf::Model& gltfModel, int nodeId,
-                  GltfHelper::PrimitiveCache& primitiveCache, Gltf::PrimitiveBuilderMap& primitiveBuilderMap, Pbr::Model& model)
+                  std::vector<NodePrimitive>& nodePrimitives, Pbr::Model& model)
     {
         const tinygltf::Node& gltfNode = gltfModel.nodes.at(nodeId);
 
@@ -48,50 +55,56 @@ namespace
             // A glTF mesh is composed of primitives.
             const tinygltf::Mesh& gltfMesh = gltfModel.meshes.at(gltfNode.mesh);
             for (const tinygltf::Primitive& gltfPrimitive : gltfMesh.primitives) {
-                // Read the primitive data from the glTF buffers.
-                const GltfHelper::Primitive primitive = primitiveCache.ReadPrimitive(gltfPrimitive);
-
-                // Insert or append the primitive into the PBR primitive builder. Primitives which use the same
-                // material are appended to reduce the number of draw calls.
-                Pbr::PrimitiveBuilder& primitiveBuilder = primitiveBuilderMap[gltfPrimitive.material];
-
-                // Use the starting offset for vertices and indices since multiple glTF primitives can
-                // be put into the same primitive builder.
-                const uint32_t startVertex = (uint32_t)primitiveBuilder.Vertices.size();
-                const uint32_t startIndex = (uint32_t)primitiveBuilder.Indices.size();
-
-                // Convert the GltfHelper vertices into the PBR vertex format.
-                primitiveBuilder.Vertices.resize(startVertex + primitive.Vertices.size());
-                for (size_t i = 0; i < primitive.Vertices.size(); i++) {
-                    const GltfHelper::Vertex& vertex = primitive.Vertices[i];
-                    Pbr::Vertex pbrVertex;
-                    pbrVertex.Position = vertex.Position;
-                    pbrVertex.Normal = vertex.Normal;
-                    pbrVertex.Tangent = vertex.Tangent;
-                    pbrVertex.Color0 = vertex.Color0;
-                    pbrVertex.TexCoord0 = vertex.TexCoord0;
-                    pbrVertex.ModelTransformIndex = transformIndex;
-
-                    primitiveBuilder.Vertices[i + startVertex] = pbrVertex;
-                }
-
-                // Insert indices with reverse winding order.
-                primitiveBuilder.Indices.resize(startIndex + primitive.Indices.size());
-                for (size_t i = 0; i < primitive.Indices.size(); i += 3) {
-                    primitiveBuilder.Indices[startIndex + i + 0] = startVertex + primitive.Indices[i + 0];
-                    primitiveBuilder.Indices[startIndex + i + 1] = startVertex + primitive.Indices[i + 2];
-                    primitiveBuilder.Indices[startIndex + i + 2] = startVertex + primitive.Indices[i + 1];
-                }
-
-                primitiveBuilder.NodeIndices.insert(transformIndex);
+                nodePrimitives.push_back({transformIndex, &gltfPrimitive});
             }
         }
 
         // Recursively load all children.
         for (const int childNodeId : gltfNode.children) {
-            LoadNode(transformIndex, gltfModel, childNodeId, primitiveCache, primitiveBuilderMap, model);
+            LoadNode(transformIndex, gltfModel, childNodeId, nodePrimitives, model);
         }
     }
+
+    // Append a primitive read from the glTF buffers to the PBR primitive builder for its material.
+    void AddPrimitive(const NodePrimitive& nodePrimitive, const GltfHelper::Primitive& primitive,
+                      Gltf::PrimitiveBuilderMap& primitiveBuilderMap)
+    {
+        const Pbr::NodeIndex_t transformIndex = nodePrimitive.transformIndex;
+
+        // Insert or append the primitive into the PBR primitive builder. Primitives which use the same
+        // material are appended to reduce the number of draw calls.
+        Pbr::PrimitiveBuilder& primitiveBuilder = primitiveBuilderMap[nodePrimitive.gltfPrimitive->material];
+
+        // Use the starting offset for vertices and indices since multiple glTF primitives can
+        // be put into the same primitive builder.
+        const uint32_t startVertex = (uint32_t)primitiveBuilder.Vertices.size();
+        const uint32_t startIndex = (uint32_t)primitiveBuilder.Indices.size();
+
+        // Convert the GltfHelper vertices into the PBR vertex format.
+        primitiveBuilder.Vertices.resize(startVertex + primitive.Vertices.size());
+        for (size_t i = 0; i < primitive.Vertices.size(); i++) {
+            const GltfHelper::Vertex& vertex = primitive.Vertices[i];
+            Pbr::Vertex pbrVertex;
+            pbrVertex.Position = vertex.Position;
+            pbrVertex.Normal = vertex.Normal;
+            pbrVertex.Tangent = vertex.Tangent;
+            pbrVertex.Color0 = vertex.Color0;
+            pbrVertex.TexCoord0 = vertex.TexCoord0;
+            pbrVertex.ModelTransformIndex = transformIndex;
+
+            primitiveBuilder.Vertices[i + startVertex] = pbrVertex;
+        }
+
+        // Insert indices with reverse winding order.
+        primitiveBuilder.Indices.resize(startIndex + primitive.Indices.size());
+        for (size_t i = 0; i < primitive.Indices.size(); i += 3) {
+            primitiveBuilder.Indices[startIndex + i + 0] = startVertex + primitive.Indices[i + 0];
+            primitiveBuilder.Indices[startIndex + i + 1] = startVertex + primitive.Indices[i + 2];
+            primitiveBuilder.Indices[startIndex + i + 2] = startVertex + primitive.Indices[i + 1];
+        }
+
+        primitiveBuilder.NodeIndices.insert(transformIndex);
+    }
 }  // namespace
 
 namespace Gltf
@@ -106,8 +119,23 @@ namespace Gltf
         const tinygltf::Scene& defaultScene = m_gltfModel->scenes.at(defaultSceneId);
 
         // Process the root scene nodes. The children will be processed recursively.
+        std::vector<NodePrimitive> nodePrimitives;
         for (const int rootNodeId : defaultScene.nodes) {
-            LoadNode(Pbr::RootNodeIndex, *m_gltfModel, rootNodeId, primitiveCache, m_primitiveBuilderMap, *m_pbrModel);
+            LoadNode(Pbr::RootNodeIndex, *m_gltfModel, rootNodeId, nodePrimitives, *m_pbrModel);
+        }
+
+        // Decoding accessors and generating tangents is the expensive part, and independent per primitive,
+        // so read them all up front in parallel.
+        std::vector<const tinygltf::Primitive*> gltfPrimitives;
+        gltfPrimitives.reserve(nodePrimitives.size());
+        for (const NodePrimitive& nodePrimitive : nodePrimitives) {
+            gltfPrimitives.push_back(nodePrimitive.gltfPrimitive);
+        }
+        primitiveCache.ReadPrimitives(gltfPrimitives);
+
+        // Merge in scene traversal order so the primitive builders come out the same as a serial load.
+        for (const NodePrimitive& nodePrimitive : nodePrimitives) {
+            AddPrimitive(nodePrimitive, primitiveCache.ReadPrimitive(*nodePrimitive.gltfPrimitive), m_primitiveBuilderMap);
         }
     }
 
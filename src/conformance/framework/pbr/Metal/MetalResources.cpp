@@ -148,7 +148,7 @@ namespace Pbr
             // TODO: Generate mipmaps if sampler's minification filter (minFilter) uses mipmapping.
             // TODO: If texture is not power-of-two and (sampler has wrapping=repeat/mirrored_repeat OR minFilter uses
             // mipmapping), resize to power-of-two.
-            texture = MetalLoadGLTFImage(*this, *image, sRGB);
+            texture = m_Resources.GltfImageTextureCache.FindOrCreate(*image, sRGB, [&] { return MetalLoadGLTFImage(*this, *image, sRGB); });
             m_LoaderResources.imageMap[imageKey] = texture;
         }
 
@@ -304,6 +304,16 @@ namespace Pbr
         return m_Resources.SolidColorTextureCache.CreateTypedSolidColorTexture(*this, color, sRGB);
     }
 
+    void MetalResources::SetImageTextureCacheBudget(size_t bytes)
+    {
+        m_Resources.GltfImageTextureCache.SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats MetalResources::GetImageTextureCacheStats() const
+    {
+        return m_Resources.GltfImageTextureCache.GetStats();
+    }
+
     span<const Conformance::Image::FormatParams> MetalResources::GetSupportedFormats() const
     {
         if (m_Resources.SupportedTextureFormats.size() == 0) {
@@ -15,8 +15,10 @@
 #include "../PbrCommon.h"
 #include "../PbrHandles.h"
 #include "../PbrSharedState.h"
+#include "../PbrTexture.h"
 
 #include <utilities/image.h>
+#include <utilities/lru_cache.h>
 #include "utilities/metal_utils.h"
 
 #include <nonstd/span.hpp>
@@ -126,6 +128,11 @@ namespace Pbr
         /// number of textures created.
         NS::SharedPtr<MTL::Texture> CreateTypedSolidColorTexture(RGBAColor color, bool sRGB) const;
 
+        /// Textures created from glTF images are shared by all models loaded through these resources when the image contents match.
+        /// Sets how many bytes of image data that cache may hold, or gets its hit and miss counters.
+        void SetImageTextureCacheBudget(size_t bytes);
+        Conformance::LruCacheStats GetImageTextureCacheStats() const;
+
         /// Get the cached list of texture formats supported by the device
         /// Note: these formats are not guaranteed to support cubemap
         span<const Conformance::Image::FormatParams> GetSupportedFormats() const;
@@ -168,6 +175,7 @@ namespace Pbr
             NS::SharedPtr<MTL::Texture> DiffuseEnvironmentMap;
             std::unique_ptr<MetalPipelineStates> PipelineStates;
             mutable MetalTextureCache SolidColorTextureCache;
+            mutable ImageTextureCache<NS::SharedPtr<MTL::Texture>> GltfImageTextureCache;
 
             std::vector<Conformance::Image::FormatParams> SupportedTextureFormats;
         };
@@ -22,6 +22,7 @@
 #include "../PbrCommon.h"
 #include "../PbrHandles.h"
 #include "../PbrSharedState.h"
+#include "../PbrTexture.h"
 
 #include "common/gfxwrapper_opengl.h"
 #include "utilities/opengl_utils.h"
@@ -160,6 +161,7 @@ namespace Pbr
             std::shared_ptr<ScopedGLTexture> DiffuseEnvironmentMap;
             std::vector<Conformance::Image::FormatParams> SupportedTextureFormats;
             mutable GLTextureCache SolidColorTextureCache{};
+            mutable ImageTextureCache<std::shared_ptr<ScopedGLTexture>> GltfImageTextureCache;
         };
         PrimitiveCollection<GLPrimitive> Primitives;
 
@@ -264,7 +266,8 @@ namespace Pbr
             // TODO: Generate mipmaps if sampler's minification filter (minFilter) uses mipmapping.
             // TODO: If texture is not power-of-two and (sampler has wrapping=repeat/mirrored_repeat OR minFilter uses
             // mipmapping), resize to power-of-two.
-            textureView = std::make_shared<ScopedGLTexture>(LoadGLTFImage(*this, *image, sRGB));
+            textureView = m_impl->Resources.GltfImageTextureCache.FindOrCreate(
+                *image, sRGB, [&] { return std::make_shared<ScopedGLTexture>(LoadGLTFImage(*this, *image, sRGB)); });
             m_impl->loaderResources.imageMap[imageKey] = textureView;
         }
 
@@ -318,6 +321,16 @@ namespace Pbr
         return m_impl->Resources.SolidColorTextureCache.CreateTypedSolidColorTexture(color, sRGB);
     }
 
+    void GLResources::SetImageTextureCacheBudget(size_t bytes)
+    {
+        m_impl->Resources.GltfImageTextureCache.SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats GLResources::GetImageTextureCacheStats() const
+    {
+        return m_impl->Resources.GltfImageTextureCache.GetStats();
+    }
+
     span<const Conformance::Image::FormatParams> GLResources::GetSupportedFormats() const
     {
         if (m_impl->Resources.SupportedTextureFormats.size() == 0) {
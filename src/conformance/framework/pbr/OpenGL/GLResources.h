@@ -10,6 +10,7 @@
 #include "GLCommon.h"
 
 #include <utilities/image.h>
+#include <utilities/lru_cache.h>
 #include "../IGltfBuilder.h"
 #include "../PbrCommon.h"
 #include "../PbrHandles.h"
@@ -87,6 +88,11 @@ namespace Pbr
         /// number of textures created.
         std::shared_ptr<ScopedGLTexture> CreateTypedSolidColorTexture(RGBAColor color, bool sRGB) const;
 
+        /// Textures created from glTF images are shared by all models loaded through these resources when the image contents match.
+        /// Sets how many bytes of image data that cache may hold, or gets its hit and miss counters.
+        void SetImageTextureCacheBudget(size_t bytes);
+        Conformance::LruCacheStats GetImageTextureCacheStats() const;
+
         /// Get the cached list of texture formats supported by the device
         span<const Conformance::Image::FormatParams> GetSupportedFormats() const;
 
@@ -11,8 +11,69 @@
 
 #include "common/xr_linear.h"
 
+#include <assert.h>
 #include <stdexcept>
 
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so neither needs extra compiler flags or runtime dispatch.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PBR_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PBR_USE_NEON
+#endif
+
+namespace
+{
+    // Computes result = a * b, like XrMatrix4x4f_Multiply, and if transposedResult is not null also stores the transpose of the product
+    // there. Each column of the product is the columns of a scaled by the components of the matching column of b and summed.
+    void MultiplyMatrices(const XrMatrix4x4f& a, const XrMatrix4x4f& b, XrMatrix4x4f& result, XrMatrix4x4f* transposedResult)
+    {
+#if defined(PBR_USE_SSE2)
+        const __m128 a0 = _mm_loadu_ps(a.m + 0);
+        const __m128 a1 = _mm_loadu_ps(a.m + 4);
+        const __m128 a2 = _mm_loadu_ps(a.m + 8);
+        const __m128 a3 = _mm_loadu_ps(a.m + 12);
+        __m128 columns[4];
+        for (int j = 0; j < 4; j++) {
+            const float* bColumn = b.m + j * 4;
+            columns[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bColumn[0])), _mm_mul_ps(a1, _mm_set1_ps(bColumn[1]))),
+                                               _mm_mul_ps(a2, _mm_set1_ps(bColumn[2]))),
+                                    _mm_mul_ps(a3, _mm_set1_ps(bColumn[3])));
+            _mm_storeu_ps(result.m + j * 4, columns[j]);
+        }
+        if (transposedResult != nullptr) {
+            _MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+            for (int j = 0; j < 4; j++) {
+                _mm_storeu_ps(transposedResult->m + j * 4, columns[j]);
+            }
+        }
+#elif defined(PBR_USE_NEON)
+        const float32x4_t a0 = vld1q_f32(a.m + 0);
+        const float32x4_t a1 = vld1q_f32(a.m + 4);
+        const float32x4_t a2 = vld1q_f32(a.m + 8);
+        const float32x4_t a3 = vld1q_f32(a.m + 12);
+        float32x4x4_t columns;
+        for (int j = 0; j < 4; j++) {
+            const float* bColumn = b.m + j * 4;
+            columns.val[j] = vaddq_f32(
+                vaddq_f32(vaddq_f32(vmulq_n_f32(a0, bColumn[0]), vmulq_n_f32(a1, bColumn[1])), vmulq_n_f32(a2, bColumn[2])),
+                vmulq_n_f32(a3, bColumn[3]));
+            vst1q_f32(result.m + j * 4, columns.val[j]);
+        }
+        if (transposedResult != nullptr) {
+            // Interleaving the four columns on store writes them out as rows.
+            vst4q_f32(transposedResult->m, columns);
+        }
+#else
+        XrMatrix4x4f_Multiply(&result, &a, &b);
+        if (transposedResult != nullptr) {
+            XrMatrix4x4f_Transpose(transposedResult, &result);
+        }
+#endif
+    }
+}  // namespace
+
 namespace Pbr
 {
     Model::Model()
@@ -46,6 +107,61 @@ namespace Pbr
         return false;
     }
 
+    void ModelInstance::ResolveTransformsAndVisibilities(bool transpose)
+    {
+        const auto& nodes = m_model->GetNodes();
+        assert(nodes.size() == m_nodeLocalTransforms.size());
+        assert(nodes.size() == m_resolvedTransforms.size());
+
+        if (transpose != m_resolvedTransformsTransposed) {
+            // Every stored transform is in the wrong layout.
+            m_resolvedTransformsTransposed = transpose;
+            std::fill(m_nodeNeedsResolve.begin(), m_nodeNeedsResolve.end(), true);
+            m_firstNodeNeedingResolve = 0;
+        }
+
+        // Nodes are guaranteed to come after their parents, so in a single pass, a node needs resolving if it changed or its parent was
+        // just resolved. Nodes before the first changed one cannot be affected.
+        const NodeIndex_t nodeCount = (NodeIndex_t)nodes.size();
+        constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;
+        for (NodeIndex_t nodeIndex = m_firstNodeNeedingResolve; nodeIndex < nodeCount; ++nodeIndex) {
+            const Node& node = nodes[nodeIndex];
+            const NodeIndex_t parentNodeIndex = node.GetParentNodeIndex();
+            const bool parentIsRoot = parentNodeIndex == Model::RootParentNodeIndex;
+            assert(parentIsRoot || parentNodeIndex < nodeIndex);
+
+            if (!m_nodeNeedsResolve[nodeIndex]) {
+                if (parentIsRoot || !m_nodeNeedsResolve[parentNodeIndex]) {
+                    continue;
+                }
+                // Flag the node so its own children are resolved too.
+                m_nodeNeedsResolve[nodeIndex] = true;
+            }
+
+            const bool parentVisibility = parentIsRoot ? true : m_resolvedVisibilities[parentNodeIndex];
+            const NodeVisibility nodeVisibility = m_nodeLocalVisibilities[nodeIndex];
+            const bool visible = nodeVisibility == NodeVisibility::Inherit ? parentVisibility : nodeVisibility == NodeVisibility::Visible;
+            m_resolvedVisibilities[nodeIndex] = visible;
+
+            const XrMatrix4x4f& parentTransform = parentIsRoot ? identityMatrix : m_worldTransforms[parentNodeIndex];
+            XrMatrix4x4f& resolvedTransform = m_resolvedTransforms[nodeIndex];
+            if (!visible) {
+                MultiplyMatrices(parentTransform, m_nodeLocalTransforms[nodeIndex], m_worldTransforms[nodeIndex], nullptr);
+                XrMatrix4x4f_CreateScale(&resolvedTransform, 0, 0, 0);
+            }
+            else if (transpose) {
+                MultiplyMatrices(parentTransform, m_nodeLocalTransforms[nodeIndex], m_worldTransforms[nodeIndex], &resolvedTransform);
+            }
+            else {
+                MultiplyMatrices(parentTransform, m_nodeLocalTransforms[nodeIndex], m_worldTransforms[nodeIndex], nullptr);
+                resolvedTransform = m_worldTransforms[nodeIndex];
+            }
+        }
+
+        std::fill(m_nodeNeedsResolve.begin() + m_firstNodeNeedingResolve, m_nodeNeedsResolve.end(), false);
+        m_firstNodeNeedingResolve = nodeCount;
+    }
+
     void Model::AddPrimitive(PrimitiveHandle primitive)
     {
         m_primitiveHandles.push_back(primitive);
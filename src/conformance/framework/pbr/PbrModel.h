@@ -15,6 +15,7 @@
 
 #include <nonstd/span.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -150,12 +151,14 @@ namespace Pbr
 
             m_nodeLocalVisibilities.resize(nodeCount, NodeVisibility::Inherit);
             m_resolvedVisibilities.resize(nodeCount, true);
+            m_nodeNeedsResolve.resize(nodeCount, true);
 
             m_nodeLocalTransforms.reserve(m_model->GetNodeCount());
             for (const Node& node : m_model->GetNodes()) {
                 m_nodeLocalTransforms.push_back(node.GetLocalTransform());
             }
             constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;  // or better yet poison it
+            m_worldTransforms.resize(nodeCount, identityMatrix);
             m_resolvedTransforms.resize(nodeCount, identityMatrix);
         }
 
@@ -165,14 +168,14 @@ namespace Pbr
         {
             m_nodeLocalVisibilities[nodeIndex] = visibility;
             // Visibility is implemented by scaling to 0
-            m_resolvedTransformsNeedUpdate = true;
+            MarkNodeNeedsResolve(nodeIndex);
         }
 
         /// Overrides the local transform of a node
         void SetNodeTransform(NodeIndex_t nodeIndex, const XrMatrix4x4f& transform)
         {
             m_nodeLocalTransforms[nodeIndex] = transform;
-            m_resolvedTransformsNeedUpdate = true;
+            MarkNodeNeedsResolve(nodeIndex);
         }
 
         /// Combine a transform with the original transform from the asset
@@ -193,44 +196,9 @@ namespace Pbr
         {
             m_resolvedTransformsNeedUpdate = false;
         }
-        void ResolveTransformsAndVisibilities(bool transpose)
-        {
-            const auto& nodes = m_model->GetNodes();
-
-            // Nodes are guaranteed to come after their parents, so each node transform can be multiplied by its parent transform in a single pass.
-            assert(nodes.size() == m_nodeLocalTransforms.size());
-            assert(nodes.size() == m_resolvedTransforms.size());
-            constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;
-            for (const auto& node : nodes) {
-                bool parentIsRoot = node.GetParentNodeIndex() == Model::RootParentNodeIndex;
-                assert(parentIsRoot || node.GetParentNodeIndex() < node.GetNodeIndex());
-
-                bool parentVisibility = (parentIsRoot) ? true : m_resolvedVisibilities[node.GetParentNodeIndex()];
-                NodeVisibility nodeVisibility = m_nodeLocalVisibilities[node.GetNodeIndex()];
-
-                m_resolvedVisibilities[node.GetNodeIndex()] =
-                    nodeVisibility == NodeVisibility::Inherit ? parentVisibility : nodeVisibility == NodeVisibility::Visible;
-
-                const XrMatrix4x4f& parentTransform = (parentIsRoot) ? identityMatrix : m_resolvedTransforms[node.GetParentNodeIndex()];
-                const XrMatrix4x4f& nodeTransform = m_nodeLocalTransforms[node.GetNodeIndex()];
-
-                if (transpose) {
-                    XrMatrix4x4f nodeTransformTranspose = Matrix::Transposed(nodeTransform);
-                    m_resolvedTransforms[node.GetNodeIndex()] = nodeTransformTranspose * parentTransform;
-                }
-                else {
-                    m_resolvedTransforms[node.GetNodeIndex()] = parentTransform * nodeTransform;
-                }
-            }
-
-            // After all node transforms and visibilities have been propagated,
-            // zero the transforms of invisible nodes.
-            for (const auto& node : nodes) {
-                if (!m_resolvedVisibilities[node.GetNodeIndex()]) {
-                    XrMatrix4x4f_CreateScale(&m_resolvedTransforms[node.GetNodeIndex()], 0, 0, 0);
-                }
-            }
-        }
+        /// Recompute the resolved transforms and visibilities of the nodes changed since the last call, and of their descendants.
+        /// Resolved transforms are stored transposed if @p transpose is set.
+        void ResolveTransformsAndVisibilities(bool transpose);
 
         const Model& GetModel() const
         {
@@ -253,7 +221,15 @@ namespace Pbr
         }
 
     private:
+        void MarkNodeNeedsResolve(NodeIndex_t nodeIndex)
+        {
+            m_nodeNeedsResolve[nodeIndex] = true;
+            m_firstNodeNeedingResolve = std::min(m_firstNodeNeedingResolve, nodeIndex);
+            m_resolvedTransformsNeedUpdate = true;
+        }
+
         bool m_resolvedTransformsNeedUpdate{true};
+        bool m_resolvedTransformsTransposed{false};
 
         // Derived classes may depend on this being immutable.
         std::shared_ptr<const Model> m_model;
@@ -262,6 +238,12 @@ namespace Pbr
         // This is initialized to the local transform of every node,
         // but can be updated for this instance.
         std::vector<XrMatrix4x4f> m_nodeLocalTransforms;
+        // Node-to-model transforms, without visibility applied, which children build on.
+        std::vector<XrMatrix4x4f> m_worldTransforms;
+        // m_worldTransforms, zeroed for invisible nodes and transposed if requested.
         std::vector<XrMatrix4x4f> m_resolvedTransforms;
+        // Nodes whose local transform or visibility changed since the last resolve. Their descendants need resolving too.
+        std::vector<bool> m_nodeNeedsResolve;
+        NodeIndex_t m_firstNodeNeedingResolve{0};
     };
 }  // namespace Pbr
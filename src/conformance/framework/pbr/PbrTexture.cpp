@@ -13,6 +13,7 @@
 #include <utilities/image.h>
 
 #include "stb_image.h"
+#include <tinygltf/tiny_gltf.h>
 
 #include <cassert>
 #include <memory>
@@ -26,6 +27,12 @@ namespace Pbr
                                       (uint8_t)(color.a * 255.)};
     }
 
+    ImageContentKey MakeImageContentKey(const tinygltf::Image& image, bool sRGB)
+    {
+        return ImageContentKey{Conformance::Image::ContentHash(image.image), image.image.size(), image.width, image.height,
+                               image.component, image.as_is, sRGB};
+    }
+
     namespace StbiLoader
     {
         void StbiDeleter::operator()(unsigned char* pointer) const
@@ -11,8 +11,18 @@
 
 #include "PbrCommon.h"
 #include <utilities/image.h>
+#include <utilities/lru_cache.h>
 
+#include <array>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace tinygltf
+{
+    struct Image;
+}  // namespace tinygltf
 
 namespace Pbr
 {
@@ -20,6 +30,61 @@ namespace Pbr
 
     std::array<uint8_t, 4> LoadRGBAUI4(RGBAColor color);
 
+    /// Identifies the contents of a glTF image independently of the tinygltf::Image holding them,
+    /// so that identical images in different models can share a texture.
+    using ImageContentKey = std::tuple<std::array<uint64_t, 2> /* content hash */, size_t /* content size */, int /* width */,
+                                       int /* height */, int /* component */, bool /* as_is */, bool /* sRGB */>;
+
+    ImageContentKey MakeImageContentKey(const tinygltf::Image& image, bool sRGB);
+
+    /// Cache of textures created from glTF images, shared by every model loaded through the same resources object.
+    /// Least recently used textures are dropped from the cache beyond a budget, measured in bytes of image data;
+    /// models still using such a texture keep it alive.
+    ///
+    /// Device-dependent, drop when device is lost or destroyed.
+    template <typename TTextureHandle>
+    class ImageTextureCache
+    {
+    public:
+        static constexpr size_t DefaultBudgetBytes = 128 * 1024 * 1024;
+
+        ImageTextureCache() : m_cache(DefaultBudgetBytes)
+        {
+        }
+
+        /// Returns the cached texture for the contents of @p image, or the result of calling @p createTexture, which is then cached.
+        template <typename TCreate>
+        TTextureHandle FindOrCreate(const tinygltf::Image& image, bool sRGB, TCreate&& createTexture);
+
+        void SetBudget(size_t bytes)
+        {
+            m_cache.SetBudget(bytes);
+        }
+
+        Conformance::LruCacheStats GetStats() const
+        {
+            return m_cache.GetStats();
+        }
+
+    private:
+        Conformance::LruCache<ImageContentKey, TTextureHandle> m_cache;
+    };
+
+    template <typename TTextureHandle>
+    template <typename TCreate>
+    TTextureHandle ImageTextureCache<TTextureHandle>::FindOrCreate(const tinygltf::Image& image, bool sRGB, TCreate&& createTexture)
+    {
+        const ImageContentKey key = MakeImageContentKey(image, sRGB);
+        TTextureHandle texture;
+        if (m_cache.TryGet(key, texture)) {
+            return texture;
+        }
+        texture = std::forward<TCreate>(createTexture)();
+        // The size of the decoded pixels (or KTX2 data) stands in for the size of the texture made from them.
+        m_cache.Insert(key, texture, std::get<1>(key));
+        return texture;
+    }
+
     namespace StbiLoader
     {
         template <typename T>
@@ -20,6 +20,7 @@
 #include <nonstd/span.hpp>
 
 #include <array>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -35,6 +36,33 @@ namespace Pbr
         if (iter != m_pipelines.end()) {
             return iter->second;
         }
+        return CreatePipeline(state);
+    }
+
+    void VulkanPipelines::WarmUp(VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, FrontFaceWindingOrder frontFaceWindingOrder,
+                                 DepthDirection depthDirection)
+    {
+        for (BlendState blendState : {BlendState::NotAlphaBlended, BlendState::AlphaBlended}) {
+            for (DoubleSided doubleSided : {DoubleSided::NotDoubleSided, DoubleSided::DoubleSided}) {
+                const PipelineStateKey state{renderPass, sampleCount, FillMode::Solid, frontFaceWindingOrder, blendState, doubleSided,
+                                             depthDirection};
+                if (m_pipelines.count(state) == 0) {
+                    CreatePipeline(state);
+                }
+            }
+        }
+    }
+
+    Conformance::Pipeline& VulkanPipelines::CreatePipeline(const PipelineStateKey& state)
+    {
+        VkRenderPass renderPass;
+        VkSampleCountFlagBits sampleCount;
+        FillMode fillMode;
+        FrontFaceWindingOrder frontFaceWindingOrder;
+        BlendState blendState;
+        DoubleSided doubleSided;
+        DepthDirection depthDirection;
+        std::tie(renderPass, sampleCount, fillMode, frontFaceWindingOrder, blendState, doubleSided, depthDirection) = state;
 
         static_assert(std::is_same<PipelineStateKey, std::tuple<VkRenderPass, VkSampleCountFlagBits, FillMode, FrontFaceWindingOrder,
                                                                 BlendState, DoubleSided, DepthDirection>>::value,
@@ -147,7 +175,7 @@ namespace Pbr
         pipeInfo.subpass = 0;
 
         Conformance::Pipeline& pipeline = m_pipelines.emplace(state, Conformance::Pipeline()).first->second;
-        pipeline.Create(m_device, pipeInfo);
+        pipeline.Create(m_device, pipeInfo, m_pipelineCache);
 
         return pipeline;
     }
@@ -21,6 +21,7 @@
 #include <memory>
 #include <stdint.h>
 #include <tuple>
+#include <utility>
 
 namespace Pbr
 {
@@ -31,11 +32,16 @@ namespace Pbr
     {
     public:
         /// Note: Make sure your shaders are global/static!
+        /// @param pipelineCache optional, must outlive this object.
         VulkanPipelines(VkDevice device, std::shared_ptr<Conformance::ScopedVkPipelineLayout> layout,
                         span<const VkVertexInputAttributeDescription> vertexAttrDesc,
                         span<const VkVertexInputBindingDescription> vertexInputBindDesc, span<const uint32_t> pbrVS,
-                        span<const uint32_t> pbrPS)
-            : m_device(device), m_layout(layout), m_vertexAttrDesc(vertexAttrDesc), m_vertexInputBindDesc(vertexInputBindDesc)
+                        span<const uint32_t> pbrPS, Conformance::PipelineCache* pipelineCache = nullptr)
+            : m_device(device)
+            , m_layout(layout)
+            , m_vertexAttrDesc(vertexAttrDesc)
+            , m_vertexInputBindDesc(vertexInputBindDesc)
+            , m_pipelineCache(pipelineCache)
         {
             m_pbrShader.Init(m_device);
             m_pbrShader.LoadVertexShader(pbrVS);
@@ -46,19 +52,28 @@ namespace Pbr
                                                    FrontFaceWindingOrder frontFaceWindingOrder, BlendState blendState,
                                                    DoubleSided doubleSided, DepthDirection depthDirection);
 
+        /// Creates the pipelines for every blend state and double-sidedness combination of solid fill for a render pass,
+        /// so that a material first seen mid-test does not stall a frame. Call when the render pass is created.
+        void WarmUp(VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, FrontFaceWindingOrder frontFaceWindingOrder,
+                    DepthDirection depthDirection);
+
         void DropStates()
         {
             m_pipelines.clear();
         }
 
     private:
-        VkDevice m_device;
         using PipelineStateKey =
             std::tuple<VkRenderPass, VkSampleCountFlagBits, FillMode, FrontFaceWindingOrder, BlendState, DoubleSided, DepthDirection>;
+
+        Conformance::Pipeline& CreatePipeline(const PipelineStateKey& state);
+
+        VkDevice m_device;
         std::shared_ptr<Conformance::ScopedVkPipelineLayout> m_layout;
         span<const VkVertexInputAttributeDescription> m_vertexAttrDesc;
         span<const VkVertexInputBindingDescription> m_vertexInputBindDesc;
         Conformance::ShaderProgram m_pbrShader;
+        Conformance::PipelineCache* m_pipelineCache;
 
         std::map<PipelineStateKey, Conformance::Pipeline> m_pipelines;
     };
@@ -24,6 +24,7 @@
 #include "../PbrCommon.h"
 #include "../PbrHandles.h"
 #include "../PbrSharedState.h"
+#include "../PbrTexture.h"
 
 #include "common/vulkan_debug_object_namer.hpp"
 #include "utilities/vulkan_scoped_handle.h"
@@ -312,7 +313,7 @@ namespace Pbr
     struct VulkanResources::Impl
     {
         void Initialize(const VulkanDebugObjectNamer& objnamer, VkPhysicalDevice physicalDevice_, VkDevice device_,
-                        uint32_t queueFamilyIndex)
+                        uint32_t queueFamilyIndex, Conformance::PipelineCache* pipelineCache)
         {
             device = device_;
             allocator.Init(physicalDevice_, device);
@@ -328,7 +329,7 @@ namespace Pbr
                 PipelineLayout::CreatePipelineLayout(device, Resources.DescriptorSetLayout->get()), device);
 
             Resources.Pipelines = std::make_unique<VulkanPipelines>(device, Resources.PipelineLayout, c_attrDesc, c_bindingDesc,
-                                                                    g_PbrVertexShader, g_PbrPixelShader);
+                                                                    g_PbrVertexShader, g_PbrPixelShader, pipelineCache);
 
             // Set up the scene constant buffer.
             Resources.SceneBuffer.Init(device, allocator);
@@ -359,6 +360,7 @@ namespace Pbr
             std::shared_ptr<VulkanTextureBundle> SpecularEnvironmentMap;
             std::shared_ptr<VulkanTextureBundle> DiffuseEnvironmentMap;
             mutable VulkanTextureCache SolidColorTextureCache;
+            mutable ImageTextureCache<std::shared_ptr<VulkanTextureBundle>> GltfImageTextureCache;
 
             Conformance::StructuredBuffer<Glsl::SceneConstantBuffer> SceneBuffer;
             Conformance::ScopedVkSampler BrdfSampler;
@@ -393,10 +395,10 @@ namespace Pbr
     };
 
     VulkanResources::VulkanResources(const VulkanDebugObjectNamer& namer, VkPhysicalDevice physicalDevice, VkDevice device,
-                                     uint32_t queueFamilyIndex)
+                                     uint32_t queueFamilyIndex, Conformance::PipelineCache* pipelineCache)
         : m_impl(std::make_unique<Impl>())
     {
-        m_impl->Initialize(namer, physicalDevice, device, queueFamilyIndex);
+        m_impl->Initialize(namer, physicalDevice, device, queueFamilyIndex, pipelineCache);
     }
 
     VulkanResources::VulkanResources(VulkanResources&& resources) noexcept = default;
@@ -501,7 +503,8 @@ namespace Pbr
             // TODO: Generate mipmaps if sampler's minification filter (minFilter) uses mipmapping.
             // TODO: If texture is not power-of-two and (sampler has wrapping=repeat/mirrored_repeat OR minFilter uses
             // mipmapping), resize to power-of-two.
-            textureView = std::make_shared<VulkanTextureBundle>(LoadGLTFImage(*this, *image, sRGB));
+            textureView = m_impl->Resources.GltfImageTextureCache.FindOrCreate(
+                *image, sRGB, [&] { return std::make_shared<VulkanTextureBundle>(LoadGLTFImage(*this, *image, sRGB)); });
             m_impl->loaderResources.imageMap[imageKey] = textureView;
         }
 
@@ -574,6 +577,12 @@ namespace Pbr
                                                                 m_sharedState.GetDepthDirection());
     }
 
+    void VulkanResources::WarmUpPipelines(VkRenderPass renderPass, VkSampleCountFlagBits sampleCount)
+    {
+        m_impl->Resources.Pipelines->WarmUp(renderPass, sampleCount, m_sharedState.GetFrontFaceWindingOrder(),
+                                            m_sharedState.GetDepthDirection());
+    }
+
     void VulkanResources::SetLight(XrVector3f direction, RGBColor diffuseColor)
     {
         m_impl->SceneBuffer.LightDirection = direction;
@@ -601,6 +610,16 @@ namespace Pbr
         return m_impl->Resources.SolidColorTextureCache.CreateTypedSolidColorTexture(*this, color, sRGB);
     }
 
+    void VulkanResources::SetImageTextureCacheBudget(size_t bytes)
+    {
+        m_impl->Resources.GltfImageTextureCache.SetBudget(bytes);
+    }
+
+    Conformance::LruCacheStats VulkanResources::GetImageTextureCacheStats() const
+    {
+        return m_impl->Resources.GltfImageTextureCache.GetStats();
+    }
+
     span<const Conformance::Image::FormatParams> VulkanResources::GetSupportedFormats() const
     {
         if (m_impl->Resources.SupportedTextureFormats.size() == 0) {
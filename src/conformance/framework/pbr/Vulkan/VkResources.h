@@ -11,6 +11,7 @@
 #include "VkCommon.h"
 
 #include <utilities/image.h>
+#include <utilities/lru_cache.h>
 #include "../IGltfBuilder.h"
 #include "../PbrCommon.h"
 #include "../PbrHandles.h"
@@ -99,7 +100,9 @@ namespace Pbr
     /// Global PBR resources required for rendering a scene.
     struct VulkanResources final : public IGltfBuilder
     {
-        VulkanResources(const VulkanDebugObjectNamer& namer, VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex);
+        /// @param pipelineCache optional cache to create pipelines with, must outlive this object.
+        VulkanResources(const VulkanDebugObjectNamer& namer, VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex,
+                        Conformance::PipelineCache* pipelineCache = nullptr);
         VulkanResources(VulkanResources&&) noexcept;
 
         ~VulkanResources() override;
@@ -122,6 +125,9 @@ namespace Pbr
         Conformance::Pipeline& GetOrCreatePipeline(VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, BlendState blendState,
                                                    DoubleSided doubleSided);
 
+        /// Create the common pipelines for a new render pass up front, with the current settings inside VkResources.
+        void WarmUpPipelines(VkRenderPass renderPass, VkSampleCountFlagBits sampleCount);
+
         /// Set the directional light.
         void SetLight(XrVector3f direction, RGBColor diffuseColor);
 
@@ -136,6 +142,11 @@ namespace Pbr
         /// number of textures created.
         std::shared_ptr<VulkanTextureBundle> CreateTypedSolidColorTexture(RGBAColor color, bool sRGB);
 
+        /// Textures created from glTF images are shared by all models loaded through these resources when the image contents match.
+        /// Sets how many bytes of image data that cache may hold, or gets its hit and miss counters.
+        void SetImageTextureCacheBudget(size_t bytes);
+        Conformance::LruCacheStats GetImageTextureCacheStats() const;
+
         /// Get the cached list of texture formats supported by the device
         /// Note: these formats are not guaranteed to support cubemap
         span<const Conformance::Image::FormatParams> GetSupportedFormats() const;
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "report.h"
+#include "utilities/lru_cache.h"
 #include <string>
 #include <cstdio>
 
@@ -84,4 +85,12 @@ namespace Conformance
         ReportV(format, args);
         va_end(args);
     }
+
+    void ReportCacheStatsConsoleOnly(const char* cacheName, const LruCacheStats& stats)
+    {
+        constexpr double bytesPerMegabyte = 1024.0 * 1024.0;
+        ReportConsoleOnlyF("%s cache: %llu hits, %llu misses, %llu evictions, %zu entries holding %.1f of %.1f MB", cacheName,
+                           (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions,
+                           stats.entryCount, stats.totalSize / bytesPerMegabyte, stats.budget / bytesPerMegabyte);
+    }
 }  // namespace Conformance
@@ -23,6 +23,8 @@
 
 namespace Conformance
 {
+    struct LruCacheStats;
+
     /**
      * @defgroup cts_report Standalone message reporters
      * @ingroup cts_framework
@@ -43,6 +45,9 @@ namespace Conformance
     /// Formatted report function, like ReportF, but for console output only (when XML report output has another way of including this data)
     void ReportConsoleOnlyF(const char* format, ...);
 
+    /// Reports the hit, miss and eviction counters and the occupancy of a cache with ReportConsoleOnlyF.
+    void ReportCacheStatsConsoleOnly(const char* cacheName, const LruCacheStats& stats);
+
     /// @}
 
 }  // namespace Conformance
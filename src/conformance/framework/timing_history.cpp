@@ -0,0 +1,136 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "timing_history.h"
+
+#include "conformance_framework.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace Conformance
+{
+    namespace
+    {
+        constexpr const char* kHistoryHeader = "# timestamp\truntime\tpath\tseconds\txrCallCount\txrCallSeconds";
+
+        /// Differences smaller than this are timer and scheduling noise, whatever the ratio.
+        constexpr double kMinimumRegressionSeconds = 0.010;
+
+        struct HistoryEntry
+        {
+            std::string runtime;
+            double seconds;
+            double callSeconds;
+        };
+
+        std::string GetCurrentTimestamp()
+        {
+            const std::time_t now = std::time(nullptr);
+            std::tm timeInfo{};
+#if defined(_MSC_VER)
+            gmtime_s(&timeInfo, &now);
+#else
+            gmtime_r(&now, &timeInfo);
+#endif
+            char timestamp[sizeof("2017-01-16T17:06:45Z")];
+            std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &timeInfo);
+            return timestamp;
+        }
+
+        double ToSeconds(std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration<double>(duration).count();
+        }
+
+        /// Tabs and newlines would break the line format; section names never contain them in practice.
+        std::string SanitizeField(std::string field)
+        {
+            std::replace_if(field.begin(), field.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+            return field;
+        }
+
+        /// The most recent entry for each path in the history file.
+        std::map<std::string, HistoryEntry> ReadLatestEntries(const std::string& path)
+        {
+            std::map<std::string, HistoryEntry> latest;
+            std::ifstream file(path);
+            std::string line;
+            while (std::getline(file, line)) {
+                if (line.empty() || line[0] == '#') {
+                    continue;
+                }
+                std::vector<std::string> fields;
+                std::istringstream stream(line);
+                for (std::string field; std::getline(stream, field, '\t');) {
+                    fields.push_back(field);
+                }
+                if (fields.size() < 6) {
+                    continue;
+                }
+                try {
+                    latest[fields[2]] = HistoryEntry{fields[1], std::stod(fields[3]), std::stod(fields[5])};
+                }
+                catch (const std::exception&) {
+                    // Skip malformed lines.
+                }
+            }
+            return latest;
+        }
+    }  // namespace
+
+    bool AppendTimingHistory(const std::string& path, const std::string& runtime, const ConformanceReport& report)
+    {
+        const bool isNewFile = !std::ifstream(path).good();
+
+        // Write the whole run at once. Sharded runs do not rely on this: each shard writes its own file (--timingHistoryOut)
+        // and conformance_cli appends them to the history when every shard has finished.
+        std::ostringstream lines;
+        if (isNewFile) {
+            lines << kHistoryHeader << '\n';
+        }
+        const std::string timestamp = GetCurrentTimestamp();
+        const std::string runtimeField = SanitizeField(runtime);
+        for (const auto& section : report.sectionTimings) {
+            const ConformanceReport::Timing& timing = section.second;
+            lines << timestamp << '\t' << runtimeField << '\t' << SanitizeField(section.first) << '\t' << ToSeconds(timing.duration)
+                  << '\t' << timing.runtimeCallCount << '\t' << ToSeconds(timing.runtimeCallTime) << '\n';
+        }
+
+        std::ofstream file(path, std::ios::app);
+        const std::string text = lines.str();
+        file.write(text.data(), text.size());
+        return bool(file);
+    }
+
+    std::vector<TimingRegression> FindTimingRegressions(const std::string& path, const ConformanceReport& report,
+                                                        double thresholdPercent)
+    {
+        const std::map<std::string, HistoryEntry> latest = ReadLatestEntries(path);
+
+        std::vector<TimingRegression> regressions;
+        for (const auto& section : report.sectionTimings) {
+            auto previous = latest.find(SanitizeField(section.first));
+            if (previous == latest.end()) {
+                continue;
+            }
+            const double currentSeconds = ToSeconds(section.second.duration);
+            const double previousSeconds = previous->second.seconds;
+            if (currentSeconds - previousSeconds >= kMinimumRegressionSeconds &&
+                currentSeconds > previousSeconds * (1.0 + thresholdPercent / 100.0)) {
+                regressions.push_back(TimingRegression{section.first, previous->second.runtime, previousSeconds, currentSeconds,
+                                                       previous->second.callSeconds, ToSeconds(section.second.runtimeCallTime)});
+            }
+        }
+
+        std::sort(regressions.begin(), regressions.end(), [](const TimingRegression& a, const TimingRegression& b) {
+            return a.currentSeconds - a.previousSeconds > b.currentSeconds - b.previousSeconds;
+        });
+        return regressions;
+    }
+}  // namespace Conformance
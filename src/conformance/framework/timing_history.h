@@ -0,0 +1,41 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    class ConformanceReport;
+
+    /// A test case or section that took noticeably longer than the last time it was recorded in a timing history.
+    struct TimingRegression
+    {
+        /// "test case/section/..." path, as in the ctsxml report.
+        std::string path;
+        /// The runtime and version of the run it is compared against.
+        std::string previousRuntime;
+        double previousSeconds;
+        double currentSeconds;
+        double previousCallSeconds;
+        double currentCallSeconds;
+    };
+
+    /// Appends the timing of every test case and section in @p report to the history file at @p path.
+    ///
+    /// The history is a tab-separated text file, one line per test case or section and run:
+    /// timestamp, runtime, path, seconds, OpenXR call count, seconds in OpenXR calls.
+    /// Lines are only ever appended, so runs against successive runtime builds can be compared.
+    /// Returns false if the file could not be written.
+    bool AppendTimingHistory(const std::string& path, const std::string& runtime, const ConformanceReport& report);
+
+    /// Compares each test case and section in @p report with its most recent entry in the history file at @p path,
+    /// which should not yet contain this run.
+    /// Returns the ones that took more than @p thresholdPercent percent longer, largest increase first. Differences below 10 ms
+    /// are ignored as noise.
+    std::vector<TimingRegression> FindTimingRegressions(const std::string& path, const ConformanceReport& report,
+                                                        double thresholdPercent);
+}  // namespace Conformance
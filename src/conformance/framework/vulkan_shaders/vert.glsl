@@ -10,12 +10,14 @@
 
 layout (std140, push_constant) uniform buf
 {
-    mat4 mvp;
-    vec4 tintColor;
+    mat4 viewProjection;
 } ubuf;
 
 layout (location = 0) in vec3 Position;
 layout (location = 1) in vec3 Color;
+// Per instance: MeshInstanceData
+layout (location = 2) in mat4 InstanceModel;
+layout (location = 6) in vec4 InstanceTintColor;
 
 layout (location = 0) out vec4 oColor;
 out gl_PerVertex
@@ -25,7 +27,7 @@ out gl_PerVertex
 
 void main()
 {
-    oColor.rgb = mix(Color.rgb, ubuf.tintColor.rgb, ubuf.tintColor.a);
+    oColor.rgb = mix(Color.rgb, InstanceTintColor.rgb, InstanceTintColor.a);
     oColor.a  = 1.0;
-    gl_Position = ubuf.mvp * vec4(Position, 1);
+    gl_Position = ubuf.viewProjection * (InstanceModel * vec4(Position, 1));
 }
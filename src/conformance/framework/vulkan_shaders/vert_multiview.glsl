@@ -0,0 +1,35 @@
+// Copyright (c) 2017-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#version 400
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_EXT_multiview : enable
+
+#pragma vertex
+
+// vert.glsl drawing both views of a VK_KHR_multiview render pass, selected by gl_ViewIndex.
+layout (std140, push_constant) uniform buf
+{
+    mat4 viewProjection[2];
+} ubuf;
+
+layout (location = 0) in vec3 Position;
+layout (location = 1) in vec3 Color;
+// Per instance: MeshInstanceData
+layout (location = 2) in mat4 InstanceModel;
+layout (location = 6) in vec4 InstanceTintColor;
+
+layout (location = 0) out vec4 oColor;
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    oColor.rgb = mix(Color.rgb, InstanceTintColor.rgb, InstanceTintColor.a);
+    oColor.a  = 1.0;
+    gl_Position = ubuf.viewProjection[gl_ViewIndex] * (InstanceModel * vec4(Position, 1));
+}
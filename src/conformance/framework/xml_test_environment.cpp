@@ -12,6 +12,7 @@
 #include <catch2/internal/catch_xmlwriter.hpp>
 
 #include <chrono>
+#include <map>
 
 #define CTS_XML_NS_PREFIX "cts"
 #define CTS_XML_NS_PREFIX_QUALIFIER CTS_XML_NS_PREFIX ":"
@@ -55,6 +56,32 @@ namespace Conformance
                     .writeAttribute("value", formatAndName.first);
             }
         }
+        if (cr.pipelineCreationCount > 0) {
+            xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "pipelineCreation")
+                .writeAttribute("count", cr.pipelineCreationCount)
+                .writeAttribute("ms", std::chrono::duration<float, std::milli>(cr.pipelineCreationTime).count());
+        }
+        if (!cr.results.empty()) {
+            // The timing of a test case is that of its outermost section, which has the test case's name as its path.
+            // Sorted by name so that reports from different runs line up.
+            const std::map<std::string, ConformanceReport::Score> sortedResults(cr.results.begin(), cr.results.end());
+            const bool haveCallStatistics = GetGlobalData().getRuntimeCallStatistics != nullptr;
+            using seconds = std::chrono::duration<double>;
+            auto e2 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "testCaseTimings");
+            for (const auto& result : sortedResults) {
+                auto it = cr.sectionTimings.find(result.first);
+                if (it == cr.sectionTimings.end()) {
+                    continue;
+                }
+                const ConformanceReport::Timing& timing = it->second;
+                auto e3 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "testCase");
+                xml.writeAttribute("name", result.first).writeAttribute("time", seconds(timing.duration).count());
+                if (haveCallStatistics) {
+                    xml.writeAttribute("xrCallCount", timing.runtimeCallCount)
+                        .writeAttribute("xrCallTime", seconds(timing.runtimeCallTime).count());
+                }
+            }
+        }
     }
 
     void WriteInstanceProperties(Catch::XmlWriter& xml, const XrInstanceProperties& instanceProperties)
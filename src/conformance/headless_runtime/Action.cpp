@@ -0,0 +1,573 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// Actions are fully validated, but since there are no input devices no interaction profile is ever current:
+// every action is inactive, has no bound sources, and haptic output goes nowhere.
+//
+
+#include "Runtime.h"
+
+#include "interaction_info.h"
+
+#include <algorithm>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        // Checks the name and localized name shared by actions and action sets.
+        XrResult CheckNames(const char* name, size_t nameCapacity, const char* localizedName, size_t localizedNameCapacity)
+        {
+            const size_t nameLength = strnlen(name, nameCapacity);
+            if (nameLength == 0 || nameLength == nameCapacity) {
+                return XR_ERROR_NAME_INVALID;
+            }
+            if (!IsWellFormedName(name, nameCapacity)) {
+                return XR_ERROR_PATH_FORMAT_INVALID;
+            }
+            const size_t localizedNameLength = strnlen(localizedName, localizedNameCapacity);
+            if (localizedNameLength == 0 || localizedNameLength == localizedNameCapacity) {
+                return XR_ERROR_LOCALIZED_NAME_INVALID;
+            }
+            return XR_SUCCESS;
+        }
+
+        bool IsKnownActionType(XrActionType actionType)
+        {
+            switch (actionType) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+            case XR_ACTION_TYPE_VECTOR2F_INPUT:
+            case XR_ACTION_TYPE_POSE_INPUT:
+            case XR_ACTION_TYPE_VIBRATION_OUTPUT:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        const Conformance::InteractionProfileAvailMetadata* FindInteractionProfile(const Instance& instance, const std::string& path)
+        {
+            for (const auto& profile : Conformance::GetAllInteractionProfiles()) {
+                if (path == profile.InteractionProfilePathString &&
+                    Conformance::kInteractionAvailabilities[(size_t)profile.Availability].IsSatisfiedBy(instance.enabledFeatures)) {
+                    return &profile;
+                }
+            }
+            return nullptr;
+        }
+
+        // A binding may name an input source exactly, or name its identifier and leave the runtime to pick the component,
+        // as in ".../input/select" for ".../input/select/click".
+        bool IsBindingForProfile(const Instance& instance, const Conformance::InteractionProfileAvailMetadata& profile,
+                                 const std::string& bindingPath)
+        {
+            for (const auto& source : profile.InputSourcePaths) {
+                if (!Conformance::kInteractionAvailabilities[(size_t)source.Availability].IsSatisfiedBy(instance.enabledFeatures)) {
+                    continue;
+                }
+                const size_t sourceLength = strlen(source.Path);
+                if (sourceLength < bindingPath.size() || bindingPath.compare(0, bindingPath.size(), source.Path, bindingPath.size()) != 0) {
+                    continue;
+                }
+                if (sourceLength == bindingPath.size()) {
+                    return true;
+                }
+                const char* component = source.Path + bindingPath.size();
+                if (component[0] == '/' && strchr(component + 1, '/') == nullptr) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Looks up the action of a state query or haptic call, and applies the checks common to all of them.
+        XrResult GetQueriedAction(const Session& session, XrAction action, XrPath subactionPath, XrActionType actionType,
+                                  const Action** actionObject)
+        {
+            *actionObject = Registry::Get<Action>(action);
+            if (*actionObject == nullptr || &(*actionObject)->actionSet.instance != &session.instance) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if ((*actionObject)->actionType != actionType) {
+                return XR_ERROR_ACTION_TYPE_MISMATCH;
+            }
+            if (!session.IsAttached((*actionObject)->actionSet)) {
+                return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+            }
+            if (subactionPath != XR_NULL_PATH && session.instance.GetPathString(subactionPath) == nullptr) {
+                return XR_ERROR_PATH_INVALID;
+            }
+            if (!(*actionObject)->AcceptsSubactionPath(subactionPath)) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+            return XR_SUCCESS;
+        }
+
+        template <typename TState>
+        XrResult GetInactiveActionState(XrSession session, const XrActionStateGetInfo* getInfo, TState* state, XrStructureType stateType,
+                                        XrActionType actionType)
+        {
+            auto lock = LockRuntime();
+            Session* sessionObject = Registry::Get<Session>(session);
+            if (sessionObject == nullptr) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (getInfo == nullptr || getInfo->type != XR_TYPE_ACTION_STATE_GET_INFO || state == nullptr || state->type != stateType) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+            const Action* action;
+            const XrResult result = GetQueriedAction(*sessionObject, getInfo->action, getInfo->subactionPath, actionType, &action);
+            if (XR_FAILED(result)) {
+                return result;
+            }
+            // Keep type and next, and report the zero state of an action that nothing is bound to.
+            void* next = state->next;
+            *state = TState{stateType};
+            state->next = next;
+            return XR_SUCCESS;
+        }
+    }  // namespace
+
+    ActionSet::~ActionSet() = default;
+
+    bool Action::AcceptsSubactionPath(XrPath subactionPath) const
+    {
+        return subactionPath == XR_NULL_PATH ||
+               std::find(subactionPaths.begin(), subactionPaths.end(), subactionPath) != subactionPaths.end();
+    }
+
+    void DestroyActionSetObject(ActionSet& actionSet)
+    {
+        Instance& instance = actionSet.instance;
+        for (auto& session : instance.sessions) {
+            auto& attached = session->attachedActionSets;
+            attached.erase(std::remove(attached.begin(), attached.end(), &actionSet), attached.end());
+        }
+        instance.actionSets.erase(std::find_if(instance.actionSets.begin(), instance.actionSets.end(),
+                                               [&](const std::unique_ptr<ActionSet>& candidate) { return candidate.get() == &actionSet; }));
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || actionSet == nullptr || createInfo->type != XR_TYPE_ACTION_SET_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const XrResult result = CheckNames(createInfo->actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, createInfo->localizedActionSetName,
+                                           XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        for (const auto& existing : instanceObject->actionSets) {
+            if (existing->name == createInfo->actionSetName) {
+                return XR_ERROR_NAME_DUPLICATED;
+            }
+            if (existing->localizedName == createInfo->localizedActionSetName) {
+                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
+            }
+        }
+
+        auto newActionSet = std::make_unique<ActionSet>(*instanceObject);
+        newActionSet->name = createInfo->actionSetName;
+        newActionSet->localizedName = createInfo->localizedActionSetName;
+        newActionSet->priority = createInfo->priority;
+        Registry::Add(*newActionSet);
+        *actionSet = ToHandle<XrActionSet>(*newActionSet);
+        instanceObject->actionSets.push_back(std::move(newActionSet));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroyActionSet(XrActionSet actionSet)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        ActionSet* actionSetObject = Registry::Get<ActionSet>(actionSet);
+        if (actionSetObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        DestroyActionSetObject(*actionSetObject);
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        ActionSet* actionSetObject = Registry::Get<ActionSet>(actionSet);
+        if (actionSetObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || action == nullptr || createInfo->type != XR_TYPE_ACTION_CREATE_INFO ||
+            !IsKnownActionType(createInfo->actionType) || (createInfo->countSubactionPaths > 0 && createInfo->subactionPaths == nullptr)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        XrResult result = CheckNames(createInfo->actionName, XR_MAX_ACTION_NAME_SIZE, createInfo->localizedActionName,
+                                     XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (actionSetObject->attached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+        for (const auto& existing : actionSetObject->actions) {
+            if (existing->name == createInfo->actionName) {
+                return XR_ERROR_NAME_DUPLICATED;
+            }
+            if (existing->localizedName == createInfo->localizedActionName) {
+                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
+            }
+        }
+
+        const Instance& instance = actionSetObject->instance;
+        std::vector<XrPath> subactionPaths(createInfo->subactionPaths, createInfo->subactionPaths + createInfo->countSubactionPaths);
+        for (size_t i = 0; i < subactionPaths.size(); ++i) {
+            const std::string* pathString = instance.GetPathString(subactionPaths[i]);
+            if (pathString == nullptr) {
+                return XR_ERROR_PATH_INVALID;
+            }
+            if (!IsTopLevelUserPath(instance, *pathString) ||
+                std::find(subactionPaths.begin(), subactionPaths.begin() + i, subactionPaths[i]) != subactionPaths.begin() + i) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+        }
+
+        auto newAction = std::make_unique<Action>(*actionSetObject);
+        newAction->name = createInfo->actionName;
+        newAction->localizedName = createInfo->localizedActionName;
+        newAction->actionType = createInfo->actionType;
+        newAction->subactionPaths = std::move(subactionPaths);
+        Registry::Add(*newAction);
+        *action = ToHandle<XrAction>(*newAction);
+        actionSetObject->actions.push_back(std::move(newAction));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroyAction(XrAction action)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Action* actionObject = Registry::Get<Action>(action);
+        if (actionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        auto& actions = actionObject->actionSet.actions;
+        actions.erase(std::find_if(actions.begin(), actions.end(),
+                                   [&](const std::unique_ptr<Action>& candidate) { return candidate.get() == actionObject; }));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL SuggestInteractionProfileBindings(XrInstance instance,
+                                                                     const XrInteractionProfileSuggestedBinding* suggestedBindings)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (suggestedBindings == nullptr || suggestedBindings->type != XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING ||
+            suggestedBindings->countSuggestedBindings == 0 || suggestedBindings->suggestedBindings == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const std::string* profilePath = instanceObject->GetPathString(suggestedBindings->interactionProfile);
+        if (profilePath == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        const Conformance::InteractionProfileAvailMetadata* profile = FindInteractionProfile(*instanceObject, *profilePath);
+        if (profile == nullptr) {
+            return XR_ERROR_PATH_UNSUPPORTED;
+        }
+
+        bool anyAttached = false;
+        for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; ++i) {
+            const XrActionSuggestedBinding& binding = suggestedBindings->suggestedBindings[i];
+            const Action* action = Registry::Get<Action>(binding.action);
+            if (action == nullptr || &action->actionSet.instance != instanceObject) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            anyAttached = anyAttached || action->actionSet.attached;
+            const std::string* bindingPath = instanceObject->GetPathString(binding.binding);
+            if (bindingPath == nullptr) {
+                return XR_ERROR_PATH_INVALID;
+            }
+            if (!IsBindingForProfile(*instanceObject, *profile, *bindingPath)) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+        }
+        if (anyAttached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+
+        instanceObject->suggestedBindings[suggestedBindings->interactionProfile].assign(
+            suggestedBindings->suggestedBindings, suggestedBindings->suggestedBindings + suggestedBindings->countSuggestedBindings);
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL AttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (attachInfo == nullptr || attachInfo->type != XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO || attachInfo->countActionSets == 0 ||
+            attachInfo->actionSets == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        std::vector<ActionSet*> actionSets(attachInfo->countActionSets);
+        for (uint32_t i = 0; i < attachInfo->countActionSets; ++i) {
+            actionSets[i] = Registry::Get<ActionSet>(attachInfo->actionSets[i]);
+            if (actionSets[i] == nullptr || &actionSets[i]->instance != &sessionObject->instance) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+        if (sessionObject->actionSetsAttached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+        for (ActionSet* actionSet : actionSets) {
+            actionSet->attached = true;
+            if (!sessionObject->IsAttached(*actionSet)) {
+                sessionObject->attachedActionSets.push_back(actionSet);
+            }
+        }
+        sessionObject->actionSetsAttached = true;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath,
+                                                                XrInteractionProfileState* interactionProfile)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (interactionProfile == nullptr || interactionProfile->type != XR_TYPE_INTERACTION_PROFILE_STATE) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const std::string* pathString = sessionObject->instance.GetPathString(topLevelUserPath);
+        if (pathString == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        if (!IsTopLevelUserPath(sessionObject->instance, *pathString)) {
+            return XR_ERROR_PATH_UNSUPPORTED;
+        }
+        if (!sessionObject->actionSetsAttached) {
+            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        }
+        interactionProfile->interactionProfile = XR_NULL_PATH;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetActionStateBoolean(XrSession session, const XrActionStateGetInfo* getInfo,
+                                                         XrActionStateBoolean* state)
+    HEADLESS_RUNTIME_TRY
+    {
+        return GetInactiveActionState(session, getInfo, state, XR_TYPE_ACTION_STATE_BOOLEAN, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetActionStateFloat(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateFloat* state)
+    HEADLESS_RUNTIME_TRY
+    {
+        return GetInactiveActionState(session, getInfo, state, XR_TYPE_ACTION_STATE_FLOAT, XR_ACTION_TYPE_FLOAT_INPUT);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetActionStateVector2f(XrSession session, const XrActionStateGetInfo* getInfo,
+                                                          XrActionStateVector2f* state)
+    HEADLESS_RUNTIME_TRY
+    {
+        return GetInactiveActionState(session, getInfo, state, XR_TYPE_ACTION_STATE_VECTOR2F, XR_ACTION_TYPE_VECTOR2F_INPUT);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetActionStatePose(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStatePose* state)
+    HEADLESS_RUNTIME_TRY
+    {
+        return GetInactiveActionState(session, getInfo, state, XR_TYPE_ACTION_STATE_POSE, XR_ACTION_TYPE_POSE_INPUT);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL SyncActions(XrSession session, const XrActionsSyncInfo* syncInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (syncInfo == nullptr || syncInfo->type != XR_TYPE_ACTIONS_SYNC_INFO ||
+            (syncInfo->countActiveActionSets > 0 && syncInfo->activeActionSets == nullptr)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < syncInfo->countActiveActionSets; ++i) {
+            const XrActiveActionSet& activeActionSet = syncInfo->activeActionSets[i];
+            const ActionSet* actionSet = Registry::Get<ActionSet>(activeActionSet.actionSet);
+            if (actionSet == nullptr || &actionSet->instance != &sessionObject->instance) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (!sessionObject->IsAttached(*actionSet)) {
+                return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+            }
+            if (activeActionSet.subactionPath != XR_NULL_PATH) {
+                const std::string* pathString = sessionObject->instance.GetPathString(activeActionSet.subactionPath);
+                if (pathString == nullptr) {
+                    return XR_ERROR_PATH_INVALID;
+                }
+                if (!IsTopLevelUserPath(sessionObject->instance, *pathString)) {
+                    return XR_ERROR_PATH_UNSUPPORTED;
+                }
+            }
+        }
+        return sessionObject->IsFocused() ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateBoundSourcesForAction(XrSession session,
+                                                                  const XrBoundSourcesForActionEnumerateInfo* enumerateInfo,
+                                                                  uint32_t sourceCapacityInput, uint32_t* sourceCountOutput,
+                                                                  XrPath* sources)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (enumerateInfo == nullptr || enumerateInfo->type != XR_TYPE_BOUND_SOURCES_FOR_ACTION_ENUMERATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const Action* action = Registry::Get<Action>(enumerateInfo->action);
+        if (action == nullptr || &action->actionSet.instance != &sessionObject->instance) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (!sessionObject->IsAttached(action->actionSet)) {
+            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        }
+        return WriteTwoCallArray<XrPath>(sourceCapacityInput, sourceCountOutput, sources, nullptr, 0);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetInputSourceLocalizedName(XrSession session, const XrInputSourceLocalizedNameGetInfo* getInfo,
+                                                               uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (getInfo == nullptr || getInfo->type != XR_TYPE_INPUT_SOURCE_LOCALIZED_NAME_GET_INFO || getInfo->whichComponents == 0 ||
+            (getInfo->whichComponents & ~(XR_INPUT_SOURCE_LOCALIZED_NAME_USER_PATH_BIT |
+                                          XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT |
+                                          XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) != 0) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const std::string* sourcePath = sessionObject->instance.GetPathString(getInfo->sourcePath);
+        if (sourcePath == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        if (!sessionObject->actionSetsAttached) {
+            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        }
+
+        // Split the path into its top level user path and the rest, and name each part after its path.
+        size_t userPathLength = sourcePath->size();
+        while (userPathLength > 0 && !IsTopLevelUserPath(sessionObject->instance, sourcePath->substr(0, userPathLength))) {
+            userPathLength = sourcePath->rfind('/', userPathLength - 1);
+            userPathLength = userPathLength == std::string::npos ? 0 : userPathLength;
+        }
+        std::vector<std::string> parts;
+        if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_USER_PATH_BIT) != 0) {
+            parts.push_back(userPathLength > 0 ? sourcePath->substr(0, userPathLength) : *sourcePath);
+        }
+        if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT) != 0) {
+            parts.push_back("Headless");
+        }
+        if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT) != 0) {
+            parts.push_back(userPathLength < sourcePath->size() ? sourcePath->substr(userPathLength) : *sourcePath);
+        }
+        std::string name;
+        for (const std::string& part : parts) {
+            name += (name.empty() ? "" : " ") + part;
+        }
+        return WriteTwoCallArray(bufferCapacityInput, bufferCountOutput, buffer, name.c_str(), (uint32_t)name.size() + 1);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL ApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo,
+                                                       const XrHapticBaseHeader* hapticFeedback)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (hapticActionInfo == nullptr || hapticActionInfo->type != XR_TYPE_HAPTIC_ACTION_INFO || hapticFeedback == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const Action* action;
+        const XrResult result = GetQueriedAction(*sessionObject, hapticActionInfo->action, hapticActionInfo->subactionPath,
+                                                 XR_ACTION_TYPE_VIBRATION_OUTPUT, &action);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (hapticFeedback->type != XR_TYPE_HAPTIC_VIBRATION) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        return sessionObject->IsFocused() ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL StopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (hapticActionInfo == nullptr || hapticActionInfo->type != XR_TYPE_HAPTIC_ACTION_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const Action* action;
+        const XrResult result = GetQueriedAction(*sessionObject, hapticActionInfo->action, hapticActionInfo->subactionPath,
+                                                 XR_ACTION_TYPE_VIBRATION_OUTPUT, &action);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        return sessionObject->IsFocused() ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
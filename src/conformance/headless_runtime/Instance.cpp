@@ -0,0 +1,353 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        const XrExtensionProperties SupportedExtensions[] = {
+            {XR_TYPE_EXTENSION_PROPERTIES, nullptr, XR_MND_HEADLESS_EXTENSION_NAME, XR_MND_headless_SPEC_VERSION},
+            {XR_TYPE_EXTENSION_PROPERTIES, nullptr, XR_KHR_LOCATE_SPACES_EXTENSION_NAME, XR_KHR_locate_spaces_SPEC_VERSION},
+            {XR_TYPE_EXTENSION_PROPERTIES, nullptr, XR_EXT_LOCAL_FLOOR_EXTENSION_NAME, XR_EXT_local_floor_SPEC_VERSION},
+        };
+
+        constexpr char RuntimeName[] = "Conformance Headless Session Runtime";
+        constexpr XrVersion RuntimeVersion = XR_MAKE_VERSION(1, 0, 0);
+
+        // Requires the runtime lock.
+        std::vector<std::unique_ptr<Instance>>& GetInstances()
+        {
+            static std::vector<std::unique_ptr<Instance>> instances;
+            return instances;
+        }
+
+        bool IsSupportedExtension(const char* name)
+        {
+            return std::any_of(std::begin(SupportedExtensions), std::end(SupportedExtensions),
+                               [&](const XrExtensionProperties& ext) { return strcmp(ext.extensionName, name) == 0; });
+        }
+
+        bool IsNullTerminatedNonEmpty(const char* str, size_t capacity)
+        {
+            const size_t length = strnlen(str, capacity);
+            return length > 0 && length < capacity;
+        }
+
+        // clang-format off
+#define HEADLESS_RUNTIME_ENUM_CASE_STR(name, val) case name: return #name;
+        // clang-format on
+
+        const char* ResultName(XrResult value)
+        {
+            switch (value) {
+                XR_LIST_ENUM_XrResult(HEADLESS_RUNTIME_ENUM_CASE_STR) default : return nullptr;
+            }
+        }
+
+        const char* StructureTypeName(XrStructureType value)
+        {
+            switch (value) {
+                XR_LIST_ENUM_XrStructureType(HEADLESS_RUNTIME_ENUM_CASE_STR) default : return nullptr;
+            }
+        }
+
+#undef HEADLESS_RUNTIME_ENUM_CASE_STR
+    }  // namespace
+
+    Instance::~Instance()
+    {
+        // Sessions refer to action sets, so release them first.
+        sessions.clear();
+        actionSets.clear();
+    }
+
+    bool Instance::IsFeatureEnabled(const char* featureName) const
+    {
+        const Conformance::FeatureBitIndex bit = Conformance::FeatureNameToBitIndex(featureName);
+        return bit != Conformance::FeatureBitIndex::FEATURE_COUNT && enabledFeatures.Get(bit);
+    }
+
+    XrPath Instance::GetOrCreatePath(const std::string& pathString)
+    {
+        auto it = paths.find(pathString);
+        if (it != paths.end()) {
+            return it->second;
+        }
+        pathStrings.push_back(pathString);
+        const XrPath path = pathStrings.size();
+        paths.emplace(pathString, path);
+        return path;
+    }
+
+    const std::string* Instance::GetPathString(XrPath path) const
+    {
+        if (path == XR_NULL_PATH || path > pathStrings.size()) {
+            return nullptr;
+        }
+        return &pathStrings[path - 1];
+    }
+
+    void Instance::PushEvent(const XrEventDataBaseHeader& event, size_t size)
+    {
+        if (events.size() >= MaxQueuedEvents) {
+            ++lostEventCount;
+            return;
+        }
+        XrEventDataBuffer buffer{};
+        memcpy(&buffer, &event, std::min(size, sizeof(buffer)));
+        events.push_back(buffer);
+    }
+
+    void Instance::RemoveEventsFor(const Session& session)
+    {
+        const XrSession handle = ToHandle<XrSession>(session);
+        events.erase(std::remove_if(events.begin(), events.end(),
+                                    [&](const XrEventDataBuffer& event) {
+                                        return event.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED &&
+                                               reinterpret_cast<const XrEventDataSessionStateChanged&>(event).session == handle;
+                                    }),
+                     events.end());
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateApiLayerProperties(uint32_t propertyCapacityInput, uint32_t* propertyCountOutput,
+                                                               XrApiLayerProperties* properties)
+    HEADLESS_RUNTIME_TRY
+    {
+        // API layers are the loader's business: the runtime itself has none.
+        return WriteTwoCallArray<XrApiLayerProperties>(propertyCapacityInput, propertyCountOutput, properties, nullptr, 0);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateInstanceExtensionProperties(const char* layerName, uint32_t propertyCapacityInput,
+                                                                        uint32_t* propertyCountOutput, XrExtensionProperties* properties)
+    HEADLESS_RUNTIME_TRY
+    {
+        if (layerName != nullptr && layerName[0] != '\0') {
+            return XR_ERROR_API_LAYER_NOT_PRESENT;
+        }
+        const uint32_t count = (uint32_t)(sizeof(SupportedExtensions) / sizeof(SupportedExtensions[0]));
+        if (propertyCountOutput == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        *propertyCountOutput = count;
+        if (propertyCapacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (propertyCapacityInput < count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        if (properties == nullptr || !HasStructureType(properties, count, XR_TYPE_EXTENSION_PROPERTIES)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            // Leave type and next as the application set them.
+            memcpy(properties[i].extensionName, SupportedExtensions[i].extensionName, XR_MAX_EXTENSION_NAME_SIZE);
+            properties[i].extensionVersion = SupportedExtensions[i].extensionVersion;
+        }
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateInstance(const XrInstanceCreateInfo* createInfo, XrInstance* instance)
+    HEADLESS_RUNTIME_TRY
+    {
+        if (createInfo == nullptr || instance == nullptr || createInfo->type != XR_TYPE_INSTANCE_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->createFlags != 0) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const XrApplicationInfo& appInfo = createInfo->applicationInfo;
+        if (!IsNullTerminatedNonEmpty(appInfo.applicationName, XR_MAX_APPLICATION_NAME_SIZE)) {
+            return XR_ERROR_NAME_INVALID;
+        }
+        if (strnlen(appInfo.engineName, XR_MAX_ENGINE_NAME_SIZE) == XR_MAX_ENGINE_NAME_SIZE) {
+            return XR_ERROR_NAME_INVALID;
+        }
+        if (XR_VERSION_MAJOR(appInfo.apiVersion) != 1 || XR_VERSION_MINOR(appInfo.apiVersion) > 1) {
+            return XR_ERROR_API_VERSION_UNSUPPORTED;
+        }
+        if (createInfo->enabledExtensionCount > 0 && createInfo->enabledExtensionNames == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < createInfo->enabledExtensionCount; ++i) {
+            if (createInfo->enabledExtensionNames[i] == nullptr || !IsSupportedExtension(createInfo->enabledExtensionNames[i])) {
+                return XR_ERROR_EXTENSION_NOT_PRESENT;
+            }
+        }
+
+        auto lock = LockRuntime();
+        auto newInstance = std::make_unique<Instance>();
+        newInstance->apiVersion = appInfo.apiVersion;
+        newInstance->applicationName = appInfo.applicationName;
+        newInstance->enabledFeatures = Conformance::FeatureSet(appInfo.apiVersion);
+        for (uint32_t i = 0; i < createInfo->enabledExtensionCount; ++i) {
+            newInstance->enabledFeatures.SetByExtensionNameString(createInfo->enabledExtensionNames[i]);
+        }
+        Registry::Add(*newInstance);
+        *instance = ToHandle<XrInstance>(*newInstance);
+        GetInstances().push_back(std::move(newInstance));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroyInstance(XrInstance instance)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        auto& instances = GetInstances();
+        instances.erase(std::find_if(instances.begin(), instances.end(),
+                                     [&](const std::unique_ptr<Instance>& candidate) { return candidate.get() == instanceObject; }));
+        // Wake any xrWaitFrame blocked on a session that no longer exists.
+        FrameCondition().notify_all();
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetInstanceProperties(XrInstance instance, XrInstanceProperties* instanceProperties)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        if (Registry::Get<Instance>(instance) == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (instanceProperties == nullptr || instanceProperties->type != XR_TYPE_INSTANCE_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        instanceProperties->runtimeVersion = RuntimeVersion;
+        strncpy(instanceProperties->runtimeName, RuntimeName, XR_MAX_RUNTIME_NAME_SIZE - 1);
+        instanceProperties->runtimeName[XR_MAX_RUNTIME_NAME_SIZE - 1] = '\0';
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL PollEvent(XrInstance instance, XrEventDataBuffer* eventData)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (eventData == nullptr || eventData->type != XR_TYPE_EVENT_DATA_BUFFER) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (instanceObject->lostEventCount > 0) {
+            XrEventDataEventsLost eventsLost{XR_TYPE_EVENT_DATA_EVENTS_LOST};
+            eventsLost.lostEventCount = instanceObject->lostEventCount;
+            instanceObject->lostEventCount = 0;
+            memcpy(eventData, &eventsLost, sizeof(eventsLost));
+            return XR_SUCCESS;
+        }
+        if (instanceObject->events.empty()) {
+            return XR_EVENT_UNAVAILABLE;
+        }
+        *eventData = instanceObject->events.front();
+        instanceObject->events.pop_front();
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL ResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE])
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        if (Registry::Get<Instance>(instance) == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (buffer == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const char* name = ResultName(value);
+        if (name != nullptr) {
+            snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "%s", name);
+        }
+        else {
+            snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, XR_SUCCEEDED(value) ? "XR_UNKNOWN_SUCCESS_%d" : "XR_UNKNOWN_FAILURE_%d",
+                     (int)value);
+        }
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL StructureTypeToString(XrInstance instance, XrStructureType value,
+                                                         char buffer[XR_MAX_STRUCTURE_NAME_SIZE])
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        if (Registry::Get<Instance>(instance) == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (buffer == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const char* name = StructureTypeName(value);
+        if (name != nullptr) {
+            snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "%s", name);
+        }
+        else {
+            snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "XR_UNKNOWN_STRUCTURE_TYPE_%d", (int)value);
+        }
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL StringToPath(XrInstance instance, const char* pathString, XrPath* path)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (pathString == nullptr || path == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!IsWellFormedPath(pathString)) {
+            return XR_ERROR_PATH_FORMAT_INVALID;
+        }
+        *path = instanceObject->GetOrCreatePath(pathString);
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL PathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput,
+                                                char* buffer)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        const std::string* pathString = instanceObject->GetPathString(path);
+        if (pathString == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        // Include the null terminator.
+        return WriteTwoCallArray(bufferCapacityInput, bufferCountOutput, buffer, pathString->c_str(), (uint32_t)pathString->size() + 1);
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
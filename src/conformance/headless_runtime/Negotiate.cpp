@@ -0,0 +1,135 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include <openxr/openxr_loader_negotiation.h>
+
+#include <cstring>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        struct FunctionInfo
+        {
+            const char* name;
+            /// The version or extension that must be enabled on the instance for the function to be returned.
+            const char* feature;
+            PFN_xrVoidFunction function;
+        };
+
+#define HEADLESS_RUNTIME_FUNCTION_INFO(name, feature) {"xr" #name, "XR_" #feature, reinterpret_cast<PFN_xrVoidFunction>(&name)},
+        const FunctionInfo Functions[] = {
+            XR_LIST_FUNCTIONS_XR_VERSION_1_0(HEADLESS_RUNTIME_FUNCTION_INFO)  //
+            XR_LIST_FUNCTIONS_XR_VERSION_1_1(HEADLESS_RUNTIME_FUNCTION_INFO)  //
+            HEADLESS_RUNTIME_FUNCTION_INFO(LocateSpacesKHR, KHR_locate_spaces)};
+#undef HEADLESS_RUNTIME_FUNCTION_INFO
+
+        // The only functions that can be retrieved without an instance.
+        const char* const GlobalFunctionNames[] = {"xrEnumerateInstanceExtensionProperties", "xrEnumerateApiLayerProperties",
+                                                   "xrCreateInstance"};
+
+        const FunctionInfo* FindFunction(const char* name)
+        {
+            for (const FunctionInfo& info : Functions) {
+                if (strcmp(info.name, name) == 0) {
+                    return &info;
+                }
+            }
+            return nullptr;
+        }
+
+        bool IsGlobalFunction(const char* name)
+        {
+            for (const char* globalName : GlobalFunctionNames) {
+                if (strcmp(globalName, name) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }  // namespace
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function)
+    HEADLESS_RUNTIME_TRY
+    {
+        if (name == nullptr || function == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        *function = nullptr;
+
+        const FunctionInfo* info = FindFunction(name);
+        if (instance == XR_NULL_HANDLE) {
+            if (!IsGlobalFunction(name)) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            *function = info->function;
+            return XR_SUCCESS;
+        }
+
+        auto lock = LockRuntime();
+        const Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (info == nullptr || !instanceObject->IsFeatureEnabled(info->feature)) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+        *function = info->function;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
+
+#if defined(__GNUC__) && __GNUC__ >= 4
+#define RUNTIME_EXPORT __attribute__((visibility("default")))
+#elif defined(__SUNPRO_C) && (__SUNPRO_C >= 0x590)
+#define RUNTIME_EXPORT __attribute__((visibility("default")))
+#else
+#define RUNTIME_EXPORT
+#endif
+
+// Function used to negotiate an interface between the loader and a runtime. This is the only function a runtime library exports.
+extern "C" RUNTIME_EXPORT XRAPI_ATTR XrResult XRAPI_CALL xrNegotiateLoaderRuntimeInterface(const XrNegotiateLoaderInfo* loaderInfo,
+                                                                                           XrNegotiateRuntimeRequest* runtimeRequest)
+{
+    if (loaderInfo == nullptr || loaderInfo->structType != XR_LOADER_INTERFACE_STRUCT_LOADER_INFO ||
+        loaderInfo->structVersion != XR_LOADER_INFO_STRUCT_VERSION || loaderInfo->structSize != sizeof(XrNegotiateLoaderInfo)) {
+        return XR_ERROR_INITIALIZATION_FAILED;
+    }
+
+    if (loaderInfo->minInterfaceVersion > XR_CURRENT_LOADER_RUNTIME_VERSION ||
+        loaderInfo->maxInterfaceVersion < XR_CURRENT_LOADER_RUNTIME_VERSION) {
+        return XR_ERROR_INITIALIZATION_FAILED;
+    }
+
+    if (loaderInfo->minApiVersion > XR_CURRENT_API_VERSION || loaderInfo->maxApiVersion < XR_MAKE_VERSION(1, 0, 0)) {
+        return XR_ERROR_INITIALIZATION_FAILED;
+    }
+
+    if (runtimeRequest == nullptr || runtimeRequest->structType != XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST ||
+        runtimeRequest->structVersion != XR_RUNTIME_INFO_STRUCT_VERSION ||
+        runtimeRequest->structSize != sizeof(XrNegotiateRuntimeRequest)) {
+        return XR_ERROR_INITIALIZATION_FAILED;
+    }
+
+    runtimeRequest->runtimeInterfaceVersion = XR_CURRENT_LOADER_RUNTIME_VERSION;
+    runtimeRequest->runtimeApiVersion = XR_CURRENT_API_VERSION;
+    runtimeRequest->getInstanceProcAddr = HeadlessRuntime::GetInstanceProcAddr;
+
+    return XR_SUCCESS;
+}
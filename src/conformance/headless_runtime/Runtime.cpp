@@ -0,0 +1,189 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include "common/platform_utils.hpp"
+#include "interaction_info.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        // Requires the runtime lock.
+        struct RegistryState
+        {
+            std::unordered_map<uint64_t, Object*> objects;
+            uint64_t nextHandle{1};
+        };
+
+        RegistryState& GetRegistryState()
+        {
+            static RegistryState state;
+            return state;
+        }
+
+        bool IsPathCharacter(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+        }
+
+        // A component made only of periods would read as a relative path element.
+        bool IsWellFormedComponent(const char* begin, const char* end)
+        {
+            if (begin == end) {
+                return false;
+            }
+            bool allPeriods = true;
+            for (const char* c = begin; c != end; ++c) {
+                if (!IsPathCharacter(*c)) {
+                    return false;
+                }
+                allPeriods = allPeriods && *c == '.';
+            }
+            return !allPeriods;
+        }
+    }  // namespace
+
+    Object::~Object()
+    {
+        Registry::Remove(*this);
+    }
+
+    void Registry::Add(Object& object)
+    {
+        RegistryState& state = GetRegistryState();
+        object.handle = state.nextHandle++;
+        state.objects.emplace(object.handle, &object);
+    }
+
+    void Registry::Remove(const Object& object)
+    {
+        GetRegistryState().objects.erase(object.handle);
+    }
+
+    Object* Registry::Find(uint64_t handle)
+    {
+        RegistryState& state = GetRegistryState();
+        auto it = state.objects.find(handle);
+        return it == state.objects.end() ? nullptr : it->second;
+    }
+
+    std::unique_lock<std::mutex> LockRuntime()
+    {
+        static std::mutex runtimeMutex;
+        return std::unique_lock<std::mutex>(runtimeMutex);
+    }
+
+    std::condition_variable& FrameCondition()
+    {
+        static std::condition_variable frameCondition;
+        return frameCondition;
+    }
+
+    // Start times at one second, so that zero and small values stay clearly invalid.
+    static constexpr XrTime TimeOrigin = 1000000000;
+
+    FrameClock::FrameClock() : m_epoch(std::chrono::steady_clock::now()), m_simulatedTime(TimeOrigin)
+    {
+        const std::string unthrottled = PlatformUtilsGetEnv("CONFORMANCE_HEADLESS_RUNTIME_UNTHROTTLED");
+        m_throttled = unthrottled.empty() || unthrottled == "0";
+
+        double displayHz = 90.0;
+        const std::string displayHzString = PlatformUtilsGetEnv("CONFORMANCE_HEADLESS_RUNTIME_DISPLAY_HZ");
+        if (!displayHzString.empty()) {
+            const double parsed = std::strtod(displayHzString.c_str(), nullptr);
+            if (parsed >= 1.0 && parsed <= 1000.0) {
+                displayHz = parsed;
+            }
+        }
+        m_displayPeriod = static_cast<XrDuration>(1e9 / displayHz);
+    }
+
+    XrTime FrameClock::Now() const
+    {
+        if (!m_throttled) {
+            return m_simulatedTime;
+        }
+        return TimeOrigin + std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+    }
+
+    void FrameClock::Advance(XrDuration duration)
+    {
+        m_simulatedTime += duration;
+    }
+
+    std::chrono::steady_clock::time_point FrameClock::ToSteadyClock(XrTime time) const
+    {
+        return m_epoch + std::chrono::nanoseconds(time - TimeOrigin);
+    }
+
+    FrameClock& GetFrameClock()
+    {
+        static FrameClock clock;
+        return clock;
+    }
+
+    bool IsWellFormedPath(const char* pathString)
+    {
+        const size_t length = strnlen(pathString, XR_MAX_PATH_LENGTH);
+        if (length == 0 || length >= XR_MAX_PATH_LENGTH || pathString[0] != '/') {
+            return false;
+        }
+        const char* componentBegin = pathString + 1;
+        for (const char* c = componentBegin;; ++c) {
+            if (*c == '/' || *c == '\0') {
+                if (!IsWellFormedComponent(componentBegin, c)) {
+                    return false;
+                }
+                if (*c == '\0') {
+                    return true;
+                }
+                componentBegin = c + 1;
+            }
+        }
+    }
+
+    bool IsWellFormedName(const char* name, size_t capacity)
+    {
+        const size_t length = strnlen(name, capacity);
+        return length < capacity && IsWellFormedComponent(name, name + length);
+    }
+
+    bool IsTopLevelUserPath(const Instance& instance, const std::string& path)
+    {
+        // Top level paths from the "Reserved Paths" section, whether or not an interaction profile uses them.
+        static const char* const ReservedPaths[] = {"/user/hand/left", "/user/hand/right", "/user/head", "/user/gamepad",
+                                                    "/user/treadmill"};
+        if (std::find(std::begin(ReservedPaths), std::end(ReservedPaths), path) != std::end(ReservedPaths)) {
+            return true;
+        }
+        for (const auto& profile : Conformance::GetAllInteractionProfiles()) {
+            if (!Conformance::kInteractionAvailabilities[(size_t)profile.Availability].IsSatisfiedBy(instance.enabledFeatures)) {
+                continue;
+            }
+            for (const char* topLevelPath : profile.TopLevelPaths) {
+                if (path == topLevelPath) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+}  // namespace HeadlessRuntime
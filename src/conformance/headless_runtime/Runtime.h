@@ -0,0 +1,402 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// Shared state of the headless session runtime.
+//
+// The runtime implements the sessions, spaces, actions and frame timing of the core API (1.0 and 1.1), XR_MND_headless,
+// XR_KHR_locate_spaces and XR_EXT_local_floor, with no devices attached: every session is headless, reference spaces
+// are fixed and all inputs are inactive. Frame timing is simulated, see @ref FrameClock. It has no swapchains.
+//
+// All entry points serialize on a single mutex (@ref LockRuntime). Objects are owned by their parent and looked up
+// through @ref Registry, so that destroyed or made-up handles are reported as XR_ERROR_HANDLE_INVALID.
+//
+
+#pragma once
+
+#include "common/hex_and_handles.h"
+#include "common/xr_dependencies.h"
+#include "utilities/feature_availability.h"
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <openxr/openxr_reflection.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Catch exceptions at the ABI boundary, in the manner of the loader's XRLOADER_ABI_TRY.
+#define HEADLESS_RUNTIME_TRY try
+#define HEADLESS_RUNTIME_CATCH                   \
+    catch (const std::bad_alloc&)                \
+    {                                            \
+        return XR_ERROR_OUT_OF_MEMORY;           \
+    }                                            \
+    catch (...)                                  \
+    {                                            \
+        return XR_ERROR_RUNTIME_FAILURE;         \
+    }
+
+namespace HeadlessRuntime
+{
+    // Declare every entry point with the exact signature of its PFN type, so that a missing or mismatched
+    // implementation is a compile or link error rather than a null entry in the loader's dispatch table.
+#define HEADLESS_RUNTIME_DECLARE_FUNCTION(name, feature) std::remove_pointer<PFN_xr##name>::type name;
+    XR_LIST_FUNCTIONS_XR_VERSION_1_0(HEADLESS_RUNTIME_DECLARE_FUNCTION)
+    XR_LIST_FUNCTIONS_XR_VERSION_1_1(HEADLESS_RUNTIME_DECLARE_FUNCTION)
+    // Promoted to 1.1, so the reflection header does not list it.
+    HEADLESS_RUNTIME_DECLARE_FUNCTION(LocateSpacesKHR, KHR_locate_spaces)
+#undef HEADLESS_RUNTIME_DECLARE_FUNCTION
+
+    constexpr XrSystemId HeadlessSystemId = 1;
+    constexpr uint32_t MaxLayerCount = XR_MIN_COMPOSITION_LAYERS_SUPPORTED;
+    constexpr size_t MaxQueuedEvents = 64;
+
+    struct Instance;
+    struct Session;
+    struct Space;
+    struct ActionSet;
+    struct Action;
+
+    /// Base of all objects with a handle.
+    struct Object
+    {
+        Object(XrObjectType type) : type(type)
+        {
+        }
+        virtual ~Object();
+
+        Object(const Object&) = delete;
+        Object& operator=(const Object&) = delete;
+
+        const XrObjectType type;
+        uint64_t handle{0};
+    };
+
+    /// Maps handle values to live objects. Handle values are never reused.
+    class Registry
+    {
+    public:
+        /// Assigns a new handle value to @p object.
+        static void Add(Object& object);
+        static void Remove(const Object& object);
+
+        /// Returns the object for @p handle, or nullptr if it is not a live object of type @p T.
+        template <typename T, typename THandle>
+        static T* Get(THandle handle)
+        {
+            Object* object = Find(MakeHandleGeneric(handle));
+            if (object == nullptr || object->type != T::ObjectType) {
+                return nullptr;
+            }
+            return static_cast<T*>(object);
+        }
+
+    private:
+        static Object* Find(uint64_t handle);
+    };
+
+    template <typename THandle>
+    THandle ToHandle(const Object& object)
+    {
+        uint64_t value = object.handle;
+        return TreatIntegerAsHandle<THandle>(value);
+    }
+
+    /// Serializes all calls into the runtime.
+    std::unique_lock<std::mutex> LockRuntime();
+
+    /// Signalled whenever frame or session state changes, so that blocked xrWaitFrame calls can re-check.
+    std::condition_variable& FrameCondition();
+
+    /// Source of XrTime values.
+    ///
+    /// By default time follows the steady clock and xrWaitFrame paces frames in real time at the display rate.
+    /// When CONFORMANCE_HEADLESS_RUNTIME_UNTHROTTLED is set to a non-zero value, time only advances by one display period
+    /// per xrWaitFrame and nothing sleeps, so that runs are deterministic and as fast as the rest of the stack allows.
+    /// CONFORMANCE_HEADLESS_RUNTIME_DISPLAY_HZ overrides the simulated display rate (90 Hz).
+    class FrameClock
+    {
+    public:
+        FrameClock();
+
+        bool IsThrottled() const
+        {
+            return m_throttled;
+        }
+
+        XrDuration DisplayPeriod() const
+        {
+            return m_displayPeriod;
+        }
+
+        XrTime Now() const;
+
+        /// Unthrottled mode only: moves simulated time forward.
+        void Advance(XrDuration duration);
+
+        std::chrono::steady_clock::time_point ToSteadyClock(XrTime time) const;
+
+    private:
+        bool m_throttled{true};
+        XrDuration m_displayPeriod;
+        std::chrono::steady_clock::time_point m_epoch;
+        XrTime m_simulatedTime;
+    };
+
+    FrameClock& GetFrameClock();
+
+    struct Instance : Object
+    {
+        static constexpr XrObjectType ObjectType = XR_OBJECT_TYPE_INSTANCE;
+
+        Instance() : Object(ObjectType)
+        {
+        }
+        ~Instance() override;
+
+        XrVersion apiVersion{};
+        Conformance::FeatureSet enabledFeatures;
+        std::string applicationName;
+        bool systemRetrieved{false};
+
+        std::vector<std::unique_ptr<Session>> sessions;
+        std::vector<std::unique_ptr<ActionSet>> actionSets;
+
+        /// Suggested bindings, by interaction profile path. Only the latest suggestion for each profile is kept.
+        std::unordered_map<XrPath, std::vector<XrActionSuggestedBinding>> suggestedBindings;
+
+        std::deque<XrEventDataBuffer> events;
+        uint32_t lostEventCount{0};
+
+        /// Path strings, indexed by XrPath value - 1.
+        std::vector<std::string> pathStrings;
+        std::unordered_map<std::string, XrPath> paths;
+
+        bool IsFeatureEnabled(const char* featureName) const;
+
+        /// Returns the path for a string that is known to be well-formed, creating it if needed.
+        XrPath GetOrCreatePath(const std::string& pathString);
+
+        /// Returns nullptr if @p path is not a path of this instance.
+        const std::string* GetPathString(XrPath path) const;
+
+        /// Adds an event to the queue, or notes that events were lost if it is full.
+        void PushEvent(const XrEventDataBaseHeader& event, size_t size);
+
+        /// Removes queued events that refer to @p session.
+        void RemoveEventsFor(const Session& session);
+    };
+
+    struct Session : Object
+    {
+        static constexpr XrObjectType ObjectType = XR_OBJECT_TYPE_SESSION;
+
+        Session(Instance& instance) : Object(ObjectType), instance(instance)
+        {
+        }
+        ~Session() override;
+
+        Instance& instance;
+
+        XrSessionState state{XR_SESSION_STATE_UNKNOWN};
+        bool running{false};
+        bool exitRequested{false};
+        XrViewConfigurationType primaryViewConfigurationType{};
+
+        /// Frame loop: counts of xrWaitFrame and xrBeginFrame calls, and whether a frame is between xrBeginFrame and xrEndFrame.
+        uint64_t waitedFrameCount{0};
+        uint64_t begunFrameCount{0};
+        bool frameInProgress{false};
+        XrTime lastPredictedDisplayTime{0};
+        std::chrono::steady_clock::time_point lastWaitFrameReturn{};
+
+        std::vector<std::unique_ptr<Space>> spaces;
+
+        /// Set by xrAttachSessionActionSets, which can only be called once. Destroyed action sets are removed from the list.
+        bool actionSetsAttached{false};
+        std::vector<ActionSet*> attachedActionSets;
+
+        /// Queues a session state change event and updates @ref state.
+        void SetState(XrSessionState newState);
+
+        bool IsFocused() const
+        {
+            return state == XR_SESSION_STATE_FOCUSED;
+        }
+
+        bool IsAttached(const ActionSet& actionSet) const;
+    };
+
+    struct Space : Object
+    {
+        static constexpr XrObjectType ObjectType = XR_OBJECT_TYPE_SPACE;
+
+        Space(Session& session) : Object(ObjectType), session(session)
+        {
+        }
+
+        Session& session;
+
+        /// Reference spaces have a fixed pose in the world. Action spaces have no device to follow, so are never located.
+        bool isReferenceSpace{true};
+        XrReferenceSpaceType referenceSpaceType{};
+        XrPosef poseInSpace{{0, 0, 0, 1}, {0, 0, 0}};
+    };
+
+    struct ActionSet : Object
+    {
+        static constexpr XrObjectType ObjectType = XR_OBJECT_TYPE_ACTION_SET;
+
+        ActionSet(Instance& instance) : Object(ObjectType), instance(instance)
+        {
+        }
+        ~ActionSet() override;
+
+        Instance& instance;
+        std::string name;
+        std::string localizedName;
+        uint32_t priority{0};
+        /// Set once attached to any session, after which no actions can be added.
+        bool attached{false};
+
+        std::vector<std::unique_ptr<Action>> actions;
+    };
+
+    struct Action : Object
+    {
+        static constexpr XrObjectType ObjectType = XR_OBJECT_TYPE_ACTION;
+
+        Action(ActionSet& actionSet) : Object(ObjectType), actionSet(actionSet)
+        {
+        }
+
+        ActionSet& actionSet;
+        std::string name;
+        std::string localizedName;
+        XrActionType actionType{};
+        std::vector<XrPath> subactionPaths;
+
+        /// Whether @p subactionPath is XR_NULL_PATH or one of the subaction paths the action was created with.
+        bool AcceptsSubactionPath(XrPath subactionPath) const;
+    };
+
+    /// Destroys a session, and its spaces, and forgets it in its instance.
+    void DestroySessionObject(Session& session);
+
+    /// Destroys an action set and its actions, and forgets it in its instance.
+    void DestroyActionSetObject(ActionSet& actionSet);
+
+    /// Checks that @p pathString is a well-formed path string as defined in the "Path Names" section of the specification.
+    bool IsWellFormedPath(const char* pathString);
+
+    /// Checks a name for an action or action set: a single well-formed path component, null-terminated within @p capacity.
+    bool IsWellFormedName(const char* name, size_t capacity);
+
+    /// Returns whether @p path names a top level user path that input can be bound to, given the enabled features.
+    bool IsTopLevelUserPath(const Instance& instance, const std::string& path);
+
+    bool IsSupportedViewConfigurationType(XrViewConfigurationType viewConfigurationType);
+
+    /// Returns XR_SUCCESS for a supported view configuration type, XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED for one that
+    /// is known but not supported, and XR_ERROR_VALIDATION_FAILURE otherwise.
+    XrResult CheckViewConfigurationType(XrViewConfigurationType viewConfigurationType);
+
+    /// Number of views of a supported view configuration type.
+    uint32_t GetViewCount(XrViewConfigurationType viewConfigurationType);
+
+    bool IsSupportedBlendMode(XrEnvironmentBlendMode blendMode);
+
+    /// Returns the pose of the VIEW reference space (the simulated head) in the world.
+    XrPosef GetViewPoseInWorld();
+
+    /// Returns the pose of @p space in the world, or false if the space cannot be located.
+    bool GetSpacePoseInWorld(const Space& space, XrPosef* pose);
+
+    /// Applies the output half of the two-call idiom: sets @p countOutput and returns XR_ERROR_SIZE_INSUFFICIENT
+    /// when @p capacityInput is non-zero but too small.
+    template <typename T>
+    XrResult WriteTwoCallArray(uint32_t capacityInput, uint32_t* countOutput, T* output, const T* values, uint32_t count)
+    {
+        if (countOutput == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        *countOutput = count;
+        if (capacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (capacityInput < count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        if (output == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            output[i] = values[i];
+        }
+        return XR_SUCCESS;
+    }
+
+    /// Checks that a caller-provided array of output structures has the expected type in every element that will be written.
+    template <typename T>
+    bool HasStructureType(const T* structs, uint32_t count, XrStructureType type)
+    {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (structs[i].type != type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    const T* FindChained(const void* next, XrStructureType type)
+    {
+        for (auto ext = reinterpret_cast<const XrBaseInStructure*>(next); ext != nullptr; ext = ext->next) {
+            if (ext->type == type) {
+                return reinterpret_cast<const T*>(ext);
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    T* FindChainedOutput(void* next, XrStructureType type)
+    {
+        for (auto ext = reinterpret_cast<XrBaseOutStructure*>(next); ext != nullptr; ext = ext->next) {
+            if (ext->type == type) {
+                return reinterpret_cast<T*>(ext);
+            }
+        }
+        return nullptr;
+    }
+
+    inline bool IsUnitQuaternion(const XrQuaternionf& q)
+    {
+        const float lengthSquared = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+        // The specification allows runtimes to accept approximately-normalized quaternions.
+        return lengthSquared > 0.99f && lengthSquared < 1.01f;
+    }
+}  // namespace HeadlessRuntime
@@ -0,0 +1,461 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include "common/xr_linear.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        constexpr float HalfInterpupillaryDistance = 0.032f;
+        constexpr float HalfFovAngle = 0.785398f;  // 45 degrees
+
+        bool IsGraphicsBinding(XrStructureType type)
+        {
+            switch (type) {
+            case XR_TYPE_GRAPHICS_BINDING_OPENGL_WIN32_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_OPENGL_XCB_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_OPENGL_WAYLAND_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_OPENGL_ES_ANDROID_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_D3D11_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_D3D12_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_METAL_KHR:
+            case XR_TYPE_GRAPHICS_BINDING_EGL_MNDX:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Looks up a session and checks that it is running, which every frame function requires.
+        XrResult GetRunningSession(XrSession session, Session** sessionObject)
+        {
+            *sessionObject = Registry::Get<Session>(session);
+            if (*sessionObject == nullptr) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (!(*sessionObject)->running) {
+                return XR_ERROR_SESSION_NOT_RUNNING;
+            }
+            return XR_SUCCESS;
+        }
+
+        // Frames are predicted one display period ahead. Keep predictions strictly increasing even if the
+        // application calls xrWaitFrame faster than the display rate, as it may from several threads.
+        XrTime PredictDisplayTime(const Session& session, XrTime now, XrDuration period)
+        {
+            const XrTime predicted = now + period;
+            return predicted > session.lastPredictedDisplayTime ? predicted : session.lastPredictedDisplayTime + period;
+        }
+
+        // Headless sessions cannot create swapchains (see xrCreateSwapchain), so no handle a layer refers to can be
+        // valid, XR_NULL_HANDLE included. Applications without graphics must submit no layers at all.
+        XrResult CheckLayerSwapchain(XrSwapchain /* swapchain */)
+        {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        XrResult CheckLayer(const Session& session, const XrCompositionLayerBaseHeader* layer)
+        {
+            if (layer == nullptr) {
+                return XR_ERROR_LAYER_INVALID;
+            }
+            const Space* space = Registry::Get<Space>(layer->space);
+            if (space == nullptr || &space->session != &session) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            switch (layer->type) {
+            case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+                auto projection = reinterpret_cast<const XrCompositionLayerProjection*>(layer);
+                if (projection->viewCount > 0 && projection->views == nullptr) {
+                    return XR_ERROR_VALIDATION_FAILURE;
+                }
+                for (uint32_t i = 0; i < projection->viewCount; ++i) {
+                    if (projection->views[i].type != XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW) {
+                        return XR_ERROR_VALIDATION_FAILURE;
+                    }
+                    if (XR_FAILED(CheckLayerSwapchain(projection->views[i].subImage.swapchain))) {
+                        return XR_ERROR_HANDLE_INVALID;
+                    }
+                }
+                return XR_SUCCESS;
+            }
+            case XR_TYPE_COMPOSITION_LAYER_QUAD:
+                return CheckLayerSwapchain(reinterpret_cast<const XrCompositionLayerQuad*>(layer)->subImage.swapchain);
+            case XR_TYPE_COMPOSITION_LAYER_CUBE_KHR:
+                return CheckLayerSwapchain(reinterpret_cast<const XrCompositionLayerCubeKHR*>(layer)->swapchain);
+            case XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR:
+                return CheckLayerSwapchain(reinterpret_cast<const XrCompositionLayerCylinderKHR*>(layer)->subImage.swapchain);
+            case XR_TYPE_COMPOSITION_LAYER_EQUIRECT_KHR:
+                return CheckLayerSwapchain(reinterpret_cast<const XrCompositionLayerEquirectKHR*>(layer)->subImage.swapchain);
+            case XR_TYPE_COMPOSITION_LAYER_EQUIRECT2_KHR:
+                return CheckLayerSwapchain(reinterpret_cast<const XrCompositionLayerEquirect2KHR*>(layer)->subImage.swapchain);
+            default:
+                return XR_ERROR_LAYER_INVALID;
+            }
+        }
+    }  // namespace
+
+    Session::~Session() = default;
+
+    void Session::SetState(XrSessionState newState)
+    {
+        state = newState;
+
+        XrEventDataSessionStateChanged event{XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED};
+        event.session = ToHandle<XrSession>(*this);
+        event.state = newState;
+        event.time = GetFrameClock().Now();
+        instance.PushEvent(reinterpret_cast<const XrEventDataBaseHeader&>(event), sizeof(event));
+    }
+
+    bool Session::IsAttached(const ActionSet& actionSet) const
+    {
+        return std::find(attachedActionSets.begin(), attachedActionSets.end(), &actionSet) != attachedActionSets.end();
+    }
+
+    void DestroySessionObject(Session& session)
+    {
+        Instance& instance = session.instance;
+        instance.RemoveEventsFor(session);
+        instance.sessions.erase(std::find_if(instance.sessions.begin(), instance.sessions.end(),
+                                             [&](const std::unique_ptr<Session>& candidate) { return candidate.get() == &session; }));
+        // Wake any xrWaitFrame blocked on the session, so that it can report the handle as invalid.
+        FrameCondition().notify_all();
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || session == nullptr || createInfo->type != XR_TYPE_SESSION_CREATE_INFO ||
+            createInfo->createFlags != 0) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->systemId != HeadlessSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        // There is no graphics device to bind to, so only headless sessions can be created.
+        for (auto ext = reinterpret_cast<const XrBaseInStructure*>(createInfo->next); ext != nullptr; ext = ext->next) {
+            if (IsGraphicsBinding(ext->type)) {
+                return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+            }
+        }
+        if (!instanceObject->IsFeatureEnabled("XR_MND_headless")) {
+            return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+        }
+
+        auto newSession = std::make_unique<Session>(*instanceObject);
+        Registry::Add(*newSession);
+        // Nothing needs to be set up and no user needs to be engaged, so the session is ready immediately.
+        newSession->SetState(XR_SESSION_STATE_IDLE);
+        newSession->SetState(XR_SESSION_STATE_READY);
+        *session = ToHandle<XrSession>(*newSession);
+        instanceObject->sessions.push_back(std::move(newSession));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroySession(XrSession session)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        DestroySessionObject(*sessionObject);
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL BeginSession(XrSession session, const XrSessionBeginInfo* beginInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (beginInfo == nullptr || beginInfo->type != XR_TYPE_SESSION_BEGIN_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const XrResult result = CheckViewConfigurationType(beginInfo->primaryViewConfigurationType);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (sessionObject->running) {
+            return XR_ERROR_SESSION_RUNNING;
+        }
+        if (sessionObject->state != XR_SESSION_STATE_READY) {
+            return XR_ERROR_SESSION_NOT_READY;
+        }
+        sessionObject->running = true;
+        sessionObject->exitRequested = false;
+        sessionObject->primaryViewConfigurationType = beginInfo->primaryViewConfigurationType;
+        sessionObject->waitedFrameCount = 0;
+        sessionObject->begunFrameCount = 0;
+        sessionObject->frameInProgress = false;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EndSession(XrSession session)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject;
+        const XrResult result = GetRunningSession(session, &sessionObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (sessionObject->state != XR_SESSION_STATE_STOPPING) {
+            return XR_ERROR_SESSION_NOT_STOPPING;
+        }
+        sessionObject->running = false;
+        sessionObject->frameInProgress = false;
+        sessionObject->SetState(XR_SESSION_STATE_IDLE);
+        // Sessions only stop because the application asked to exit, and there is nothing to come back for.
+        sessionObject->SetState(XR_SESSION_STATE_EXITING);
+        FrameCondition().notify_all();
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL RequestExitSession(XrSession session)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject;
+        const XrResult result = GetRunningSession(session, &sessionObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (sessionObject->exitRequested) {
+            return XR_SUCCESS;
+        }
+        sessionObject->exitRequested = true;
+        // Step back down through each state, since applications must see every transition.
+        if (sessionObject->state == XR_SESSION_STATE_FOCUSED) {
+            sessionObject->SetState(XR_SESSION_STATE_VISIBLE);
+        }
+        if (sessionObject->state == XR_SESSION_STATE_VISIBLE || sessionObject->state == XR_SESSION_STATE_READY) {
+            sessionObject->SetState(XR_SESSION_STATE_SYNCHRONIZED);
+        }
+        sessionObject->SetState(XR_SESSION_STATE_STOPPING);
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL WaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject;
+        XrResult result = GetRunningSession(session, &sessionObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if ((frameWaitInfo != nullptr && frameWaitInfo->type != XR_TYPE_FRAME_WAIT_INFO) || frameState == nullptr ||
+            frameState->type != XR_TYPE_FRAME_STATE) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        FrameClock& clock = GetFrameClock();
+
+        // A frame that has been waited for must begin before the next xrWaitFrame returns.
+        // The session may be ended or destroyed while waiting, so look it up again on every wake.
+        while (sessionObject->begunFrameCount < sessionObject->waitedFrameCount) {
+            FrameCondition().wait(lock);
+            result = GetRunningSession(session, &sessionObject);
+            if (XR_FAILED(result)) {
+                return result;
+            }
+        }
+
+        if (clock.IsThrottled()) {
+            const auto deadline = sessionObject->lastWaitFrameReturn + std::chrono::nanoseconds(clock.DisplayPeriod());
+            while (std::chrono::steady_clock::now() < deadline) {
+                FrameCondition().wait_until(lock, deadline);
+                result = GetRunningSession(session, &sessionObject);
+                if (XR_FAILED(result)) {
+                    return result;
+                }
+            }
+            sessionObject->lastWaitFrameReturn = std::chrono::steady_clock::now();
+        }
+        else {
+            clock.Advance(clock.DisplayPeriod());
+        }
+
+        // The application has synchronized with the frame loop: bring the session to the foreground.
+        if (sessionObject->state == XR_SESSION_STATE_READY && !sessionObject->exitRequested) {
+            sessionObject->SetState(XR_SESSION_STATE_SYNCHRONIZED);
+            sessionObject->SetState(XR_SESSION_STATE_VISIBLE);
+            sessionObject->SetState(XR_SESSION_STATE_FOCUSED);
+        }
+
+        ++sessionObject->waitedFrameCount;
+        sessionObject->lastPredictedDisplayTime = PredictDisplayTime(*sessionObject, clock.Now(), clock.DisplayPeriod());
+        frameState->predictedDisplayTime = sessionObject->lastPredictedDisplayTime;
+        frameState->predictedDisplayPeriod = clock.DisplayPeriod();
+        frameState->shouldRender =
+            (sessionObject->state == XR_SESSION_STATE_VISIBLE || sessionObject->state == XR_SESSION_STATE_FOCUSED) ? XR_TRUE : XR_FALSE;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL BeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject;
+        const XrResult result = GetRunningSession(session, &sessionObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (frameBeginInfo != nullptr && frameBeginInfo->type != XR_TYPE_FRAME_BEGIN_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (sessionObject->begunFrameCount == sessionObject->waitedFrameCount) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+        ++sessionObject->begunFrameCount;
+        FrameCondition().notify_all();
+        if (sessionObject->frameInProgress) {
+            // The previous frame was never ended, and is replaced by this one.
+            return XR_FRAME_DISCARDED;
+        }
+        sessionObject->frameInProgress = true;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject;
+        const XrResult result = GetRunningSession(session, &sessionObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (frameEndInfo == nullptr || frameEndInfo->type != XR_TYPE_FRAME_END_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!sessionObject->frameInProgress) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+        if (frameEndInfo->displayTime <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+        if (!IsSupportedBlendMode(frameEndInfo->environmentBlendMode)) {
+            return XR_ERROR_ENVIRONMENT_BLEND_MODE_UNSUPPORTED;
+        }
+        if (frameEndInfo->layerCount > MaxLayerCount) {
+            return XR_ERROR_LAYER_LIMIT_EXCEEDED;
+        }
+        if (frameEndInfo->layerCount > 0 && frameEndInfo->layers == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < frameEndInfo->layerCount; ++i) {
+            const XrResult layerResult = CheckLayer(*sessionObject, frameEndInfo->layers[i]);
+            if (XR_FAILED(layerResult)) {
+                return layerResult;
+            }
+        }
+        sessionObject->frameInProgress = false;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL LocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState,
+                                               uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrView* views)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (viewLocateInfo == nullptr || viewLocateInfo->type != XR_TYPE_VIEW_LOCATE_INFO || viewState == nullptr ||
+            viewState->type != XR_TYPE_VIEW_STATE || viewCountOutput == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const Space* space = Registry::Get<Space>(viewLocateInfo->space);
+        if (space == nullptr || &space->session != sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        XrResult result = CheckViewConfigurationType(viewLocateInfo->viewConfigurationType);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (viewLocateInfo->displayTime <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        const uint32_t count = GetViewCount(viewLocateInfo->viewConfigurationType);
+        *viewCountOutput = count;
+        if (viewCapacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (viewCapacityInput < count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        if (views == nullptr || !HasStructureType(views, count, XR_TYPE_VIEW)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        XrPosef baseInWorld;
+        if (!GetSpacePoseInWorld(*space, &baseInWorld)) {
+            viewState->viewStateFlags = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                views[i].pose = XrPosef{{0, 0, 0, 1}, {0, 0, 0}};
+                views[i].fov = XrFovf{};
+            }
+            return XR_SUCCESS;
+        }
+
+        XrPosef worldInBase;
+        XrPosef_Invert(&worldInBase, &baseInWorld);
+        const XrPosef headInWorld = GetViewPoseInWorld();
+        XrPosef headInBase;
+        XrPosef_Multiply(&headInBase, &worldInBase, &headInWorld);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            // Views are ordered left to right.
+            const float offset = count == 1 ? 0.0f : (i == 0 ? -HalfInterpupillaryDistance : HalfInterpupillaryDistance);
+            const XrPosef eyeInHead{{0, 0, 0, 1}, {offset, 0, 0}};
+            XrPosef_Multiply(&views[i].pose, &headInBase, &eyeInHead);
+            views[i].fov = XrFovf{-HalfFovAngle, HalfFovAngle, HalfFovAngle, -HalfFovAngle};
+        }
+        viewState->viewStateFlags = XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT |
+                                    XR_VIEW_STATE_ORIENTATION_TRACKED_BIT | XR_VIEW_STATE_POSITION_TRACKED_BIT;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
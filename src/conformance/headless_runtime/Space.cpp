@@ -0,0 +1,314 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include "common/xr_linear.h"
+
+#include <algorithm>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        // The world origin is the centre of the stage, on the floor. The simulated user stands there, eyes 1.6m up.
+        constexpr float EyeHeight = 1.6f;
+        constexpr float StageWidth = 2.0f;
+        constexpr float StageDepth = 2.0f;
+
+        // Reference space types available to @p session, in order of preference.
+        std::vector<XrReferenceSpaceType> GetReferenceSpaceTypes(const Session& session)
+        {
+            std::vector<XrReferenceSpaceType> types{XR_REFERENCE_SPACE_TYPE_VIEW, XR_REFERENCE_SPACE_TYPE_LOCAL,
+                                                    XR_REFERENCE_SPACE_TYPE_STAGE};
+            if (session.instance.IsFeatureEnabled("XR_VERSION_1_1") || session.instance.IsFeatureEnabled("XR_EXT_local_floor")) {
+                types.push_back(XR_REFERENCE_SPACE_TYPE_LOCAL_FLOOR);
+            }
+            return types;
+        }
+
+        bool IsReferenceSpaceTypeSupported(const Session& session, XrReferenceSpaceType type)
+        {
+            const std::vector<XrReferenceSpaceType> types = GetReferenceSpaceTypes(session);
+            return std::find(types.begin(), types.end(), type) != types.end();
+        }
+
+        XrPosef GetReferenceSpacePoseInWorld(XrReferenceSpaceType type)
+        {
+            switch (type) {
+            case XR_REFERENCE_SPACE_TYPE_VIEW:
+                return GetViewPoseInWorld();
+            case XR_REFERENCE_SPACE_TYPE_LOCAL:
+                return XrPosef{{0, 0, 0, 1}, {0, EyeHeight, 0}};
+            default:
+                // STAGE and LOCAL_FLOOR
+                return XrPosef{{0, 0, 0, 1}, {0, 0, 0}};
+            }
+        }
+
+        XrResult CreateSpace(Session& session, const XrPosef& poseInSpace, XrSpace* space, std::unique_ptr<Space> newSpace)
+        {
+            newSpace->poseInSpace = poseInSpace;
+            Registry::Add(*newSpace);
+            *space = ToHandle<XrSpace>(*newSpace);
+            session.spaces.push_back(std::move(newSpace));
+            return XR_SUCCESS;
+        }
+
+        /// Fills in one location. Velocities are always zero, since nothing moves.
+        void LocateSpaceIn(const Space& space, const Space& baseSpace, XrSpaceLocationFlags* locationFlags, XrPosef* pose,
+                           XrSpaceVelocityFlags* velocityFlags, XrVector3f* linearVelocity, XrVector3f* angularVelocity)
+        {
+            XrPosef spaceInWorld;
+            XrPosef baseInWorld;
+            const bool located = GetSpacePoseInWorld(space, &spaceInWorld) && GetSpacePoseInWorld(baseSpace, &baseInWorld);
+            if (located) {
+                XrPosef worldInBase;
+                XrPosef_Invert(&worldInBase, &baseInWorld);
+                XrPosef_Multiply(pose, &worldInBase, &spaceInWorld);
+                *locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+                                 XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+            }
+            else {
+                *pose = XrPosef{{0, 0, 0, 1}, {0, 0, 0}};
+                *locationFlags = 0;
+            }
+            if (velocityFlags != nullptr) {
+                *velocityFlags = located ? (XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) : 0;
+                *linearVelocity = XrVector3f{0, 0, 0};
+                *angularVelocity = XrVector3f{0, 0, 0};
+            }
+        }
+
+        // Shared by xrLocateSpaces and xrLocateSpacesKHR, whose structures are aliases of each other.
+        XrResult LocateSpacesImpl(XrSession session, const XrSpacesLocateInfo* locateInfo, XrSpaceLocations* spaceLocations)
+        {
+            Session* sessionObject = Registry::Get<Session>(session);
+            if (sessionObject == nullptr) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (locateInfo == nullptr || locateInfo->type != XR_TYPE_SPACES_LOCATE_INFO || spaceLocations == nullptr ||
+                spaceLocations->type != XR_TYPE_SPACE_LOCATIONS) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+            if (locateInfo->spaceCount == 0 || locateInfo->spaces == nullptr || spaceLocations->locationCount != locateInfo->spaceCount ||
+                spaceLocations->locations == nullptr) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+            const Space* baseSpace = Registry::Get<Space>(locateInfo->baseSpace);
+            if (baseSpace == nullptr) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            std::vector<const Space*> spaces(locateInfo->spaceCount);
+            for (uint32_t i = 0; i < locateInfo->spaceCount; ++i) {
+                spaces[i] = Registry::Get<Space>(locateInfo->spaces[i]);
+                if (spaces[i] == nullptr) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
+            }
+            if (locateInfo->time <= 0) {
+                return XR_ERROR_TIME_INVALID;
+            }
+
+            auto velocities = FindChainedOutput<XrSpaceVelocities>(spaceLocations->next, XR_TYPE_SPACE_VELOCITIES);
+            if (velocities != nullptr && (velocities->velocityCount != locateInfo->spaceCount || velocities->velocities == nullptr)) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+
+            for (uint32_t i = 0; i < locateInfo->spaceCount; ++i) {
+                XrSpaceLocationData& location = spaceLocations->locations[i];
+                if (velocities != nullptr) {
+                    XrSpaceVelocityData& velocity = velocities->velocities[i];
+                    LocateSpaceIn(*spaces[i], *baseSpace, &location.locationFlags, &location.pose, &velocity.velocityFlags,
+                                  &velocity.linearVelocity, &velocity.angularVelocity);
+                }
+                else {
+                    LocateSpaceIn(*spaces[i], *baseSpace, &location.locationFlags, &location.pose, nullptr, nullptr, nullptr);
+                }
+            }
+            return XR_SUCCESS;
+        }
+    }  // namespace
+
+    XrPosef GetViewPoseInWorld()
+    {
+        return XrPosef{{0, 0, 0, 1}, {0, EyeHeight, 0}};
+    }
+
+    bool GetSpacePoseInWorld(const Space& space, XrPosef* pose)
+    {
+        if (!space.isReferenceSpace) {
+            return false;
+        }
+        const XrPosef referenceInWorld = GetReferenceSpacePoseInWorld(space.referenceSpaceType);
+        XrPosef_Multiply(pose, &referenceInWorld, &space.poseInSpace);
+        return true;
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateReferenceSpaces(XrSession session, uint32_t spaceCapacityInput, uint32_t* spaceCountOutput,
+                                                            XrReferenceSpaceType* spaces)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        const std::vector<XrReferenceSpaceType> types = GetReferenceSpaceTypes(*sessionObject);
+        return WriteTwoCallArray(spaceCapacityInput, spaceCountOutput, spaces, types.data(), (uint32_t)types.size());
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || space == nullptr || createInfo->type != XR_TYPE_REFERENCE_SPACE_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!IsReferenceSpaceTypeSupported(*sessionObject, createInfo->referenceSpaceType)) {
+            return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+        }
+        if (!IsUnitQuaternion(createInfo->poseInReferenceSpace.orientation)) {
+            return XR_ERROR_POSE_INVALID;
+        }
+        auto newSpace = std::make_unique<Space>(*sessionObject);
+        newSpace->referenceSpaceType = createInfo->referenceSpaceType;
+        return CreateSpace(*sessionObject, createInfo->poseInReferenceSpace, space, std::move(newSpace));
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetReferenceSpaceBoundsRect(XrSession session, XrReferenceSpaceType referenceSpaceType,
+                                                               XrExtent2Df* bounds)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (bounds == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!IsReferenceSpaceTypeSupported(*sessionObject, referenceSpaceType)) {
+            return referenceSpaceType == XR_REFERENCE_SPACE_TYPE_MAX_ENUM ? XR_ERROR_VALIDATION_FAILURE
+                                                                           : XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+        }
+        if (referenceSpaceType != XR_REFERENCE_SPACE_TYPE_STAGE) {
+            *bounds = XrExtent2Df{0, 0};
+            return XR_SPACE_BOUNDS_UNAVAILABLE;
+        }
+        *bounds = XrExtent2Df{StageWidth, StageDepth};
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* createInfo, XrSpace* space)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Session* sessionObject = Registry::Get<Session>(session);
+        if (sessionObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || space == nullptr || createInfo->type != XR_TYPE_ACTION_SPACE_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const Action* action = Registry::Get<Action>(createInfo->action);
+        if (action == nullptr || &action->actionSet.instance != &sessionObject->instance) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (action->actionType != XR_ACTION_TYPE_POSE_INPUT) {
+            return XR_ERROR_ACTION_TYPE_MISMATCH;
+        }
+        if (createInfo->subactionPath != XR_NULL_PATH && sessionObject->instance.GetPathString(createInfo->subactionPath) == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        if (!action->AcceptsSubactionPath(createInfo->subactionPath)) {
+            return XR_ERROR_PATH_UNSUPPORTED;
+        }
+        if (!IsUnitQuaternion(createInfo->poseInActionSpace.orientation)) {
+            return XR_ERROR_POSE_INVALID;
+        }
+        auto newSpace = std::make_unique<Space>(*sessionObject);
+        newSpace->isReferenceSpace = false;
+        return CreateSpace(*sessionObject, createInfo->poseInActionSpace, space, std::move(newSpace));
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroySpace(XrSpace space)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Space* spaceObject = Registry::Get<Space>(space);
+        if (spaceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        auto& spaces = spaceObject->session.spaces;
+        spaces.erase(std::find_if(spaces.begin(), spaces.end(),
+                                  [&](const std::unique_ptr<Space>& candidate) { return candidate.get() == spaceObject; }));
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL LocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        const Space* spaceObject = Registry::Get<Space>(space);
+        const Space* baseSpaceObject = Registry::Get<Space>(baseSpace);
+        if (spaceObject == nullptr || baseSpaceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (location == nullptr || location->type != XR_TYPE_SPACE_LOCATION) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (time <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+        auto velocity = FindChainedOutput<XrSpaceVelocity>(location->next, XR_TYPE_SPACE_VELOCITY);
+        if (velocity != nullptr) {
+            LocateSpaceIn(*spaceObject, *baseSpaceObject, &location->locationFlags, &location->pose, &velocity->velocityFlags,
+                          &velocity->linearVelocity, &velocity->angularVelocity);
+        }
+        else {
+            LocateSpaceIn(*spaceObject, *baseSpaceObject, &location->locationFlags, &location->pose, nullptr, nullptr, nullptr);
+        }
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL LocateSpaces(XrSession session, const XrSpacesLocateInfo* locateInfo, XrSpaceLocations* spaceLocations)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        return LocateSpacesImpl(session, locateInfo, spaceLocations);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL LocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR* locateInfo,
+                                                   XrSpaceLocationsKHR* spaceLocations)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        return LocateSpacesImpl(session, locateInfo, spaceLocations);
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
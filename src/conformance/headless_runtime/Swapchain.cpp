@@ -0,0 +1,78 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// XR_MND_headless sessions have no graphics API, so they support no swapchain formats, no swapchain can be created,
+// and every swapchain handle is invalid.
+//
+
+#include "Runtime.h"
+
+namespace HeadlessRuntime
+{
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput, uint32_t* formatCountOutput,
+                                                             int64_t* formats)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        if (Registry::Get<Session>(session) == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        return WriteTwoCallArray<int64_t>(formatCapacityInput, formatCountOutput, formats, nullptr, 0);
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL CreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        if (Registry::Get<Session>(session) == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || swapchain == nullptr || createInfo->type != XR_TYPE_SWAPCHAIN_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL DestroySwapchain(XrSwapchain /* swapchain */)
+    {
+        return XR_ERROR_HANDLE_INVALID;
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateSwapchainImages(XrSwapchain /* swapchain */, uint32_t /* imageCapacityInput */,
+                                                            uint32_t* /* imageCountOutput */, XrSwapchainImageBaseHeader* /* images */)
+    {
+        return XR_ERROR_HANDLE_INVALID;
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL AcquireSwapchainImage(XrSwapchain /* swapchain */, const XrSwapchainImageAcquireInfo* /* acquireInfo */,
+                                                         uint32_t* /* index */)
+    {
+        return XR_ERROR_HANDLE_INVALID;
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL WaitSwapchainImage(XrSwapchain /* swapchain */, const XrSwapchainImageWaitInfo* /* waitInfo */)
+    {
+        return XR_ERROR_HANDLE_INVALID;
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL ReleaseSwapchainImage(XrSwapchain /* swapchain */, const XrSwapchainImageReleaseInfo* /* releaseInfo */)
+    {
+        return XR_ERROR_HANDLE_INVALID;
+    }
+}  // namespace HeadlessRuntime
@@ -0,0 +1,230 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Runtime.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace HeadlessRuntime
+{
+    namespace
+    {
+        constexpr char SystemName[] = "Headless Reference HMD";
+        constexpr uint32_t MaxSwapchainImageSize = 4096;
+
+        const XrViewConfigurationType SupportedViewConfigurations[] = {XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO};
+        const XrEnvironmentBlendMode SupportedBlendModes[] = {XR_ENVIRONMENT_BLEND_MODE_OPAQUE};
+
+        bool IsKnownViewConfigurationType(XrViewConfigurationType viewConfigurationType)
+        {
+            switch (viewConfigurationType) {
+            case XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO:
+            case XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO:
+            case XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET:
+            case XR_VIEW_CONFIGURATION_TYPE_SECONDARY_MONO_FIRST_PERSON_OBSERVER_MSFT:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Looks up the instance and checks the system ID, which every function in this file takes.
+        XrResult GetSystemInstance(XrInstance instance, XrSystemId systemId, Instance** instanceObject)
+        {
+            *instanceObject = Registry::Get<Instance>(instance);
+            if (*instanceObject == nullptr) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (systemId != HeadlessSystemId) {
+                return XR_ERROR_SYSTEM_INVALID;
+            }
+            return XR_SUCCESS;
+        }
+    }  // namespace
+
+    bool IsSupportedViewConfigurationType(XrViewConfigurationType viewConfigurationType)
+    {
+        return std::find(std::begin(SupportedViewConfigurations), std::end(SupportedViewConfigurations), viewConfigurationType) !=
+               std::end(SupportedViewConfigurations);
+    }
+
+    XrResult CheckViewConfigurationType(XrViewConfigurationType viewConfigurationType)
+    {
+        if (IsSupportedViewConfigurationType(viewConfigurationType)) {
+            return XR_SUCCESS;
+        }
+        return IsKnownViewConfigurationType(viewConfigurationType) ? XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED
+                                                                   : XR_ERROR_VALIDATION_FAILURE;
+    }
+
+    uint32_t GetViewCount(XrViewConfigurationType viewConfigurationType)
+    {
+        return viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO ? 2 : 1;
+    }
+
+    bool IsSupportedBlendMode(XrEnvironmentBlendMode blendMode)
+    {
+        return std::find(std::begin(SupportedBlendModes), std::end(SupportedBlendModes), blendMode) != std::end(SupportedBlendModes);
+    }
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject = Registry::Get<Instance>(instance);
+        if (instanceObject == nullptr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (getInfo == nullptr || systemId == nullptr || getInfo->type != XR_TYPE_SYSTEM_GET_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY) {
+            return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+        }
+        instanceObject->systemRetrieved = true;
+        *systemId = HeadlessSystemId;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties* properties)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject;
+        const XrResult result = GetSystemInstance(instance, systemId, &instanceObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (properties == nullptr || properties->type != XR_TYPE_SYSTEM_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        properties->systemId = systemId;
+        properties->vendorId = 0;
+        snprintf(properties->systemName, XR_MAX_SYSTEM_NAME_SIZE, "%s", SystemName);
+        properties->graphicsProperties.maxSwapchainImageWidth = MaxSwapchainImageSize;
+        properties->graphicsProperties.maxSwapchainImageHeight = MaxSwapchainImageSize;
+        properties->graphicsProperties.maxLayerCount = MaxLayerCount;
+        properties->trackingProperties.orientationTracking = XR_TRUE;
+        properties->trackingProperties.positionTracking = XR_TRUE;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateEnvironmentBlendModes(XrInstance instance, XrSystemId systemId,
+                                                                  XrViewConfigurationType viewConfigurationType,
+                                                                  uint32_t environmentBlendModeCapacityInput,
+                                                                  uint32_t* environmentBlendModeCountOutput,
+                                                                  XrEnvironmentBlendMode* environmentBlendModes)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject;
+        XrResult result = GetSystemInstance(instance, systemId, &instanceObject);
+        if (XR_SUCCEEDED(result)) {
+            result = CheckViewConfigurationType(viewConfigurationType);
+        }
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        return WriteTwoCallArray(environmentBlendModeCapacityInput, environmentBlendModeCountOutput, environmentBlendModes,
+                                 SupportedBlendModes, (uint32_t)(sizeof(SupportedBlendModes) / sizeof(SupportedBlendModes[0])));
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateViewConfigurations(XrInstance instance, XrSystemId systemId,
+                                                               uint32_t viewConfigurationTypeCapacityInput,
+                                                               uint32_t* viewConfigurationTypeCountOutput,
+                                                               XrViewConfigurationType* viewConfigurationTypes)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject;
+        const XrResult result = GetSystemInstance(instance, systemId, &instanceObject);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        return WriteTwoCallArray(viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, viewConfigurationTypes,
+                                 SupportedViewConfigurations,
+                                 (uint32_t)(sizeof(SupportedViewConfigurations) / sizeof(SupportedViewConfigurations[0])));
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL GetViewConfigurationProperties(XrInstance instance, XrSystemId systemId,
+                                                                  XrViewConfigurationType viewConfigurationType,
+                                                                  XrViewConfigurationProperties* configurationProperties)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject;
+        XrResult result = GetSystemInstance(instance, systemId, &instanceObject);
+        if (XR_SUCCEEDED(result)) {
+            result = CheckViewConfigurationType(viewConfigurationType);
+        }
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (configurationProperties == nullptr || configurationProperties->type != XR_TYPE_VIEW_CONFIGURATION_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        configurationProperties->viewConfigurationType = viewConfigurationType;
+        configurationProperties->fovMutable = XR_TRUE;
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+
+    XRAPI_ATTR XrResult XRAPI_CALL EnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId,
+                                                                   XrViewConfigurationType viewConfigurationType,
+                                                                   uint32_t viewCapacityInput, uint32_t* viewCountOutput,
+                                                                   XrViewConfigurationView* views)
+    HEADLESS_RUNTIME_TRY
+    {
+        auto lock = LockRuntime();
+        Instance* instanceObject;
+        XrResult result = GetSystemInstance(instance, systemId, &instanceObject);
+        if (XR_SUCCEEDED(result)) {
+            result = CheckViewConfigurationType(viewConfigurationType);
+        }
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        if (viewCountOutput == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        const uint32_t count = GetViewCount(viewConfigurationType);
+        *viewCountOutput = count;
+        if (viewCapacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (viewCapacityInput < count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        if (views == nullptr || !HasStructureType(views, count, XR_TYPE_VIEW_CONFIGURATION_VIEW)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            views[i].recommendedImageRectWidth = 1440;
+            views[i].maxImageRectWidth = MaxSwapchainImageSize;
+            views[i].recommendedImageRectHeight = 1600;
+            views[i].maxImageRectHeight = MaxSwapchainImageSize;
+            views[i].recommendedSwapchainSampleCount = 1;
+            views[i].maxSwapchainSampleCount = 4;
+        }
+        return XR_SUCCESS;
+    }
+    HEADLESS_RUNTIME_CATCH
+}  // namespace HeadlessRuntime
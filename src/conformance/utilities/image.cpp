@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "image.h"
+#include "lru_cache.h"
 
 // These are required to cleanly use basis_universal
 #if defined(__GNUC__) || defined(__clang__)
@@ -22,9 +23,15 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <iostream>
 #include <sstream>
-#include <numeric>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <mutex>
 
@@ -73,8 +80,8 @@ namespace Conformance
             return DivRoundingUp(physicalDimensions.width, blockSize.width);
         }
 
-        // BasisU is not thread safe unless you pass a state pointer around,
-        // so until we make everything else thread safe too, we can use a mutex
+        // Guards the one-time initialization of basisU's tables. Transcoding itself does not need it,
+        // as each thread transcodes with its own basist::ktx2_transcoder_state.
         std::mutex BasisUMutex;
 
         static void InitKTX2Impl(std::unique_lock<std::mutex>& lock, bool implicitInit)
@@ -121,9 +128,10 @@ namespace Conformance
                 virtual size_t RequiredScratchSpaceForLevel(FormatParams destFormatParams, basist::ktx2_transcoder& transcoder,
                                                             const basist::ktx2_image_level_info& imageLevelInfo) const = 0;
 
+                /// Must be thread safe as long as each thread passes its own @p transcoderState
                 virtual ImageLevel TranscodeLevel(FormatParams destFormatParams, basist::ktx2_transcoder& transcoder,
-                                                  const basist::ktx2_image_level_info& imageLevelInfo,
-                                                  span<uint8_t> scratchBuffer) const = 0;
+                                                  const basist::ktx2_image_level_info& imageLevelInfo, span<uint8_t> scratchBuffer,
+                                                  basist::ktx2_transcoder_state* transcoderState) const = 0;
             };
 
             class DecodeToRaw : public FormatStrategy
@@ -151,7 +159,7 @@ namespace Conformance
                         throw std::logic_error("Invalid format params for DecodeToRaw");
                     }
 
-                    auto targetFormat = KTXFormatMetadataMap[destFormatParams];
+                    auto targetFormat = KTXFormatMetadataMap.at(destFormatParams);
                     assert(basis_transcoder_format_is_uncompressed(targetFormat));
 
                     const uint32_t origWidth = imageLevelInfo.m_orig_width;
@@ -165,14 +173,15 @@ namespace Conformance
                 }
 
                 ImageLevel TranscodeLevel(FormatParams destFormatParams, basist::ktx2_transcoder& transcoder,
-                                          const basist::ktx2_image_level_info& imageLevelInfo, span<uint8_t> scratchBuffer) const override
+                                          const basist::ktx2_image_level_info& imageLevelInfo, span<uint8_t> scratchBuffer,
+                                          basist::ktx2_transcoder_state* transcoderState) const override
                 {
 
                     if (TranscodeFidelity(transcoder.get_format(), destFormatParams) == MatchFidelity::NotPossible) {
                         throw std::logic_error("Invalid format params for DecodeToRaw");
                     }
 
-                    auto targetFormat = KTXFormatMetadataMap[destFormatParams];
+                    auto targetFormat = KTXFormatMetadataMap.at(destFormatParams);
                     assert(basis_transcoder_format_is_uncompressed(targetFormat));
 
                     const uint32_t origWidth = imageLevelInfo.m_orig_width;
@@ -198,7 +207,7 @@ namespace Conformance
                         origHeight,  // uint32_t output_rows_in_pixels = 0,
                         -1,          // int channel0 = -1,
                         -1,          // int channel1 = -1,
-                        nullptr      // ktx2_transcoder_state *pState = nullptr,
+                        transcoderState  // ktx2_transcoder_state *pState = nullptr,
                     );
                     if (!success) {
                         throw std::logic_error("CTS KTX2: Failed to transcode KTX2 image data.");
@@ -249,7 +258,7 @@ namespace Conformance
                         throw std::logic_error("Invalid format params for MatchFidelity");
                     }
 
-                    auto targetFormat = KTXFormatMetadataMap[destFormatParams];
+                    auto targetFormat = KTXFormatMetadataMap.at(destFormatParams);
                     assert(!basis_transcoder_format_is_uncompressed(targetFormat));
 
                     const uint32_t dstBlocksX = DivRoundingUp(imageLevelInfo.m_width, basis_get_block_width(targetFormat));
@@ -262,14 +271,15 @@ namespace Conformance
                 }
 
                 ImageLevel TranscodeLevel(FormatParams destFormatParams, basist::ktx2_transcoder& transcoder,
-                                          const basist::ktx2_image_level_info& imageLevelInfo, span<uint8_t> scratchBuffer) const override
+                                          const basist::ktx2_image_level_info& imageLevelInfo, span<uint8_t> scratchBuffer,
+                                          basist::ktx2_transcoder_state* transcoderState) const override
                 {
 
                     if (TranscodeFidelity(transcoder.get_format(), destFormatParams) == MatchFidelity::NotPossible) {
                         throw std::logic_error("Invalid format params for MatchFidelity");
                     }
 
-                    auto targetFormat = KTXFormatMetadataMap[destFormatParams];
+                    auto targetFormat = KTXFormatMetadataMap.at(destFormatParams);
                     assert(!basis_transcoder_format_is_uncompressed(targetFormat));
 
                     const uint32_t origWidth = imageLevelInfo.m_orig_width;
@@ -310,7 +320,7 @@ namespace Conformance
                         // -1 (default) results in channel0 = 0 (R) and channel1 = 3 (A).
                         -1,      // int channel0 = -1,
                         -1,      // int channel1 = -1,
-                        nullptr  // ktx2_transcoder_state *pState = nullptr,
+                        transcoderState  // ktx2_transcoder_state *pState = nullptr,
                     );
                     if (!success) {
                         throw std::logic_error("CTS KTX2: Failed to transcode KTX2 image data.");
@@ -329,6 +339,75 @@ namespace Conformance
                                                  std::vector<uint8_t>& scratchBuffer);
         }  // namespace FormatStrategies
 
+        namespace
+        {
+            /// Transcoded levels of a KTX2 image, cached so that the same texture loaded again
+            /// (e.g. for another model or graphics plugin) is copied rather than transcoded.
+            struct KTX2TranscodedLevels
+            {
+                /// The encoded KTX2 data, compared on every hit because the cache key is only a fingerprint of it.
+                std::vector<uint8_t> encodedData;
+                std::vector<ImageLevelMetadata> levelMetadata;
+                std::vector<size_t> levelSizes;
+                std::vector<uint8_t> data;
+            };
+
+            using KTX2TranscodeCacheKey =
+                std::tuple<uint64_t /* content fingerprint */, size_t /* content size */, Codec, Channels, ColorSpaceType>;
+            using KTX2TranscodeCache = LruCache<KTX2TranscodeCacheKey, std::shared_ptr<const KTX2TranscodedLevels>>;
+
+            /// Least recently used entries are evicted beyond the budget.
+            KTX2TranscodeCache& GetKTX2TranscodeCache()
+            {
+                static KTX2TranscodeCache cache(256 * 1024 * 1024);
+                return cache;
+            }
+
+            /// Levels with less total data than this are transcoded on the calling thread only, as starting workers would cost more.
+            constexpr size_t ParallelTranscodeMinBytes = 256 * 1024;
+
+            /// Runs transcodeLevel for every level, concurrently if worthwhile. Each worker gets its own transcoder state.
+            template <typename F>
+            void ForEachLevelConcurrently(uint32_t levelCount, size_t totalBytes, F&& transcodeLevel)
+            {
+                std::atomic<uint32_t> nextLevel{0};
+                auto worker = [&] {
+                    basist::ktx2_transcoder_state transcoderState;
+                    // Levels are ordered largest first, so the big ones start first.
+                    for (uint32_t level = nextLevel++; level < levelCount; level = nextLevel++) {
+                        transcodeLevel(level, &transcoderState);
+                    }
+                };
+
+                const uint32_t workerCount =
+                    totalBytes < ParallelTranscodeMinBytes ? 1 : std::min(levelCount, std::max(1u, std::thread::hardware_concurrency()));
+                std::vector<std::future<void>> workers;
+                for (uint32_t i = 1; i < workerCount; ++i) {
+                    workers.push_back(std::async(std::launch::async, worker));
+                }
+                std::exception_ptr firstError;
+                try {
+                    worker();
+                }
+                catch (...) {
+                    firstError = std::current_exception();
+                }
+                for (std::future<void>& w : workers) {
+                    try {
+                        w.get();
+                    }
+                    catch (...) {
+                        if (!firstError) {
+                            firstError = std::current_exception();
+                        }
+                    }
+                }
+                if (firstError) {
+                    std::rethrow_exception(firstError);
+                }
+            }
+        }  // namespace
+
         bool IsCompressed(Codec codec)
         {
             switch (codec) {
@@ -345,6 +424,90 @@ namespace Conformance
             };
         }
 
+        uint64_t ContentFingerprint(span<const uint8_t> data)
+        {
+            // 64-bit FNV-1a, a word at a time, over the size and up to 64 samples of 64 bytes spread evenly over the data,
+            // including its first and last bytes. Small inputs are hashed whole.
+            constexpr uint64_t prime = 1099511628211ull;
+            constexpr size_t sampleSize = 64;
+            constexpr size_t sampleCount = 64;
+            uint64_t hash = (14695981039346656037ull ^ data.size()) * prime;
+            auto hashRange = [&](size_t offset, size_t size) {
+                const size_t end = offset + size;
+                for (; offset + sizeof(uint64_t) <= end; offset += sizeof(uint64_t)) {
+                    uint64_t word;
+                    std::memcpy(&word, data.data() + offset, sizeof(word));
+                    hash = (hash ^ word) * prime;
+                }
+                for (; offset < end; ++offset) {
+                    hash = (hash ^ data[offset]) * prime;
+                }
+            };
+            if (data.size() <= sampleSize * sampleCount) {
+                hashRange(0, data.size());
+                return hash;
+            }
+            const size_t stride = (data.size() - sampleSize) / (sampleCount - 1);
+            for (size_t sample = 0; sample + 1 < sampleCount; ++sample) {
+                hashRange(sample * stride, sampleSize);
+            }
+            hashRange(data.size() - sampleSize, sampleSize);
+            return hash;
+        }
+
+        std::array<uint64_t, 2> ContentHash(span<const uint8_t> data)
+        {
+            constexpr uint64_t c1 = 0x87c37b91114253d5ull;
+            constexpr uint64_t c2 = 0x4cf5ad432745937full;
+            auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+            auto fmix = [](uint64_t k) {
+                k = (k ^ (k >> 33)) * 0xff51afd7ed558ccdull;
+                k = (k ^ (k >> 33)) * 0xc4ceb9fe1a85ec53ull;
+                return k ^ (k >> 33);
+            };
+            auto mixK1 = [&](uint64_t k1) { return rotl(k1 * c1, 31) * c2; };
+            auto mixK2 = [&](uint64_t k2) { return rotl(k2 * c2, 33) * c1; };
+
+            uint64_t h1 = 0;
+            uint64_t h2 = 0;
+            const size_t blockCount = data.size() / 16;
+            for (size_t block = 0; block < blockCount; ++block) {
+                uint64_t k[2];
+                std::memcpy(k, data.data() + block * 16, sizeof(k));
+                h1 = (rotl(h1 ^ mixK1(k[0]), 27) + h2) * 5 + 0x52dce729;
+                h2 = (rotl(h2 ^ mixK2(k[1]), 31) + h1) * 5 + 0x38495ab5;
+            }
+
+            const size_t tail = blockCount * 16;
+            uint64_t k1 = 0;
+            uint64_t k2 = 0;
+            for (size_t i = data.size(); i-- > tail;) {
+                const uint64_t byte = data[i];
+                if (i - tail >= 8) {
+                    k2 = (k2 << 8) | byte;
+                }
+                else {
+                    k1 = (k1 << 8) | byte;
+                }
+            }
+            if (data.size() - tail > 8) {
+                h2 ^= mixK2(k2);
+            }
+            if (data.size() > tail) {
+                h1 ^= mixK1(k1);
+            }
+
+            h1 ^= data.size();
+            h2 ^= data.size();
+            h1 += h2;
+            h2 += h1;
+            h1 = fmix(h1);
+            h2 = fmix(h2);
+            h1 += h2;
+            h2 += h1;
+            return {h1, h2};
+        }
+
         size_t FormatParams::BytesPerBlockOrPixel() const
         {
             // partly based on values from basis_get_bytes_per_block_or_pixel
@@ -392,12 +555,13 @@ namespace Conformance
         Image Image::LoadAndTranscodeKTX2(span<const uint8_t> encodedData, bool sRGB, span<const FormatParams> supportedFormats,
                                           std::vector<uint8_t>& scratchBuffer, const char* imageDesc, XrExtent2Di expectedDimensions)
         {
+            {
+                std::unique_lock<std::mutex> lock(BasisUMutex);
 
-            std::unique_lock<std::mutex> lock(BasisUMutex);
-
-            // Initializing the tables required for KTX2 decoding can take (~9) milliseconds,
-            // so this should ideally be done at startup to avoid adding to the hitch on model load.
-            InitKTX2Impl(lock, true);
+                // Initializing the tables required for KTX2 decoding can take (~9) milliseconds,
+                // so this should ideally be done at startup to avoid adding to the hitch on model load.
+                InitKTX2Impl(lock, true);
+            }
 
             basist::ktx2_transcoder transcoder{};
 
@@ -545,19 +709,55 @@ namespace Conformance
                     formatStrategy->RequiredScratchSpaceForLevel(targetFormat, transcoder, imageLevelInfos[mipLevel]));
             }
 
-            size_t scratchBufferSize = std::accumulate(scratchBufferSizes.begin(), scratchBufferSizes.end(), size_t(0));
-            scratchBuffer.resize(scratchBufferSize);
+            // Each level has its own range of the scratch buffer.
+            std::vector<size_t> levelOffsets;
+            levelOffsets.reserve(mipLevels);
+            size_t scratchBufferSize = 0;
+            for (size_t size : scratchBufferSizes) {
+                levelOffsets.push_back(scratchBufferSize);
+                scratchBufferSize += size;
+            }
 
             Image ret{targetFormat};
-            auto it = scratchBuffer.begin();
-            for (uint32_t mipLevel = 0; mipLevel < mipLevels; ++mipLevel) {
-                size_t size = scratchBufferSizes[mipLevel];
-                assert(it + size <= scratchBuffer.end());
-                ret.levels.emplace_back(
-                    formatStrategy->TranscodeLevel(targetFormat, transcoder, imageLevelInfos[mipLevel], {it, it + size}));
-                it += size;
+            auto addLevels = [&](const std::vector<ImageLevelMetadata>& levelMetadata) {
+                assert(scratchBuffer.size() == scratchBufferSize);
+                for (uint32_t mipLevel = 0; mipLevel < mipLevels; ++mipLevel) {
+                    ret.levels.push_back(
+                        ImageLevel{levelMetadata[mipLevel], {scratchBuffer.data() + levelOffsets[mipLevel], scratchBufferSizes[mipLevel]}});
+                }
+            };
+
+            const KTX2TranscodeCacheKey cacheKey{ContentFingerprint(encodedData), encodedData.size(), targetFormat.codec,
+                                                 targetFormat.channels, targetFormat.colorSpaceType};
+            auto isSameContent = [&](const std::shared_ptr<const KTX2TranscodedLevels>& entry) {
+                return entry->encodedData.size() == encodedData.size() &&
+                       std::memcmp(entry->encodedData.data(), encodedData.data(), encodedData.size()) == 0;
+            };
+            std::shared_ptr<const KTX2TranscodedLevels> cached;
+            if (GetKTX2TranscodeCache().TryGet(cacheKey, cached, isSameContent)) {
+                if (cached->levelSizes != scratchBufferSizes) {
+                    throw std::logic_error(std::string("CTS KTX2: Cached transcode does not match level sizes of ") + imageDesc);
+                }
+                scratchBuffer.assign(cached->data.begin(), cached->data.end());
+                addLevels(cached->levelMetadata);
+                return ret;
             }
 
+            // Each level transcodes into its own preallocated range of the scratch buffer, so levels are independent.
+            scratchBuffer.resize(scratchBufferSize);
+            std::vector<ImageLevelMetadata> levelMetadata(mipLevels);
+            ForEachLevelConcurrently(mipLevels, scratchBufferSize, [&](uint32_t mipLevel, basist::ktx2_transcoder_state* transcoderState) {
+                span<uint8_t> levelBuffer{scratchBuffer.data() + levelOffsets[mipLevel], scratchBufferSizes[mipLevel]};
+                ImageLevel level =
+                    formatStrategy->TranscodeLevel(targetFormat, transcoder, imageLevelInfos[mipLevel], levelBuffer, transcoderState);
+                levelMetadata[mipLevel] = level.metadata;
+            });
+
+            auto transcoded = std::make_shared<const KTX2TranscodedLevels>(KTX2TranscodedLevels{
+                std::vector<uint8_t>(encodedData.begin(), encodedData.end()), levelMetadata, scratchBufferSizes, scratchBuffer});
+            GetKTX2TranscodeCache().Insert(cacheKey, std::move(transcoded), encodedData.size() + scratchBuffer.size());
+
+            addLevels(levelMetadata);
             return ret;
         }
 
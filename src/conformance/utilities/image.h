@@ -7,6 +7,7 @@
 #include <nonstd/span.hpp>
 #include <openxr/openxr.h>
 
+#include <array>
 #include <cstddef>
 #include <stdint.h>
 #include <vector>
@@ -37,6 +38,15 @@ namespace Conformance
         /// Whether a TextureCodec represents a compressed format.
         bool IsCompressed(Codec codec);
 
+        /// 64-bit fingerprint of @p data for keying caches of decoded or transcoded images by their content.
+        /// Only evenly spaced samples and the size are hashed, so the cost does not grow with the data: contents that differ
+        /// elsewhere share a fingerprint, and a cache hit must be confirmed by comparing the full content.
+        uint64_t ContentFingerprint(span<const uint8_t> data);
+
+        /// 128-bit hash (MurmurHash3 x64) of every byte of @p data, for keying caches by content without keeping a copy of it:
+        /// distinct contents only share a hash by a collision too improbable to guard against.
+        std::array<uint64_t, 2> ContentHash(span<const uint8_t> data);
+
         enum Channels : uint8_t
         {
             RGB = 3,
@@ -0,0 +1,139 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <utility>
+
+namespace Conformance
+{
+    /// Counters reported by @ref LruCache
+    struct LruCacheStats
+    {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        size_t entryCount{0};
+        /// Sum of the sizes passed to @ref LruCache::Insert for the entries currently held.
+        size_t totalSize{0};
+        size_t budget{0};
+    };
+
+    /// Thread-safe map that evicts its least recently used entries once the total size of its values exceeds a budget.
+    ///
+    /// Sizes are supplied by the caller on insertion, in whatever unit the budget is in (usually bytes).
+    /// Values are returned by copy, so large or device-owned values should be held by a shared pointer type.
+    template <typename TKey, typename TValue>
+    class LruCache
+    {
+    public:
+        explicit LruCache(size_t budget) : m_mutex(std::make_unique<std::mutex>()), m_budget(budget)
+        {
+        }
+
+        LruCache(LruCache&&) = default;
+        LruCache& operator=(LruCache&&) = default;
+
+        /// Copies the value for @p key into @p value and marks it most recently used, or returns false on a miss.
+        bool TryGet(const TKey& key, TValue& value)
+        {
+            return TryGet(key, value, [](const TValue&) { return true; });
+        }
+
+        /// As above, but an entry for which @p matches returns false counts as a miss.
+        /// For keys that may collide, such as content fingerprints: @p matches compares the full content.
+        template <typename TMatch>
+        bool TryGet(const TKey& key, TValue& value, TMatch&& matches)
+        {
+            std::lock_guard<std::mutex> lock(*m_mutex);
+            auto it = m_entries.find(key);
+            if (it == m_entries.end() || !matches(it->second->value)) {
+                ++m_stats.misses;
+                return false;
+            }
+            ++m_stats.hits;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            value = it->second->value;
+            return true;
+        }
+
+        /// Adds an entry, replacing any entry for @p key, unless it is larger than the budget.
+        void Insert(const TKey& key, TValue value, size_t size)
+        {
+            std::lock_guard<std::mutex> lock(*m_mutex);
+            if (size > m_budget) {
+                return;
+            }
+            auto existing = m_entries.find(key);
+            if (existing != m_entries.end()) {
+                m_totalSize -= existing->second->size;
+                m_lru.erase(existing->second);
+                m_entries.erase(existing);
+            }
+            m_totalSize += size;
+            m_lru.push_front(Node{key, std::move(value), size});
+            m_entries.emplace(key, m_lru.begin());
+            EvictToBudget();
+        }
+
+        /// Changes the budget, evicting entries immediately if it shrank.
+        void SetBudget(size_t budget)
+        {
+            std::lock_guard<std::mutex> lock(*m_mutex);
+            m_budget = budget;
+            EvictToBudget();
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(*m_mutex);
+            m_entries.clear();
+            m_lru.clear();
+            m_totalSize = 0;
+        }
+
+        LruCacheStats GetStats() const
+        {
+            std::lock_guard<std::mutex> lock(*m_mutex);
+            LruCacheStats stats = m_stats;
+            stats.entryCount = m_entries.size();
+            stats.totalSize = m_totalSize;
+            stats.budget = m_budget;
+            return stats;
+        }
+
+    private:
+        struct Node
+        {
+            TKey key;
+            TValue value;
+            size_t size;
+        };
+
+        // requires m_mutex to be held
+        void EvictToBudget()
+        {
+            while (m_totalSize > m_budget) {
+                m_totalSize -= m_lru.back().size;
+                m_entries.erase(m_lru.back().key);
+                m_lru.pop_back();
+                ++m_stats.evictions;
+            }
+        }
+
+        // in unique_ptr to make it moveable
+        std::unique_ptr<std::mutex> m_mutex;
+        size_t m_budget;
+        size_t m_totalSize{0};
+        LruCacheStats m_stats{};
+        std::list<Node> m_lru;
+        std::map<TKey, typename std::list<Node>::iterator> m_entries;
+    };
+}  // namespace Conformance
@@ -7,6 +7,8 @@
 
 #include "common/gfxwrapper_opengl.h"
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 namespace Conformance
@@ -57,6 +59,79 @@ namespace Conformance
             XRC_CHECK_THROW_MSG(r, msg);
         }
     }
+
+    namespace
+    {
+        /// Unmaps the bound pixel unpack buffer if it is still mapped, and unbinds it, when leaving the scope. Otherwise an
+        /// exception part way through an upload would leave it bound, turning the pixel pointers of later uploads into offsets.
+        struct PixelUnpackBufferBinding
+        {
+            PixelUnpackBufferBinding() = default;
+            PixelUnpackBufferBinding(const PixelUnpackBufferBinding&) = delete;
+            PixelUnpackBufferBinding& operator=(const PixelUnpackBufferBinding&) = delete;
+
+            ~PixelUnpackBufferBinding()
+            {
+                if (mapped) {
+                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                }
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+
+            bool mapped{false};
+        };
+    }  // namespace
+
+    void PixelUnpackBufferRing::UploadFlippedRGBA8(GLenum target, GLint layer, GLsizei width, GLsizei height, const void* pixels)
+    {
+        GLuint& buffer = m_buffers[m_next];
+        m_next = (m_next + 1) % BufferCount;
+        if (buffer == 0) {
+            XRC_CHECK_THROW_GLCMD(glGenBuffers(1, &buffer));
+        }
+
+        const size_t rowSize = size_t(width) * 4;
+        const GLsizeiptr size = GLsizeiptr(rowSize * height);
+
+        PixelUnpackBufferBinding binding;
+        XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer));
+        // Orphan the previous storage so mapping does not stall on an upload still reading from it.
+        XRC_CHECK_THROW_GLCMD(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        binding.mapped = mapped != nullptr;
+        XRC_CHECK_THROW_GLRESULT(glGetError(), "glMapBufferRange");
+        XRC_CHECK_THROW(mapped != nullptr);
+
+        const uint8_t* src = static_cast<const uint8_t*>(pixels);
+        uint8_t* dst = static_cast<uint8_t*>(mapped);
+        for (GLsizei y = 0; y < height; ++y) {
+            memcpy(dst + size_t(y) * rowSize, src + size_t(height - 1 - y) * rowSize, rowSize);
+        }
+
+        binding.mapped = false;
+        GLboolean unmapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        XRC_CHECK_THROW_GLRESULT(glGetError(), "glUnmapBuffer");
+        XRC_CHECK_THROW_MSG(unmapped == GL_TRUE, "Pixel unpack buffer contents were lost while mapped");
+
+        // With a pixel unpack buffer bound, the data pointer is an offset into the buffer.
+        if (target == GL_TEXTURE_2D_ARRAY) {
+            XRC_CHECK_THROW_GLCMD(glTexSubImage3D(target, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        }
+        else {
+            XRC_CHECK_THROW_GLCMD(glTexSubImage2D(target, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        }
+    }
+
+    void PixelUnpackBufferRing::Reset()
+    {
+        for (GLuint& buffer : m_buffers) {
+            if (buffer != 0) {
+                glDeleteBuffers(1, &buffer);
+                buffer = 0;
+            }
+        }
+        m_next = 0;
+    }
 }  // namespace Conformance
 
 #endif  // defined(XR_USE_GRAPHICS_API_OPENGL) || defined(XR_USE_GRAPHICS_API_OPENGL_ES)
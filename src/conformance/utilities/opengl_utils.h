@@ -11,6 +11,7 @@
 #include "utilities/stringification.h"
 #include "utilities/throw_helpers.h"
 
+#include <cstddef>
 #include <string>
 
 namespace Conformance
@@ -54,6 +55,32 @@ namespace Conformance
     void CheckGLShader(GLuint shader);
     void CheckGLProgram(GLuint prog);
 
+    /// Streams RGBA8 texture uploads through a small ring of pixel unpack buffers.
+    ///
+    /// Each upload orphans the next buffer's storage before mapping it, so the driver never has to wait for
+    /// a previous upload from the same buffer to finish, and the whole image goes to the texture in a single
+    /// glTexSubImage call. Buffers are created lazily; call Reset() while the context is still current.
+    class PixelUnpackBufferRing
+    {
+    public:
+        PixelUnpackBufferRing() = default;
+        PixelUnpackBufferRing(const PixelUnpackBufferRing&) = delete;
+        PixelUnpackBufferRing& operator=(const PixelUnpackBufferRing&) = delete;
+
+        /// Upload `pixels` (tightly packed RGBA8 rows, top row first) to the texture bound to `target`,
+        /// which is GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY; `layer` is ignored for GL_TEXTURE_2D.
+        /// Rows are flipped while being written into the buffer, to match GL's bottom-up origin.
+        void UploadFlippedRGBA8(GLenum target, GLint layer, GLsizei width, GLsizei height, const void* pixels);
+
+        /// Delete the buffers.
+        void Reset();
+
+    private:
+        static constexpr size_t BufferCount = 3;
+        GLuint m_buffers[BufferCount]{};
+        size_t m_next{0};
+    };
+
 }  // namespace Conformance
 
 #endif  // defined(XR_USE_GRAPHICS_API_OPENGL) || defined(XR_USE_GRAPHICS_API_OPENGL_ES)
@@ -0,0 +1,23 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr_platform_defines.h>
+
+#include <stdint.h>
+
+/// Totals for the OpenXR calls that the conformance layer has passed down to the runtime since the layer was loaded.
+struct XrcRuntimeCallStatistics
+{
+    uint64_t callCount;
+    /// Wall time spent in the runtime, summed over all threads.
+    uint64_t callNanoseconds;
+};
+
+/// Name of a private conformance layer entry point, found with xrGetInstanceProcAddr on an instance with the layer enabled.
+/// It is not part of any OpenXR extension; the loader passes unknown names down to the layer.
+#define XRC_GET_RUNTIME_CALL_STATISTICS_NAME "xrcGetRuntimeCallStatistics"
+
+typedef void(XRAPI_PTR* PFN_xrcGetRuntimeCallStatistics)(XrcRuntimeCallStatistics* statistics);
@@ -0,0 +1,53 @@
+// Copyright (c) 2019-2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace Conformance
+{
+    /// Wall time in seconds spent in each test case, by test case name.
+    ///
+    /// Recorded with `--recordDurations` and used to balance shards by time with `--shardDurations`.
+    /// Stored as one "<seconds> <test case name>" line per test case; lines starting with '#' are ignored.
+    using TestDurations = std::map<std::string, double>;
+
+    /// Reads durations written by @ref WriteTestDurations. A missing or malformed file yields no (or fewer) entries.
+    inline TestDurations ReadTestDurations(const std::string& path)
+    {
+        TestDurations durations;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            const size_t separator = line.find(' ');
+            if (separator == std::string::npos || separator + 1 == line.size()) {
+                continue;
+            }
+            try {
+                durations[line.substr(separator + 1)] = std::stod(line.substr(0, separator));
+            }
+            catch (const std::exception&) {
+                // Skip lines that do not start with a number.
+            }
+        }
+        return durations;
+    }
+
+    /// Returns false if the file could not be written.
+    inline bool WriteTestDurations(const std::string& path, const TestDurations& durations)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "# Test case durations in seconds, recorded by the OpenXR CTS\n";
+        for (const auto& entry : durations) {
+            file << entry.second << ' ' << entry.first << '\n';
+        }
+        return bool(file);
+    }
+}  // namespace Conformance
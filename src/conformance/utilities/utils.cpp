@@ -19,6 +19,7 @@
 #include <ctype.h>
 #include <string>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include <chrono>
 #include <thread>
@@ -32,6 +33,8 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <unistd.h>
 #endif
 
 #ifdef XR_USE_PLATFORM_ANDROID
@@ -132,6 +135,71 @@ namespace Conformance
         return data;
     }
 
+    bool ReplaceFileContents(const std::string& path, const std::vector<uint8_t>& data) noexcept
+    {
+        // The temporary name is per process, so that concurrent writers (e.g. shards) never interleave their writes.
+#ifdef _WIN32
+        const std::string tempPath = path + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#else
+        const std::string tempPath = path + "." + std::to_string(getpid()) + ".tmp";
+#endif
+        {
+            std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+            file.close();
+            if (!file) {
+                std::remove(tempPath.c_str());
+                return false;
+            }
+        }
+#ifdef _WIN32
+        const bool renamed = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        const bool renamed = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+        if (!renamed) {
+            std::remove(tempPath.c_str());
+        }
+        return renamed;
+    }
+
+    TempDirectory::TempDirectory(const char* prefix)
+    {
+#ifdef _WIN32
+        char tempPath[MAX_PATH + 1];
+        const DWORD length = GetTempPathA(MAX_PATH + 1, tempPath);
+        if (length == 0 || length > MAX_PATH) {
+            return;
+        }
+        // The process id keeps concurrent processes apart; the attempt count skips directories left behind by earlier runs.
+        for (uint32_t attempt = 0; attempt < 100 && m_path.empty(); ++attempt) {
+            const std::string candidate =
+                std::string(tempPath, length) + prefix + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(attempt);
+            if (CreateDirectoryA(candidate.c_str(), nullptr)) {
+                m_path = candidate;
+            }
+        }
+#else
+        const char* tempRoot = getenv("TMPDIR");
+        std::string pattern = std::string(tempRoot != nullptr && *tempRoot != '\0' ? tempRoot : "/tmp") + "/" + prefix + "XXXXXX";
+        if (mkdtemp(&pattern[0]) != nullptr) {
+            m_path = pattern;
+        }
+#endif
+    }
+
+    TempDirectory::~TempDirectory()
+    {
+        if (m_path.empty()) {
+            return;
+        }
+#ifdef _WIN32
+        RemoveDirectoryA(m_path.c_str());
+#else
+        rmdir(m_path.c_str());
+#endif
+    }
+
     // Provides a managed set of random number generators. Currently the usage of these generators
     // is imperfect because modulus (%) operations are done against their results, which introduces
     // a slight skew in the distribution for most ranges. C++ random number generation requires
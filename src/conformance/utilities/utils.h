@@ -249,6 +249,32 @@ namespace Conformance
     /// errors in case this fails, e.g. "texture".
     std::vector<uint8_t> ReadFileBytes(const char* path, const char* description = "");
 
+    /// Replaces the contents of the file at @p path with @p data by writing a temporary file next to it and renaming it over
+    /// the target, so that readers (including other processes) only ever see the old or the new contents in full.
+    /// Returns false, leaving the file untouched, on failure.
+    bool ReplaceFileContents(const std::string& path, const std::vector<uint8_t>& data) noexcept;
+
+    /// A new, uniquely named directory under the system temporary directory, removed again on destruction.
+    /// The directory must be empty by then; files created in it are the owner's to remove.
+    class TempDirectory
+    {
+    public:
+        /// Creates the directory, named @p prefix followed by a unique suffix. On failure, path() is empty.
+        explicit TempDirectory(const char* prefix);
+        ~TempDirectory();
+
+        TempDirectory(const TempDirectory&) = delete;
+        TempDirectory& operator=(const TempDirectory&) = delete;
+
+        const std::string& path() const noexcept
+        {
+            return m_path;
+        }
+
+    private:
+        std::string m_path;
+    };
+
     /// SleepMs
     ///
     /// Sleeps the current thread for at least the given milliseconds. Attempt is made to return
@@ -7,6 +7,7 @@
 #ifdef XR_USE_GRAPHICS_API_VULKAN
 
 #include "throw_helpers.h"
+#include "utils.h"
 #include "common/xr_linear.h"
 #include "common/xr_dependencies.h"
 #include "common/vulkan_debug_object_namer.hpp"
@@ -15,6 +16,14 @@
 
 #include <nonstd/span.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -626,6 +635,232 @@ namespace Conformance
         }
     };
 
+    /// A host-visible, persistently-mapped staging buffer used as a ring for uploads to images.
+    ///
+    /// Each upload records into its own command buffer. The region an upload used is only handed out
+    /// again once that command buffer's fence has signalled, so callers do not need to wait for one
+    /// upload to finish before starting the next.
+    struct StagingBufferRing
+    {
+        /// A region of the ring returned by Acquire(): write the source data to `data`, record copies
+        /// from `buffer` at `offset` into `cmdBuffer`, then call Submit().
+        /// If it is destroyed before Submit(), for example by an exception, the upload is cancelled
+        /// so that the ring can be used again.
+        struct Upload
+        {
+            Upload(StagingBufferRing* ring, uint8_t* data, VkBuffer buffer, VkDeviceSize offset, CmdBuffer* cmdBuffer)
+                : data(data), buffer(buffer), offset(offset), cmdBuffer(cmdBuffer), m_ring(ring)
+            {
+            }
+
+            Upload(Upload&& other) noexcept
+                : data(other.data), buffer(other.buffer), offset(other.offset), cmdBuffer(other.cmdBuffer), m_ring(other.m_ring)
+            {
+                other.m_ring = nullptr;
+            }
+
+            Upload(const Upload&) = delete;
+            Upload& operator=(const Upload&) = delete;
+            Upload& operator=(Upload&&) = delete;
+
+            ~Upload()
+            {
+                if (m_ring != nullptr) {
+                    m_ring->CancelUnsubmitted();
+                }
+            }
+
+            uint8_t* data;
+            VkBuffer buffer;
+            VkDeviceSize offset;
+            CmdBuffer* cmdBuffer;
+
+        private:
+            StagingBufferRing* m_ring;
+        };
+
+        /// Number of uploads that may be in flight before Acquire() waits for the oldest.
+        static constexpr size_t MaxInFlight = 4;
+
+        /// Alignment of each upload within the buffer; satisfies the copy offset requirements of every format we upload.
+        static constexpr VkDeviceSize OffsetAlignment = 256;
+
+        StagingBufferRing() = default;
+
+        StagingBufferRing(const StagingBufferRing&) = delete;
+        StagingBufferRing& operator=(const StagingBufferRing&) = delete;
+        StagingBufferRing(StagingBufferRing&&) = delete;
+        StagingBufferRing& operator=(StagingBufferRing&&) = delete;
+
+        ~StagingBufferRing()
+        {
+            Reset();
+        }
+
+        void Init(const VulkanDebugObjectNamer& namer, VkDevice device, const MemoryAllocator& memAllocator, uint32_t queueFamilyIndex,
+                  VkDeviceSize initialSize)
+        {
+            m_namer = &namer;
+            m_vkDevice = device;
+            m_memAllocator = &memAllocator;
+
+            for (size_t i = 0; i < MaxInFlight; ++i) {
+                m_cmdBuffers.emplace_back(std::make_unique<CmdBuffer>());
+                if (!m_cmdBuffers.back()->Init(namer, device, queueFamilyIndex)) {
+                    XRC_THROW("Failed to create staging command buffer");
+                }
+            }
+
+            CreateBuffer(initialSize);
+        }
+
+        /// Wait for outstanding uploads, then destroy the buffer and command buffers.
+        void Reset()
+        {
+            if (m_vkDevice != VK_NULL_HANDLE) {
+                WaitIdle();
+                DestroyBuffer();
+            }
+            m_cmdBuffers.clear();
+            m_inFlight.clear();
+            m_nextCmdBuffer = 0;
+            m_recording = false;
+            m_memAllocator = nullptr;
+            m_namer = nullptr;
+            m_vkDevice = VK_NULL_HANDLE;
+        }
+
+        /// Block until every submitted upload has completed.
+        void WaitIdle()
+        {
+            while (!m_inFlight.empty()) {
+                RetireOldest();
+            }
+        }
+
+        /// Reserve `size` bytes and begin recording into the command buffer that will own them.
+        Upload Acquire(VkDeviceSize size)
+        {
+            XRC_CHECK_THROW(!m_recording);
+
+            if (size > m_size) {
+                WaitIdle();
+                DestroyBuffer();
+                CreateBuffer(std::max(size, m_size * 2));
+            }
+
+            CmdBuffer* cmdBuffer = m_cmdBuffers[m_nextCmdBuffer].get();
+            while (cmdBuffer->state == CmdBuffer::CmdBufferState::Executing) {
+                RetireOldest();
+            }
+
+            VkDeviceSize offset = (m_head + OffsetAlignment - 1) & ~(OffsetAlignment - 1);
+            if (offset + size > m_size) {
+                // Wrap around; the tail end of the buffer stays unused this time round.
+                offset = 0;
+            }
+            while (OverlapsInFlight(offset, size)) {
+                RetireOldest();
+            }
+
+            cmdBuffer->Clear();
+            cmdBuffer->Begin();
+
+            m_pending = {m_nextCmdBuffer, offset, size};
+            m_recording = true;
+            return Upload(this, m_mapped + offset, m_buffer.buf, offset, cmdBuffer);
+        }
+
+        /// Finish recording the upload returned by the last Acquire() and submit it to `queue`.
+        void Submit(VkQueue queue)
+        {
+            XRC_CHECK_THROW(m_recording);
+
+            CmdBuffer* cmdBuffer = m_cmdBuffers[m_pending.cmdBufferIndex].get();
+            cmdBuffer->End();
+            cmdBuffer->Exec(queue);
+
+            m_inFlight.push_back(m_pending);
+            m_head = m_pending.offset + m_pending.size;
+            m_nextCmdBuffer = (m_nextCmdBuffer + 1) % m_cmdBuffers.size();
+            m_recording = false;
+        }
+
+    private:
+        /// Called by ~Upload: drop the upload being recorded if Submit() was not reached or did not submit it.
+        /// Its region and command buffer are simply reused by the next Acquire().
+        void CancelUnsubmitted() noexcept
+        {
+            if (!m_recording) {
+                return;
+            }
+            CmdBuffer* cmdBuffer = m_cmdBuffers[m_pending.cmdBufferIndex].get();
+            // Recording, or Executable if End() succeeded but the submit failed; either way the fence is unsignalled.
+            (void)vkResetCommandBuffer(cmdBuffer->buf, 0);
+            cmdBuffer->state = CmdBuffer::CmdBufferState::Initialized;
+            m_recording = false;
+        }
+
+        struct Region
+        {
+            size_t cmdBufferIndex;
+            VkDeviceSize offset;
+            VkDeviceSize size;
+        };
+
+        void CreateBuffer(VkDeviceSize size)
+        {
+            VkBufferCreateInfo bufInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            bufInfo.size = size;
+            m_buffer.Create(m_vkDevice, *m_memAllocator, bufInfo);
+            XRC_CHECK_THROW_VKCMD(m_namer->SetName(VK_OBJECT_TYPE_BUFFER, (uint64_t)m_buffer.buf, "CTS staging ring buffer"));
+            XRC_CHECK_THROW_VKCMD(vkMapMemory(m_vkDevice, m_buffer.mem, 0, VK_WHOLE_SIZE, 0, (void**)&m_mapped));
+            m_size = size;
+            m_head = 0;
+        }
+
+        void DestroyBuffer()
+        {
+            if (m_mapped != nullptr) {
+                vkUnmapMemory(m_vkDevice, m_buffer.mem);
+                m_mapped = nullptr;
+            }
+            m_buffer.Reset(m_vkDevice);
+            m_size = 0;
+            m_head = 0;
+        }
+
+        void RetireOldest()
+        {
+            const Region& oldest = m_inFlight.front();
+            if (!m_cmdBuffers[oldest.cmdBufferIndex]->Wait()) {
+                XRC_THROW("Timed out waiting for a staging upload to complete");
+            }
+            m_inFlight.pop_front();
+        }
+
+        bool OverlapsInFlight(VkDeviceSize offset, VkDeviceSize size) const
+        {
+            return std::any_of(m_inFlight.begin(), m_inFlight.end(), [&](const Region& region) {
+                return offset < region.offset + region.size && region.offset < offset + size;
+            });
+        }
+
+        VkDevice m_vkDevice{VK_NULL_HANDLE};
+        const VulkanDebugObjectNamer* m_namer{nullptr};
+        const MemoryAllocator* m_memAllocator{nullptr};
+        std::vector<std::unique_ptr<CmdBuffer>> m_cmdBuffers;
+        BufferAndMemory m_buffer;
+        uint8_t* m_mapped{nullptr};
+        VkDeviceSize m_size{0};
+        VkDeviceSize m_head{0};
+        std::deque<Region> m_inFlight;
+        Region m_pending{};
+        size_t m_nextCmdBuffer{0};
+        bool m_recording{false};
+    };
+
     // VertexBuffer base class
     struct VertexBufferBase
     {
@@ -772,17 +1007,20 @@ namespace Conformance
         VkFormat colorFmt{};
         VkFormat depthFmt{};
         VkSampleCountFlagBits sampleCount{};
+        /// Views rendered by the subpass with VK_KHR_multiview, relative to the first layer of the attachments; 0 if not multiview.
+        uint32_t viewMask{};
         VkRenderPass pass{VK_NULL_HANDLE};
 
         RenderPass() = default;
 
         bool Create(const VulkanDebugObjectNamer& namer, VkDevice device, VkFormat aColorFmt, VkFormat aDepthFmt,
-                    VkSampleCountFlagBits aSampleCount)
+                    VkSampleCountFlagBits aSampleCount, uint32_t aViewMask = 0)
         {
             m_vkDevice = device;
             colorFmt = aColorFmt;
             depthFmt = aDepthFmt;
             sampleCount = aSampleCount;
+            viewMask = aViewMask;
 
             VkSubpassDescription subpass = {};
             subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
@@ -829,6 +1067,16 @@ namespace Conformance
                 subpass.pDepthStencilAttachment = &depthRef;
             }
 
+            // The views are rendered at the same time, so let the implementation share work between them.
+            VkRenderPassMultiviewCreateInfoKHR multiviewInfo{VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO_KHR};
+            if (viewMask != 0) {
+                multiviewInfo.subpassCount = 1;
+                multiviewInfo.pViewMasks = &viewMask;
+                multiviewInfo.correlationMaskCount = 1;
+                multiviewInfo.pCorrelationMasks = &viewMask;
+                rpInfo.pNext = &multiviewInfo;
+            }
+
             XRC_CHECK_THROW_VKCMD(vkCreateRenderPass(m_vkDevice, &rpInfo, nullptr, &pass));
             XRC_CHECK_THROW_VKCMD(namer.SetName(VK_OBJECT_TYPE_RENDER_PASS, (uint64_t)pass, "CTS render pass"));
 
@@ -920,14 +1168,21 @@ namespace Conformance
             swap(m_vkDevice, other.m_vkDevice);
             return *this;
         }
+        /// A multiview @p renderPass gets image views of the array layers its view mask covers, starting at @p baseArrayLayer.
         void Create(const VulkanDebugObjectNamer& namer, VkDevice device, VkImage aColorImage, VkImage aDepthOrStencilImage,
-                    VkImageAspectFlags depthOrStencilImageAspect, uint32_t baseArrayLayer, VkExtent2D size, RenderPass& renderPass)
+                    VkImageAspectFlags depthOrStencilImageAspect, uint32_t baseArrayLayer, VkExtent2D size, const RenderPass& renderPass)
         {
             m_vkDevice = device;
 
             colorImage = aColorImage;
             depthImage = aDepthOrStencilImage;
 
+            uint32_t layerCount = 1;
+            while ((renderPass.viewMask >> layerCount) != 0) {
+                ++layerCount;
+            }
+            const VkImageViewType viewType = renderPass.viewMask != 0 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+
             std::array<VkImageView, 2> attachments{};
             uint32_t attachmentCount = 0;
 
@@ -935,7 +1190,7 @@ namespace Conformance
             if (colorImage != VK_NULL_HANDLE) {
                 VkImageViewCreateInfo colorViewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
                 colorViewInfo.image = colorImage;
-                colorViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                colorViewInfo.viewType = viewType;
                 colorViewInfo.format = renderPass.colorFmt;
                 colorViewInfo.components.r = VK_COMPONENT_SWIZZLE_R;
                 colorViewInfo.components.g = VK_COMPONENT_SWIZZLE_G;
@@ -945,7 +1200,7 @@ namespace Conformance
                 colorViewInfo.subresourceRange.baseMipLevel = 0;
                 colorViewInfo.subresourceRange.levelCount = 1;
                 colorViewInfo.subresourceRange.baseArrayLayer = baseArrayLayer;
-                colorViewInfo.subresourceRange.layerCount = 1;
+                colorViewInfo.subresourceRange.layerCount = layerCount;
                 XRC_CHECK_THROW_VKCMD(vkCreateImageView(m_vkDevice, &colorViewInfo, nullptr, &colorView));
                 XRC_CHECK_THROW_VKCMD(namer.SetName(VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)colorView, "CTS color image view"));
                 attachments[attachmentCount++] = colorView;
@@ -955,7 +1210,7 @@ namespace Conformance
             if (depthImage != VK_NULL_HANDLE) {
                 VkImageViewCreateInfo depthViewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
                 depthViewInfo.image = depthImage;
-                depthViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                depthViewInfo.viewType = viewType;
                 depthViewInfo.format = renderPass.depthFmt;
                 depthViewInfo.components.r = VK_COMPONENT_SWIZZLE_R;
                 depthViewInfo.components.g = VK_COMPONENT_SWIZZLE_G;
@@ -965,7 +1220,7 @@ namespace Conformance
                 depthViewInfo.subresourceRange.baseMipLevel = 0;
                 depthViewInfo.subresourceRange.levelCount = 1;
                 depthViewInfo.subresourceRange.baseArrayLayer = baseArrayLayer;
-                depthViewInfo.subresourceRange.layerCount = 1;
+                depthViewInfo.subresourceRange.layerCount = layerCount;
                 XRC_CHECK_THROW_VKCMD(vkCreateImageView(m_vkDevice, &depthViewInfo, nullptr, &depthView));
 
                 const bool isDepth = depthOrStencilImageAspect & VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -1001,13 +1256,19 @@ namespace Conformance
         VkDevice m_vkDevice{VK_NULL_HANDLE};
     };
 
+    /// Push constants of the mesh vertex shader. The model transform and tint color are per-instance vertex attributes.
     struct VulkanUniformBuffer
     {
-        XrMatrix4x4f mvp;
-        XrColor4f tintColor;
+        XrMatrix4x4f viewProjection;
     };
 
-    // Simple vertex MVP xform, tint color & color fragment shader layout
+    /// Push constants of the multiview mesh vertex shader, which draws both views of a stereo pair in one pass.
+    struct VulkanMultiviewUniformBuffer
+    {
+        XrMatrix4x4f viewProjection[2];
+    };
+
+    // Simple vertex view-projection xform & color fragment shader layout
     struct PipelineLayout
     {
         VkPipelineLayout layout{VK_NULL_HANDLE};
@@ -1034,11 +1295,11 @@ namespace Conformance
         {
             m_vkDevice = device;
 
-            // MVP matrix is a push_constant
+            // View-projection matrices are push_constants; the range fits both the single-view and the multiview shader.
             VkPushConstantRange pcr = {};
             pcr.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
             pcr.offset = 0;
-            pcr.size = sizeof(VulkanUniformBuffer);
+            pcr.size = (uint32_t)std::max(sizeof(VulkanUniformBuffer), sizeof(VulkanMultiviewUniformBuffer));
 
             VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
             pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
@@ -1055,6 +1316,158 @@ namespace Conformance
         VkDevice m_vkDevice{VK_NULL_HANDLE};
     };
 
+    /// Wraps a VkPipelineCache whose contents outlive the VkDevice it is created for.
+    ///
+    /// The data is retrieved on @ref Reset and used to seed the cache of the next device (the CTS creates one per session),
+    /// and, if a file path is given, written to that file so that the next run starts with the compiled pipelines too.
+    /// Data is only used if its header matches the vendor, device and pipeline cache UUID of the physical device.
+    struct PipelineCache
+    {
+        VkPipelineCache cache{VK_NULL_HANDLE};
+
+        /// Pipelines created through @ref CreateGraphicsPipeline since @ref Init, and the time spent creating them.
+        uint64_t createdCount{0};
+        std::chrono::nanoseconds creationTime{0};
+
+        PipelineCache() = default;
+
+        ~PipelineCache()
+        {
+            Reset();
+        }
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        /// @param filePath file to keep the cache data in between runs, or empty to only keep it for this run.
+        void Init(VkPhysicalDevice physicalDevice, VkDevice device, const std::string& filePath)
+        {
+            Reset();
+            m_vkDevice = device;
+            createdCount = 0;
+            creationTime = {};
+
+            if (filePath != m_filePath) {
+                m_filePath = filePath;
+                m_data = Load(m_filePath);
+            }
+
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+            if (!IsCompatible(m_data, properties)) {
+                // Stale (driver update) or from another GPU. Drivers should reject it, but not all do so gracefully.
+                m_data.clear();
+            }
+
+            VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+            createInfo.initialDataSize = m_data.size();
+            createInfo.pInitialData = m_data.empty() ? nullptr : m_data.data();
+            XRC_CHECK_THROW_VKCMD(vkCreatePipelineCache(m_vkDevice, &createInfo, nullptr, &cache));
+        }
+
+        /// Creates a graphics pipeline using this cache, counting it in @ref createdCount and @ref creationTime.
+        VkPipeline CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& info)
+        {
+            VkPipeline pipeline{VK_NULL_HANDLE};
+            const auto start = std::chrono::steady_clock::now();
+            XRC_CHECK_THROW_VKCMD(vkCreateGraphicsPipelines(m_vkDevice, cache, 1, &info, nullptr, &pipeline));
+            creationTime += std::chrono::steady_clock::now() - start;
+            ++createdCount;
+            return pipeline;
+        }
+
+        /// Keeps (and writes out, if there is a file) the cache contents, then destroys the cache.
+        /// Must be called before the device is destroyed.
+        void Reset()
+        {
+            if (m_vkDevice != VK_NULL_HANDLE && cache != VK_NULL_HANDLE) {
+                size_t size = 0;
+                std::vector<uint8_t> data;
+                if (vkGetPipelineCacheData(m_vkDevice, cache, &size, nullptr) == VK_SUCCESS && size != 0) {
+                    data.resize(size);
+                    if (vkGetPipelineCacheData(m_vkDevice, cache, &size, data.data()) == VK_SUCCESS) {
+                        data.resize(size);
+                        m_data = std::move(data);
+                        Save();
+                    }
+                }
+                vkDestroyPipelineCache(m_vkDevice, cache, nullptr);
+            }
+            cache = VK_NULL_HANDLE;
+            m_vkDevice = VK_NULL_HANDLE;
+        }
+
+    private:
+        static bool IsCompatible(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties)
+        {
+            // VkPipelineCacheHeaderVersionOne: header size, header version, vendor ID, device ID, then the cache UUID.
+            constexpr size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+            if (data.size() < headerSize) {
+                return false;
+            }
+            uint32_t header[4];
+            memcpy(header, data.data(), sizeof(header));
+            return header[0] >= headerSize && header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && header[2] == properties.vendorID &&
+                   header[3] == properties.deviceID &&
+                   memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+
+        // The file is a small header in front of the vkGetPipelineCacheData blob, so that a truncated or corrupt file is
+        // caught here rather than left to the driver: magic, blob size and 64-bit FNV-1a of the blob (all uint64), then the blob.
+        static constexpr uint64_t FileMagic = 0x3143504b56435258ull;  // "XRCVKPC1" in little-endian byte order
+        static constexpr size_t FileHeaderSize = 3 * sizeof(uint64_t);
+
+        static uint64_t Hash(const uint8_t* data, size_t size)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ data[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        static std::vector<uint8_t> Load(const std::string& filePath)
+        {
+            if (filePath.empty()) {
+                return {};
+            }
+            std::ifstream file(filePath, std::ios::in | std::ios::binary);
+            std::vector<uint8_t> contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            if (contents.size() < FileHeaderSize) {
+                return {};
+            }
+            uint64_t header[3];  // magic, size, hash
+            memcpy(header, contents.data(), sizeof(header));
+            const uint8_t* body = contents.data() + FileHeaderSize;
+            if (header[0] != FileMagic || header[1] != contents.size() - FileHeaderSize || header[2] != Hash(body, (size_t)header[1])) {
+                return {};
+            }
+            return std::vector<uint8_t>(body, body + header[1]);
+        }
+
+        void Save() const noexcept
+        {
+            if (m_filePath.empty()) {
+                return;
+            }
+            try {
+                const uint64_t header[3] = {FileMagic, m_data.size(), Hash(m_data.data(), m_data.size())};
+                std::vector<uint8_t> contents(FileHeaderSize + m_data.size());
+                memcpy(contents.data(), header, sizeof(header));
+                std::copy(m_data.begin(), m_data.end(), contents.begin() + FileHeaderSize);
+                // Several processes (e.g. shards) may share the file: each writes its own temporary and renames it into place.
+                (void)ReplaceFileContents(m_filePath, contents);
+            }
+            catch (const std::bad_alloc&) {
+                // Not worth failing a run over; the next run just starts cold.
+            }
+        }
+
+        std::string m_filePath;
+        std::vector<uint8_t> m_data;
+        VkDevice m_vkDevice{VK_NULL_HANDLE};
+    };
+
     // Pipeline wrapper for rendering pipeline state
     struct Pipeline
     {
@@ -1067,8 +1480,8 @@ namespace Conformance
         }
 
         void Create(VkDevice device, VkExtent2D /*size*/, const PipelineLayout& layout, const RenderPass& rp, const ShaderProgram& sp,
-                    const VkVertexInputBindingDescription& bindDesc, span<const VkVertexInputAttributeDescription> attrDesc,
-                    span<VkDynamicState> dynamicStates)
+                    span<const VkVertexInputBindingDescription> bindDesc, span<const VkVertexInputAttributeDescription> attrDesc,
+                    span<VkDynamicState> dynamicStates, PipelineCache* pipelineCache = nullptr)
         {
             m_vkDevice = device;
 
@@ -1077,8 +1490,8 @@ namespace Conformance
             dynamicState.pDynamicStates = dynamicStates.data();
 
             VkPipelineVertexInputStateCreateInfo vi{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
-            vi.vertexBindingDescriptionCount = 1;
-            vi.pVertexBindingDescriptions = &bindDesc;
+            vi.vertexBindingDescriptionCount = (uint32_t)bindDesc.size();
+            vi.pVertexBindingDescriptions = bindDesc.data();
             vi.vertexAttributeDescriptionCount = (uint32_t)attrDesc.size();
             vi.pVertexAttributeDescriptions = attrDesc.data();
 
@@ -1159,13 +1572,17 @@ namespace Conformance
             pipeInfo.renderPass = rp.pass;
             pipeInfo.subpass = 0;
 
-            Create(device, pipeInfo);
+            Create(device, pipeInfo, pipelineCache);
         }
 
-        void Create(VkDevice device, const VkGraphicsPipelineCreateInfo& info)
+        void Create(VkDevice device, const VkGraphicsPipelineCreateInfo& info, PipelineCache* pipelineCache = nullptr)
         {
             m_vkDevice = device;
 
+            if (pipelineCache != nullptr) {
+                pipe = pipelineCache->CreateGraphicsPipeline(info);
+                return;
+            }
             XRC_CHECK_THROW_VKCMD(vkCreateGraphicsPipelines(m_vkDevice, VK_NULL_HANDLE, 1, &info, nullptr, &pipe));
         }
 
@@ -25,7 +25,10 @@
 
 #include <openxr/openxr.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -62,6 +65,40 @@ static XRAPI_ATTR XrResult XRAPI_CALL LoaderXrTermSubmitDebugUtilsMessageEXT(
 static XRAPI_ATTR XrResult XRAPI_CALL LoaderXrGetInstanceProcAddr(XrInstance instance, const char *name,
                                                                   PFN_xrVoidFunction *function);
 
+// An entry in one of the loader's command tables below.  Each table is sorted by name (in strcmp order)
+// so that a command implemented by the loader can be found with a binary search instead of a chain of
+// string comparisons on every xrGetInstanceProcAddr call.
+struct LoaderCommandEntry {
+    const char *name;
+    PFN_xrVoidFunction function;
+    // The command may be queried with an XR_NULL_HANDLE instance.
+    bool allowed_without_instance;
+    // The command is only returned when XR_EXT_debug_utils is enabled on the instance.
+    bool requires_debug_utils;
+};
+
+// True if the names of the table are in strictly increasing strcmp order, as FindLoaderCommand requires.
+template <size_t count>
+static bool IsLoaderCommandTableSorted(const LoaderCommandEntry (&table)[count]) {
+    const auto out_of_order = [](const LoaderCommandEntry &cur, const LoaderCommandEntry &next) {
+        return strcmp(cur.name, next.name) >= 0;
+    };
+    return std::adjacent_find(std::begin(table), std::end(table), out_of_order) == std::end(table);
+}
+
+template <size_t count>
+static const LoaderCommandEntry *FindLoaderCommand(const LoaderCommandEntry (&table)[count], const char *name) {
+    // The tables are sorted by hand, so catch an out-of-order or duplicate entry in debug builds.
+    assert(IsLoaderCommandTableSorted(table));
+    const LoaderCommandEntry *entry =
+        std::lower_bound(std::begin(table), std::end(table), name,
+                         [](const LoaderCommandEntry &cur, const char *value) { return strcmp(cur.name, value) < 0; });
+    if (entry != std::end(table) && strcmp(entry->name, name) == 0) {
+        return entry;
+    }
+    return nullptr;
+}
+
 // Utility template function meant to validate if a fixed size string contains
 // a null-terminator.
 template <size_t max_length>
@@ -356,6 +393,9 @@ static XRAPI_ATTR XrResult XRAPI_CALL LoaderXrDestroyInstance(XrInstance instanc
     // Finally, unload the runtime if necessary
     RuntimeInterface::UnloadRuntime("xrDestroyInstance");
 
+    // Make sure anything queued by asynchronous recorders has been written out.
+    LoaderLogger::GetInstance().Flush();
+
     return XR_SUCCESS;
 }
 XRLOADER_ABI_CATCH_FALLBACK
@@ -451,24 +491,27 @@ static XRAPI_ATTR XrResult XRAPI_CALL LoaderXrTermGetInstanceProcAddr(XrInstance
 
     // NOTE: ActiveLoaderInstance cannot be used in this function because it is called before an instance is made active.
 
-    if (0 == strcmp(name, "xrGetInstanceProcAddr")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermGetInstanceProcAddr);
-    } else if (0 == strcmp(name, "xrCreateInstance")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateInstance);
-    } else if (0 == strcmp(name, "xrDestroyInstance")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermDestroyInstance);
-    } else if (0 == strcmp(name, "xrSetDebugUtilsObjectNameEXT")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermSetDebugUtilsObjectNameEXT);
-    } else if (0 == strcmp(name, "xrCreateDebugUtilsMessengerEXT")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateDebugUtilsMessengerEXT);
-    } else if (0 == strcmp(name, "xrDestroyDebugUtilsMessengerEXT")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermDestroyDebugUtilsMessengerEXT);
-    } else if (0 == strcmp(name, "xrSubmitDebugUtilsMessageEXT")) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermSubmitDebugUtilsMessageEXT);
-    } else if (0 == strcmp(name, "xrCreateApiLayerInstance")) {
+    // Commands which need to go through a loader terminator, sorted by name.
+    static const LoaderCommandEntry terminator_commands[] = {
         // Special layer version of xrCreateInstance terminator.  If we get called this by a layer,
         // we simply re-direct the information back into the standard xrCreateInstance terminator.
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateApiLayerInstance);
+        {"xrCreateApiLayerInstance", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateApiLayerInstance), false, false},
+        {"xrCreateDebugUtilsMessengerEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateDebugUtilsMessengerEXT), false,
+         false},
+        {"xrCreateInstance", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermCreateInstance), false, false},
+        {"xrDestroyDebugUtilsMessengerEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermDestroyDebugUtilsMessengerEXT), false,
+         false},
+        {"xrDestroyInstance", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermDestroyInstance), false, false},
+        {"xrGetInstanceProcAddr", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermGetInstanceProcAddr), false, false},
+        {"xrSetDebugUtilsObjectNameEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermSetDebugUtilsObjectNameEXT), false,
+         false},
+        {"xrSubmitDebugUtilsMessageEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrTermSubmitDebugUtilsMessageEXT), false,
+         false},
+    };
+
+    const LoaderCommandEntry *entry = FindLoaderCommand(terminator_commands, name);
+    if (nullptr != entry) {
+        *function = entry->function;
     }
 
     if (nullptr != *function) {
@@ -729,12 +772,45 @@ XRAPI_ATTR XrResult XRAPI_CALL LoaderXrGetInstanceProcAddr(XrInstance instance,
     // Initialize the function to nullptr in case it does not get caught in a known case
     *function = nullptr;
 
+    // These functions must always go through the loader's implementation (trampoline), sorted by name.
+    // XR_EXT_debug_utils is built into the loader and handled partly through the xrGetInstanceProcAddress terminator,
+    // but the check to see if the extension is enabled must be done here where ActiveLoaderInstance is safe to use.
+    static const LoaderCommandEntry trampoline_commands[] = {
+        {"xrCreateDebugUtilsMessengerEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineCreateDebugUtilsMessengerEXT),
+         false, true},
+        {"xrCreateInstance", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrCreateInstance), true, false},
+        {"xrDestroyDebugUtilsMessengerEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineDestroyDebugUtilsMessengerEXT),
+         false, true},
+        {"xrDestroyInstance", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrDestroyInstance), false, false},
+        {"xrEnumerateApiLayerProperties", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrEnumerateApiLayerProperties), true, false},
+        {"xrEnumerateInstanceExtensionProperties",
+         reinterpret_cast<PFN_xrVoidFunction>(LoaderXrEnumerateInstanceExtensionProperties), true, false},
+        // TODO why is xrGetInstanceProcAddr not allowed without an instance?
+        {"xrGetInstanceProcAddr", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrGetInstanceProcAddr), false, false},
+#ifdef XR_KHR_LOADER_INIT_SUPPORT
+        {"xrInitializeLoaderKHR", reinterpret_cast<PFN_xrVoidFunction>(LoaderXrInitializeLoaderKHR), true, false},
+#else
+        // Known to the loader, but unsupported on this platform.
+        {"xrInitializeLoaderKHR", nullptr, true, false},
+#endif
+        {"xrSessionBeginDebugUtilsLabelRegionEXT",
+         reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionBeginDebugUtilsLabelRegionEXT), false, true},
+        {"xrSessionEndDebugUtilsLabelRegionEXT",
+         reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionEndDebugUtilsLabelRegionEXT), false, true},
+        {"xrSessionInsertDebugUtilsLabelEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionInsertDebugUtilsLabelEXT),
+         false, true},
+        {"xrSetDebugUtilsObjectNameEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSetDebugUtilsObjectNameEXT), false,
+         true},
+        {"xrSubmitDebugUtilsMessageEXT", reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSubmitDebugUtilsMessageEXT), false,
+         true},
+    };
+
+    const LoaderCommandEntry *entry = FindLoaderCommand(trampoline_commands, name);
+
     LoaderInstance *loader_instance = nullptr;
     if (instance == XR_NULL_HANDLE) {
         // Null instance is allowed for a few specific API entry points, otherwise return error
-        if (strcmp(name, "xrCreateInstance") != 0 && strcmp(name, "xrEnumerateApiLayerProperties") != 0 &&
-            strcmp(name, "xrEnumerateInstanceExtensionProperties") != 0 && strcmp(name, "xrInitializeLoaderKHR") != 0) {
-            // TODO why is xrGetInstanceProcAddr not listed in here?
+        if (nullptr == entry || !entry->allowed_without_instance) {
             std::string error_str = "XR_NULL_HANDLE for instance but query for ";
             error_str += name;
             error_str += " requires a valid instance";
@@ -753,59 +829,16 @@ XRAPI_ATTR XrResult XRAPI_CALL LoaderXrGetInstanceProcAddr(XrInstance instance,
         }
     }
 
-    // These functions must always go through the loader's implementation (trampoline).
-    if (strcmp(name, "xrGetInstanceProcAddr") == 0) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrGetInstanceProcAddr);
-        return XR_SUCCESS;
-    } else if (strcmp(name, "xrInitializeLoaderKHR") == 0) {
-#ifdef XR_KHR_LOADER_INIT_SUPPORT
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrInitializeLoaderKHR);
-        return XR_SUCCESS;
-#else
-        return XR_ERROR_FUNCTION_UNSUPPORTED;
-#endif
-    } else if (strcmp(name, "xrEnumerateApiLayerProperties") == 0) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrEnumerateApiLayerProperties);
-        return XR_SUCCESS;
-    } else if (strcmp(name, "xrEnumerateInstanceExtensionProperties") == 0) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrEnumerateInstanceExtensionProperties);
-        return XR_SUCCESS;
-    } else if (strcmp(name, "xrCreateInstance") == 0) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrCreateInstance);
-        return XR_SUCCESS;
-    } else if (strcmp(name, "xrDestroyInstance") == 0) {
-        *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderXrDestroyInstance);
-        return XR_SUCCESS;
-    }
-
-    // XR_EXT_debug_utils is built into the loader and handled partly through the xrGetInstanceProcAddress terminator,
-    // but the check to see if the extension is enabled must be done here where ActiveLoaderInstance is safe to use.
-    if (*function == nullptr) {
-        if (strcmp(name, "xrCreateDebugUtilsMessengerEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineCreateDebugUtilsMessengerEXT);
-        } else if (strcmp(name, "xrDestroyDebugUtilsMessengerEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineDestroyDebugUtilsMessengerEXT);
-        } else if (strcmp(name, "xrSessionBeginDebugUtilsLabelRegionEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionBeginDebugUtilsLabelRegionEXT);
-        } else if (strcmp(name, "xrSessionEndDebugUtilsLabelRegionEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionEndDebugUtilsLabelRegionEXT);
-        } else if (strcmp(name, "xrSessionInsertDebugUtilsLabelEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSessionInsertDebugUtilsLabelEXT);
-        } else if (strcmp(name, "xrSetDebugUtilsObjectNameEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSetDebugUtilsObjectNameEXT);
-        } else if (strcmp(name, "xrSubmitDebugUtilsMessageEXT") == 0) {
-            *function = reinterpret_cast<PFN_xrVoidFunction>(LoaderTrampolineSubmitDebugUtilsMessageEXT);
+    if (nullptr != entry) {
+        if (nullptr == entry->function) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
         }
-
-        if (*function != nullptr && !loader_instance->ExtensionIsEnabled("XR_EXT_debug_utils")) {
+        if (entry->requires_debug_utils && !loader_instance->ExtensionIsEnabled("XR_EXT_debug_utils")) {
             // The function matches one of the XR_EXT_debug_utils functions but the extension is not enabled.
-            *function = nullptr;
             return XR_ERROR_FUNCTION_UNSUPPORTED;
         }
-    }
-
-    if (*function != nullptr) {
         // The loader has a trampoline or implementation of this function.
+        *function = entry->function;
         return XR_SUCCESS;
     }
 
@@ -115,6 +115,16 @@ LoaderLogger::LoaderLogger() {
 #endif  // __ANDROID__
     }
 
+    // XR_LOADER_BINARY_LOG names a file to receive every message in the compact binary format
+    // described in loader_logger_recorders.hpp, independently of XR_LOADER_DEBUG.
+    std::string binary_log_path = PlatformUtilsGetSecureEnv("XR_LOADER_BINARY_LOG");
+    if (!binary_log_path.empty()) {
+        std::unique_ptr<LoaderLogRecorder> binary_recorder = MakeBinaryFileLoaderLogRecorder(binary_log_path);
+        if (binary_recorder) {
+            AddLogRecorder(std::move(binary_recorder));
+        }
+    }
+
 #ifdef _WIN32
     // Add an debugger logger by default so that we at least get errors out to the debugger.
     AddLogRecorder(MakeDebuggerLoaderLogRecorder(nullptr));
@@ -135,7 +145,14 @@ LoaderLogger::LoaderLogger() {
             debug_flags = XR_LOADER_LOG_MESSAGE_SEVERITY_ERROR_BIT | XR_LOADER_LOG_MESSAGE_SEVERITY_WARNING_BIT |
                           XR_LOADER_LOG_MESSAGE_SEVERITY_INFO_BIT | XR_LOADER_LOG_MESSAGE_SEVERITY_VERBOSE_BIT;
         }
-        AddLogRecorder(MakeStdOutLoaderLogRecorder(nullptr, debug_flags));
+        // XR_LOADER_DEBUG_ASYNC moves the formatted output off of the calling thread, at the cost of
+        // messages showing up slightly later (and possibly being dropped if they are produced faster
+        // than they can be written).
+        if (PlatformUtilsGetEnvSet("XR_LOADER_DEBUG_ASYNC")) {
+            AddLogRecorder(MakeAsyncStdOutLoaderLogRecorder(nullptr, debug_flags));
+        } else {
+            AddLogRecorder(MakeStdOutLoaderLogRecorder(nullptr, debug_flags));
+        }
     }
 }
 
@@ -173,6 +190,13 @@ void LoaderLogger::RemoveLogRecordersForXrInstance(XrInstance instance) {
     }
 }
 
+void LoaderLogger::Flush() {
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    for (std::unique_ptr<LoaderLogRecorder>& recorder : _recorders) {
+        recorder->Flush();
+    }
+}
+
 bool LoaderLogger::LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity, XrLoaderLogMessageTypeFlags message_type,
                               const std::string& message_id, const std::string& command_name, const std::string& message,
                               const std::vector<XrSdkLogObjectInfo>& objects) {
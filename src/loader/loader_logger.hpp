@@ -59,6 +59,7 @@ enum XrLoaderLogType {
     XR_LOADER_LOG_DEBUG_UTILS,
     XR_LOADER_LOG_DEBUGGER,
     XR_LOADER_LOG_LOGCAT,
+    XR_LOADER_LOG_BINARY_FILE,
 };
 
 class LoaderLogRecorder {
@@ -92,6 +93,9 @@ class LoaderLogRecorder {
 
     virtual void Stop() { _active = false; }
 
+    // Block until all messages previously logged to this recorder have been output - defaults to do nothing.
+    virtual void Flush() {}
+
     virtual bool LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity, XrLoaderLogMessageTypeFlags message_type,
                             const XrLoaderLogMessengerCallbackData* callback_data) = 0;
 
@@ -122,6 +126,9 @@ class LoaderLogger {
     void AddLogRecorderForXrInstance(XrInstance instance, std::unique_ptr<LoaderLogRecorder>&& recorder);
     void RemoveLogRecordersForXrInstance(XrInstance instance);
 
+    //! Wait for all recorders to output any messages they have queued.
+    void Flush();
+
     //! Called from LoaderXrTermSetDebugUtilsObjectNameEXT - an empty name means remove
     void AddObjectName(uint64_t object_handle, XrObjectType object_type, const std::string& object_name);
     void BeginLabelRegion(XrSession session, const XrDebugUtilsLabelEXT* label_info);
@@ -14,8 +14,16 @@
 
 #include <openxr/openxr.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -26,6 +34,11 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#include "platform_utils.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 // Anonymous namespace to keep these types private
@@ -81,6 +94,104 @@ class OstreamLoaderLogRecorder : public LoaderLogRecorder {
     std::ostream& os_;
 };
 
+// With std::cout: Standard Output logger used with XR_LOADER_DEBUG and XR_LOADER_DEBUG_ASYNC
+// Formats each message on the calling thread, then hands it to a background writer thread through a
+// bounded multi-producer single-consumer ring buffer, so logging threads never block on stream output.
+class AsyncOstreamLoaderLogRecorder : public LoaderLogRecorder {
+   public:
+    AsyncOstreamLoaderLogRecorder(std::ostream& os, void* user_data, XrLoaderLogMessageSeverityFlags flags, size_t slot_count,
+                                  size_t byte_budget);
+    ~AsyncOstreamLoaderLogRecorder() override;
+
+    bool LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity, XrLoaderLogMessageTypeFlags message_type,
+                    const XrLoaderLogMessengerCallbackData* callback_data) override;
+
+    void Flush() override;
+
+   private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::string record;
+    };
+
+    bool TryPush(std::string&& record);
+    bool TryPop(std::string& record);
+    void WriterThread();
+    void DrainAndWrite();
+
+    std::ostream& os_;
+
+    // Ring buffer: a power-of-two number of slots, each tagged with a sequence number so producers
+    // can claim slots with a single compare-and-swap (bounded MPMC queue design, used here with one consumer).
+    std::unique_ptr<Slot[]> slots_;
+    size_t slot_mask_;
+    std::atomic<size_t> enqueue_pos_{0};
+    // Only touched by the writer thread.
+    size_t dequeue_pos_{0};
+
+    // Upper bound on the bytes of formatted text waiting in the buffer.
+    const size_t byte_budget_;
+    std::atomic<size_t> queued_bytes_{0};
+    std::atomic<uint64_t> dropped_count_{0};
+
+    // Used to wake the writer and to wait for it in Flush(); never taken by LogMessage.
+    std::mutex writer_mutex_;
+    std::condition_variable writer_cv_;
+    std::condition_variable flushed_cv_;
+    size_t written_pos_{0};
+    bool flush_requested_{false};
+    bool stop_requested_{false};
+    std::thread writer_thread_;
+};
+
+// Binary file logger used with XR_LOADER_BINARY_LOG
+// Copies each message into a memory-mapped file without any text formatting. Space for each record is
+// reserved with a compare-and-swap on the logical write position, so concurrent loggers never wait on
+// each other. The mapping is a ring of fixed-size blocks: once it is full, new records overwrite the
+// oldest ones.
+class BinaryFileLoaderLogRecorder : public LoaderLogRecorder {
+   public:
+    static std::unique_ptr<BinaryFileLoaderLogRecorder> Create(const std::string& filename, size_t capacity);
+    ~BinaryFileLoaderLogRecorder() override;
+
+    bool LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity, XrLoaderLogMessageTypeFlags message_type,
+                    const XrLoaderLogMessengerCallbackData* callback_data) override;
+
+    void Flush() override;
+
+   private:
+    static constexpr uint32_t kFormatVersion = 2;
+    static constexpr size_t kHeaderSize = 32;
+    static constexpr size_t kRecordFixedSize = 48;
+    static constexpr size_t kObjectSize = 12;
+    // Records cannot cross blocks, so the decoder can find the start of the oldest surviving records
+    // after a wrap. At most the unused tail of each block is wasted.
+    static constexpr size_t kBlockSize = 1024 * 1024;
+
+    BinaryFileLoaderLogRecorder(uint8_t* mapping, size_t capacity);
+
+    //! Reserves @p record_size bytes and returns their position, or false if a record that size can never fit.
+    bool ReservePosition(size_t record_size, uint64_t& position);
+    void WriteHeader();
+    void CloseMapping();
+
+    uint8_t* mapping_;
+    const size_t capacity_;
+    // The part of the mapping after the header that holds records: a whole number of blocks.
+    const size_t data_size_;
+    // Bytes reserved since the recorder was created, including block tails skipped over. Never wraps;
+    // the offset of a record after the header is its position modulo data_size_.
+    std::atomic<uint64_t> write_position_{0};
+    std::atomic<uint64_t> dropped_count_{0};
+
+#ifdef _WIN32
+    HANDLE file_{INVALID_HANDLE_VALUE};
+    HANDLE file_mapping_{nullptr};
+#else
+    int fd_{-1};
+#endif
+};
+
 // Debug Utils logger used with XR_EXT_debug_utils
 class DebugUtilsLogRecorder : public LoaderLogRecorder {
    public:
@@ -137,6 +248,353 @@ bool OstreamLoaderLogRecorder::LogMessage(XrLoaderLogMessageSeverityFlagBits mes
     return false;
 }
 
+// Asynchronous stdout logger
+AsyncOstreamLoaderLogRecorder::AsyncOstreamLoaderLogRecorder(std::ostream& os, void* user_data, XrLoaderLogMessageSeverityFlags flags,
+                                                             size_t slot_count, size_t byte_budget)
+    : LoaderLogRecorder(XR_LOADER_LOG_STDOUT, user_data, flags, 0xFFFFFFFFUL), os_(os), byte_budget_(byte_budget) {
+    // Round up to a power of two so positions can be mapped to slots with a mask.
+    size_t capacity = 2;
+    while (capacity < slot_count) {
+        capacity *= 2;
+    }
+    slots_.reset(new Slot[capacity]);
+    slot_mask_ = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer_thread_ = std::thread(&AsyncOstreamLoaderLogRecorder::WriterThread, this);
+
+    // Automatically start
+    Start();
+}
+
+AsyncOstreamLoaderLogRecorder::~AsyncOstreamLoaderLogRecorder() {
+    {
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        stop_requested_ = true;
+    }
+    writer_cv_.notify_one();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+bool AsyncOstreamLoaderLogRecorder::TryPush(std::string&& record) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & slot_mask_];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (difference == 0) {
+            // The slot is free for this position: try to claim it.
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The writer has not yet consumed this slot from the previous lap: the buffer is full.
+            return false;
+        } else {
+            // Another producer claimed this position; try again with the latest one.
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->record = std::move(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncOstreamLoaderLogRecorder::TryPop(std::string& record) {
+    Slot& slot = slots_[dequeue_pos_ & slot_mask_];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeue_pos_ + 1) {
+        // Empty, or a producer has claimed this slot but not yet filled it in.
+        return false;
+    }
+    record.swap(slot.record);
+    slot.record.clear();
+    slot.sequence.store(dequeue_pos_ + slot_mask_ + 1, std::memory_order_release);
+    ++dequeue_pos_;
+    return true;
+}
+
+bool AsyncOstreamLoaderLogRecorder::LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity,
+                                               XrLoaderLogMessageTypeFlags message_type,
+                                               const XrLoaderLogMessengerCallbackData* callback_data) {
+    if (_active && 0 != (_message_severities & message_severity) && 0 != (_message_types & message_type)) {
+        std::ostringstream oss;
+        OutputMessageToStream(oss, message_severity, message_type, callback_data);
+        std::string record = oss.str();
+        const size_t record_size = record.size();
+
+        // Reserve space in the byte budget first, so the buffer can never hold more than the budget.
+        const size_t previously_queued = queued_bytes_.fetch_add(record_size, std::memory_order_relaxed);
+        if (previously_queued + record_size > byte_budget_ || !TryPush(std::move(record))) {
+            queued_bytes_.fetch_sub(record_size, std::memory_order_relaxed);
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Return of "true" means that we should exit the application after the logged message.  We
+    // don't want to do that for our internal logging.  Only let a user return true.
+    return false;
+}
+
+void AsyncOstreamLoaderLogRecorder::DrainAndWrite() {
+    std::string record;
+    bool wrote_any = false;
+    while (TryPop(record)) {
+        os_ << record;
+        queued_bytes_.fetch_sub(record.size(), std::memory_order_relaxed);
+        wrote_any = true;
+    }
+    const uint64_t dropped = dropped_count_.exchange(0, std::memory_order_relaxed);
+    if (dropped != 0) {
+        os_ << "Warning [GENERAL | AsyncLogRecorder | OpenXR-Loader] : " << dropped
+            << " message(s) dropped because the log buffer was full" << std::endl;
+        wrote_any = true;
+    }
+    if (wrote_any) {
+        os_.flush();
+    }
+}
+
+void AsyncOstreamLoaderLogRecorder::WriterThread() {
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    for (;;) {
+        // Producers never signal (that would need the mutex), so poll at a short interval as well.
+        writer_cv_.wait_for(lock, std::chrono::milliseconds(10), [&] { return flush_requested_ || stop_requested_; });
+        const bool stopping = stop_requested_;
+        const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+        lock.unlock();
+        DrainAndWrite();
+        lock.lock();
+        written_pos_ = dequeue_pos_;
+        if (written_pos_ >= target) {
+            flush_requested_ = false;
+        }
+        flushed_cv_.notify_all();
+        if (stopping && written_pos_ >= target) {
+            return;
+        }
+    }
+}
+
+void AsyncOstreamLoaderLogRecorder::Flush() {
+    const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    while (written_pos_ < target) {
+        flush_requested_ = true;
+        writer_cv_.notify_one();
+        flushed_cv_.wait(lock);
+    }
+}
+
+// Binary file logger
+
+BinaryFileLoaderLogRecorder::BinaryFileLoaderLogRecorder(uint8_t* mapping, size_t capacity)
+    : LoaderLogRecorder(XR_LOADER_LOG_BINARY_FILE, nullptr,
+                        XR_LOADER_LOG_MESSAGE_SEVERITY_VERBOSE_BIT | XR_LOADER_LOG_MESSAGE_SEVERITY_INFO_BIT |
+                            XR_LOADER_LOG_MESSAGE_SEVERITY_WARNING_BIT | XR_LOADER_LOG_MESSAGE_SEVERITY_ERROR_BIT,
+                        0xFFFFFFFFUL),
+      mapping_(mapping),
+      capacity_(capacity),
+      data_size_((capacity - kHeaderSize) / kBlockSize * kBlockSize) {
+    WriteHeader();
+    // Automatically start
+    Start();
+}
+
+std::unique_ptr<BinaryFileLoaderLogRecorder> BinaryFileLoaderLogRecorder::Create(const std::string& filename, size_t capacity) {
+    std::unique_ptr<BinaryFileLoaderLogRecorder> recorder;
+#ifdef _WIN32
+    HANDLE file = CreateFileW(utf8_to_wide(filename).c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return recorder;
+    }
+    const uint64_t capacity64 = capacity;
+    HANDLE file_mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(capacity64 >> 32),
+                                             static_cast<DWORD>(capacity64 & 0xFFFFFFFFUL), nullptr);
+    if (file_mapping == nullptr) {
+        CloseHandle(file);
+        return recorder;
+    }
+    void* mapping = MapViewOfFile(file_mapping, FILE_MAP_WRITE, 0, 0, capacity);
+    if (mapping == nullptr) {
+        CloseHandle(file_mapping);
+        CloseHandle(file);
+        return recorder;
+    }
+    recorder.reset(new BinaryFileLoaderLogRecorder(static_cast<uint8_t*>(mapping), capacity));
+    recorder->file_ = file;
+    recorder->file_mapping_ = file_mapping;
+#else
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return recorder;
+    }
+    if (ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+        close(fd);
+        return recorder;
+    }
+    void* mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return recorder;
+    }
+    recorder.reset(new BinaryFileLoaderLogRecorder(static_cast<uint8_t*>(mapping), capacity));
+    recorder->fd_ = fd;
+#endif
+    return recorder;
+}
+
+BinaryFileLoaderLogRecorder::~BinaryFileLoaderLogRecorder() { CloseMapping(); }
+
+void BinaryFileLoaderLogRecorder::WriteHeader() {
+    const char magic[8] = {'X', 'R', 'L', 'D', 'B', 'L', 'O', 'G'};
+    const uint32_t format_version = kFormatVersion;
+    const uint32_t header_size = static_cast<uint32_t>(kHeaderSize);
+    const uint64_t dropped = dropped_count_.load(std::memory_order_relaxed);
+    const uint32_t block_size = static_cast<uint32_t>(kBlockSize);
+    const uint32_t block_count = static_cast<uint32_t>(data_size_ / kBlockSize);
+    memcpy(mapping_, magic, sizeof(magic));
+    memcpy(mapping_ + 8, &format_version, sizeof(format_version));
+    memcpy(mapping_ + 12, &header_size, sizeof(header_size));
+    memcpy(mapping_ + 16, &dropped, sizeof(dropped));
+    memcpy(mapping_ + 24, &block_size, sizeof(block_size));
+    memcpy(mapping_ + 28, &block_count, sizeof(block_count));
+}
+
+void BinaryFileLoaderLogRecorder::CloseMapping() {
+    if (mapping_ == nullptr) {
+        return;
+    }
+    WriteHeader();
+    // Trim the file to the data actually written, which is all of it once the ring has wrapped.
+    const size_t used = kHeaderSize + static_cast<size_t>(std::min<uint64_t>(write_position_.load(), data_size_));
+#ifdef _WIN32
+    FlushViewOfFile(mapping_, used);
+    UnmapViewOfFile(mapping_);
+    CloseHandle(file_mapping_);
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(used);
+    if (SetFilePointerEx(file_, size, nullptr, FILE_BEGIN)) {
+        SetEndOfFile(file_);
+    }
+    CloseHandle(file_);
+#else
+    munmap(mapping_, capacity_);
+    if (ftruncate(fd_, static_cast<off_t>(used)) != 0) {
+        // Leaves zero padding at the end, which the decoder treats as the end of the data.
+    }
+    close(fd_);
+#endif
+    mapping_ = nullptr;
+}
+
+bool BinaryFileLoaderLogRecorder::LogMessage(XrLoaderLogMessageSeverityFlagBits message_severity,
+                                             XrLoaderLogMessageTypeFlags message_type,
+                                             const XrLoaderLogMessengerCallbackData* callback_data) {
+    if (!_active || 0 == (_message_severities & message_severity) || 0 == (_message_types & message_type)) {
+        return false;
+    }
+
+    const size_t message_id_size = std::min<size_t>(strlen(callback_data->message_id), UINT16_MAX);
+    const size_t command_name_size = std::min<size_t>(strlen(callback_data->command_name), UINT16_MAX);
+    const size_t message_size = std::min<size_t>(strlen(callback_data->message), UINT32_MAX / 2);
+    const uint8_t object_count = callback_data->object_count;
+    const size_t unpadded_size =
+        kRecordFixedSize + object_count * kObjectSize + message_id_size + command_name_size + message_size;
+    const size_t record_size = (unpadded_size + 7) & ~size_t(7);
+
+    uint64_t position;
+    if (!ReservePosition(record_size, position)) {
+        dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint8_t* const record = mapping_ + kHeaderSize + static_cast<size_t>(position % data_size_);
+    // Clear the size of the record being overwritten first, so that until this one is complete the
+    // decoder sees the end of the block's data rather than an old header over new contents.
+    const uint32_t no_record = 0;
+    memcpy(record, &no_record, sizeof(no_record));
+    std::atomic_thread_fence(std::memory_order_release);
+    uint8_t* cur = record + sizeof(uint32_t);
+    auto write = [&cur](const void* data, size_t size) {
+        memcpy(cur, data, size);
+        cur += size;
+    };
+    const uint16_t message_id_size16 = static_cast<uint16_t>(message_id_size);
+    const uint16_t command_name_size16 = static_cast<uint16_t>(command_name_size);
+    const uint32_t message_size32 = static_cast<uint32_t>(message_size);
+    const uint8_t reserved[3] = {0, 0, 0};
+    const uint64_t timestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t severity = message_severity;
+    const uint64_t type = message_type;
+    write(&message_id_size16, sizeof(message_id_size16));
+    write(&command_name_size16, sizeof(command_name_size16));
+    write(&message_size32, sizeof(message_size32));
+    write(&object_count, sizeof(object_count));
+    write(reserved, sizeof(reserved));
+    write(&position, sizeof(position));
+    write(&timestamp, sizeof(timestamp));
+    write(&severity, sizeof(severity));
+    write(&type, sizeof(type));
+    for (uint8_t obj = 0; obj < object_count; ++obj) {
+        const uint64_t handle = callback_data->objects[obj].handle;
+        const uint32_t object_type = static_cast<uint32_t>(callback_data->objects[obj].type);
+        write(&handle, sizeof(handle));
+        write(&object_type, sizeof(object_type));
+    }
+    write(callback_data->message_id, message_id_size);
+    write(callback_data->command_name, command_name_size);
+    write(callback_data->message, message_size);
+    memset(cur, 0, record_size - unpadded_size);
+
+    // The size goes in last, so a record that is still being written (or was cut short by a crash)
+    // reads as the end of the data.
+    const uint32_t record_size32 = static_cast<uint32_t>(record_size);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(record, &record_size32, sizeof(record_size32));
+
+    // Return of "true" means that we should exit the application after the logged message.  We
+    // don't want to do that for our internal logging.  Only let a user return true.
+    return false;
+}
+
+bool BinaryFileLoaderLogRecorder::ReservePosition(size_t record_size, uint64_t& position) {
+    if (record_size > kBlockSize) {
+        return false;
+    }
+    uint64_t current = write_position_.load(std::memory_order_relaxed);
+    for (;;) {
+        position = current;
+        // Skip to the next block rather than cross into it; the decoder stops at the stale bytes left
+        // in the tail, since their position does not follow on.
+        const uint64_t block_offset = position % kBlockSize;
+        if (block_offset + record_size > kBlockSize) {
+            position += kBlockSize - block_offset;
+        }
+        if (write_position_.compare_exchange_weak(current, position + record_size, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void BinaryFileLoaderLogRecorder::Flush() {
+    if (mapping_ == nullptr) {
+        return;
+    }
+    WriteHeader();
+#ifdef _WIN32
+    FlushViewOfFile(mapping_, 0);
+#else
+    msync(mapping_, capacity_, MS_ASYNC);
+#endif
+}
+
 // A logger associated with the XR_EXT_debug_utils extension
 
 DebugUtilsLogRecorder::DebugUtilsLogRecorder(const XrDebugUtilsMessengerCreateInfoEXT* create_info,
@@ -264,6 +722,20 @@ std::unique_ptr<LoaderLogRecorder> MakeStdOutLoaderLogRecorder(void* user_data,
     return recorder;
 }
 
+std::unique_ptr<LoaderLogRecorder> MakeAsyncStdOutLoaderLogRecorder(void* user_data, XrLoaderLogMessageSeverityFlags flags) {
+    // Up to 4096 queued messages, using at most 4 MiB of formatted text.
+    std::unique_ptr<LoaderLogRecorder> recorder(
+        new AsyncOstreamLoaderLogRecorder(std::cout, user_data, flags, 4096, 4 * 1024 * 1024));
+    return recorder;
+}
+
+std::unique_ptr<LoaderLogRecorder> MakeBinaryFileLoaderLogRecorder(const std::string& filename) {
+    // The file is created sparse at this size and trimmed to the data written when the recorder is destroyed.
+    // Once it is full, the oldest records are overwritten.
+    std::unique_ptr<LoaderLogRecorder> recorder(BinaryFileLoaderLogRecorder::Create(filename, 64 * 1024 * 1024));
+    return recorder;
+}
+
 std::unique_ptr<LoaderLogRecorder> MakeStdErrLoaderLogRecorder(void* user_data) {
     std::unique_ptr<LoaderLogRecorder> recorder(
         new OstreamLoaderLogRecorder(std::cerr, user_data, XR_LOADER_LOG_MESSAGE_SEVERITY_ERROR_BIT));
@@ -14,6 +14,7 @@
 #include <openxr/openxr.h>
 
 #include <memory>
+#include <string>
 
 //! Standard Error logger, on by default. Disabled with environment variable XR_LOADER_DEBUG = "none".
 std::unique_ptr<LoaderLogRecorder> MakeStdErrLoaderLogRecorder(void* user_data);
@@ -21,6 +22,31 @@ std::unique_ptr<LoaderLogRecorder> MakeStdErrLoaderLogRecorder(void* user_data);
 //! Standard Output logger used with XR_LOADER_DEBUG environment variable.
 std::unique_ptr<LoaderLogRecorder> MakeStdOutLoaderLogRecorder(void* user_data, XrLoaderLogMessageSeverityFlags flags);
 
+//! Standard Output logger used with XR_LOADER_DEBUG when XR_LOADER_DEBUG_ASYNC is also set.
+//! Messages are formatted on the calling thread, queued in a bounded lock-free ring buffer, and written
+//! by a background thread. Messages that do not fit in the buffer are dropped and counted.
+std::unique_ptr<LoaderLogRecorder> MakeAsyncStdOutLoaderLogRecorder(void* user_data, XrLoaderLogMessageSeverityFlags flags);
+
+//! Binary file logger used with the XR_LOADER_BINARY_LOG environment variable.
+//! Records every message, without text formatting, into a memory-mapped file used as a ring buffer:
+//! once it is full, the oldest records are overwritten, so the file always holds the latest messages.
+//! Returns nullptr if the file could not be created.
+//!
+//! File layout (all integers little-endian, see src/scripts/loader_binary_log_decoder.py):
+//!  - 32-byte header: "XRLDBLOG" magic, uint32 format version (2), uint32 header size,
+//!    uint64 count of dropped records (too large for a block), uint32 block size, uint32 block count.
+//!  - block count x block size bytes of records. Records never cross a block boundary, so each block
+//!    starts with a record. Each record is 8-byte aligned: uint32 record size (including padding),
+//!    uint16 message id length, uint16 command name length, uint32 message length, uint8 object count,
+//!    3 reserved bytes, uint64 position (bytes logged before this record, so position modulo the data
+//!    size is its offset after the header), uint64 timestamp (ns since the epoch), uint64 severity,
+//!    uint64 message type, object count x (uint64 handle, uint32 object type), then the three strings
+//!    (not null-terminated).
+//!  - Within a block, a record size of zero, or a record whose position does not follow on from the
+//!    previous one, marks the end of that block's data. Records older than the latest record's end
+//!    minus the data size have been overwritten.
+std::unique_ptr<LoaderLogRecorder> MakeBinaryFileLoaderLogRecorder(const std::string& filename);
+
 #ifdef __ANDROID__
 //! Android liblog ("logcat") logger
 std::unique_ptr<LoaderLogRecorder> MakeLogcatLoaderLogRecorder();
@@ -32,7 +32,9 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -465,6 +467,120 @@ static void ReadLayerDataFilesInRegistry(const std::string &registry_location, s
 
 #endif  // XR_OS_WINDOWS
 
+namespace {
+// Identifies one version of a manifest file on disk.
+struct ManifestFileStamp {
+    bool valid = false;
+    uint64_t size = 0;
+    uint64_t modification_stamp = 0;
+};
+
+// The parsed JSON of a manifest file, together with the stamp of the file it was parsed from.
+struct CachedManifestJson {
+    std::string filename;
+    ManifestFileStamp stamp;
+    Json::Value root_node;
+};
+
+// Entries are kept in least recently used order, most recent first, and indexed by file name.
+struct ManifestCache {
+    std::list<CachedManifestJson> entries;
+    std::unordered_map<std::string, std::list<CachedManifestJson>::iterator> index;
+    // The number of files found by the last directory scan of each manifest type.
+    size_t scan_sizes[MANIFEST_TYPE_EXPLICIT_API_LAYER + 1] = {};
+};
+}  // namespace
+
+// Parsed manifest files are cached by path, so that repeatedly creating instances or enumerating layers does not
+// re-read and re-parse every manifest.  Directories are still scanned each time, and an entry is only reused if the
+// file's size and modification stamp are unchanged.  The cache holds as many entries as the last API layer scans of
+// each type found files, plus kCachedManifestHeadroom for the runtime manifest and files that come and go between
+// scans.  A scan reads its files in order, so a cache even one entry smaller than the files in use would evict each
+// file just before it is read again.  Beyond that the least recently used entry is evicted, so a long-running process
+// that sees many manifest paths over time does not keep all of them.
+static constexpr size_t kCachedManifestHeadroom = 64;
+
+static std::mutex &GetManifestCacheMutex() {
+    static std::mutex manifest_cache_mutex;
+    return manifest_cache_mutex;
+}
+
+static ManifestCache &GetManifestCache() {
+    static ManifestCache manifest_cache;
+    return manifest_cache;
+}
+
+static size_t GetManifestCacheCapacity(const ManifestCache &cache) {
+    size_t capacity = kCachedManifestHeadroom;
+    for (size_t scan_size : cache.scan_sizes) {
+        capacity += scan_size;
+    }
+    return capacity;
+}
+
+static void EvictManifestCacheEntries(ManifestCache &cache) {
+    const size_t capacity = GetManifestCacheCapacity(cache);
+    while (cache.entries.size() > capacity) {
+        cache.index.erase(cache.entries.back().filename);
+        cache.entries.pop_back();
+    }
+}
+
+// Record how many files a directory scan of one manifest type found, which sizes the cache.
+static void SetManifestCacheScanSize(ManifestFileType type, size_t file_count) {
+    std::unique_lock<std::mutex> lock(GetManifestCacheMutex());
+    auto &cache = GetManifestCache();
+    cache.scan_sizes[type] = file_count;
+    EvictManifestCacheEntries(cache);
+}
+
+static ManifestFileStamp GetManifestFileStamp(const std::string &filename) {
+    ManifestFileStamp stamp;
+    stamp.valid = FileSysUtilsGetFileStamp(filename, stamp.size, stamp.modification_stamp);
+    return stamp;
+}
+
+// Retrieve the previously parsed contents of a manifest file, if the file has not changed since.
+static bool LookUpCachedManifestJson(const std::string &filename, const ManifestFileStamp &stamp, Json::Value &root_node) {
+    std::unique_lock<std::mutex> lock(GetManifestCacheMutex());
+    auto &cache = GetManifestCache();
+    auto it = cache.index.find(filename);
+    if (it == cache.index.end()) {
+        return false;
+    }
+    const ManifestFileStamp &cached_stamp = it->second->stamp;
+    if (!stamp.valid || cached_stamp.size != stamp.size || cached_stamp.modification_stamp != stamp.modification_stamp) {
+        cache.entries.erase(it->second);
+        cache.index.erase(it);
+        return false;
+    }
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    root_node = it->second->root_node;
+    return true;
+}
+
+// Remember the parsed contents of a manifest file.  The stamp must have been taken before the file was read,
+// so that a file modified while being read is parsed again next time.
+static void StoreCachedManifestJson(const std::string &filename, const ManifestFileStamp &stamp, const Json::Value &root_node) {
+    if (!stamp.valid) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(GetManifestCacheMutex());
+    auto &cache = GetManifestCache();
+    auto it = cache.index.find(filename);
+    if (it != cache.index.end()) {
+        cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    } else {
+        cache.entries.emplace_front();
+        cache.entries.front().filename = filename;
+        cache.index.emplace(filename, cache.entries.begin());
+    }
+    CachedManifestJson &entry = cache.entries.front();
+    entry.stamp = stamp;
+    entry.root_node = root_node;
+    EvictManifestCacheEntries(cache);
+}
+
 ManifestFile::ManifestFile(ManifestFileType type, const std::string &filename, const std::string &library_path)
     : _filename(filename), _type(type), _library_path(library_path) {}
 
@@ -568,9 +684,16 @@ void ManifestFile::ParseCommon(Json::Value const &root_node) {
 
 void RuntimeManifestFile::CreateIfValid(std::string const &filename,
                                         std::vector<std::unique_ptr<RuntimeManifestFile>> &manifest_files) {
-    std::ifstream json_stream(filename, std::ifstream::in);
-
     LoaderLogger::LogInfoMessage("", "RuntimeManifestFile::CreateIfValid - attempting to load " + filename);
+
+    const ManifestFileStamp stamp = GetManifestFileStamp(filename);
+    Json::Value root_node = Json::nullValue;
+    if (LookUpCachedManifestJson(filename, stamp, root_node)) {
+        CreateIfValid(root_node, filename, manifest_files);
+        return;
+    }
+
+    std::ifstream json_stream(filename, std::ifstream::in);
     std::ostringstream error_ss("RuntimeManifestFile::CreateIfValid ");
     if (!json_stream.is_open()) {
         error_ss << "failed to open " << filename << ".  Does it exist?";
@@ -579,7 +702,6 @@ void RuntimeManifestFile::CreateIfValid(std::string const &filename,
     }
     Json::CharReaderBuilder builder;
     std::string errors;
-    Json::Value root_node = Json::nullValue;
     if (!Json::parseFromStream(builder, json_stream, &root_node, &errors) || !root_node.isObject()) {
         error_ss << "failed to parse " << filename << ".";
         if (!errors.empty()) {
@@ -589,6 +711,7 @@ void RuntimeManifestFile::CreateIfValid(std::string const &filename,
         LoaderLogger::LogErrorMessage("", error_ss.str());
         return;
     }
+    StoreCachedManifestJson(filename, stamp, root_node);
 
     CreateIfValid(root_node, filename, manifest_files);
 }
@@ -778,22 +901,36 @@ void ApiLayerManifestFile::AddManifestFilesAndroid(const std::string &openxr_com
 }
 #endif  // defined(XR_USE_PLATFORM_ANDROID) && defined(XR_KHR_LOADER_INIT_SUPPORT)
 
-void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::string &filename, std::istream &json_stream,
-                                         LibraryLocator locate_library,
-                                         std::vector<std::unique_ptr<ApiLayerManifestFile>> &manifest_files) {
-    std::ostringstream error_ss("ApiLayerManifestFile::CreateIfValid ");
+bool ApiLayerManifestFile::ParseJson(const std::string &filename, std::istream &json_stream, Json::Value &root_node) {
     Json::CharReaderBuilder builder;
     std::string errors;
-    Json::Value root_node = Json::nullValue;
     if (!Json::parseFromStream(builder, json_stream, &root_node, &errors) || !root_node.isObject()) {
+        std::ostringstream error_ss("ApiLayerManifestFile::CreateIfValid ");
         error_ss << "failed to parse " << filename << ".";
         if (!errors.empty()) {
             error_ss << " (Error message: " << errors << ")";
         }
         error_ss << " Is it a valid layer manifest file?";
         LoaderLogger::LogErrorMessage("", error_ss.str());
+        return false;
+    }
+    return true;
+}
+
+void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::string &filename, std::istream &json_stream,
+                                         LibraryLocator locate_library,
+                                         std::vector<std::unique_ptr<ApiLayerManifestFile>> &manifest_files) {
+    Json::Value root_node = Json::nullValue;
+    if (!ParseJson(filename, json_stream, root_node)) {
         return;
     }
+    CreateIfValid(type, filename, root_node, locate_library, manifest_files);
+}
+
+void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::string &filename, const Json::Value &root_node,
+                                         LibraryLocator locate_library,
+                                         std::vector<std::unique_ptr<ApiLayerManifestFile>> &manifest_files) {
+    std::ostringstream error_ss("ApiLayerManifestFile::CreateIfValid ");
     JsonVersion file_version = {};
     if (!ManifestFile::IsValidJson(root_node, file_version)) {
         error_ss << "isValidJson indicates " << filename << " is not a valid manifest file.";
@@ -801,7 +938,7 @@ void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::strin
         return;
     }
 
-    Json::Value layer_root_node = root_node["api_layer"];
+    const Json::Value &layer_root_node = root_node["api_layer"];
 
     // The API Layer manifest file needs the "api_layer" root as well as other sub-nodes.
     // If any of those aren't there, fail.
@@ -896,14 +1033,22 @@ void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::strin
 
 void ApiLayerManifestFile::CreateIfValid(ManifestFileType type, const std::string &filename,
                                          std::vector<std::unique_ptr<ApiLayerManifestFile>> &manifest_files) {
-    std::ifstream json_stream(filename, std::ifstream::in);
-    if (!json_stream.is_open()) {
-        std::ostringstream error_ss("ApiLayerManifestFile::CreateIfValid ");
-        error_ss << "failed to open " << filename << ".  Does it exist?";
-        LoaderLogger::LogErrorMessage("", error_ss.str());
-        return;
+    const ManifestFileStamp stamp = GetManifestFileStamp(filename);
+    Json::Value root_node = Json::nullValue;
+    if (!LookUpCachedManifestJson(filename, stamp, root_node)) {
+        std::ifstream json_stream(filename, std::ifstream::in);
+        if (!json_stream.is_open()) {
+            std::ostringstream error_ss("ApiLayerManifestFile::CreateIfValid ");
+            error_ss << "failed to open " << filename << ".  Does it exist?";
+            LoaderLogger::LogErrorMessage("", error_ss.str());
+            return;
+        }
+        if (!ParseJson(filename, json_stream, root_node)) {
+            return;
+        }
+        StoreCachedManifestJson(filename, stamp, root_node);
     }
-    CreateIfValid(type, filename, json_stream, &ApiLayerManifestFile::LocateLibraryRelativeToJson, manifest_files);
+    CreateIfValid(type, filename, root_node, &ApiLayerManifestFile::LocateLibraryRelativeToJson, manifest_files);
 }
 
 bool ApiLayerManifestFile::LocateLibraryRelativeToJson(
@@ -991,6 +1136,7 @@ XrResult ApiLayerManifestFile::FindManifestFiles(const std::string &openxr_comma
     }
 #endif
 
+    SetManifestCacheScanSize(type, filenames.size());
     for (std::string &cur_file : filenames) {
         ApiLayerManifestFile::CreateIfValid(type, cur_file, manifest_files);
     }
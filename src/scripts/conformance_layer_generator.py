@@ -71,11 +71,15 @@ class ConformanceLayerGenerator(AutomaticSourceOutputGenerator):
         sorted_cmds = self.core_commands + self.ext_commands
         skip_hooks = set(self.no_trampoline_or_terminator).union(
             set(MANUALLY_DEFINED_IN_LAYER))
+        # Commands with generated hooks, in the order of their latency histogram indices.
+        hooked_command_names = [cmd.name for cmd in sorted_cmds
+                                if cmd.name not in skip_hooks and cmd.name != "xrGetInstanceProcAddr"]
         file_data = self.template.render(
             gen=self,
             registry=self.registry,
             sorted_cmds=sorted_cmds,
-            skip_hooks=skip_hooks)
+            skip_hooks=skip_hooks,
+            hooked_command_names=hooked_command_names)
         write(file_data, file=self.outFile)
 
         # Finish processing in superclass
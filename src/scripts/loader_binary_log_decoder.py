@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2024, The Khronos Group Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Purpose:      Decode a binary log written by the loader when the
+#               XR_LOADER_BINARY_LOG environment variable is set, into the
+#               same text form as the loader's stdout logger, or into JSON.
+#               See MakeBinaryFileLoaderLogRecorder in
+#               src/loader/loader_logger_recorders.hpp for the file layout.
+
+import argparse
+import datetime
+import json
+import struct
+import sys
+
+MAGIC = b'XRLDBLOG'
+SUPPORTED_VERSIONS = (1, 2)
+
+HEADER = struct.Struct('<8sIIQII')
+RECORD_FIXED_V1 = struct.Struct('<IHHIB3xQQQ')
+RECORD_FIXED = struct.Struct('<IHHIB3xQQQQ')
+OBJECT = struct.Struct('<QI')
+
+SEVERITY_INFO_BIT = 0x00000010
+SEVERITY_WARNING_BIT = 0x00000100
+SEVERITY_ERROR_BIT = 0x00001000
+
+MESSAGE_TYPES = {
+    0x1: 'GENERAL',
+    0x2: 'SPEC',
+    0x4: 'PERF',
+}
+
+
+def severity_name(severity):
+    # Mirrors OutputMessageToStream in loader_logger_recorders.cpp
+    if severity < SEVERITY_INFO_BIT:
+        return 'Verbose'
+    if severity < SEVERITY_WARNING_BIT:
+        return 'Info'
+    if severity < SEVERITY_ERROR_BIT:
+        return 'Warning'
+    return 'Error'
+
+
+def parse_record(data, offset, fixed):
+    """Return (record size, position or None, record dict) for the record at offset."""
+    fields = fixed.unpack_from(data, offset)
+    if fixed is RECORD_FIXED_V1:
+        (record_size, message_id_size, command_name_size, message_size, object_count, timestamp, severity,
+         message_type) = fields
+        position = None
+    else:
+        (record_size, message_id_size, command_name_size, message_size, object_count, position, timestamp, severity,
+         message_type) = fields
+    cur = offset + fixed.size
+    objects = []
+    for _ in range(object_count):
+        handle, object_type = OBJECT.unpack_from(data, cur)
+        objects.append({'handle': handle, 'type': object_type})
+        cur += OBJECT.size
+
+    def take(size):
+        nonlocal cur
+        text = data[cur:cur + size].decode('utf-8', errors='replace')
+        cur += size
+        return text
+
+    message_id = take(message_id_size)
+    command_name = take(command_name_size)
+    message = take(message_size)
+    return record_size, position, {
+        'timestamp_ns': timestamp,
+        'severity': severity,
+        'message_type': message_type,
+        'message_id': message_id,
+        'command_name': command_name,
+        'message': message,
+        'objects': objects,
+    }
+
+
+def read_records_v1(data):
+    """Yield one dict per record in a version 1 log, which is filled once from the header onwards."""
+    offset = HEADER.size
+    while offset + RECORD_FIXED_V1.size <= len(data):
+        record_size = struct.unpack_from('<I', data, offset)[0]
+        if record_size == 0 or offset + record_size > len(data):
+            # End of the data, or a record that was never completed.
+            break
+        yield parse_record(data, offset, RECORD_FIXED_V1)[2]
+        offset += record_size
+
+
+def read_records(data, block_size, block_count):
+    """Yield one dict per surviving record in a version 2 log, oldest first.
+
+    The records area is a ring of blocks. Each block is read from its start for as long as the records'
+    positions follow on from each other; the records older than one ring's worth before the latest record's
+    end have been partly overwritten and are skipped.
+    """
+    data_size = block_size * block_count
+    records = []
+    for block_start in range(0, min(data_size, len(data) - HEADER.size), block_size):
+        offset = block_start
+        block_end = min(block_start + block_size, len(data) - HEADER.size)
+        expected_position = None
+        while offset + RECORD_FIXED.size <= block_end:
+            record_size = struct.unpack_from('<I', data, HEADER.size + offset)[0]
+            if record_size == 0 or offset + record_size > block_end:
+                # End of the block's data, or a record that was never completed.
+                break
+            record_size, position, record = parse_record(data, HEADER.size + offset, RECORD_FIXED)
+            if position % data_size != offset or (expected_position is not None and position != expected_position):
+                # Stale bytes from an earlier pass over the ring.
+                break
+            records.append((position, record_size, record))
+            expected_position = position + record_size
+            offset += record_size
+
+    if not records:
+        return
+    end = max(position + record_size for position, record_size, _ in records)
+    for position, _, record in sorted(records, key=lambda entry: entry[0]):
+        if position >= end - data_size:
+            yield record
+
+
+def format_text(record):
+    timestamp = datetime.datetime.fromtimestamp(record['timestamp_ns'] / 1e9, tz=datetime.timezone.utc)
+    lines = ['{} {} [{} | {} | {}] : {}'.format(
+        timestamp.isoformat(),
+        severity_name(record['severity']),
+        MESSAGE_TYPES.get(record['message_type'], 'UNKNOWN'),
+        record['command_name'],
+        record['message_id'],
+        record['message'])]
+    for index, obj in enumerate(record['objects']):
+        lines.append('    Object[{}] = 0x{:016x} (type {})'.format(index, obj['handle'], obj['type']))
+    return '\n'.join(lines)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Decode an OpenXR loader binary log (XR_LOADER_BINARY_LOG).')
+    parser.add_argument('log_file', help='binary log file written by the loader')
+    parser.add_argument('--json', action='store_true', help='output one JSON object per line instead of text')
+    args = parser.parse_args(argv)
+
+    with open(args.log_file, 'rb') as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        print('File is too short to be a loader binary log', file=sys.stderr)
+        return 1
+    magic, version, header_size, dropped, block_size, block_count = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or header_size != HEADER.size:
+        print('Not a loader binary log', file=sys.stderr)
+        return 1
+    if version not in SUPPORTED_VERSIONS:
+        print('Unsupported loader binary log version {}'.format(version), file=sys.stderr)
+        return 1
+
+    if version == 1:
+        records = read_records_v1(data)
+    else:
+        records = read_records(data, block_size, block_count)
+    for record in records:
+        if args.json:
+            print(json.dumps(record))
+        else:
+            print(format_text(record))
+
+    if dropped:
+        if version == 1:
+            print('{} record(s) were dropped because the log file was full'.format(dropped), file=sys.stderr)
+        else:
+            print('{} record(s) were dropped because they were larger than a block'.format(dropped), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
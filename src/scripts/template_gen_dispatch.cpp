@@ -5,6 +5,8 @@
 // Used in conformance layer.
 
 #include "gen_dispatch.h"
+#include "CallStatistics.h"
+#include "LatencyHistograms.h"
 
 #if defined(ANDROID)
 #include <android/log.h>
@@ -38,6 +40,13 @@
 
 //# set ext_return_codes = registry.commandextensionsuccesses + registry.commandextensionerrors
 
+const char* const g_hookedCommandNames[] = {
+//# for name in hooked_command_names
+    /*{ name | quote_string }*/,
+//# endfor
+};
+const size_t g_hookedCommandCount = sizeof(g_hookedCommandNames) / sizeof(g_hookedCommandNames[0]);
+
 //# for cur_cmd in sorted_cmds
 //#     if cur_cmd.name not in skip_hooks and cur_cmd.name != "xrGetInstanceProcAddr"
 
@@ -68,7 +77,12 @@
         return XR_ERROR_VALIDATION_FAILURE;
     }
 
+    const bool timeRuntimeCall = RuntimeCallTimingEnabled();
+    const auto runtimeCallStart = timeRuntimeCall ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
     const /*{cur_cmd.return_type.text}*/ result =  this->dispatchTable./*{ cur_cmd.name | base_name }*/(/*{ cur_cmd.params | map(attribute="name") | join(", ") }*/);
+    if (timeRuntimeCall) {
+        RecordRuntimeCall(/*{ hooked_command_names.index(cur_cmd.name) }*/, std::chrono::steady_clock::now() - runtimeCallStart);
+    }
 
 //## TODO: Inspect out structs
 //## Check if the return code is a valid return code.
@@ -172,6 +186,11 @@ static PFN_xrVoidFunction ConformanceLayer_InnerGetInstanceProcAddr(
     if (strcmp(name, "xrGetInstanceProcAddr") == 0) {
         return reinterpret_cast<PFN_xrVoidFunction>(ConformanceLayer_xrGetInstanceProcAddr);
     }
+
+    if (strcmp(name, XRC_GET_RUNTIME_CALL_STATISTICS_NAME) == 0) {
+        EnableRuntimeCallStatistics();
+        return reinterpret_cast<PFN_xrVoidFunction>(ConformanceLayer_GetRuntimeCallStatistics);
+    }
 //# for cur_cmd in sorted_cmds
 //#     set is_core = "XR_VERSION_" in cur_cmd.ext_name
 //#     if cur_cmd.name not in skip_hooks and cur_cmd.name != "xrGetInstanceProcAddr"